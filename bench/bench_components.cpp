@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "algorithms/Dijkstra.h"
+#include "algorithms/TopologySnapshot.h"
+#include "core/Network.h"
+#include "core/PacketBuffer.h"
+#include "core/PageReassembler.h"
+#include "core/RoutingTable.h"
+
+// Microbenchmarks of the hot paths of a tick, each in isolation
+
+namespace {
+const IPAddress SRC{1, 1};
+const IPAddress DST{2, 1};
+
+/** Page of length packets from SRC to DST, in arrival order */
+std::vector<Packet> makePage(size_t pageID, size_t length) {
+    std::vector<Packet> packets;
+    packets.reserve(length);
+    for (size_t pos = 0; pos < length; ++pos) {
+        packets.emplace_back(pageID, pos, length, SRC, DST, Packet::MAX_TIMEOUT);
+    }
+    return packets;
+}
+
+/** Network with the given number of routers and a fixed seed, without traffic */
+Network makeNetwork(IPAddress::RouterID routers, size_t complexity) {
+    return Network{Network::Config{.routerCount = routers, .maxTerminalCount = 4,
+                                   .complexity = complexity, .trafficProbability = 0.0f,
+                                   .maxPageLen = Network::DEF_MAX_PAGE_LEN, .seed = 1}};
+}
+}  // namespace
+
+// =============== PacketBuffer ===============
+static void BM_PacketBuffer_EnqueueDequeue(benchmark::State& state) {
+    const auto burst = static_cast<size_t>(state.range(0));
+    PacketBuffer buffer;
+    const Packet packet(0, 0, 1, SRC, DST, Packet::MAX_TIMEOUT);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < burst; ++i) {
+            buffer.enqueue(packet);
+        }
+        Packet out = packet;
+        while (buffer.tryDequeue(out)) {
+            benchmark::DoNotOptimize(out);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PacketBuffer_EnqueueDequeue)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_PacketBuffer_Batch(benchmark::State& state) {
+    const auto burst = static_cast<size_t>(state.range(0));
+    PacketBuffer buffer;
+    const std::vector<Packet> packets = makePage(0, burst);
+    std::vector<Packet> out;
+
+    for (auto _ : state) {
+        buffer.enqueueBatch(packets);
+        out.clear();
+        buffer.dequeueBatch(burst, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PacketBuffer_Batch)->Arg(8)->Arg(64)->Arg(512);
+
+// =============== Router ===============
+// Input processing of one batch at the default processing rate, and the timeout scan alone over
+// the same batch, which bounds what a column layout of the packets could save
+static void BM_Router_ProcessInput(benchmark::State& state) {
+    const Router::Config cfg{0, Router::DEF_INPUT_PROC, 0, Router::DEF_LOC_BW, 64,
+                             Router::DEF_OUTPUT_BW};
+    Router router{IPAddress{1, 0}, 0, cfg};
+    Router neighbor{IPAddress{DST.getRouterIP()}};
+    router.connectRouter(&neighbor);
+    RoutingTable table;
+    table.setNextHopIP(neighbor.getIP(), neighbor.getIP());
+    router.setRoutingTable(std::move(table));
+    const std::vector<Packet> packets = makePage(0, Router::DEF_INPUT_PROC);
+
+    for (auto _ : state) {
+        router.receivePackets(packets);
+        benchmark::DoNotOptimize(router.processInputBuffer(1));
+    }
+    state.SetItemsProcessed(state.iterations() * Router::DEF_INPUT_PROC);
+}
+BENCHMARK(BM_Router_ProcessInput);
+
+static void BM_Router_TimeoutScan(benchmark::State& state) {
+    const std::vector<Packet> packets = makePage(0, Router::DEF_INPUT_PROC);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(packets.data());
+        size_t expired = 0;
+        for (const Packet& packet : packets) {
+            expired += packet.getTimeout() <= 1;
+        }
+        benchmark::DoNotOptimize(expired);
+    }
+    state.SetItemsProcessed(state.iterations() * Router::DEF_INPUT_PROC);
+}
+BENCHMARK(BM_Router_TimeoutScan);
+
+// =============== RoutingTable ===============
+static void BM_RoutingTable_GetNextHopIP(benchmark::State& state) {
+    RoutingTable table;
+    for (size_t id = 1; id < 256; ++id) {
+        table.setNextHopIP(IPAddress{static_cast<uint8_t>(id)},
+                           IPAddress{static_cast<uint8_t>(id % 7 + 1)});
+    }
+
+    uint8_t dest = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.getNextHopIP(IPAddress{dest, 3}));
+        dest = static_cast<uint8_t>(dest % 255 + 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RoutingTable_GetNextHopIP);
+
+// =============== DijkstraAlgorithm ===============
+static void BM_Dijkstra_ComputeRoutingTable(benchmark::State& state) {
+    const Network network = makeNetwork(static_cast<IPAddress::RouterID>(state.range(0)), 5);
+    const TopologySnapshot topology(network.getRouters());
+
+    size_t source = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(DijkstraAlgorithm::computeRoutingTable(topology, source));
+        source = (source + 1) % topology.routerCount();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Dijkstra_ComputeRoutingTable)->Arg(20)->Arg(100)->Arg(255);
+
+// =============== PageReassembler ===============
+static void BM_PageReassembler_AddPacket(benchmark::State& state) {
+    const auto length = static_cast<size_t>(state.range(0));
+    const std::vector<Packet> page = makePage(7, length);
+    ReassemblyPool pool(length);
+
+    for (auto _ : state) {
+        PageReassembler reassembler(7, SRC, length, Packet::MAX_TIMEOUT, &pool);
+        for (const Packet& packet : page) {
+            benchmark::DoNotOptimize(reassembler.addPacket(packet));
+        }
+        benchmark::DoNotOptimize(reassembler.finish());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PageReassembler_AddPacket)->Arg(4)->Arg(10)->Arg(64);
+
+// =============== Network ===============
+static void BM_Network_Tick(benchmark::State& state) {
+    // Ticks run in blocks of whole route intervals, so every block pays the same route updates
+    const auto ticks = static_cast<size_t>(state.range(0));
+    Network network{Network::Config{.routerCount = 20, .maxTerminalCount = 4, .complexity = 5,
+                                    .trafficProbability = 0.5f,
+                                    .maxPageLen = Network::DEF_MAX_PAGE_LEN, .seed = 1}};
+    network.simulate(20);
+
+    for (auto _ : state) {
+        network.simulate(ticks);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Network_Tick)->Arg(Network::DEF_ROUTE_INTERVAL * 10);
@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include "core/Network.h"
+
+// Whole-network scenarios across topology sizes, densities and traffic loads
+
+namespace {
+/** Ticks simulated before measuring, so the buffers hold a steady load */
+constexpr size_t WARMUP_TICKS = 50;
+/** Ticks simulated per benchmark iteration */
+constexpr size_t TICKS_PER_ITERATION = 100;
+}  // namespace
+
+/**
+ * Arguments: router count, complexity, traffic probability in percent. Every run uses the same
+ * seed, so a change in throughput comes from the code and not from a different topology.
+ */
+static void BM_Scenario(benchmark::State& state) {
+    const auto routers      = static_cast<IPAddress::RouterID>(state.range(0));
+    const auto complexity   = static_cast<size_t>(state.range(1));
+    const float probability = static_cast<float>(state.range(2)) / 100.0f;
+
+    Network network{Network::Config{.routerCount = routers,
+                                    .maxTerminalCount = Network::DEF_MAX_TERMINALS,
+                                    .complexity = complexity, .trafficProbability = probability,
+                                    .maxPageLen = Network::DEF_MAX_PAGE_LEN, .seed = 1}};
+    network.simulate(WARMUP_TICKS);
+    const NetworkStats before = network.getStats();
+
+    for (auto _ : state) {
+        network.simulate(TICKS_PER_ITERATION);
+    }
+
+    const NetworkStats after = network.getStats();
+    const auto ticks         = static_cast<double>(after.currentTick - before.currentTick);
+    const auto generated = static_cast<double>(after.packetsGenerated - before.packetsGenerated);
+    const auto delivered = static_cast<double>(after.packetsDelivered - before.packetsDelivered);
+
+    state.counters["ticks"]     = benchmark::Counter(ticks, benchmark::Counter::kIsRate);
+    state.counters["generated"] = benchmark::Counter(generated, benchmark::Counter::kIsRate);
+    state.counters["delivered"] = benchmark::Counter(delivered, benchmark::Counter::kIsRate);
+    state.counters["success"]   = after.successRate();
+}
+BENCHMARK(BM_Scenario)
+    ->ArgNames({"routers", "complexity", "traffic%"})
+    ->ArgsProduct({{20, 100, 255}, {1, 5, 10}, {5, 50}})
+    ->Unit(benchmark::kMillisecond);
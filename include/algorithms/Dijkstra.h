@@ -1,32 +1,40 @@
 #pragma once
 
 #include <limits>
+#include <utility>
+#include <vector>
+#include "algorithms/TopologySnapshot.h"
 #include "core/RoutingTable.h"
 #include "structures/list.h"
 
-// Forward declaration
+// Forward declarations
 class Router;
+class ThreadPool;
 
 /**
  * @class DijkstraAlgorithm
  * @brief Implements Dijkstra's shortest path algorithm for network routing.
  *
- * Calculates the shortest paths between routers and generates routing tables.
+ * Calculates the shortest paths between routers and generates routing tables. The search runs on
+ * a TopologySnapshot with a binary heap and records the first hop of every destination while
+ * relaxing edges, so each source costs O(E log V).
+ *
+ * The multipath variant keeps up to maxPaths first hops per destination, one for each distinct
+ * first hop of the shortest paths. Paths are compared by total weight and then by hop count, so
+ * zero-weight links cannot tie a path with a detour through them: every next hop is strictly
+ * closer to the destination under that order, and forwarding over any of them cannot loop.
+ *
+ * With a slack, next hops are also kept when their path weighs at most slack more than the
+ * shortest one, provided the neighbor is strictly closer to the destination than the source under
+ * the same order, which keeps them loop-free. This needs the costs from every neighbor of the
+ * source. A single source runs one search per neighbor on top of its own; computing all tables
+ * runs one search per router and shares the rows, at the cost of holding V rows of costs.
  */
 class DijkstraAlgorithm {
     static constexpr size_t INF = std::numeric_limits<size_t>::max();
 
-    /**
-     * @struct DistanceInfo
-     * @brief Stores distance and parent information for Dijkstra's algorithm.
-     */
-    struct DistanceInfo {
-        size_t distance;
-        IPAddress parent;
-        bool visited;
-
-        DistanceInfo() : distance(INF), parent(IPAddress{}), visited(false) {}
-    };
+    /** Cost of a path as (total weight, hops), compared in that order */
+    using Cost = std::pair<size_t, size_t>;
 
 public:
     /**
@@ -35,11 +43,27 @@ public:
      * @param routers List of all routers in the network.
      * @param sourceIP IP of the source router.
      * @return Routing table for the source router.
-     * @throws std::invalid_argument if sourceIP not found.
+     * @throws std::runtime_error if sourceIP not found.
      */
     [[nodiscard]] static RoutingTable computeRoutingTable(const List<const Router*>& routers,
                                                           IPAddress sourceIP);
 
+    /**
+     * @brief Computes shortest paths from a source router over a captured topology.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param sourceIndex Index of the source router in the snapshot.
+     * @param maxPaths Most equal-cost next hops kept per destination (1 for a single path).
+     * @param slack Extra path weight a next hop may have over the shortest path (0 keeps only
+     * equal-cost paths, ignored with a single path).
+     * @return Routing table for the source router.
+     * @throws std::out_of_range if sourceIndex is not a valid router index.
+     * @throws std::invalid_argument if maxPaths is 0 or above RoutingTable::MAX_PATHS.
+     */
+    [[nodiscard]] static RoutingTable computeRoutingTable(const TopologySnapshot& topology,
+                                                          size_t sourceIndex, size_t maxPaths = 1,
+                                                          size_t slack = 0);
+
     /**
      * @brief Computes routing tables for all routers in the network.
      *
@@ -49,22 +73,66 @@ public:
     static void computeAllRoutingTables(const List<const Router*>& routers,
                                         List<RoutingTable>& tables);
 
+    /**
+     * @brief Computes routing tables for every router of a captured topology.
+     *
+     * Sources are independent and read the snapshot only, so when a pool is given they are spread
+     * across its threads. The result is identical to the serial computation.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param tables Output routing tables, indexed like the snapshot routers (resized first).
+     * @param pool Thread pool to run the sources on, or nullptr to run them serially.
+     * @param maxPaths Most equal-cost next hops kept per destination (1 for a single path).
+     * @param slack Extra path weight a next hop may have over the shortest path.
+     * @throws std::invalid_argument if maxPaths is 0 or above RoutingTable::MAX_PATHS.
+     */
+    static void computeAllRoutingTables(const TopologySnapshot& topology,
+                                        std::vector<RoutingTable>& tables,
+                                        ThreadPool* pool = nullptr, size_t maxPaths = 1,
+                                        size_t slack = 0);
+
 private:
     /**
-     * @brief Finds the unvisited router with minimum distance.
+     * @brief Computes the multipath routing table of a source router.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param sourceIndex Index of the source router in the snapshot.
+     * @param maxPaths Most equal-cost next hops kept per destination.
+     * @return Routing table for the source router.
+     */
+    [[nodiscard]] static RoutingTable computeMultipathTable(const TopologySnapshot& topology,
+                                                            size_t sourceIndex, size_t maxPaths);
+
+    /**
+     * @brief Computes the multipath routing table of a source router, keeping near-equal paths.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param sourceIndex Index of the source router in the snapshot.
+     * @param maxPaths Most next hops kept per destination.
+     * @param slack Extra path weight a next hop may have over the shortest path.
+     * @param costs Path costs from each router by index, as computed by pathCosts(); only the
+     * rows of the source and its neighbors are read.
+     * @return Routing table for the source router.
+     */
+    [[nodiscard]] static RoutingTable computeNearEqualTable(
+        const TopologySnapshot& topology, size_t sourceIndex, size_t maxPaths, size_t slack,
+        const std::vector<std::vector<Cost>>& costs);
+
+    /**
+     * @brief Computes the cost of the shortest path from a router to every other.
      *
-     * @param distances Array of distance information.
-     * @param routerCount Number of routers.
-     * @return Index of minimum distance router, or -1 if none found.
+     * @param topology Snapshot of the network graph.
+     * @param sourceIndex Index of the router the paths start at.
+     * @return Cost of each router by index, {INF, INF} if unreachable.
      */
-    static size_t findMinDistance(const List<DistanceInfo>& distances, size_t routerCount);
+    [[nodiscard]] static std::vector<Cost> pathCosts(const TopologySnapshot& topology,
+                                                     size_t sourceIndex);
 
     /**
-     * @brief Gets index of router in a list.
+     * @brief Checks that a path count is one a routing table can hold.
      *
-     * @param routers List of routers.
-     * @param routerIP IP to find.
-     * @return Index, or -1 if not found.
+     * @param maxPaths Most next hops kept per destination.
+     * @throws std::invalid_argument if maxPaths is 0 or above RoutingTable::MAX_PATHS.
      */
-    static size_t getRouterIndex(const List<const Router*>& routers, IPAddress routerIP);
+    static void checkPathCount(size_t maxPaths);
 };
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class GraphOrdering
+ * @brief Computes locality-aware orderings of the nodes of an undirected graph.
+ *
+ * Nodes that are adjacent in the graph end up close to each other in the ordering, so storing
+ * routers in that order keeps the neighbors a router reads from during a tick on nearby cache
+ * lines. The graph is given as a list of links between node indices; self-links and duplicate
+ * links are ignored. Every node appears exactly once in the result, disconnected components one
+ * after another.
+ */
+class GraphOrdering {
+public:
+    /** Link between two node indices */
+    using Link = std::pair<size_t, size_t>;
+
+    /**
+     * @brief Orders the nodes breadth-first, starting from node 0, visiting the neighbors of each
+     * node by increasing index.
+     *
+     * @param nodeCount Number of nodes in the graph.
+     * @param links Links between nodes (every index must be below @p nodeCount).
+     * @return Node indices in breadth-first order.
+     * @throws std::invalid_argument if a link refers to a node outside the graph.
+     */
+    [[nodiscard]] static std::vector<size_t> breadthFirst(size_t nodeCount,
+                                                          const std::vector<Link>& links);
+
+    /**
+     * @brief Orders the nodes with the reverse Cuthill-McKee algorithm: a breadth-first search
+     * from a node of minimum degree that visits the neighbors of each node by increasing degree,
+     * reversed at the end. It narrows the bandwidth of the adjacency matrix, so links mostly join
+     * nodes that are close in the ordering.
+     *
+     * @param nodeCount Number of nodes in the graph.
+     * @param links Links between nodes (every index must be below @p nodeCount).
+     * @return Node indices in reverse Cuthill-McKee order.
+     * @throws std::invalid_argument if a link refers to a node outside the graph.
+     */
+    [[nodiscard]] static std::vector<size_t> reverseCuthillMcKee(size_t nodeCount,
+                                                                 const std::vector<Link>& links);
+
+private:
+    /**
+     * @brief Runs a breadth-first search from each unvisited root in turn, expanding the
+     * neighbors of every node in the order of its adjacency list.
+     *
+     * @param neighbors Adjacency list of each node.
+     * @param roots Candidate start nodes, tried in order; every node must appear once.
+     * @return Nodes in the order they were reached.
+     */
+    static std::vector<size_t> search(const std::vector<std::vector<size_t>>& neighbors,
+                                      const std::vector<size_t>& roots);
+
+    /**
+     * @brief Builds sorted, duplicate-free adjacency lists from a list of links.
+     *
+     * @param nodeCount Number of nodes in the graph.
+     * @param links Links between nodes.
+     * @return Neighbors of each node by increasing index.
+     * @throws std::invalid_argument if a link refers to a node outside the graph.
+     */
+    static std::vector<std::vector<size_t>> adjacency(size_t nodeCount,
+                                                      const std::vector<Link>& links);
+};
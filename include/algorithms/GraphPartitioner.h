@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "algorithms/TopologySnapshot.h"
+
+/**
+ * @class GraphPartitioner
+ * @brief Splits the router graph into balanced parts with few links between them.
+ *
+ * Each part is first grown breadth-first from a seed router until it holds its share of the
+ * routers, so parts start out as connected regions whenever the graph allows. Refinement passes
+ * then move boundary routers to the neighboring part holding most of their links whenever that
+ * strictly lowers the number of cut links, as in the Fiduccia-Mattheyses heuristic, without
+ * letting any part grow past the balance tolerance or become empty. The result depends only on
+ * the topology, never on the link loads.
+ */
+class GraphPartitioner {
+    /** Part of a router not assigned yet */
+    static constexpr size_t NO_PART = static_cast<size_t>(-1);
+
+public:
+    /** Fraction by which a part may exceed the ideal size during refinement */
+    static constexpr double IMBALANCE = 0.1;
+    /** Maximum number of refinement passes over the routers */
+    static constexpr size_t MAX_PASSES = 8;
+
+    /**
+     * @brief Partitions the routers of a captured topology.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param parts Number of parts (at least 1, at most the number of routers).
+     * @return Part of each router, by router index of the snapshot.
+     * @throws std::invalid_argument if @p parts is 0 or exceeds the number of routers.
+     */
+    [[nodiscard]] static std::vector<size_t> partition(const TopologySnapshot& topology,
+                                                       size_t parts);
+
+    /**
+     * @brief Counts the links whose ends lie in different parts. Each direction of a
+     * bidirectional link counts once.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param partOf Part of each router, by router index of the snapshot.
+     * @return Number of directed edges crossing a part boundary.
+     */
+    [[nodiscard]] static size_t cutEdges(const TopologySnapshot& topology,
+                                         const std::vector<size_t>& partOf);
+
+private:
+    /**
+     * @brief Runs one refinement pass, moving every router with a positive gain.
+     *
+     * @param topology Snapshot of the network graph.
+     * @param partOf Part of each router, updated in place.
+     * @param sizes Number of routers in each part, updated in place.
+     * @param maxSize Largest size a part may reach.
+     * @return Number of routers moved.
+     */
+    static size_t refine(const TopologySnapshot& topology, std::vector<size_t>& partOf,
+                         std::vector<size_t>& sizes, size_t maxSize);
+};
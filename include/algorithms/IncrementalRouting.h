@@ -0,0 +1,204 @@
+#pragma once
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "algorithms/TopologySnapshot.h"
+#include "core/RoutingTable.h"
+
+// Forward declaration
+class ThreadPool;
+
+/**
+ * @class IncrementalRouting
+ * @brief Keeps one shortest path tree per router and repairs them as link loads change.
+ *
+ * Each call to update() compares the edge weights of a new TopologySnapshot with the weights the
+ * trees were built with. Changes up to the configured threshold are ignored; the remaining edges
+ * are applied as a batch of dynamic single-source shortest path updates:
+ * - an increase on a tree edge invalidates the subtree below it, whose routers are reseeded from
+ *   their still valid in-neighbors;
+ * - a decrease seeds its target when it now offers a shorter path;
+ * and a Dijkstra pass from the seeds settles the affected routers only. When the topology itself
+ * changed, on the first update, or when more than the configured ratio of edges changed, every
+ * tree is rebuilt from scratch instead, which yields the same routes as DijkstraAlgorithm.
+ */
+class IncrementalRouting {
+public:
+    static constexpr size_t DEF_WEIGHT_THRESHOLD     = 0;    /**< Default ignored weight change */
+    static constexpr double DEF_FULL_RECOMPUTE_RATIO = 0.25; /**< Default full recompute ratio */
+
+    /**
+     * @struct Config
+     * @brief Tuning parameters of the incremental engine.
+     */
+    struct Config {
+        /** Edges whose weight moved by at most this amount keep their previous weight */
+        size_t weightThreshold;
+        /** Fraction of changed edges above which all trees are rebuilt instead of repaired */
+        double fullRecomputeRatio;
+
+        /**
+         * @brief Default constructor for Config, initializes with default values.
+         */
+        Config()
+            : weightThreshold(DEF_WEIGHT_THRESHOLD), fullRecomputeRatio(DEF_FULL_RECOMPUTE_RATIO) {}
+
+        /**
+         * @brief Parameterized constructor for Config allows setting custom values.
+         *
+         * @param weightThreshold Largest weight change that is ignored.
+         * @param fullRecomputeRatio Fraction of changed edges that triggers a full recompute.
+         */
+        Config(size_t weightThreshold, double fullRecomputeRatio)
+            : weightThreshold(weightThreshold), fullRecomputeRatio(fullRecomputeRatio) {}
+    };
+
+private:
+    static constexpr size_t INF = std::numeric_limits<size_t>::max();
+
+    /**
+     * @struct SourceTree
+     * @brief Shortest path tree rooted at one source router, indexed by router index.
+     */
+    struct SourceTree {
+        std::vector<size_t> distance; /**< Path length from the source, or INF if unreachable */
+        std::vector<size_t> parent;   /**< Predecessor on the path, or NO_INDEX */
+        std::vector<size_t> firstHop; /**< First router after the source on the path, or NO_INDEX */
+        bool changed = false;         /**< Whether the first hops changed during the last update */
+    };
+
+    /**
+     * @struct EdgeChange
+     * @brief An edge whose weight moved past the threshold, with the weight the trees used.
+     */
+    struct EdgeChange {
+        size_t edge;      /**< Edge id */
+        size_t oldWeight; /**< Weight before the change */
+    };
+
+    Config config;                         /**< Engine configuration */
+    std::optional<TopologySnapshot> graph; /**< Topology the trees were built on */
+    std::vector<size_t> weights;           /**< Effective weight of every edge, by edge id */
+    std::vector<SourceTree> trees;         /**< Shortest path tree of every source */
+
+    size_t fullRecomputes     = 0; /**< Number of updates that rebuilt every tree */
+    size_t incrementalUpdates = 0; /**< Number of updates that repaired the trees */
+    size_t lastChangedEdges   = 0; /**< Edges that moved past the threshold in the last update */
+
+public:
+    /**
+     * @brief Creates an engine with no trees; the first update() builds them.
+     *
+     * @param cfg Engine configuration.
+     * @throws std::invalid_argument if the full recompute ratio is negative.
+     */
+    explicit IncrementalRouting(const Config& cfg = Config{});
+
+    /**
+     * @brief Brings every shortest path tree up to date with a new snapshot.
+     *
+     * @param snapshot Current topology and link loads.
+     * @param pool Thread pool to process the sources on, or nullptr to process them serially.
+     * @return Number of sources whose routing table changed.
+     */
+    size_t update(const TopologySnapshot& snapshot, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Builds the routing table of a source from its shortest path tree.
+     *
+     * @param source Router index of the source.
+     * @return Routing table for the source router.
+     * @throws std::out_of_range if source is not a valid router index.
+     */
+    [[nodiscard]] RoutingTable buildRoutingTable(size_t source) const;
+
+    // =============== Getters ===============
+    /**
+     * @brief Checks whether the routing table of a source changed during the last update.
+     *
+     * @param source Router index of the source.
+     * @return true if the first hop towards any destination changed.
+     * @throws std::out_of_range if source is not a valid router index.
+     */
+    [[nodiscard]] bool routesChanged(size_t source) const;
+
+    /**
+     * @brief Gets the current path length between two routers.
+     *
+     * @param source Router index of the source.
+     * @param target Router index of the destination.
+     * @return Path length, or the maximum size_t value if the target is unreachable.
+     * @throws std::out_of_range if either index is not a valid router index.
+     */
+    [[nodiscard]] size_t getDistance(size_t source, size_t target) const;
+
+    /**
+     * @brief Gets the number of updates that rebuilt every tree.
+     *
+     * @return Number of full recomputes.
+     */
+    [[nodiscard]] size_t getFullRecomputes() const noexcept;
+
+    /**
+     * @brief Gets the number of updates that repaired the trees incrementally.
+     *
+     * @return Number of incremental updates.
+     */
+    [[nodiscard]] size_t getIncrementalUpdates() const noexcept;
+
+    /**
+     * @brief Gets the number of edges that moved past the threshold in the last update.
+     *
+     * @return Number of changed edges.
+     */
+    [[nodiscard]] size_t getLastChangedEdges() const noexcept;
+
+private:
+    /**
+     * @brief Rebuilds the tree of a source from scratch with the current weights.
+     *
+     * @param source Router index of the source.
+     */
+    void rebuildTree(size_t source);
+
+    /**
+     * @brief Repairs the tree of a source after a batch of edge weight changes.
+     *
+     * @param source Router index of the source.
+     * @param changes Edges that changed, with the weights the tree was built with.
+     */
+    void repairTree(size_t source, const std::vector<EdgeChange>& changes);
+
+    /**
+     * @brief Settles the routers queued in a heap, Dijkstra style, relaxing their outgoing edges.
+     *
+     * @param tree Tree being updated.
+     * @param source Router index of the tree's source.
+     * @param heap Min-heap of (distance, router index) seeds; consumed by the call.
+     */
+    void propagate(SourceTree& tree, size_t source,
+                   std::vector<std::pair<size_t, size_t>>& heap) const;
+
+    /**
+     * @brief Validates a router index.
+     *
+     * @param index Router index to check.
+     * @throws std::out_of_range if the index is not a valid router index.
+     */
+    void checkIndex(size_t index) const;
+};
+
+inline size_t IncrementalRouting::getFullRecomputes() const noexcept {
+    return fullRecomputes;
+}
+
+inline size_t IncrementalRouting::getIncrementalUpdates() const noexcept {
+    return incrementalUpdates;
+}
+
+inline size_t IncrementalRouting::getLastChangedEdges() const noexcept {
+    return lastChangedEdges;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "core/IPAddress.h"
+#include "structures/list.h"
+
+// Forward declaration
+class Router;
+
+/**
+ * @class TopologySnapshot
+ * @brief Immutable compressed-sparse-row (CSR) copy of the router graph.
+ *
+ * Routers are numbered by their position in the list the snapshot was built from. The outgoing
+ * edges of router `i` occupy the range `[offsets[i], offsets[i + 1])` of the neighbor and weight
+ * arrays, where each weight is the output buffer usage towards that neighbor at capture time.
+ * Capturing the graph once lets every shortest path computation of a recompute run on contiguous
+ * arrays instead of walking the routers' hash maps.
+ *
+ * Edges are also identified by their position in those arrays (edge id), and a reverse CSR lists
+ * the incoming edge ids of every router for algorithms that need to walk the graph backwards.
+ */
+class TopologySnapshot {
+public:
+    static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max(); /**< Missing router */
+
+private:
+    std::vector<IPAddress> routerIPs;    /**< Router IP addresses, by router index */
+    std::vector<size_t> offsets;         /**< First edge of each router, plus a final sentinel */
+    std::vector<size_t> neighborIndices; /**< Target router index of each edge */
+    std::vector<size_t> edgeWeights;     /**< Weight of each edge */
+    std::vector<size_t> indexByRouterID; /**< Router index by router ID, or NO_INDEX */
+    std::vector<size_t> edgeSources;     /**< Source router index of each edge */
+    std::vector<size_t> inOffsets;       /**< First incoming edge of each router, plus sentinel */
+    std::vector<size_t> inEdgeIDs;       /**< Edge ids grouped by target router */
+
+public:
+    /**
+     * @brief Captures the current topology and link loads of the given routers.
+     *
+     * @param routers List of all routers in the network.
+     * @throws std::runtime_error if a router is connected to a router missing from the list.
+     */
+    explicit TopologySnapshot(const List<const Router*>& routers);
+
+    /**
+     * @brief Captures the current topology and link loads of the given routers.
+     *
+     * @param routers Contiguous array of all routers in the network.
+     * @throws std::runtime_error if a router is connected to a router missing from the array.
+     */
+    explicit TopologySnapshot(std::span<const Router* const> routers);
+
+    // =============== Getters ===============
+    /**
+     * @brief Gets the number of routers in the snapshot.
+     *
+     * @return Number of routers.
+     */
+    [[nodiscard]] size_t routerCount() const noexcept;
+
+    /**
+     * @brief Gets the number of directed edges in the snapshot.
+     *
+     * @return Number of edges.
+     */
+    [[nodiscard]] size_t edgeCount() const noexcept;
+
+    /**
+     * @brief Gets the IP address of the router at the given index.
+     *
+     * @param index Router index.
+     * @return IP address of the router.
+     */
+    [[nodiscard]] IPAddress getRouterIP(size_t index) const noexcept;
+
+    /**
+     * @brief Gets the index of the router with the given IP address.
+     *
+     * @param routerIP IP address of the router (only its router ID is used).
+     * @return Router index, or NO_INDEX if the router is not part of the snapshot.
+     */
+    [[nodiscard]] size_t indexOf(IPAddress routerIP) const noexcept;
+
+    /**
+     * @brief Gets the neighbor indices of the router at the given index.
+     *
+     * @param index Router index.
+     * @return View over the target router index of each outgoing edge.
+     */
+    [[nodiscard]] std::span<const size_t> neighbors(size_t index) const noexcept;
+
+    /**
+     * @brief Gets the edge weights of the router at the given index, parallel to neighbors().
+     *
+     * @param index Router index.
+     * @return View over the weight of each outgoing edge.
+     */
+    [[nodiscard]] std::span<const size_t> weights(size_t index) const noexcept;
+
+    /**
+     * @brief Gets the edge id of the first outgoing edge of a router; its k-th neighbor is reached
+     * through edge `firstEdge(index) + k`.
+     *
+     * @param index Router index.
+     * @return Edge id of the first outgoing edge.
+     */
+    [[nodiscard]] size_t firstEdge(size_t index) const noexcept;
+
+    /**
+     * @brief Gets the ids of the edges that point to the router at the given index.
+     *
+     * @param index Router index.
+     * @return View over the incoming edge ids.
+     */
+    [[nodiscard]] std::span<const size_t> incomingEdges(size_t index) const noexcept;
+
+    /**
+     * @brief Gets the source router index of an edge.
+     *
+     * @param edge Edge id.
+     * @return Index of the router the edge leaves from.
+     */
+    [[nodiscard]] size_t edgeSource(size_t edge) const noexcept;
+
+    /**
+     * @brief Gets the target router index of an edge.
+     *
+     * @param edge Edge id.
+     * @return Index of the router the edge points to.
+     */
+    [[nodiscard]] size_t edgeTarget(size_t edge) const noexcept;
+
+    /**
+     * @brief Gets the weight of an edge.
+     *
+     * @param edge Edge id.
+     * @return Output buffer usage of the edge at capture time.
+     */
+    [[nodiscard]] size_t edgeWeight(size_t edge) const noexcept;
+
+    /**
+     * @brief Checks whether two snapshots have the same routers and edges, ignoring weights. Edge
+     * ids are interchangeable between snapshots with the same topology.
+     *
+     * @param other Snapshot to compare with.
+     * @return true if both snapshots describe the same graph.
+     */
+    [[nodiscard]] bool sameTopology(const TopologySnapshot& other) const noexcept;
+
+private:
+    /**
+     * @brief Fills the snapshot from any sized range of router pointers.
+     *
+     * @tparam Routers Range type with `size()` whose elements are `const Router*`.
+     * @param routers Routers to capture.
+     */
+    template <typename Routers>
+    void capture(const Routers& routers);
+};
+
+inline size_t TopologySnapshot::routerCount() const noexcept {
+    return routerIPs.size();
+}
+
+inline size_t TopologySnapshot::edgeCount() const noexcept {
+    return neighborIndices.size();
+}
+
+inline IPAddress TopologySnapshot::getRouterIP(size_t index) const noexcept {
+    return routerIPs[index];
+}
+
+inline size_t TopologySnapshot::indexOf(IPAddress routerIP) const noexcept {
+    const size_t id = routerIP.getRouterIP();
+    return id < indexByRouterID.size() ? indexByRouterID[id] : NO_INDEX;
+}
+
+inline std::span<const size_t> TopologySnapshot::neighbors(size_t index) const noexcept {
+    return {neighborIndices.data() + offsets[index], offsets[index + 1] - offsets[index]};
+}
+
+inline std::span<const size_t> TopologySnapshot::weights(size_t index) const noexcept {
+    return {edgeWeights.data() + offsets[index], offsets[index + 1] - offsets[index]};
+}
+
+inline size_t TopologySnapshot::firstEdge(size_t index) const noexcept {
+    return offsets[index];
+}
+
+inline std::span<const size_t> TopologySnapshot::incomingEdges(size_t index) const noexcept {
+    return {inEdgeIDs.data() + inOffsets[index], inOffsets[index + 1] - inOffsets[index]};
+}
+
+inline size_t TopologySnapshot::edgeSource(size_t edge) const noexcept {
+    return edgeSources[edge];
+}
+
+inline size_t TopologySnapshot::edgeTarget(size_t edge) const noexcept {
+    return neighborIndices[edge];
+}
+
+inline size_t TopologySnapshot::edgeWeight(size_t edge) const noexcept {
+    return edgeWeights[edge];
+}
+
+inline bool TopologySnapshot::sameTopology(const TopologySnapshot& other) const noexcept {
+    return routerIPs == other.routerIPs && offsets == other.offsets &&
+           neighborIndices == other.neighborIndices;
+}
@@ -52,4 +52,10 @@ public:
      * @param reportInterval The interval (in ticks) at which to print the network report.
      */
     void runFor(size_t ticks, size_t reportInterval = 10) const;
+
+    /**
+     * @brief Prints the per-tick time of every profiled phase (mean, median, 99th percentile and
+     * maximum), or a note if the simulator was built without ROUTERSIM_PROFILING.
+     */
+    void printProfile() const;
 };
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @struct CheckpointHeader
+ * @brief Header at the start of a simulation checkpoint.
+ *
+ * The header is followed by the state of the topology generator and then, router by router in
+ * router ID order, the traffic stream of the router and the state Router::saveState() writes.
+ * Arrays are stored at offsets aligned to CheckpointWriter::ALIGNMENT, so a mapped checkpoint is
+ * read in place.
+ */
+struct CheckpointHeader {
+    /** File signature */
+    static constexpr char MAGIC[8]     = {'R', 'S', 'C', 'K', 'P', 'T', '\0', '\0'};
+    /** Current format version */
+    static constexpr uint32_t VERSION  = 6;
+    /** Next hop entry of a destination without route */
+    static constexpr uint32_t NO_ROUTE = UINT32_MAX;
+
+    char magic[8];          /**< Always MAGIC */
+    uint32_t version;       /**< Format version of the checkpoint */
+    uint8_t routerBits;     /**< IPAddress::ROUTER_BITS of the simulator that wrote it */
+    uint8_t terminalBits;   /**< IPAddress::TERMINAL_BITS of the simulator that wrote it */
+    uint16_t reserved;      /**< Padding, always zero */
+    uint64_t seed;          /**< Seed of the network */
+    uint64_t currentTick;   /**< Next tick the network simulates */
+    uint32_t routerCount;   /**< Number of routers */
+    uint32_t terminalCount; /**< Number of terminals over all routers */
+};
+
+static_assert(sizeof(CheckpointHeader) == 40, "Checkpoint headers are 40 bytes");
+
+/**
+ * @class CheckpointWriter
+ * @brief Writes the binary state of a simulation to a stream.
+ *
+ * Values are written as their raw bytes, so only trivially copyable types are accepted, and a
+ * checkpoint only loads in a build with the same address layout and word size.
+ */
+class CheckpointWriter {
+public:
+    /** Alignment of every array in the checkpoint */
+    static constexpr size_t ALIGNMENT = 8;
+
+private:
+    std::ostream& out; /**< Stream receiving the checkpoint */
+    uint64_t offset;   /**< Bytes written so far */
+
+public:
+    /**
+     * @brief Constructor for CheckpointWriter.
+     *
+     * @param out Stream receiving the checkpoint, positioned at its start.
+     */
+    explicit CheckpointWriter(std::ostream& out) noexcept : out(out), offset(0) {}
+
+    /**
+     * @brief Writes a value.
+     *
+     * @tparam T Trivially copyable type of the value.
+     * @param value Value to write.
+     */
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoints store raw bytes");
+        writeBytes(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Pads the checkpoint to the next array boundary. Values written right after form an
+     * array that CheckpointReader::readArray() can read in place.
+     */
+    void align() {
+        static constexpr char PADDING[ALIGNMENT] = {};
+        writeBytes(PADDING, (ALIGNMENT - offset % ALIGNMENT) % ALIGNMENT);
+    }
+
+    /**
+     * @brief Writes an array at the next array boundary. The size is not written.
+     *
+     * @tparam T Trivially copyable type of the elements.
+     * @param values Elements to write.
+     */
+    template <typename T>
+    void writeArray(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoints store raw bytes");
+        align();
+        writeBytes(values.data(), values.size_bytes());
+    }
+
+    /**
+     * @brief Checks that every byte reached the stream.
+     *
+     * @return true if the stream has not failed.
+     */
+    [[nodiscard]] bool good() const { return static_cast<bool>(out); }
+
+private:
+    /**
+     * @brief Writes raw bytes.
+     *
+     * @param data Bytes to write.
+     * @param size Number of bytes.
+     */
+    void writeBytes(const void* data, size_t size) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        offset += size;
+    }
+};
+
+/**
+ * @class CheckpointReader
+ * @brief Reads a checkpoint written by CheckpointWriter from memory.
+ *
+ * Arrays are returned as views into the checkpoint instead of being copied, so restoring from a
+ * mapped file moves each packet once, straight from the page cache into its buffer. The bytes
+ * must start on an ALIGNMENT boundary, as mappings and heap allocations do.
+ */
+class CheckpointReader {
+    std::span<const unsigned char> bytes; /**< Contents of the checkpoint */
+    size_t offset;                        /**< Bytes read so far */
+
+public:
+    /**
+     * @brief Constructor for CheckpointReader.
+     *
+     * @param bytes Contents of the checkpoint, which must outlive the views readArray() returns.
+     * @throws std::invalid_argument if the bytes are not aligned to an array boundary.
+     */
+    explicit CheckpointReader(std::span<const unsigned char> bytes) : bytes(bytes), offset(0) {
+        if (reinterpret_cast<uintptr_t>(bytes.data()) % CheckpointWriter::ALIGNMENT != 0) {
+            throw std::invalid_argument("Checkpoint bytes must be 8-byte aligned");
+        }
+    }
+
+    /**
+     * @brief Reads a value.
+     *
+     * @tparam T Trivially copyable type of the value.
+     * @return The value.
+     * @throws std::runtime_error if the checkpoint is truncated.
+     */
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoints store raw bytes");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    /**
+     * @brief Reads an array written by CheckpointWriter::writeArray(), or by
+     * CheckpointWriter::align() followed by values of the same type.
+     *
+     * @tparam T Trivially copyable type of the elements.
+     * @param count Number of elements.
+     * @return View of the elements inside the checkpoint.
+     * @throws std::runtime_error if the checkpoint is truncated.
+     */
+    template <typename T>
+    std::span<const T> readArray(size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoints store raw bytes");
+        static_assert(CheckpointWriter::ALIGNMENT % alignof(T) == 0, "Arrays are 8-byte aligned");
+        take((CheckpointWriter::ALIGNMENT - offset % CheckpointWriter::ALIGNMENT) %
+             CheckpointWriter::ALIGNMENT);
+        if (count > (bytes.size() - offset) / sizeof(T)) {
+            throw std::runtime_error("Truncated checkpoint");
+        }
+        return {reinterpret_cast<const T*>(take(count * sizeof(T))), count};
+    }
+
+    /**
+     * @brief Checks whether the whole checkpoint has been read.
+     *
+     * @return true if no bytes are left.
+     */
+    [[nodiscard]] bool atEnd() const noexcept { return offset == bytes.size(); }
+
+private:
+    /**
+     * @brief Consumes raw bytes.
+     *
+     * @param size Number of bytes.
+     * @return Start of the bytes.
+     * @throws std::runtime_error if fewer bytes are left.
+     */
+    const unsigned char* take(size_t size) {
+        if (size > bytes.size() - offset) {
+            throw std::runtime_error("Truncated checkpoint");
+        }
+        const unsigned char* start = bytes.data() + offset;
+        offset += size;
+        return start;
+    }
+};
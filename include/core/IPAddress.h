@@ -1,105 +1,171 @@
 #pragma once
 
+#include <concepts>
 #include <cstdint>
 #include <iomanip>
+#include <sstream>
 #include <string>
+#include <type_traits>
+
+#ifndef ROUTERSIM_ROUTER_BITS
+/** Bits of the router ID in IPAddress (set by the ROUTERSIM_ADDRESS_LAYOUT CMake option) */
+#define ROUTERSIM_ROUTER_BITS 8
+#endif
+#ifndef ROUTERSIM_TERMINAL_BITS
+/** Bits of the terminal ID in IPAddress (set by the ROUTERSIM_ADDRESS_LAYOUT CMake option) */
+#define ROUTERSIM_TERMINAL_BITS 8
+#endif
+
+namespace detail {
+/**
+ * @brief Smallest unsigned integer type holding a number of bits (at most 32).
+ *
+ * @tparam Bits Number of bits to hold.
+ */
+template <unsigned Bits>
+using UintFor = std::conditional_t<
+    Bits <= 8, uint8_t, std::conditional_t<Bits <= 16, uint16_t, uint32_t>>;
+}  // namespace detail
 
 /**
- * @class IPAddress
- * @brief Represents a compact 2-byte IP address for routers and terminals in the network
- * simulation.
+ * @class BasicIPAddress
+ * @brief Represents a compact IP address for routers and terminals in the network simulation.
  *
  * The IP address is structured as follows:
- * - The upper 8 bits (bits 15-8) represent the Router ID, which identifies the network/router.
- * - The lower 8 bits (bits 7-0) represent the Terminal ID, which identifies a specific terminal
+ * - The upper RouterBits bits represent the Router ID, which identifies the network/router.
+ * - The lower TerminalBits bits represent the Terminal ID, which identifies a specific terminal
  * connected to that router.
+ *
+ * The address is stored in the smallest unsigned integer that holds both fields, so the default
+ * 8 + 8 layout keeps 2-byte addresses while wider layouts (16 + 16 or 24 + 8, in 4 bytes) allow
+ * tens of thousands of routers. The simulator uses the layout selected at compile time through
+ * the IPAddress alias.
+ *
+ * @tparam RouterBits Bits of the router ID.
+ * @tparam TerminalBits Bits of the terminal ID.
  */
-class IPAddress {
-    uint16_t address{}; /**< Internal 16-bit representation of the IP address, combining router and
-                           terminal IDs. */
+template <unsigned RouterBits, unsigned TerminalBits>
+class BasicIPAddress {
+    static_assert(RouterBits > 0 && TerminalBits > 0 && RouterBits + TerminalBits <= 32,
+                  "Addresses hold a router and a terminal ID in at most 32 bits");
+
+public:
+    /** Unsigned integer holding a whole address */
+    using Raw        = detail::UintFor<RouterBits + TerminalBits>;
+    /** Unsigned integer holding a router ID */
+    using RouterID   = detail::UintFor<RouterBits>;
+    /** Unsigned integer holding a terminal ID */
+    using TerminalID = detail::UintFor<TerminalBits>;
+
+    static constexpr unsigned ROUTER_BITS   = RouterBits;   /**< Bits of the router ID */
+    static constexpr unsigned TERMINAL_BITS = TerminalBits; /**< Bits of the terminal ID */
+    /** Largest router ID */
+    static constexpr RouterID MAX_ROUTER_ID     = static_cast<RouterID>((1ULL << RouterBits) - 1);
+    /** Largest terminal ID */
+    static constexpr TerminalID MAX_TERMINAL_ID =
+        static_cast<TerminalID>((1ULL << TerminalBits) - 1);
+
+private:
+    Raw address{}; /**< Internal representation of the IP address, combining router and terminal
+                      IDs. */
 
 public:
     // =============== Constructors & Destructor ===============
     /**
      * @brief Default constructor initializes the IP address to 0.0 (invalid).
      */
-    constexpr IPAddress() noexcept = default;
+    constexpr BasicIPAddress() noexcept = default;
 
     /**
      * @brief Constructor that takes separate router and terminal IDs to create a compact IP
      * address.
      *
-     * The routerIP is stored in the upper 8 bits and the terminalIP in the lower 8 bits of the
-     * 16-bit address.
+     * The routerIP is stored in the upper RouterBits bits and the terminalIP in the lower
+     * TerminalBits bits of the address.
      *
-     * @param routerIP The 8-bit identifier for the router (must be > 0 for valid routers).
-     * @param terminalIP The 8-bit identifier for the terminal (0 for routers, > 0 for terminals).
+     * @param routerIP The identifier for the router (must be > 0 for valid routers).
+     * @param terminalIP The identifier for the terminal (0 for routers, > 0 for terminals).
      * Default is 0, which indicates a router.
      */
-    constexpr explicit IPAddress(uint8_t routerIP, uint8_t terminalIP = 0) noexcept;
+    constexpr explicit BasicIPAddress(RouterID routerIP, TerminalID terminalIP = 0) noexcept;
 
     /**
-     * @brief Constructor that takes a raw 16-bit integer to create an IP address. This allows for
-     * direct initialization from a pre-packed address, but requires the caller to ensure the
-     * correct format (router in upper 8 bits, terminal in lower 8 bits).
+     * @brief Constructor that takes a raw integer to create an IP address. This allows for direct
+     * initialization from a pre-packed address, but requires the caller to ensure the correct
+     * format (router in the upper bits, terminal in the lower bits).
+     *
+     * Only an argument of exactly the Raw type selects this constructor, and only in layouts
+     * where Raw differs from RouterID; fromRaw() works in every layout.
      *
-     * @param rawAddress A 16-bit integer where the upper 8 bits represent the router ID and the
-     * lower 8 bits represent the terminal ID.
+     * @tparam T Type of the argument, which must be Raw.
+     * @param rawAddress An integer where the upper bits represent the router ID and the lower
+     * bits represent the terminal ID.
      */
-    constexpr explicit IPAddress(uint16_t rawAddress) noexcept;
+    template <std::same_as<Raw> T>
+        requires(!std::same_as<Raw, RouterID>)
+    constexpr explicit BasicIPAddress(T rawAddress) noexcept : address(rawAddress) {}
+
+    /**
+     * @brief Creates an IP address from its raw representation.
+     *
+     * @param rawAddress An integer where the upper bits represent the router ID and the lower
+     * bits represent the terminal ID.
+     * @return The IP address.
+     */
+    [[nodiscard]] static constexpr BasicIPAddress fromRaw(Raw rawAddress) noexcept;
 
     /**
      * @brief Default destructor.
      */
-    ~IPAddress() = default;
+    ~BasicIPAddress() = default;
 
     /**
      * @brief Default copy constructor.
      */
-    IPAddress(const IPAddress&) = default;
+    BasicIPAddress(const BasicIPAddress&) = default;
 
     /**
      * @brief Default move constructor.
      */
-    IPAddress(IPAddress&&) noexcept = default;
+    BasicIPAddress(BasicIPAddress&&) noexcept = default;
 
     /**
      * @brief Default copy assignment operator.
      *
      * @return Reference to this IPAddress after copy assignment.
      */
-    IPAddress& operator=(const IPAddress&) = default;
+    BasicIPAddress& operator=(const BasicIPAddress&) = default;
 
     /**
      * @brief Default move assignment operator.
      *
      * @return Reference to this IPAddress after move assignment.
      */
-    IPAddress& operator=(IPAddress&&) noexcept = default;
+    BasicIPAddress& operator=(BasicIPAddress&&) noexcept = default;
 
     // =============== Getters ===============
     /**
-     * @brief Extracts the 8-bit Router ID from the 16-bit address.
+     * @brief Extracts the Router ID from the address.
      *
-     * @return The upper 8 bits of the address representing the Router ID.
+     * @return The upper RouterBits bits of the address representing the Router ID.
      */
-    [[nodiscard]] constexpr uint8_t getRouterIP() const noexcept;
+    [[nodiscard]] constexpr RouterID getRouterIP() const noexcept;
 
     /**
-     * @brief Extracts the 8-bit Terminal ID from the 16-bit address.
+     * @brief Extracts the Terminal ID from the address.
      *
-     * @return The lower 8 bits of the address representing the Terminal ID.
+     * @return The lower TerminalBits bits of the address representing the Terminal ID.
      */
-    [[nodiscard]] constexpr uint8_t getTerminalIP() const noexcept;
+    [[nodiscard]] constexpr TerminalID getTerminalIP() const noexcept;
 
     /**
-     * @brief Returns the raw 16-bit integer representation of the IP address, combining both the
+     * @brief Returns the raw integer representation of the IP address, combining both the
      * Router ID and Terminal ID.
      *
-     * @return The 16-bit integer where the upper 8 bits are the Router ID and the lower 8 bits are
-     * the Terminal ID.
+     * @return The integer where the upper RouterBits bits are the Router ID and the lower
+     * TerminalBits bits are the Terminal ID.
      */
-    [[nodiscard]] constexpr uint16_t getRawAddress() const noexcept;
+    [[nodiscard]] constexpr Raw getRawAddress() const noexcept;
 
     // =============== Query Methods ===============
     /**
@@ -121,7 +187,8 @@ public:
     // =============== Utilities ===============
     /**
      * @brief Converts the IP address to a human-readable string format "RRR.TTT", where RRR is the
-     * Router ID and TTT is the Terminal ID, both zero-padded to 3 digits.
+     * Router ID and TTT is the Terminal ID, each zero-padded to the digits of its largest value
+     * (3 digits for 8-bit fields).
      *
      * @return A string describing the IP address in a human-readable format.
      */
@@ -134,7 +201,10 @@ public:
      * @param ip The IPAddress object to print.
      * @return Reference to the output stream after inserting the IP address string representation.
      */
-    friend std::ostream& operator<<(std::ostream& os, const IPAddress& ip);
+    friend std::ostream& operator<<(std::ostream& os, const BasicIPAddress& ip) {
+        os << ip.toString();
+        return os;
+    }
 
     // =============== Comparison Operators ===============
     /**
@@ -144,7 +214,7 @@ public:
      * @return true if both IP addresses are the same (same router and terminal IDs), false
      * otherwise.
      */
-    [[nodiscard]] constexpr bool operator==(const IPAddress& other) const noexcept;
+    [[nodiscard]] constexpr bool operator==(const BasicIPAddress& other) const noexcept;
 
     /**
      * @brief Inequality operator to compare two IPAddress objects.
@@ -152,7 +222,7 @@ public:
      * @param other The other IPAddress to compare with.
      * @return true if the IP addresses are different, false if they are the same.
      */
-    [[nodiscard]] constexpr bool operator!=(const IPAddress& other) const noexcept;
+    [[nodiscard]] constexpr bool operator!=(const BasicIPAddress& other) const noexcept;
 
     /**
      * @brief Less-than operator for ordering IPAddress objects.
@@ -160,7 +230,7 @@ public:
      * @param other The other IPAddress to compare with.
      * @return true if this address is less than the other, false otherwise.
      */
-    [[nodiscard]] constexpr bool operator<(const IPAddress& other) const noexcept;
+    [[nodiscard]] constexpr bool operator<(const BasicIPAddress& other) const noexcept;
 
     /**
      * @brief Less-than-or-equal operator for ordering IPAddress objects.
@@ -168,7 +238,7 @@ public:
      * @param other The other IPAddress to compare with.
      * @return true if this address is less than or equal to the other, false otherwise.
      */
-    [[nodiscard]] constexpr bool operator<=(const IPAddress& other) const noexcept;
+    [[nodiscard]] constexpr bool operator<=(const BasicIPAddress& other) const noexcept;
 
     /**
      * @brief Greater-than operator for ordering IPAddress objects.
@@ -176,7 +246,7 @@ public:
      * @param other The other IPAddress to compare with.
      * @return true if this address is greater than the other, false otherwise.
      */
-    [[nodiscard]] constexpr bool operator>(const IPAddress& other) const noexcept;
+    [[nodiscard]] constexpr bool operator>(const BasicIPAddress& other) const noexcept;
 
     /**
      * @brief Greater-than-or-equal operator for ordering IPAddress objects.
@@ -184,84 +254,118 @@ public:
      * @param other The other IPAddress to compare with.
      * @return true if this address is greater than or equal to the other, false otherwise.
      */
-    [[nodiscard]] constexpr bool operator>=(const IPAddress& other) const noexcept;
+    [[nodiscard]] constexpr bool operator>=(const BasicIPAddress& other) const noexcept;
+
+private:
+    /**
+     * @brief Counts the decimal digits of a value.
+     *
+     * @param value The value to measure.
+     * @return Number of decimal digits (1 for 0).
+     */
+    [[nodiscard]] static constexpr int digitsOf(unsigned long long value) noexcept;
 };
 
-// =============== Constructors & Destructor ===============
-constexpr IPAddress::IPAddress(uint8_t routerIP, uint8_t terminalIP) noexcept
-    : address(static_cast<uint16_t>(routerIP) << 8 | terminalIP) {}
+/** Address layout of the simulator, selected at compile time (8 + 8 bits by default) */
+using IPAddress = BasicIPAddress<ROUTERSIM_ROUTER_BITS, ROUTERSIM_TERMINAL_BITS>;
 
-constexpr IPAddress::IPAddress(uint16_t rawAddress) noexcept : address(rawAddress) {}
+// =============== Constructors & Destructor ===============
+template <unsigned R, unsigned T>
+constexpr BasicIPAddress<R, T>::BasicIPAddress(RouterID routerIP, TerminalID terminalIP) noexcept
+    : address(static_cast<Raw>(static_cast<Raw>(routerIP) << T | terminalIP)) {}
+
+template <unsigned R, unsigned T>
+constexpr BasicIPAddress<R, T> BasicIPAddress<R, T>::fromRaw(Raw rawAddress) noexcept {
+    BasicIPAddress ip;
+    ip.address = rawAddress;
+    return ip;
+}
 
 // =============== Getters ===============
-constexpr uint8_t IPAddress::getRouterIP() const noexcept {
-    return static_cast<uint8_t>(address >> 8);
+template <unsigned R, unsigned T>
+constexpr auto BasicIPAddress<R, T>::getRouterIP() const noexcept -> RouterID {
+    return static_cast<RouterID>(address >> T);
 }
 
-constexpr uint8_t IPAddress::getTerminalIP() const noexcept {
-    return static_cast<uint8_t>(address & 0xFF);
+template <unsigned R, unsigned T>
+constexpr auto BasicIPAddress<R, T>::getTerminalIP() const noexcept -> TerminalID {
+    return static_cast<TerminalID>(address & MAX_TERMINAL_ID);
 }
 
-constexpr uint16_t IPAddress::getRawAddress() const noexcept {
+template <unsigned R, unsigned T>
+constexpr auto BasicIPAddress<R, T>::getRawAddress() const noexcept -> Raw {
     return address;
 }
 
 // =============== Query Methods ===============
-constexpr bool IPAddress::isRouter() const noexcept {
-    return (address & 0xFF) == 0;
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::isRouter() const noexcept {
+    return (address & MAX_TERMINAL_ID) == 0;
 }
 
-constexpr bool IPAddress::isValid() const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::isValid() const noexcept {
     return address != 0;
 }
 
 // =============== Utilities ===============
-inline std::string IPAddress::toString() const {
-    const uint8_t r = getRouterIP();
-    const uint8_t t = getTerminalIP();
+template <unsigned R, unsigned T>
+std::string BasicIPAddress<R, T>::toString() const {
+    constexpr int ROUTER_DIGITS   = digitsOf(MAX_ROUTER_ID);
+    constexpr int TERMINAL_DIGITS = digitsOf(MAX_TERMINAL_ID);
 
     std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(3) << +r << "." << std::setfill('0') << std::setw(3)
-        << +t;
+    oss << std::setfill('0') << std::setw(ROUTER_DIGITS) << +getRouterIP() << "."
+        << std::setfill('0') << std::setw(TERMINAL_DIGITS) << +getTerminalIP();
 
     return oss.str();
 }
 
-inline std::ostream& operator<<(std::ostream& os, const IPAddress& ip) {
-    os << ip.toString();
-    return os;
+template <unsigned R, unsigned T>
+constexpr int BasicIPAddress<R, T>::digitsOf(unsigned long long value) noexcept {
+    int digits = 1;
+    for (; value >= 10; value /= 10) {
+        digits++;
+    }
+    return digits;
 }
 
 // =============== Comparison Operators ===============
-constexpr bool IPAddress::operator==(const IPAddress& other) const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::operator==(const BasicIPAddress& other) const noexcept {
     return address == other.address;
 }
 
-constexpr bool IPAddress::operator!=(const IPAddress& other) const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::operator!=(const BasicIPAddress& other) const noexcept {
     return address != other.address;
 }
 
-constexpr bool IPAddress::operator<(const IPAddress& other) const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::operator<(const BasicIPAddress& other) const noexcept {
     return address < other.address;
 }
 
-constexpr bool IPAddress::operator<=(const IPAddress& other) const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::operator<=(const BasicIPAddress& other) const noexcept {
     return address <= other.address;
 }
 
-constexpr bool IPAddress::operator>(const IPAddress& other) const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::operator>(const BasicIPAddress& other) const noexcept {
     return address > other.address;
 }
 
-constexpr bool IPAddress::operator>=(const IPAddress& other) const noexcept {
+template <unsigned R, unsigned T>
+constexpr bool BasicIPAddress<R, T>::operator>=(const BasicIPAddress& other) const noexcept {
     return address >= other.address;
 }
 
 /** @cond */
-template <>
-struct std::hash<IPAddress> {
-    size_t operator()(const IPAddress& ip) const noexcept {
-        return std::hash<uint16_t>{}(ip.getRawAddress());
+template <unsigned R, unsigned T>
+struct std::hash<BasicIPAddress<R, T>> {
+    size_t operator()(const BasicIPAddress<R, T>& ip) const noexcept {
+        return std::hash<typename BasicIPAddress<R, T>::Raw>{}(ip.getRawAddress());
     }
 };
 /** @endcond */
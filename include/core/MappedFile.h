@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The bytes are read straight from the page cache, so opening a file costs the same whatever its
+ * size. Where mapping is unavailable the file is read into memory instead. The mapping starts on
+ * a page boundary, so arrays written at aligned offsets can be used in place.
+ */
+class MappedFile {
+    const unsigned char* data;       /**< Start of the mapped file */
+    uint64_t size;                   /**< Size of the file in bytes */
+    std::vector<unsigned char> copy; /**< Contents of the file where mapping is unavailable */
+
+public:
+    /**
+     * @brief Maps a file.
+     *
+     * @param path Path of the file.
+     * @param kind Kind of file, for the error messages.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    MappedFile(const std::string& path, const std::string& kind);
+
+    /**
+     * @brief Destructor, unmaps the file.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    MappedFile(const MappedFile&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     *
+     * @return Reference to this file.
+     */
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Gets the contents of the file.
+     *
+     * @return Bytes of the file, valid while the file is mapped.
+     */
+    [[nodiscard]] std::span<const unsigned char> bytes() const noexcept;
+
+    /**
+     * @brief Unmaps the file, if mapped. bytes() is empty afterwards.
+     */
+    void unmap() noexcept;
+};
+
+inline std::span<const unsigned char> MappedFile::bytes() const noexcept {
+    return data ? std::span<const unsigned char>(data, static_cast<size_t>(size))
+                : std::span<const unsigned char>();
+}
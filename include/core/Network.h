@@ -1,9 +1,27 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <queue>
 #include <random>
+#include <span>
+#include <string>
+#include <vector>
 
 #include "Router.h"
+#include "ThreadPool.h"
+#include "TopologyFile.h"
+#include "TraceFile.h"
+#include "TrafficModel.h"
 #include "algorithms/Dijkstra.h"
+#include "algorithms/GraphOrdering.h"
+#include "algorithms/IncrementalRouting.h"
+#include "structures/arena.h"
 
 /**
  * @struct NetworkStats
@@ -24,6 +42,7 @@ struct NetworkStats {
     size_t packetsDelivered = 0; /**< Total of packets that successfully completed a page */
     size_t packetsDropped   = 0; /**< Total of packets dropped due to buffer overflows */
     size_t packetsTimedOut  = 0; /**< Total of packets that timed out while in transit */
+    size_t packetsDoomed    = 0; /**< Dropped packets of pages that had already lost one */
     size_t packetsInFlight  = 0; /**< Total of packets currently in transit within the network */
 
     size_t pagesCreated   = 0; /**< Total of pages created by all the terminals */
@@ -76,18 +95,56 @@ struct NetworkStats {
 class Network {
 public:
     /** Default number of routers in the network */
-    static constexpr uint8_t DEF_ROUTERS_COUNT = 20;
+    static constexpr IPAddress::RouterID DEF_ROUTERS_COUNT   = 20;
     /** Default maximum number of terminals connected to each router */
-    static constexpr uint8_t DEF_MAX_TERMINALS = 10;
+    static constexpr IPAddress::TerminalID DEF_MAX_TERMINALS = 10;
     /** Default complexity level for additional connections between routers */
-    static constexpr size_t DEF_COMPLEXITY     = 5;
+    static constexpr size_t DEF_COMPLEXITY                   = 5;
     /** Default probability of generating traffic for terminals in each tick (0.0 to 1.0) */
-    static constexpr float DEF_PROBABILITY     = 0.5;
+    static constexpr float DEF_PROBABILITY                   = 0.5;
     /** Default maximum page length for traffic generation for terminals */
-    static constexpr size_t DEF_MAX_PAGE_LEN   = 10;
+    static constexpr size_t DEF_MAX_PAGE_LEN                 = 10;
+    /** Default number of threads used to recalculate routes (1 runs serially) */
+    static constexpr size_t DEF_ROUTE_THREADS                = 1;
+    /** Default number of ticks between route recalculations */
+    static constexpr size_t DEF_ROUTE_INTERVAL               = 5;
+    /** Default number of threads used to run each tick (1 runs the classic sequential tick) */
+    static constexpr size_t DEF_TICK_THREADS                 = 1;
+    /** Default change of the link loads, in packets, that triggers a load-driven recompute */
+    static constexpr size_t DEF_ROUTE_LOAD_THRESHOLD         = 50;
+    /** Last tick a network can run: packets sent on it still fit their 32-bit expiration tick */
+    static constexpr size_t MAX_TICK = Packet::MAX_TIMEOUT - PACKET_TTL;
 
-    /** Type alias for a unique pointer to a Router object. */
-    using RouterPtr = std::unique_ptr<Router>;
+    /**
+     * @enum Layout
+     * @brief Order in which the routers are stored in the router arena, and so ticked.
+     *
+     * Storing routers that are linked to each other next to each other keeps the neighbor reads
+     * of a tick on nearby cache lines. The layout changes the order of the sequential tick, so it
+     * can change the outcome of a seed; the routers, links and traffic streams are the same.
+     */
+    enum class Layout : uint8_t {
+        Creation,           /**< By router ID, the order the routers are created in */
+        BreadthFirst,       /**< Breadth-first over the links, from router 0 */
+        ReverseCuthillMcKee /**< Reverse Cuthill-McKee, narrowing the distance across links */
+    };
+
+    /**
+     * @enum RoutePolicy
+     * @brief When step() recalculates the routes after a tick.
+     *
+     * Every policy is decided from the tick number and the network state alone, so a run split
+     * into several simulate() or step() calls recomputes at the same ticks as a single call, and
+     * a network restored from a checkpoint keeps the schedule of the original.
+     */
+    enum class RoutePolicy : uint8_t {
+        Interval,   /**< After every tick that is a multiple of routeInterval */
+        LoadChange, /**< After a tick whose link loads moved by more than routeLoadThreshold */
+        Manual      /**< Only when recomputeRoutes() is called */
+    };
+
+    /** Callback run after the ticks it is registered for */
+    using TickCallback = std::function<void(const Network&)>;
 
     /**
      * @struct Config
@@ -95,63 +152,164 @@ public:
      *
      * This structure allows for easy specification of the number of routers, maximum terminals per
      * router, complexity of the network topology, traffic generation probability, and maximum page
-     * length for traffic generation. It provides default values for all parameters, allowing for
-     * flexible initialization of the network.
+     * length for traffic generation. Every field has a default value, so a configuration is built
+     * with designated initializers that name only the fields it changes, in declaration order.
      */
     struct Config {
         /** Number of routers in the network */
-        uint8_t routerCount;
+        IPAddress::RouterID routerCount{DEF_ROUTERS_COUNT};
         /** Maximum number of terminals that can be connected */
-        uint8_t maxTerminalCount;
+        IPAddress::TerminalID maxTerminalCount{DEF_MAX_TERMINALS};
         /** Number of additional random connections to increase complexity */
-        size_t complexity;
+        size_t complexity{DEF_COMPLEXITY};
         /** Probability of generating traffic for terminals in each tick (0.0 to 1.0) */
-        float trafficProbability;
+        float trafficProbability{DEF_PROBABILITY};
         /** Maximum page length for traffic generation for terminals */
-        size_t maxPageLen;
-
+        size_t maxPageLen{DEF_MAX_PAGE_LEN};
+        /** Threads used to recalculate routes (0 for all hardware threads, 1 runs serially) */
+        size_t routeThreads{DEF_ROUTE_THREADS};
+        /** Number of ticks between route recalculations (1 recalculates every tick) */
+        size_t routeInterval{DEF_ROUTE_INTERVAL};
+        /** Whether routes are repaired incrementally instead of recomputed from scratch */
+        bool incrementalRoutes{false};
+        /** Threads used to run each tick (0 for all hardware threads, 1 for the sequential tick) */
+        size_t tickThreads{DEF_TICK_THREADS};
+        /** Seed for topology and traffic generation (0 draws a random seed) */
+        uint64_t seed{0};
+        /** Whether expired packets are purged from every buffer each tick */
+        bool eagerExpiry{false};
+        /** Whether only routers with pending activity are ticked (discrete-event simulation) */
+        bool eventDriven{false};
+        /** Traffic model copied into every terminal (nullptr uses trafficProbability per tick) */
+        std::shared_ptr<const TrafficModel> trafficModel{};
+        /** Binary trace file receiving every packet event (empty disables tracing) */
+        std::string tracePath{};
+        /** Order the routers are stored and ticked in */
+        Layout layout{Layout::Creation};
+        /** Number of partitions ticked independently between exchanges (1 disables them) */
+        size_t partitions{1};
         /**
-         * @brief Default constructor for Config, initializes with default values.
+         * Topology file the network is loaded from instead of generated (empty generates it).
+         * The file sets the routers, terminals, links, layout, routes and seed, so routerCount,
+         * maxTerminalCount, complexity, layout and seed are ignored.
          */
-        Config()
-            : routerCount(DEF_ROUTERS_COUNT),
-              maxTerminalCount(DEF_MAX_TERMINALS),
-              complexity(DEF_COMPLEXITY),
-              trafficProbability(DEF_PROBABILITY),
-              maxPageLen(DEF_MAX_PAGE_LEN) {}
-
+        std::string topologyPath{};
+        /** Queueing discipline and traffic classes of the router output buffers */
+        QueueConfig outQueue{};
+        /** Bits of each generation of the per-router doomed page filter (0 disables early drop) */
+        size_t doomedFilterBits{0};
+        /** Most equal-cost next hops kept per destination (1 routes over a single path) */
+        size_t routePaths{1};
+        /** When routes are recalculated between ticks */
+        RoutePolicy routePolicy{RoutePolicy::Interval};
         /**
-         * @brief Parameterized constructor for Config struct that allows custom settings.
-         *
-         * @param routerCount Number of routers in the network.
-         * @param maxTerminalCount Maximum number of terminals that can be connected to each router.
-         * @param complexity Number of additional random connections to increase complexity.
-         * @param trafficProbability Probability of generating traffic
-         * @param maxPageLen Maximum page length for traffic generation for terminals.
+         * Total change of the link loads since the last recompute, in packets, that triggers the
+         * next one with RoutePolicy::LoadChange.
          */
-        Config(uint8_t routerCount, uint8_t maxTerminalCount, size_t complexity,
-               float trafficProbability, size_t maxPageLen)
-            : routerCount(routerCount),
-              maxTerminalCount(maxTerminalCount),
-              complexity(complexity),
-              trafficProbability(trafficProbability),
-              maxPageLen(maxPageLen) {}
+        size_t routeLoadThreshold{DEF_ROUTE_LOAD_THRESHOLD};
+        /**
+         * Whether simulate() runs every partition on its own thread without a barrier per tick,
+         * each one only waiting for the partitions that send to it. Needs partitions > 1, a tick
+         * thread per partition, RoutePolicy::Interval or RoutePolicy::Manual, and neither tracing
+         * nor early drop.
+         */
+        bool pipelined{false};
+        /**
+         * Extra link load, in packets, a next hop's path may carry over the shortest one and still
+         * be kept with routePaths above 1 (0 keeps only equal-cost paths).
+         */
+        size_t routeSlack{0};
     };
 
 private:
-    List<RouterPtr> routers;      /**< List of all routers in the network */
-    List<const Router*> cRouters; /**< List of raw pointers to routers for algorithm use */
-    List<IPAddress> addressBook;  /**< List of all terminal IPs in the network */
-    size_t currentTick;           /**< Current simulation tick, used for timing */
-    std::mt19937 m_rng{std::random_device{}()}; /**< Random number generator */
+    Arena<Router> routers;                /**< All routers in the network, by router index */
+    std::vector<const Router*> cRouters;  /**< Raw pointers to the routers for algorithm use */
+    std::vector<IPAddress> addressBook;   /**< All terminal IPs in the network */
+    size_t currentTick;                   /**< Current simulation tick, used for timing */
+    uint64_t seed;                        /**< Seed the generators were initialized from */
+    std::mt19937 m_rng;                   /**< Random number generator for the topology */
+    Xoshiro256 trafficStreams;            /**< Master traffic stream, jumped past each handed out */
+    std::deque<Xoshiro256> routerRngs;    /**< Traffic stream of each router ID's terminals */
+    std::unique_ptr<ThreadPool> tickPool; /**< Pool running the two-phase tick, if enabled */
+
+    /** Router indices of each partition, in index order; empty when partitioning is disabled */
+    std::vector<std::vector<size_t>> partitions;
+
+    /**
+     * @struct PartitionClock
+     * @brief Progress of a partition in a pipelined run, on its own cache line.
+     */
+    struct alignas(64) PartitionClock {
+        std::atomic<size_t> computed{0}; /**< Compute phases finished, or PIPELINE_ABORTED */
+    };
+
+    /** Clock value of a partition whose pipelined run threw */
+    static constexpr size_t PIPELINE_ABORTED = SIZE_MAX;
+
+    bool pipelined; /**< Whether simulate() runs the partitions pipelined */
+    std::vector<std::vector<size_t>> partitionSources; /**< Partitions linked into each one */
+    std::unique_ptr<PartitionClock[]> partitionClocks; /**< Progress of each partition */
+
+    std::unique_ptr<ThreadPool> routePool;           /**< Pool for parallel route recalculation */
+    std::vector<RoutingTable> routeTables;           /**< Scratch tables of each recalculation */
+    std::unique_ptr<IncrementalRouting> routeEngine; /**< Incremental route engine, if enabled */
+    size_t routeInterval;                            /**< Ticks between route recalculations */
+    size_t routePaths;                               /**< Equal-cost next hops per destination */
+    size_t routeSlack;                               /**< Extra load of near-equal-cost paths */
+    RoutePolicy routePolicy;                         /**< When routes are recalculated */
+    size_t routeLoadThreshold;                       /**< Load change triggering a recompute */
+    std::vector<size_t> routedLoads;                 /**< Link loads at the last recompute */
+    size_t routeRecomputes;                          /**< Route recalculations run so far */
+
+    /**
+     * @struct PeriodicCallback
+     * @brief A callback registered with addPeriodicCallback().
+     */
+    struct PeriodicCallback {
+        size_t id;             /**< Handle returned at registration */
+        size_t interval;       /**< Ticks between calls */
+        TickCallback callback; /**< Function to call */
+    };
+
+    std::vector<PeriodicCallback> callbacks; /**< Registered callbacks, in registration order */
+    size_t nextCallbackID;                   /**< Handle of the next registered callback */
+
+    /** Pending router visits as (tick, router index), earliest first */
+    using Agenda = std::priority_queue<std::pair<size_t, size_t>,
+                                       std::vector<std::pair<size_t, size_t>>, std::greater<>>;
+
+    bool eventDriven;                  /**< Whether only routers with pending activity are ticked */
+    Agenda agenda;                     /**< Scheduled router visits; stale entries are skipped */
+    std::vector<size_t> nextVisit;     /**< Tick of the scheduled visit of each router */
+    std::vector<size_t> indexByRouter; /**< Router index by router ID */
+    bool earlyDrop;                    /**< Whether routers drop the packets of doomed pages */
+
+    mutable std::optional<NetworkStats> statsCache; /**< Stats of the current tick, once computed */
+
+    std::unique_ptr<TraceWriter> traceWriter; /**< Writer of the trace file, while tracing */
+    std::deque<TraceBuffer> traceBuffers;     /**< Event buffer of each router, while tracing */
 
 public:
+    /**
+     * @brief Constructs a network with the default configuration.
+     */
+    Network();
+
     /**
      * @brief Constructor for Network.
      *
      * @param config Configuration struct for initializing the network with specific parameters.
+     * @throws std::invalid_argument if the route interval is 0, if the maximum page length is
+     * above Packet::MAX_PAGE_LEN, if the event-driven mode is combined with a multi-threaded tick
+     * or with partitions, if the partition count is 0 or exceeds the number of routers, if the
+     * output queue configuration is invalid, if the route path count is 0, above
+     * RoutingTable::MAX_PATHS, or combined with incremental routes, if a route slack is set with
+     * a single path, or if a pipelined network lacks partitions or a tick thread per partition,
+     * or is combined with load-driven routes, tracing or early drop.
+     * @throws std::runtime_error if the trace file cannot be opened, or the topology file cannot
+     * be opened or is corrupt.
      */
-    explicit Network(const Config& config = Config{});
+    explicit Network(const Config& config);
 
     /**
      * @brief Destructor for Network. Defaulted to allow automatic cleanup of resources.
@@ -183,31 +341,14 @@ public:
     Network& operator=(Network&&) = delete;
 
     // =============== Initialization ===============
-    /**
-     * @brief Generates a random network topology based on the specified parameters.
-     *
-     * This method initializes the specified number of routers, connects them in a minimal spanning
-     * tree configuration to ensure basic connectivity, and then adds additional random connections
-     * to increase the complexity of the network. It also initializes terminals for each router and
-     * populates the address book with terminal IPs for routing purposes.
-     *
-     * @param routerCount Number of routers to create in the network.
-     * @param TerminalCount Maximum number of terminals that can be connected to each router.
-     * @param complexity Number of additional random connections to add for each router (0 for no
-     * extra connections).
-     * @param probability Probability of generating traffic for terminals in each tick (0.0 to 1.0).
-     * @param pageLen Maximum page length for traffic generation for terminals.
-     */
-    void generateRandomNetwork(uint8_t routerCount, uint8_t TerminalCount, size_t complexity,
-                               float probability, size_t pageLen);
-
     /**
      * @brief Adds additional random connections between routers to increase network complexity.
      *
      * The number of additional connections is determined by the `complexity` parameter, which
      * specifies how many extra links each router should attempt to create with randomly selected
      * target routers. This method ensures that the network has a more complex topology beyond the
-     * minimal spanning tree configuration.
+     * minimal spanning tree configuration. It draws the same links the constructor would for a
+     * network of this size.
      *
      * @param complexity Number of additional connections to add for each router (0 for no extra
      * connections).
@@ -226,66 +367,420 @@ public:
      * @brief Simulates the network for a specified number of ticks, allowing routers and terminals
      * to process their queues and update their state. Each tick represents a cycle of operation
      * where routers process their output buffers, local buffers, and terminals, and then process
-     * their input buffers. Routing tables are recalculated every 5 ticks to reflect any changes in
-     * the network topology or traffic patterns.
+     * their input buffers. Routing tables are recalculated as Config::routePolicy schedules them.
+     *
+     * Equivalent to calling step() @p ticks times, so a run can be split into any number of calls
+     * without changing its outcome or adding route recalculations. A pipelined network runs the
+     * ticks between two route recalculations or callbacks with tickPipelined(), with the same
+     * outcome as the partitioned tick.
      *
      * @param ticks Number of simulation ticks to run.
+     * @throws std::out_of_range if the run would go past MAX_TICK; no tick is run then.
      */
     void simulate(size_t ticks);
 
+    /**
+     * @brief Simulates a single tick, then recalculates the routes if Config::routePolicy
+     * schedules it, then runs the periodic callbacks due on this tick.
+     *
+     * @throws std::out_of_range if the current tick is past MAX_TICK.
+     */
+    void step();
+
+    /**
+     * @brief Recalculates the routes of every router now, whatever the route policy. This is the
+     * only way routes change with RoutePolicy::Manual.
+     */
+    void recomputeRoutes();
+
+    /**
+     * @brief Registers a callback run after every tick that is a multiple of @p interval, once
+     * the routes of that tick are settled. Callbacks run in registration order and must not
+     * advance the simulation or register or remove callbacks.
+     *
+     * @param interval Ticks between calls.
+     * @param callback Function to call with the network.
+     * @return Handle to remove the callback with.
+     * @throws std::invalid_argument if the interval is 0 or the callback is empty.
+     */
+    size_t addPeriodicCallback(size_t interval, TickCallback callback);
+
+    /**
+     * @brief Removes a callback registered with addPeriodicCallback().
+     *
+     * @param id Handle returned at registration.
+     * @return true if the callback was removed, false if no callback has that handle.
+     */
+    bool removePeriodicCallback(size_t id);
+
+    /**
+     * @brief Gets the number of ticks simulated so far.
+     *
+     * @return Last simulated tick, or 0 before the first one.
+     */
+    [[nodiscard]] size_t getCurrentTick() const noexcept;
+
+    /**
+     * @brief Gets the number of route recalculations run so far, including the initial one.
+     *
+     * @return Route recalculations since the network was built.
+     */
+    [[nodiscard]] size_t getRouteRecomputes() const noexcept;
+
     /**
      * @brief Gets a list of raw pointers to the routers in the network for use in algorithms.
      *
      * This method returns a list of const pointers to the routers, which can be used by routing
      * algorithms like Dijkstra's algorithm without allowing modification of the router objects.
      *
-     * @return List of const pointers to the routers in the network.
+     * @return Contiguous array of const pointers to the routers in the network.
+     */
+    const std::vector<const Router*>& getRouters() const;
+
+    /**
+     * @brief Gets the seed the network was generated from, to reproduce a run.
+     *
+     * @return Seed of the topology and traffic generators.
+     */
+    [[nodiscard]] uint64_t getSeed() const noexcept;
+
+    /**
+     * @brief Gets the routers of each partition, when the network is partitioned.
+     *
+     * @return Router indices (positions in getRouters()) of each partition, or an empty list if
+     * partitioning is disabled.
+     */
+    [[nodiscard]] const std::vector<std::vector<size_t>>& getPartitions() const noexcept;
+
+    /**
+     * @brief Stops tracing and finishes the trace file, which is otherwise finished when the
+     * network is destroyed. Ticks simulated afterwards are not traced.
+     *
+     * @return true if every event reached the file (or tracing was off), false after an I/O error.
+     */
+    bool closeTrace();
+
+    /**
+     * @brief Saves the routers, terminal counts, links, storage order, routing tables and seed to
+     * a topology file, which Config::topologyPath loads without generating the network or
+     * recalculating its routes. A network loaded from the file and given the same traffic
+     * settings simulates exactly like this one would from its creation.
+     *
+     * @param path Path of the topology file.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void saveTopology(const std::string& path) const;
+
+    /**
+     * @brief Writes a checkpoint of the whole live state of the network: the current tick, every
+     * buffer, reassembler and quarantined page, the counters, the routing tables, the traffic
+     * schedules and every random generator.
+     *
+     * A network built from the same configuration and restored from the checkpoint simulates
+     * exactly like this one from here on, so one warmed-up network can be forked into many
+     * experiments. The restored network must have the same routers, links, seed, traffic model
+     * type and output queue configuration; other settings, like the traffic parameters or the
+     * route interval, may differ to run what-if experiments from the same warmed-up state.
+     *
+     * @param out Stream receiving the checkpoint.
+     * @throws std::runtime_error if the stream fails.
+     */
+    void saveCheckpoint(std::ostream& out) const;
+
+    /**
+     * @brief Restores a checkpoint written by saveCheckpoint() from a file, mapped so that the
+     * packets are moved straight from the page cache into their buffers.
+     *
+     * @param path Path of the checkpoint file.
+     * @throws std::runtime_error if the file cannot be opened, was written by another build or
+     * network, or is truncated. The state of the network is unspecified after a failed restore.
+     */
+    void restoreCheckpoint(const std::string& path);
+
+    /**
+     * @brief Restores a checkpoint written by saveCheckpoint() from a stream.
+     *
+     * @param in Stream holding the checkpoint, read to its end.
+     * @throws std::runtime_error if the checkpoint was written by another build or network, or is
+     * truncated. The state of the network is unspecified after a failed restore.
      */
-    const List<const Router*>& getRouters() const;
+    void restoreCheckpoint(std::istream& in);
+
+    /**
+     * @brief Restores a checkpoint written by saveCheckpoint() in place, reading every array as a
+     * view into the given bytes.
+     *
+     * @param bytes Contents of the checkpoint, starting on an 8-byte boundary.
+     * @throws std::invalid_argument if the bytes are misaligned.
+     * @throws std::runtime_error if the checkpoint was written by another build or network, or is
+     * truncated. The state of the network is unspecified after a failed restore.
+     */
+    void restoreCheckpoint(std::span<const unsigned char> bytes);
 
     /**
      * @brief Retrieves the current statistics of the network, including counts of routers,
      * terminals, packets, and pages, as well as delivery and drop rates.
      *
+     * Terminals add their events to running totals kept by their router, so only the routers are
+     * walked, once per tick on the first call; later calls in the same tick return the cached
+     * result. Packets in flight are the generated packets not yet delivered, dropped or timed out.
+     *
      * @return A NetworkStats structure containing the current statistics of the network.
      */
     NetworkStats getStats() const;
 
+    /**
+     * @brief Gets the running totals of each traffic class over the output buffers of every
+     * router, to compare how the classes fare under a queueing discipline.
+     *
+     * @return Counters of each class of Config::outQueue, by class.
+     */
+    [[nodiscard]] std::vector<ClassCounters> getClassCounters() const;
+
 private:
+    /** Link between two router IDs */
+    using Link = GraphOrdering::Link;
+
+    /**
+     * @brief Generates a random network topology based on the specified parameters.
+     *
+     * The links are drawn first, as pairs of router IDs: a minimal spanning tree that ensures
+     * basic connectivity, then additional random connections that increase the complexity of the
+     * network. The routers are then constructed in the router arena in the order given by the
+     * layout, with their terminals, and the links are established in the order they were drawn.
+     * The address book lists the terminal IPs by router ID whatever the layout.
+     *
+     * @param routerCount Number of routers to create in the network.
+     * @param TerminalCount Maximum number of terminals that can be connected to each router.
+     * @param complexity Number of additional random connections to add for each router (0 for no
+     * extra connections).
+     * @param probability Probability of generating traffic for terminals in each tick (0.0 to 1.0).
+     * @param pageLen Maximum page length for traffic generation for terminals.
+     * @param layout Order the routers are stored in.
+     */
+    void generateRandomNetwork(IPAddress::RouterID routerCount,
+                               IPAddress::TerminalID TerminalCount, size_t complexity,
+                               float probability, size_t pageLen, Layout layout);
+
+    /**
+     * @brief Builds the network stored in a topology file: the routers in the stored order, the
+     * links of each router in the stored connection order, and the stored routing tables.
+     *
+     * @param file Topology file to load.
+     * @param probability Probability of generating traffic for terminals in each tick (0.0 to 1.0).
+     * @param pageLen Maximum page length for traffic generation for terminals.
+     * @throws std::runtime_error if the file holds out-of-range router IDs or terminal counts.
+     */
+    void loadTopology(const TopologyFile& file, float probability, size_t pageLen);
+
     /**
-     * @brief Connects routers in a minimal spanning tree configuration to ensure basic
-     * connectivity.
+     * @brief Lists the terminal IPs of every router in the address book, by router ID.
+     */
+    void buildAddressBook();
+
+    /**
+     * @brief Draws the links of a minimal spanning tree that ensures basic connectivity.
      *
-     * This method connects each router to at least one previously added router, creating a
-     * connected network with the minimum number of links. The connections are made randomly to
-     * create variability in the network topology.
+     * Each router is linked to one randomly chosen router with a lower ID, creating a connected
+     * network with the minimum number of links.
      *
      * @param routerCount The total number of routers in the network.
+     * @param links List the links are appended to.
      */
-    void connectMinimal(uint8_t routerCount);
+    void drawMinimalLinks(IPAddress::RouterID routerCount, std::vector<Link>& links);
 
     /**
-     * @brief Adds a new router to the network with the specified ID and maximum terminal count.
+     * @brief Draws the additional random links of every router, as addAdditionalConnections()
+     * establishes them. Links of a router to itself are kept and later ignored.
+     *
+     * @param routerCount The total number of routers in the network.
+     * @param complexity Number of additional links to draw for each router.
+     * @param links List the links are appended to.
+     */
+    void drawAdditionalLinks(size_t routerCount, size_t complexity, std::vector<Link>& links);
+
+    /**
+     * @brief Computes the order the routers are stored in for a layout.
+     *
+     * @param routerCount The total number of routers in the network.
+     * @param links Links between router IDs.
+     * @param layout Requested layout.
+     * @return Router IDs in storage order.
+     */
+    static std::vector<size_t> layoutOrder(size_t routerCount, const std::vector<Link>& links,
+                                           Layout layout);
+
+    /**
+     * @brief Adds a new router to the network with the specified ID and maximum terminal count,
+     * constructing it in the next slot of the router arena. Its terminals draw their traffic from
+     * the stream of its router ID, so the layout does not change the traffic.
      *
      * @param rtrID Unique ID for the new router (must be > 0).
      * @param TerminalCount Maximum number of terminals that can be connected to this router.
      * @param probability Probability of generating traffic for terminals.
      * @param PageLen Maximum page length for traffic generation for terminals.
      */
-    void addRouter(uint8_t rtrID, uint8_t TerminalCount, float probability, size_t PageLen);
+    void addRouter(IPAddress::RouterID rtrID, IPAddress::TerminalID TerminalCount,
+                   float probability, size_t PageLen);
 
     /**
      * @brief Recalculates routing tables for all routers in the network using Dijkstra's algorithm.
+     *
+     * The topology and link loads are captured once; the per-router computations then run on the
+     * route thread pool when one is configured, and the tables are installed afterwards. With
+     * incremental routes enabled, only the trees affected by changed link loads are repaired and
+     * only the tables that changed are reinstalled. With Config::routePaths above 1, the tables
+     * keep that many equal-cost next hops per destination.
      */
     void recalculateAllRoutes();
 
+    /**
+     * @brief Checks whether the route policy calls for a recompute after a tick.
+     *
+     * @param tick Tick just simulated.
+     * @return true if the routes are due for a recompute.
+     */
+    [[nodiscard]] bool routesDue(size_t tick) const;
+
+    /**
+     * @brief Records the current load of every link as the baseline of RoutePolicy::LoadChange.
+     */
+    void captureRoutedLoads();
+
     /**
      * @brief Advances the simulation by one tick, allowing each router to process its queues and
      * update its state.
+     *
+     * With a tick pool the tick runs in two phases. In the compute phase every router stages its
+     * outgoing packets into per-neighbor outboxes and processes its local traffic; in the exchange
+     * phase every router pulls the packets staged for it into its input buffer. Routers only touch
+     * their own state in either phase, and every router generates traffic from its own generator,
+     * so the outcome depends on the seed but not on the number of threads. In discrete-event mode
+     * only the routers with activity due this tick are visited (see tickScheduledRouters()), and
+     * in partitioned mode each partition runs its own sequential tick (see tickPartitions()).
+     *
+     * While tracing, each router records its events into its own buffer, and the buffers are
+     * handed to the trace writer in router order once the tick is over, so the events of a tick
+     * are grouped by router rather than interleaved in time.
      */
     void tick();
+
+    /**
+     * @brief Hands the drop notices of every router to the routers of the doomed pages' sources,
+     * so the rest of each page is dropped at its first hop.
+     *
+     * Notices are delivered once the tick is over and in router order, so the outcome does not
+     * depend on the tick mode or the number of threads.
+     */
+    void deliverDropNotices();
+
+    /**
+     * @brief Splits the routers into partitions with GraphPartitioner and stages every link that
+     * crosses a partition boundary.
+     *
+     * @param parts Number of partitions.
+     */
+    void assignPartitions(size_t parts);
+
+    /**
+     * @brief Runs the current tick of the partitioned mode.
+     *
+     * Each partition ticks its routers in index order, as the sequential tick does, with direct
+     * delivery over the links inside the partition. Packets for links that cross a boundary are
+     * batched into the link's outbox and, once every partition has finished, pulled by the
+     * receivers in an exchange phase, so they reach the other partition one tick later. Partitions
+     * only touch their own routers in either phase and run on the tick pool when there is one;
+     * the outcome does not depend on the number of threads.
+     */
+    void tickPartitions();
+
+    /**
+     * @brief Runs several ticks of the partitioned mode without a barrier between them.
+     *
+     * Every partition runs on its own thread of the tick pool. After its compute phase of a tick
+     * a partition publishes its clock, waits only for the partitions that send to it to reach the
+     * same tick, and collects from their link rings (see Router::setLinkRings()). Neighboring
+     * partitions therefore stay within one tick of each other while distant ones drift further
+     * apart, and the outcome is the same as tickPartitions() run @p ticks times. Nothing else in
+     * the network is touched, so the ticks must not need route recalculations or callbacks.
+     *
+     * @param ticks Number of ticks to run.
+     * @throws std::runtime_error if another partition failed during the run; the first exception
+     * thrown by a partition is rethrown instead when there is one.
+     */
+    void tickPipelined(size_t ticks);
+
+    /**
+     * @brief Waits until a partition has finished a number of compute phases in the current
+     * pipelined run.
+     *
+     * @param partition Index of the partition.
+     * @param ticks Compute phases to wait for.
+     * @throws std::runtime_error if the partition aborted the run.
+     */
+    void awaitPartition(size_t partition, size_t ticks) const;
+
+    /**
+     * @brief Checks that a run starting at the current tick stays within MAX_TICK.
+     *
+     * @param ticks Number of ticks of the run.
+     * @throws std::out_of_range if the last tick of the run is past MAX_TICK.
+     */
+    void checkTickRange(size_t ticks) const;
+
+    /**
+     * @brief Counts the ticks that can run before, and including, the next tick after which
+     * routes are recalculated or a callback runs.
+     *
+     * @return Ticks up to the next scheduled event, or SIZE_MAX if none is scheduled.
+     */
+    [[nodiscard]] size_t ticksToNextEvent() const noexcept;
+
+    /**
+     * @brief Runs what step() schedules after a tick: the route recalculation, if due, and the
+     * periodic callbacks due on the tick.
+     *
+     * @param tickNumber Tick just simulated.
+     */
+    void finishTick(size_t tickNumber);
+
+    /**
+     * @brief Runs the current tick of the discrete-event mode: visits, in index order, every
+     * router whose next activity falls on this tick, and schedules its next visit.
+     *
+     * Idle routers are not visited at all. Ticking a router that has nothing buffered only moves
+     * its terminals' timers and page emissions, whose ticks are known in advance, so the outcome
+     * matches ticking every router. When a router sends packets to a neighbor, the neighbor is
+     * visited later in the same tick if it comes after the sender, or in the next tick otherwise,
+     * just as in the sequential tick.
+     */
+    void tickScheduledRouters();
+
+    /**
+     * @brief Schedules a visit of a router unless an earlier one is already scheduled.
+     *
+     * @param index Index of the router.
+     * @param tick Tick of the visit (Terminal::NO_ACTIVITY schedules nothing).
+     */
+    void scheduleVisit(size_t index, size_t tick);
 };
 
-inline const List<const Router*>& Network::getRouters() const {
+inline const std::vector<const Router*>& Network::getRouters() const {
     return cRouters;
 }
+
+inline const std::vector<std::vector<size_t>>& Network::getPartitions() const noexcept {
+    return partitions;
+}
+
+inline size_t Network::getCurrentTick() const noexcept {
+    return currentTick - 1;
+}
+
+inline size_t Network::getRouteRecomputes() const noexcept {
+    return routeRecomputes;
+}
+
+inline uint64_t Network::getSeed() const noexcept {
+    return seed;
+}
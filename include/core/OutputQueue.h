@@ -0,0 +1,427 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "PacketBuffer.h"
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/**
+ * @enum QueueDiscipline
+ * @brief Order in which an output queue sends its packets to the neighbor.
+ *
+ * Every discipline is work conserving: a link sends as many packets per tick as with FIFO, only
+ * the order changes.
+ */
+enum class QueueDiscipline : uint8_t {
+    Fifo,              /**< Arrival order, a single class */
+    StrictPriority,    /**< Lowest class with packets first */
+    DeficitRoundRobin, /**< Classes take turns, each sending up to its quantum per turn */
+    EarliestDeadline   /**< Earliest timeout first, ties in arrival order */
+};
+
+/**
+ * @enum AqmMode
+ * @brief Active queue management of an output queue, which drops packets before the queue is
+ * full to keep the queueing delay short.
+ */
+enum class AqmMode : uint8_t {
+    None, /**< Packets are only dropped when the queue is full */
+    Red,  /**< Random early detection on the average queue length, at enqueue */
+    CoDel /**< Controlled delay on the queueing delay, at dequeue */
+};
+
+/**
+ * @struct AqmConfig
+ * @brief Parameters of the active queue management of an output queue.
+ *
+ * RED drops arrivals with a probability that grows linearly from 0 at minThreshold to
+ * maxProbability at maxThreshold of the average queue length, and every arrival above
+ * maxThreshold. Drops are spaced evenly by accumulating the probability instead of drawing it,
+ * which keeps runs reproducible. CoDel estimates the queueing delay as the ticks the backlog needs
+ * to drain at the link bandwidth; once it stays above target for a whole interval, packets are
+ * dropped from the head at a rate that grows with the square root of the drops, until the delay
+ * falls below target.
+ */
+struct AqmConfig {
+    /** Queue management algorithm */
+    AqmMode mode          = AqmMode::None;
+    /** Weight of each arrival in the average queue length, RED */
+    double weight         = 0.2;
+    /** Average queue length at which RED starts dropping */
+    double minThreshold   = 5;
+    /** Average queue length from which RED drops every arrival */
+    double maxThreshold   = 15;
+    /** Drop probability of RED just below maxThreshold */
+    double maxProbability = 0.1;
+    /** Queueing delay CoDel tolerates, in ticks */
+    double target         = 5;
+    /** Ticks the delay must stay above target before CoDel drops, and its initial drop spacing */
+    double interval       = 20;
+};
+
+/**
+ * @struct QueueConfig
+ * @brief Discipline and traffic classes of the output queues of a router.
+ *
+ * Packets are classified by the length of their page, so short interactive pages are not stuck
+ * behind the packets of a heavy one: class k holds the pages of up to classLimits[k] packets, and
+ * the last class holds the longer ones. FIFO queues have a single class and ignore the limits.
+ */
+struct QueueConfig {
+    /** Order the packets are sent in */
+    QueueDiscipline discipline = QueueDiscipline::Fifo;
+    /** Largest page length of each class but the last, strictly ascending */
+    std::vector<size_t> classLimits{};
+    /** Packets each class sends per turn with deficit round robin (empty gives each class 1) */
+    std::vector<size_t> quanta{};
+    /** Active queue management over all classes */
+    AqmConfig aqm{};
+};
+
+/**
+ * @struct ClassCounters
+ * @brief Running totals of one traffic class of an output queue.
+ */
+struct ClassCounters {
+    size_t enqueued   = 0; /**< Packets accepted, including those already expired on arrival */
+    size_t dropped    = 0; /**< Packets refused because the queue was full */
+    size_t sent       = 0; /**< Packets handed to the neighbor */
+    size_t timedOut   = 0; /**< Packets that expired while queued */
+    size_t aqmDropped = 0; /**< Packets dropped early by active queue management */
+
+    /**
+     * @brief Adds the totals of another class.
+     *
+     * @param other Counters to add.
+     * @return Reference to these counters.
+     */
+    ClassCounters& operator+=(const ClassCounters& other) noexcept {
+        enqueued += other.enqueued;
+        dropped += other.dropped;
+        sent += other.sent;
+        timedOut += other.timedOut;
+        aqmDropped += other.aqmDropped;
+        return *this;
+    }
+};
+
+/**
+ * @class OutputQueue
+ * @brief Output buffer of a link to a neighbor router, served with a queueing discipline.
+ *
+ * FIFO, strict priority and deficit round robin keep one PacketBuffer per class, so eager expiry
+ * works as in any other buffer and picking the next packet costs O(classes). Earliest deadline
+ * first keeps a binary heap ordered by timeout, where expired packets are always on top: sending
+ * and purging cost O(log n) per packet and need no expiry wheel. A capacity bounds the packets of
+ * all classes together.
+ */
+class OutputQueue {
+    /**
+     * @struct Deadline
+     * @brief Packet in the earliest-deadline heap, with its arrival number to break ties.
+     */
+    struct Deadline {
+        Packet packet; /**< Queued packet */
+        uint64_t seq;  /**< Arrival number of the packet */
+    };
+
+    /** CoDel state of a delay that is not above target */
+    static constexpr size_t NOT_ABOVE = SIZE_MAX;
+
+    /**
+     * @struct AqmState
+     * @brief Running state of the active queue management.
+     */
+    struct AqmState {
+        double averageSize = 0;         /**< Average queue length seen by arrivals, RED */
+        double dropCredit  = 0;         /**< Drop probability accumulated since a drop, RED */
+        size_t firstAbove  = NOT_ABOVE; /**< Tick from which the delay allows drops, CoDel */
+        double dropNext    = 0;         /**< Tick of the next drop while dropping, CoDel */
+        size_t dropCount   = 0;         /**< Drops of the last dropping state, CoDel */
+        bool dropping      = false;     /**< Whether CoDel is dropping */
+    };
+
+    QueueDiscipline discipline;          /**< Order the packets are sent in */
+    IPAddress dstIP;                     /**< Neighbor router the queue sends to */
+    size_t capacity;                     /**< Maximum packets over all classes (0 = unlimited) */
+    std::vector<size_t> classLimits;     /**< Largest page length of each class but the last */
+    std::vector<PacketBuffer> classes;   /**< Packets of each class, unless earliest deadline */
+    std::vector<size_t> quanta;          /**< Packets per turn of each class, round robin */
+    std::vector<size_t> deficits;        /**< Packets each class may still send in its turn */
+    size_t turn;                         /**< Class whose turn it is, round robin */
+    std::vector<Deadline> deadlines;     /**< Min-heap of packets by timeout, earliest deadline */
+    uint64_t nextSeq;                    /**< Arrival number of the next packet */
+    bool eagerExpiry;                    /**< Whether purgeExpired() retires expired packets */
+    size_t lastPurge;                    /**< Tick of the last purge, earliest deadline */
+    size_t expiredOnEntry;               /**< Expired arrivals not reported yet */
+    std::vector<ClassCounters> counters; /**< Running totals of each class */
+    AqmConfig aqm;                       /**< Active queue management parameters */
+    AqmState aqmState;                   /**< Active queue management state */
+    std::vector<Packet> head;            /**< Scratch storage for a packet dropped at the head */
+
+public:
+    /** Largest number of classes of a queue */
+    static constexpr size_t MAX_CLASSES = 16;
+
+    // =============== Constructors ===============
+    /**
+     * @brief Constructor for OutputQueue.
+     *
+     * @param dstIP Neighbor router the queue sends to.
+     * @param capacity Maximum packets over all classes (0 = unlimited, default).
+     * @param config Discipline and traffic classes (FIFO by default).
+     * @throws std::invalid_argument if the configuration is invalid (see classCount()).
+     */
+    explicit OutputQueue(IPAddress dstIP, size_t capacity = 0, const QueueConfig& config = {});
+
+    // =============== Getters ===============
+    /**
+     * @brief Gets the neighbor router the queue sends to.
+     *
+     * @return IP address of the neighbor router.
+     */
+    [[nodiscard]] IPAddress getDstIP() const noexcept;
+
+    /**
+     * @brief Gets the maximum capacity.
+     *
+     * @return Maximum packets over all classes (0 = unlimited).
+     */
+    [[nodiscard]] size_t getCapacity() const noexcept;
+
+    /**
+     * @brief Gets the queueing discipline.
+     *
+     * @return Order the packets are sent in.
+     */
+    [[nodiscard]] QueueDiscipline getDiscipline() const noexcept;
+
+    /**
+     * @brief Gets the number of traffic classes.
+     *
+     * @return Number of classes, 1 for FIFO.
+     */
+    [[nodiscard]] size_t getClassCount() const noexcept;
+
+    /**
+     * @brief Gets the running totals of every class.
+     *
+     * @return Counters of each class, by class.
+     */
+    [[nodiscard]] std::span<const ClassCounters> getClassCounters() const noexcept;
+
+    /**
+     * @brief Gets the class of a packet.
+     *
+     * @param packet Packet to classify.
+     * @return Class of the packet, from the length of its page.
+     */
+    [[nodiscard]] size_t classOf(const Packet& packet) const noexcept;
+
+    /**
+     * @brief Validates a configuration and counts its classes.
+     *
+     * @param config Configuration to check.
+     * @return Number of classes of a queue with the configuration.
+     * @throws std::invalid_argument if the class limits are not strictly ascending, there are
+     * more than MAX_CLASSES classes, the quanta do not give a positive quantum to every class, or
+     * the parameters of the queue management are out of range.
+     */
+    static size_t classCount(const QueueConfig& config);
+
+    // =============== Queue Operations ===============
+    /**
+     * @brief Adds a packet to the queue of its class.
+     *
+     * @param packet The packet to add.
+     * @return true if the packet was added, false if the queue is full or RED dropped it.
+     */
+    bool enqueue(const Packet& packet);
+
+    /**
+     * @brief Removes packets in the order of the discipline until n unexpired ones were appended
+     * to a vector or the queue is empty. Expired packets are discarded on the way.
+     *
+     * @param n Maximum number of unexpired packets to append.
+     * @param currentTick Current tick; packets with timeout <= currentTick are expired.
+     * With CoDel, packets may first be dropped from the head to bring the queueing delay, at a
+     * bandwidth of n packets per tick, back to target.
+     *
+     * @param n Maximum number of unexpired packets to append.
+     * @param currentTick Current tick; packets with timeout <= currentTick are expired.
+     * @param out Vector receiving the unexpired packets, in sending order.
+     * @param expiredOut Vector receiving the expired packets instead of discarding them, if any.
+     * @param droppedOut Vector receiving the packets dropped by CoDel instead of discarding them,
+     * if any.
+     * @return Number of expired packets discarded.
+     */
+    size_t dequeueLive(size_t n, size_t currentTick, std::vector<Packet>& out,
+                       std::vector<Packet>* expiredOut = nullptr,
+                       std::vector<Packet>* droppedOut = nullptr);
+
+    // =============== Query methods ===============
+    /**
+     * @brief Gets the current number of packets in the queue.
+     *
+     * @return Number of live packets over all classes.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Checks if the queue is empty.
+     *
+     * @return true if no class holds packets.
+     */
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    /**
+     * @brief Checks if the queue holds no packets and has no expirations left to report.
+     *
+     * @return true if neither dequeuing nor purging can change the queue until a packet arrives.
+     */
+    [[nodiscard]] bool isDrained() const noexcept;
+
+    // =============== Eager expiry ===============
+    /**
+     * @brief Enables or disables eager expiry, as PacketBuffer::setEagerExpiry() does.
+     *
+     * @param enabled true to retire expired packets in purgeExpired(), false for lazy expiry.
+     * @param currentTick Current system tick.
+     */
+    void setEagerExpiry(bool enabled, size_t currentTick = 0);
+
+    /**
+     * @brief Retires every packet whose timeout is at or before the given tick.
+     *
+     * @param currentTick Current system tick.
+     * @return Number of packets that expired since the previous purge (0 without eager expiry).
+     */
+    size_t purgeExpired(size_t currentTick);
+
+    // =============== Checkpoints ===============
+    /**
+     * @brief Writes the discipline, the live packets of every class, the round robin turn, the
+     * queue management state and the class counters.
+     *
+     * @param out Checkpoint being written.
+     */
+    void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Replaces the contents of the queue with the state written by saveState(). The
+     * capacity and expiry mode of this queue are kept.
+     *
+     * @param in Checkpoint being read.
+     * @throws std::runtime_error if the checkpoint is truncated, was written by a queue with
+     * another discipline or class count, or holds more packets than the capacity.
+     */
+    void restoreState(CheckpointReader& in);
+
+private:
+    // =============== Private helpers ===============
+    /**
+     * @brief Sends packets in the order of the discipline, without queue management.
+     *
+     * @see dequeueLive()
+     */
+    size_t dequeueNext(size_t n, size_t currentTick, std::vector<Packet>& out,
+                       std::vector<Packet>* expiredOut);
+
+    /**
+     * @brief Updates the average queue length with an arrival and decides whether RED drops it.
+     *
+     * @return true if the arrival is dropped.
+     */
+    bool redDrops() noexcept;
+
+    /**
+     * @brief Runs the CoDel control law before a dequeue, dropping packets from the head while
+     * the queueing delay calls for it.
+     *
+     * @see dequeueLive()
+     */
+    size_t controlDelay(size_t n, size_t currentTick, std::vector<Packet>* expiredOut,
+                        std::vector<Packet>* droppedOut);
+
+    /**
+     * @brief Drops the next packet of the discipline on behalf of CoDel.
+     *
+     * @return Number of expired packets discarded while looking for it.
+     * @see dequeueLive()
+     */
+    size_t dropHead(size_t currentTick, std::vector<Packet>* expiredOut,
+                    std::vector<Packet>* droppedOut);
+
+    /**
+     * @brief Sends packets from the classes in priority order.
+     *
+     * @see dequeueLive()
+     */
+    size_t dequeuePriority(size_t n, size_t currentTick, std::vector<Packet>& out,
+                           std::vector<Packet>* expiredOut);
+
+    /**
+     * @brief Sends packets from the classes in deficit round robin order. A class that runs out
+     * of bandwidth keeps the rest of its turn for the next call.
+     *
+     * @see dequeueLive()
+     */
+    size_t dequeueRoundRobin(size_t n, size_t currentTick, std::vector<Packet>& out,
+                             std::vector<Packet>* expiredOut);
+
+    /**
+     * @brief Sends packets from the earliest-deadline heap.
+     *
+     * @see dequeueLive()
+     */
+    size_t dequeueDeadline(size_t n, size_t currentTick, std::vector<Packet>& out,
+                           std::vector<Packet>* expiredOut);
+
+    /**
+     * @brief Removes the packet with the earliest deadline from the heap.
+     *
+     * @return The removed packet.
+     * @pre The heap is not empty.
+     */
+    Packet popDeadline();
+
+    /**
+     * @brief Sends up to n unexpired packets of one class, updating its counters.
+     *
+     * @param k Class to send from.
+     * @return Number of expired packets discarded.
+     * @see dequeueLive()
+     */
+    size_t dequeueClass(size_t k, size_t n, size_t currentTick, std::vector<Packet>& out,
+                        std::vector<Packet>* expiredOut);
+};
+
+// =============== Getters ===============
+inline IPAddress OutputQueue::getDstIP() const noexcept {
+    return dstIP;
+}
+
+inline size_t OutputQueue::getCapacity() const noexcept {
+    return capacity;
+}
+
+inline QueueDiscipline OutputQueue::getDiscipline() const noexcept {
+    return discipline;
+}
+
+inline size_t OutputQueue::getClassCount() const noexcept {
+    return counters.size();
+}
+
+inline std::span<const ClassCounters> OutputQueue::getClassCounters() const noexcept {
+    return counters;
+}
+
+// =============== Query methods ===============
+inline bool OutputQueue::isEmpty() const noexcept {
+    return size() == 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 #include "IPAddress.h"
 
@@ -14,14 +16,28 @@ constexpr size_t PACKET_TTL = 100;
  * Stores all the information from the page it belongs to, including its position within the page,
  * and a priority assigned by the router. This priority is used to determine the packet's
  * transmission priority. Packets are the fundamental units used by routers for data transmission.
+ *
+ * The fields are packed into 16 bytes (32-bit page ID and timeout, 16-bit position and length,
+ * two 16-bit addresses) so that four packets fit in a cache line; wide address layouts take 20.
+ * The getters keep returning @c size_t; the constructor rejects values that do not fit the packed
+ * layout.
  */
 class Packet {
-    size_t pageID;   /**< ID of the page this packet belongs to. */
-    size_t pagePos;  /**< Position of this packet within the page. */
-    size_t pageLen;  /**< Total number of packets on the page. */
-    size_t timeout;  /**< Simulation tick at which this packet should expire. */
-    IPAddress srcIP; /**< Reference to the source terminal IP. */
-    IPAddress dstIP; /**< Reference to the destination terminal IP. */
+public:
+    /** Largest page ID representable by a packet. */
+    static constexpr size_t MAX_PAGE_ID  = std::numeric_limits<uint32_t>::max();
+    /** Largest number of packets a page can be split into. */
+    static constexpr size_t MAX_PAGE_LEN = std::numeric_limits<uint16_t>::max();
+    /** Largest expiration tick representable by a packet; Network::MAX_TICK keeps runs below it. */
+    static constexpr size_t MAX_TIMEOUT  = std::numeric_limits<uint32_t>::max();
+
+private:
+    uint32_t pageID;  /**< ID of the page this packet belongs to. */
+    uint32_t timeout; /**< Simulation tick at which this packet should expire. */
+    uint16_t pagePos; /**< Position of this packet within the page. */
+    uint16_t pageLen; /**< Total number of packets on the page. */
+    IPAddress srcIP;  /**< Reference to the source terminal IP. */
+    IPAddress dstIP;  /**< Reference to the destination terminal IP. */
 
 public:
     // =============== Constructors & Destructor ===============
@@ -41,6 +57,8 @@ public:
      *
      * @throws std::invalid_argument if pagePos is out of range, if pageLen is 0, or if srcIP/dstIP
      * are invalid.
+     * @throws std::out_of_range if pageID exceeds MAX_PAGE_ID, pageLen exceeds MAX_PAGE_LEN or
+     * timeout exceeds MAX_TIMEOUT.
      */
     Packet(size_t pageID, size_t pagePos, size_t pageLen, IPAddress srcIP, IPAddress dstIP,
            size_t timeout);
@@ -168,6 +186,9 @@ public:
     [[nodiscard]] bool operator!=(const Packet& other) const noexcept;
 };
 
+static_assert(sizeof(Packet) == 12 + 2 * sizeof(IPAddress),
+              "Packet must stay packed into 16 bytes, or 20 with 32-bit addresses");
+
 // =============== Getters ===============
 inline size_t Packet::getPageID() const noexcept {
     return pageID;
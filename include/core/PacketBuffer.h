@@ -1,7 +1,15 @@
 #pragma once
 
+#include <optional>
+#include <span>
+#include <vector>
+
 #include "Packet.h"
-#include "structures/list.h"
+#include "structures/expiry_wheel.h"
+#include "structures/ring_buffer.h"
+
+class CheckpointReader;
+class CheckpointWriter;
 
 /**
  * @class PacketBuffer
@@ -12,11 +20,25 @@
  * (empty/full), and manage buffer capacity. It can be used for both terminal output buffers
  * (packets waiting to be sent to the router) and router input/output buffers (packets waiting to be
  * processed or forwarded).
+ *
+ * Packets are stored in a contiguous ring buffer. A bounded buffer preallocates one slot per unit
+ * of capacity, so enqueueing and dequeueing never touch the allocator; an unbounded buffer grows
+ * its storage geometrically and then reuses it.
+ *
+ * By default, expired packets are only noticed by the owner when they are dequeued. With eager
+ * expiry enabled, an ExpiryWheel counts the packets by timeout and purgeExpired() retires every
+ * packet whose timeout has been reached in O(expired): retired packets stop counting towards the
+ * size and capacity straight away and are discarded without being returned once they reach the
+ * front of the queue.
  */
 class PacketBuffer {
-    List<Packet> packets; /**< List of packets currently in the buffer, maintained in FIFO order */
-    size_t capacity;      /**< Maximum number of packets the buffer can hold (0 = unlimited) */
-    IPAddress dstIP;      /**< Associated destination IP for this buffer */
+    RingBuffer<Packet> packets;        /**< Packets currently in the buffer, in FIFO order */
+    size_t capacity;                   /**< Maximum number of packets held (0 = unlimited) */
+    size_t limit;                      /**< Capacity, or SIZE_MAX if unlimited */
+    IPAddress dstIP;                   /**< Associated destination IP for this buffer */
+    std::optional<ExpiryWheel> expiry; /**< Timeouts of the live packets, with eager expiry */
+    size_t retired;        /**< Expired packets still stored, waiting to be discarded */
+    size_t expiredOnEntry; /**< Expired packets refused since the last purge, not yet reported */
 
 public:
     // =============== Constructors & Destructor ===============
@@ -90,13 +112,64 @@ public:
     bool enqueue(const Packet& packet);
 
     /**
-     * @brief Removes and returns the front packet from the buffer.
+     * @brief Adds a packet to the buffer by moving it into its slot.
+     *
+     * @param packet The packet to add to the buffer.
+     * @return true if the packet was added successfully, false if the buffer is full and the packet
+     * was dropped.
+     */
+    bool enqueue(Packet&& packet);
+
+    /**
+     * @brief Removes the front packet from the buffer and returns it by moving it out of its slot.
      *
      * @return The packet at the front of the buffer.
      * @throws std::runtime_error if the buffer is empty when attempting to dequeue.
      */
     Packet dequeue();
 
+    /**
+     * @brief Moves the front packet into @p out and removes it from the buffer, if there is one.
+     *
+     * Non-throwing alternative to dequeue() for drain loops.
+     *
+     * @param out Packet that receives the front packet.
+     * @return true if a packet was dequeued, false if the buffer was empty (@p out is untouched).
+     */
+    bool tryDequeue(Packet& out) noexcept;
+
+    /**
+     * @brief Adds packets to the back of the buffer with a single capacity check.
+     *
+     * Packets are accepted in order until the buffer is full; the rest are rejected.
+     *
+     * @param batch Packets to add.
+     * @return Number of packets accepted, always a prefix of the batch.
+     */
+    size_t enqueueBatch(std::span<const Packet> batch);
+
+    /**
+     * @brief Removes up to n packets from the front of the buffer and appends them to a vector.
+     *
+     * @param n Maximum number of packets to remove.
+     * @param out Vector receiving the packets, in FIFO order.
+     * @return Number of packets moved.
+     */
+    size_t dequeueBatch(size_t n, std::vector<Packet>& out);
+
+    /**
+     * @brief Removes packets from the front of the buffer until n unexpired ones were appended to
+     * a vector or the buffer is empty. Expired packets are discarded on the way.
+     *
+     * @param n Maximum number of unexpired packets to append.
+     * @param currentTick Current tick; packets with timeout <= currentTick are expired.
+     * @param out Vector receiving the unexpired packets, in FIFO order.
+     * @param expiredOut Vector receiving the expired packets instead of discarding them, if any.
+     * @return Number of expired packets discarded.
+     */
+    size_t dequeueLive(size_t n, size_t currentTick, std::vector<Packet>& out,
+                       std::vector<Packet>* expiredOut = nullptr);
+
     // =============== Query methods ===============
     /**
      * @brief Checks if the buffer is empty.
@@ -113,6 +186,13 @@ public:
      */
     [[nodiscard]] bool isFull() const noexcept;
 
+    /**
+     * @brief Checks if the buffer holds no packets and has no expirations left to report.
+     *
+     * @return true if neither dequeuing nor purging can change the buffer until a packet arrives.
+     */
+    [[nodiscard]] bool isDrained() const noexcept;
+
     /**
      * @brief Gets the current number of packets in the buffer.
      *
@@ -178,6 +258,54 @@ public:
      */
     void removeAt(size_t index);
 
+    // =============== Eager expiry ===============
+    /**
+     * @brief Enables or disables eager expiry.
+     *
+     * When enabled, packets whose timeout is at or before the given tick are retired on the next
+     * purge. When disabled, packets already retired are discarded and the buffer goes back to
+     * lazy expiry.
+     *
+     * @param enabled true to retire expired packets in purgeExpired(), false for lazy expiry.
+     * @param currentTick Current system tick.
+     */
+    void setEagerExpiry(bool enabled, size_t currentTick = 0);
+
+    /**
+     * @brief Checks if eager expiry is enabled.
+     *
+     * @return true if expired packets are retired by purgeExpired(), false otherwise.
+     */
+    [[nodiscard]] bool hasEagerExpiry() const noexcept;
+
+    /**
+     * @brief Retires every packet whose timeout is at or before the given tick. Packets that were
+     * already expired when enqueued since the previous purge are reported as well.
+     *
+     * @param currentTick Current system tick.
+     * @return Number of packets that expired since the previous purge (0 without eager expiry).
+     */
+    size_t purgeExpired(size_t currentTick);
+
+    // =============== Checkpoints ===============
+    /**
+     * @brief Writes the live packets, in FIFO order, and the expirations not reported yet.
+     * Packets already retired by eager expiry are left out.
+     *
+     * @param out Checkpoint being written.
+     */
+    void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Replaces the contents of the buffer with the state written by saveState(). The
+     * capacity, destination and expiry mode of this buffer are kept; a buffer with eager expiry
+     * resumes from the last purge of the saved buffer.
+     *
+     * @param in Checkpoint being read.
+     * @throws std::runtime_error if the checkpoint is truncated or the packets exceed the capacity.
+     */
+    void restoreState(CheckpointReader& in);
+
     // =============== Utilities ===============
     /**
      * @brief Gets a string representation of the buffer.
@@ -195,6 +323,35 @@ public:
      * @return Reference to the output stream.
      */
     friend std::ostream& operator<<(std::ostream& os, const PacketBuffer& buffer);
+
+private:
+    // =============== Private helpers ===============
+    /**
+     * @brief Checks if a stored packet has been retired by eager expiry.
+     *
+     * @param packet Packet stored in the buffer.
+     * @return true if the packet expired at or before the last purge, false otherwise.
+     */
+    [[nodiscard]] bool isRetired(const Packet& packet) const noexcept;
+
+    /**
+     * @brief Discards the retired packets at the front of the queue.
+     */
+    void discardRetiredFront() noexcept;
+
+    /**
+     * @brief Discards every retired packet, preserving the order of the live ones.
+     */
+    void compact() noexcept;
+
+    /**
+     * @brief Finds the storage position of a live packet.
+     *
+     * @param index Index of the packet among the live packets (0-based).
+     * @return Position of the packet in the underlying ring buffer.
+     * @pre index < size().
+     */
+    [[nodiscard]] size_t storageIndex(size_t index) const noexcept;
 };
 
 // =============== Getters ===============
@@ -208,7 +365,7 @@ inline size_t PacketBuffer::getCapacity() const noexcept {
 
 // =============== Query methods ===============
 inline bool PacketBuffer::isEmpty() const noexcept {
-    return packets.isEmpty();
+    return size() == 0;
 }
 
 inline void PacketBuffer::setDstIP(IPAddress newDst) noexcept {
@@ -216,11 +373,21 @@ inline void PacketBuffer::setDstIP(IPAddress newDst) noexcept {
 }
 
 inline bool PacketBuffer::isFull() const noexcept {
-    if (capacity == 0)
-        return false;
-    return packets.size() >= capacity;
+    return size() >= limit;
+}
+
+inline bool PacketBuffer::isDrained() const noexcept {
+    return isEmpty() && expiredOnEntry == 0;
 }
 
 inline size_t PacketBuffer::size() const noexcept {
-    return packets.size();
+    return packets.size() - retired;
+}
+
+inline bool PacketBuffer::hasEagerExpiry() const noexcept {
+    return expiry.has_value();
+}
+
+inline bool PacketBuffer::isRetired(const Packet& packet) const noexcept {
+    return retired > 0 && packet.getTimeout() <= expiry->getCurrentTick();
 }
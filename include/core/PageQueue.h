@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Packet.h"
+#include "Page.h"
+#include "structures/expiry_wheel.h"
+#include "structures/ring_buffer.h"
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/**
+ * @class PageQueue
+ * @brief Output buffer of a terminal that holds whole pages and fragments them into packets as
+ * they are dequeued.
+ *
+ * Each queued page is a single descriptor the size of one packet that remembers the position of
+ * the next packet to emit, so queueing a page costs the same whatever its length and no packet
+ * exists before the bandwidth of the terminal lets it out. The capacity is still counted in
+ * packets: a page is admitted only if all of its packets fit, and size() counts the packets not
+ * emitted yet, so the queue behaves exactly like a PacketBuffer filled with Page::toPackets().
+ *
+ * All the packets of a page share its timeout, so expiry works on whole descriptors. With eager
+ * expiry an ExpiryWheel counts the pages by timeout and purgeExpired() only walks the queue when
+ * one of them has expired.
+ */
+class PageQueue {
+    /**
+     * @struct Descriptor
+     * @brief A queued page, laid out like the packet it emits next.
+     */
+    struct Descriptor {
+        uint32_t pageID;  /**< ID of the page */
+        uint32_t timeout; /**< Tick at which the packets of the page expire */
+        uint16_t nextPos; /**< Position of the next packet to emit */
+        uint16_t pageLen; /**< Number of packets on the page */
+        IPAddress srcIP;  /**< Source terminal IP */
+        IPAddress dstIP;  /**< Destination terminal IP */
+
+        /**
+         * @brief Counts the packets of the page not emitted yet.
+         *
+         * @return Remaining packets.
+         */
+        [[nodiscard]] size_t remaining() const noexcept { return pageLen - nextPos; }
+
+        /**
+         * @brief Builds the packet at a position of the page.
+         *
+         * @param pos Position within the page.
+         * @return The packet.
+         */
+        [[nodiscard]] Packet packetAt(size_t pos) const {
+            return {pageID, pos, pageLen, srcIP, dstIP, timeout};
+        }
+    };
+    static_assert(sizeof(Descriptor) == sizeof(Packet), "A queued page costs a single packet");
+
+    RingBuffer<Descriptor> pages;      /**< Queued pages, in FIFO order */
+    size_t capacity;                   /**< Maximum number of packets held (0 = unlimited) */
+    size_t limit;                      /**< Capacity, or SIZE_MAX if unlimited */
+    size_t pending;                    /**< Packets of the queued pages not emitted yet */
+    std::optional<ExpiryWheel> expiry; /**< Timeouts of the queued pages, with eager expiry */
+    size_t expiredOnEntry; /**< Expired packets refused since the last purge, not yet reported */
+
+public:
+    // =============== Constructors & Destructor ===============
+    /**
+     * @brief Constructor with optional capacity.
+     *
+     * @param capacity Maximum number of packets held (0 = unlimited, default).
+     */
+    explicit PageQueue(size_t capacity = 0);
+
+    // =============== Getters ===============
+    /**
+     * @brief Gets the maximum capacity.
+     *
+     * @return Maximum number of packets the queue can hold (0 = unlimited).
+     */
+    [[nodiscard]] size_t getCapacity() const noexcept;
+
+    /**
+     * @brief Gets the number of queued pages, including the one being fragmented.
+     *
+     * @return Pages with packets left to emit.
+     */
+    [[nodiscard]] size_t getPageCount() const noexcept;
+
+    // =============== Queue Operations ===============
+    /**
+     * @brief Queues every packet of a page, or none of them if they do not all fit.
+     *
+     * @param page Page to queue.
+     * @param timeout Tick at which the packets of the page expire.
+     * @return true if the page was queued, false if the queue lacks space for the whole page.
+     * @throws std::out_of_range if the page does not fit the packed layout of a Packet.
+     */
+    bool enqueue(const Page& page, size_t timeout);
+
+    /**
+     * @brief Emits packets from the front pages until n unexpired ones were appended to a vector
+     * or the queue is empty. The remaining packets of an expired page are discarded on the way.
+     *
+     * @param n Maximum number of unexpired packets to append.
+     * @param currentTick Current tick; packets with timeout <= currentTick are expired.
+     * @param out Vector receiving the unexpired packets, in FIFO order.
+     * @param expiredOut Vector receiving the expired packets instead of discarding them, if any.
+     * @return Number of expired packets discarded.
+     */
+    size_t dequeueLive(size_t n, size_t currentTick, std::vector<Packet>& out,
+                       std::vector<Packet>* expiredOut = nullptr);
+
+    // =============== Query methods ===============
+    /**
+     * @brief Checks if the queue is empty.
+     *
+     * @return true if no packets are left to emit.
+     */
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    /**
+     * @brief Checks if the queue holds no packets and has no expirations left to report.
+     *
+     * @return true if neither dequeuing nor purging can change the queue until a page arrives.
+     */
+    [[nodiscard]] bool isDrained() const noexcept;
+
+    /**
+     * @brief Gets the number of packets left to emit.
+     *
+     * @return Packets of the queued pages not emitted yet.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Gets the number of additional packets that can be queued before reaching capacity.
+     *
+     * @return Number of additional packets that can be queued (0 if full, or
+     * std::numeric_limits<int>::max() if unlimited).
+     */
+    [[nodiscard]] size_t availableSpace() const noexcept;
+
+    // =============== Buffer Management ===============
+    /**
+     * @brief Drops every queued page.
+     */
+    void clear() noexcept;
+
+    // =============== Eager expiry ===============
+    /**
+     * @brief Enables or disables eager expiry.
+     *
+     * When enabled, pages whose timeout is at or before the given tick are dropped on the next
+     * purge.
+     *
+     * @param enabled true to drop expired pages in purgeExpired(), false for lazy expiry.
+     * @param currentTick Current system tick.
+     */
+    void setEagerExpiry(bool enabled, size_t currentTick = 0);
+
+    /**
+     * @brief Checks if eager expiry is enabled.
+     *
+     * @return true if expired pages are dropped by purgeExpired(), false otherwise.
+     */
+    [[nodiscard]] bool hasEagerExpiry() const noexcept;
+
+    /**
+     * @brief Drops every page whose timeout is at or before the given tick. Pages that were
+     * already expired when queued since the previous purge are reported as well.
+     *
+     * @param currentTick Current system tick.
+     * @return Number of packets that expired since the previous purge (0 without eager expiry).
+     */
+    size_t purgeExpired(size_t currentTick);
+
+    // =============== Checkpoints ===============
+    /**
+     * @brief Writes the queued pages, in FIFO order, and the expirations not reported yet.
+     *
+     * @param out Checkpoint being written.
+     */
+    void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Replaces the contents of the queue with the state written by saveState(). The
+     * capacity and expiry mode of this queue are kept; a queue with eager expiry resumes from the
+     * last purge of the saved queue.
+     *
+     * @param in Checkpoint being read.
+     * @throws std::runtime_error if the checkpoint is truncated, holds an invalid page or the
+     * packets exceed the capacity.
+     */
+    void restoreState(CheckpointReader& in);
+
+private:
+    // =============== Private helpers ===============
+    /**
+     * @brief Removes the front page, which has no packets left to emit or has expired.
+     */
+    void popFront() noexcept;
+
+    /**
+     * @brief Drops every page whose timeout is at or before a tick, keeping the order of the
+     * others. The wheel is left untouched.
+     *
+     * @param currentTick Current system tick.
+     * @return Number of packets dropped.
+     */
+    size_t dropExpired(size_t currentTick) noexcept;
+};
+
+// =============== Getters ===============
+inline size_t PageQueue::getCapacity() const noexcept {
+    return capacity;
+}
+
+inline size_t PageQueue::getPageCount() const noexcept {
+    return pages.size();
+}
+
+// =============== Query methods ===============
+inline bool PageQueue::isEmpty() const noexcept {
+    return pending == 0;
+}
+
+inline bool PageQueue::isDrained() const noexcept {
+    return isEmpty() && expiredOnEntry == 0;
+}
+
+inline size_t PageQueue::size() const noexcept {
+    return pending;
+}
+
+inline bool PageQueue::hasEagerExpiry() const noexcept {
+    return expiry.has_value();
+}
@@ -1,10 +1,152 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "Packet.h"
 #include "structures/list.h"
 
+class CheckpointReader;
+class CheckpointWriter;
+
 constexpr size_t MAX_ASSEMBLER_TTL = 250; /**< Maximum TTL for a PageReassembler */
 
+/**
+ * @class ReassemblyPool
+ * @brief Recycles the fragment storage of page reassemblers.
+ *
+ * Each reassembler needs one block of words holding its received-position bitmap followed by the
+ * timeouts of its fragments. A terminal keeps one pool sized to its maximum page length, so once
+ * the pool has warmed up, starting a page reuses a block returned by a completed or expired page
+ * instead of allocating. Pages longer than the block size get a dedicated block that is freed
+ * rather than pooled.
+ */
+class ReassemblyPool {
+public:
+    /**
+     * @class Block
+     * @brief Owning handle to a block of fragment storage; returns it to its pool on destruction.
+     */
+    class Block {
+        std::unique_ptr<uint64_t[]> words; /**< Storage words */
+        size_t capacity;                   /**< Fragments the block can describe */
+        ReassemblyPool* owner;             /**< Pool to return the block to, or nullptr */
+
+    public:
+        /**
+         * @brief Creates an empty handle.
+         */
+        Block() noexcept;
+
+        /**
+         * @brief Takes ownership of a block.
+         *
+         * @param words Storage words, at least ReassemblyPool::wordsFor(capacity) long.
+         * @param capacity Fragments the block can describe.
+         * @param owner Pool to return the block to, or nullptr to free it.
+         */
+        Block(std::unique_ptr<uint64_t[]> words, size_t capacity, ReassemblyPool* owner) noexcept;
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param other Handle to take the block from; left empty.
+         */
+        Block(Block&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator; returns the currently held block first.
+         *
+         * @param other Handle to take the block from; left empty.
+         * @return Reference to this handle.
+         */
+        Block& operator=(Block&& other) noexcept;
+
+        /**
+         * @brief Returns the block to its pool, or frees it.
+         */
+        ~Block();
+
+        /**
+         * @brief Gets the storage words.
+         *
+         * @return Pointer to the first word, or nullptr for an empty handle.
+         */
+        [[nodiscard]] uint64_t* data() const noexcept;
+
+    private:
+        /**
+         * @brief Hands the block back to its owner, leaving the handle empty.
+         */
+        void release() noexcept;
+    };
+
+    /**
+     * @brief Constructor for ReassemblyPool.
+     *
+     * @param blockFragments Fragments described by each pooled block.
+     */
+    explicit ReassemblyPool(size_t blockFragments = 0);
+
+    /**
+     * @brief Gets a block able to describe the given number of fragments.
+     *
+     * @param fragments Number of fragments of the page.
+     * @return Block with its bitmap words cleared.
+     */
+    Block acquire(size_t fragments);
+
+    /**
+     * @brief Changes the size of pooled blocks, dropping the free blocks of the old size.
+     *
+     * @param fragments Fragments described by each pooled block.
+     */
+    void setBlockFragments(size_t fragments) noexcept;
+
+    /**
+     * @brief Gets the number of fragments described by each pooled block.
+     *
+     * @return Block size in fragments.
+     */
+    [[nodiscard]] size_t getBlockFragments() const noexcept;
+
+    /**
+     * @brief Gets the number of blocks waiting to be reused.
+     *
+     * @return Number of free blocks.
+     */
+    [[nodiscard]] size_t getFreeBlocks() const noexcept;
+
+    /**
+     * @brief Gets the number of bitmap words needed for a page.
+     *
+     * @param fragments Number of fragments of the page.
+     * @return Words holding one bit per fragment.
+     */
+    [[nodiscard]] static constexpr size_t bitmapWords(size_t fragments) noexcept;
+
+    /**
+     * @brief Gets the number of words a block needs to describe a page.
+     *
+     * @param fragments Number of fragments of the page.
+     * @return Bitmap words plus two 32-bit timeouts per word.
+     */
+    [[nodiscard]] static constexpr size_t wordsFor(size_t fragments) noexcept;
+
+private:
+    size_t blockFragments; /**< Fragments described by each pooled block */
+    std::vector<std::unique_ptr<uint64_t[]>> freeBlocks; /**< Blocks waiting to be reused */
+
+    /**
+     * @brief Takes back a block, keeping it if it has the current pooled size.
+     *
+     * @param words Storage words of the block.
+     * @param capacity Fragments the block can describe.
+     */
+    void release(std::unique_ptr<uint64_t[]> words, size_t capacity) noexcept;
+};
+
 /**
  * @class PageReassembler
  * @brief Manages the reassembly of packets into a complete page for a specific page ID.
@@ -13,14 +155,20 @@ constexpr size_t MAX_ASSEMBLER_TTL = 250; /**< Maximum TTL for a PageReassembler
  * far, and the expiration tick. It provides methods to add packets, check completion status, and
  * package the received packets into an ordered list. The reassembler can be reset after packaging
  * to allow reuse.
+ *
+ * Fragments are not stored as packets: the fields shared by the whole page are kept once, received
+ * positions are tracked in a bitmap and only each fragment's timeout is kept, in a block taken from
+ * a ReassemblyPool. When the caller does not need the packets, finish() completes the page without
+ * rebuilding them.
  */
 class PageReassembler {
-    size_t pageID;    /**< ID of the page being reassembled */
-    IPAddress srcIP;  /**< Source IP of the page */
-    size_t total;     /**< Total number of packets expected */
-    size_t count;     /**< Number of packets received so far */
-    size_t timeout;   /**< System tick at which this reassembler should expire if not completed */
-    Packet** packets; /**< Array of pointers to received packets, indexed by their position */
+    size_t pageID;                  /**< ID of the page being reassembled */
+    IPAddress srcIP;                /**< Source IP of the page */
+    IPAddress dstIP;                /**< Destination IP of the page, set by the first fragment */
+    size_t total;                   /**< Total number of packets expected */
+    size_t count;                   /**< Number of packets received so far */
+    size_t timeout;                 /**< System tick at which this reassembler should expire */
+    ReassemblyPool::Block fragments; /**< Received-position bitmap followed by fragment timeouts */
 
 public:
     // =============== Constructors & Destructor ===============
@@ -31,9 +179,11 @@ public:
      * @param ip Source IP address of the page being reassembled.
      * @param length Total number of packets expected for the page (must be > 0).
      * @param timeout System tick at which this reassembler should expire if not completed.
+     * @param pool Pool to take the fragment storage from, or nullptr to allocate it (optional).
      * @throws std::invalid_argument if length is 0.
      */
-    PageReassembler(size_t id, IPAddress ip, size_t length, size_t timeout);
+    PageReassembler(size_t id, IPAddress ip, size_t length, size_t timeout,
+                    ReassemblyPool* pool = nullptr);
 
     /**
      * @brief Deleted Copy constructor.
@@ -48,24 +198,24 @@ public:
     PageReassembler& operator=(const PageReassembler&) = delete;
 
     /**
-     * @brief Deleted Move constructor.
+     * @brief Move constructor.
      *
      * @param other The other PageReassembler to move from.
      */
-    PageReassembler(PageReassembler&& other) noexcept;
+    PageReassembler(PageReassembler&& other) noexcept = default;
 
     /**
-     * @brief Deleted Move assignment operator.
+     * @brief Move assignment operator.
      *
      * @param other The other PageReassembler to move from.
      * @return Reference to this object.
      */
-    PageReassembler& operator=(PageReassembler&& other) noexcept;
+    PageReassembler& operator=(PageReassembler&& other) noexcept = default;
 
     /**
-     * @brief Destructor - cleans up all allocated packets.
+     * @brief Destructor - returns the fragment storage to its pool.
      */
-    ~PageReassembler();
+    ~PageReassembler() = default;
 
     // =============== Getters ===============
     /**
@@ -136,8 +286,9 @@ public:
 
     // =============== Modifiers ===============
     /**
-     * @brief Adds a packet to the reassembler if it matches the page ID and expected total, and if
-     * the position is valid and not already filled.
+     * @brief Adds a packet to the reassembler if it matches the page ID, source, destination and
+     * expected total, and if the position is valid and not already filled. The first packet
+     * accepted fixes the destination of the page.
      *
      * @param p Packet to add to the reassembler.
      * @return true if the packet was added successfully, false if the packet is invalid or a packet
@@ -156,11 +307,38 @@ public:
      */
     List<Packet> package();
 
+    /**
+     * @brief Completes the page without rebuilding its packets, for callers that only need to
+     * account for it. After finishing, the reassembler is reset and can be reused.
+     *
+     * @return Number of packets of the completed page.
+     * @throws std::runtime_error if the page is not complete.
+     */
+    size_t finish();
+
     /**
      * @brief Resets the reassembler, deleting all stored packets.
      */
     void reset();
 
+    // =============== Checkpoints ===============
+    /**
+     * @brief Writes the page fields, the received-position bitmap and the fragment timeouts.
+     *
+     * @param out Checkpoint being written.
+     */
+    void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Rebuilds a reassembler written by saveState().
+     *
+     * @param in Checkpoint being read.
+     * @param pool Pool to take the fragment storage from, or nullptr to allocate it (optional).
+     * @return Reassembler holding the same fragments.
+     * @throws std::runtime_error if the checkpoint is truncated or describes an invalid page.
+     */
+    static PageReassembler restoreState(CheckpointReader& in, ReassemblyPool* pool = nullptr);
+
     /**
      * @brief Generates a string representation of the reassembler.
      *
@@ -195,8 +373,39 @@ public:
      * presence; false otherwise.
      */
     bool operator!=(const PageReassembler& other) const noexcept;
+
+private:
+    // =============== Private helpers ===============
+    /**
+     * @brief Gets the timeout stored for a received fragment.
+     *
+     * @param position Position of the fragment.
+     * @return Timeout of the fragment.
+     */
+    [[nodiscard]] size_t timeoutAt(size_t position) const noexcept;
 };
 
+// =============== ReassemblyPool ===============
+inline uint64_t* ReassemblyPool::Block::data() const noexcept {
+    return words.get();
+}
+
+inline size_t ReassemblyPool::getBlockFragments() const noexcept {
+    return blockFragments;
+}
+
+inline size_t ReassemblyPool::getFreeBlocks() const noexcept {
+    return freeBlocks.size();
+}
+
+constexpr size_t ReassemblyPool::bitmapWords(size_t fragments) noexcept {
+    return (fragments + 63) / 64;
+}
+
+constexpr size_t ReassemblyPool::wordsFor(size_t fragments) noexcept {
+    return bitmapWords(fragments) + (fragments + 1) / 2;
+}
+
 // =============== Query methods ===============
 inline bool PageReassembler::isComplete() const {
     return count == total;
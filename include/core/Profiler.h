@@ -0,0 +1,194 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef ROUTERSIM_PROFILING
+/** Set to 1 (CMake option ROUTERSIM_PROFILING) to compile the phase timers in */
+#define ROUTERSIM_PROFILING 0
+#endif
+
+/**
+ * @class Profiler
+ * @brief Process-wide wall time profile of the phases of a simulation tick.
+ *
+ * Timed scopes add their duration to the running total of their phase; at the end of every network
+ * tick the totals are moved into one histogram per phase, so each histogram describes how long a
+ * phase took per tick rather than per call. Every thread keeps its own totals, so routers ticked on
+ * different threads record without sharing a counter; endTick() merges them and must not overlap
+ * with recording.
+ *
+ * Threads that run several ticks before the network closes them, as pipelined partitions do, mark
+ * the end of each tick with closeThreadTick() and the network closes the whole run with endTicks().
+ *
+ * The timers are only placed in the simulator when it is built with ROUTERSIM_PROFILING, through
+ * the ROUTERSIM_PROFILE_SCOPE and ROUTERSIM_PROFILE_END_TICK macros, which otherwise expand to
+ * nothing. Phases can nest: reassembly runs inside the terminals phase and is counted in both.
+ */
+class Profiler {
+public:
+    /**
+     * @enum Phase
+     * @brief Timed phases of a tick.
+     */
+    enum class Phase : uint8_t {
+        RouterOutput,    /**< Forwarding output buffers to neighbors, and collecting them */
+        RouterLocal,     /**< Delivering the local buffer to terminals */
+        RouterTerminals, /**< Ticking the terminals */
+        RouterInput,     /**< Routing the input buffer */
+        Routing,         /**< Recomputing the routing tables */
+        Reassembly       /**< Reassembling incoming pages in terminals */
+    };
+
+    /** Number of phases */
+    static constexpr size_t PHASE_COUNT = 6;
+    /** Number of histogram buckets; bucket b holds durations in [2^b, 2^(b+1)) ns */
+    static constexpr size_t BUCKET_COUNT = 48;
+    /** Whether the phase timers are compiled into the simulator */
+    static constexpr bool ENABLED = ROUTERSIM_PROFILING != 0;
+
+    /**
+     * @struct Histogram
+     * @brief Distribution of the per-tick time of one phase on a log2 scale.
+     */
+    struct Histogram {
+        std::array<uint64_t, BUCKET_COUNT> buckets{}; /**< Ticks per duration bucket */
+        uint64_t ticks      = 0;                      /**< Ticks recorded */
+        uint64_t totalNanos = 0;                      /**< Time over all recorded ticks */
+        uint64_t maxNanos   = 0;                      /**< Longest recorded tick */
+
+        /**
+         * @brief Adds the time of one tick.
+         *
+         * @param nanos Time spent in the phase during the tick.
+         */
+        void add(uint64_t nanos) noexcept;
+
+        /**
+         * @brief Estimates a percentile of the per-tick time.
+         *
+         * @param q Quantile in [0, 1].
+         * @return Upper bound of the bucket holding the quantile, capped at maxNanos, or 0 if no
+         * tick was recorded.
+         */
+        [[nodiscard]] uint64_t percentile(double q) const noexcept;
+
+        /**
+         * @brief Gets the mean time per tick.
+         *
+         * @return Mean nanoseconds per recorded tick, or 0 if none was recorded.
+         */
+        [[nodiscard]] double meanNanos() const noexcept;
+    };
+
+    /**
+     * @brief Adds time to the running total of a phase for the current tick.
+     *
+     * @param phase Phase the time was spent in.
+     * @param nanos Nanoseconds spent.
+     */
+    static void record(Phase phase, uint64_t nanos) noexcept;
+
+    /**
+     * @brief Closes the current tick: moves the running totals of every thread into the
+     * histograms.
+     */
+    static void endTick();
+
+    /**
+     * @brief Marks the end of a tick of a run on the calling thread: the time it recorded since
+     * its previous mark is set aside for that tick until endTicks() closes the run.
+     *
+     * @param runTick Index of the tick within the run, from 0.
+     */
+    static void closeThreadTick(size_t runTick);
+
+    /**
+     * @brief Closes the ticks of a run, adding one sample per tick to each histogram. Time marked
+     * with closeThreadTick() goes to its tick; time recorded after the last mark of a thread, or
+     * without marks, goes to the last tick of the run.
+     *
+     * @param ticks Number of ticks in the run.
+     */
+    static void endTicks(size_t ticks);
+
+    /**
+     * @brief Gets the histogram of a phase.
+     *
+     * @param phase Phase to query.
+     * @return Histogram of the per-tick time of the phase.
+     */
+    [[nodiscard]] static const Histogram& histogram(Phase phase) noexcept;
+
+    /**
+     * @brief Clears the running totals and every histogram.
+     */
+    static void reset();
+
+    /**
+     * @brief Gets the display name of a phase.
+     *
+     * @param phase Phase to name.
+     * @return Name of the phase.
+     */
+    [[nodiscard]] static const char* phaseName(Phase phase) noexcept;
+};
+
+/**
+ * @class ScopedPhaseTimer
+ * @brief Records the wall time of its own lifetime into a profiler phase.
+ */
+class ScopedPhaseTimer {
+    using Clock = std::chrono::steady_clock; /**< Monotonic clock used for timing */
+
+    Profiler::Phase phase;   /**< Phase the time is recorded into */
+    Clock::time_point start; /**< Time of construction */
+
+public:
+    /**
+     * @brief Starts timing a phase.
+     *
+     * @param phase Phase to record the time into.
+     */
+    explicit ScopedPhaseTimer(Profiler::Phase phase) noexcept : phase(phase), start(Clock::now()) {}
+
+    /**
+     * @brief Records the time elapsed since construction.
+     */
+    ~ScopedPhaseTimer() {
+        const auto elapsed = Clock::now() - start;
+        const auto nanos   = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        Profiler::record(phase, static_cast<uint64_t>(nanos));
+    }
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     *
+     * @return Reference to this timer.
+     */
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+};
+
+#if ROUTERSIM_PROFILING
+/** Times the rest of the enclosing scope into the given Profiler::Phase */
+#define ROUTERSIM_PROFILE_SCOPE(phase) \
+    const ScopedPhaseTimer routersimPhaseTimer { Profiler::Phase::phase }
+/** Closes the current tick of the profiler */
+#define ROUTERSIM_PROFILE_END_TICK() Profiler::endTick()
+/** Marks the end of the given tick of a run on the calling thread */
+#define ROUTERSIM_PROFILE_CLOSE_THREAD_TICK(runTick) Profiler::closeThreadTick(runTick)
+/** Closes the given number of ticks of a run */
+#define ROUTERSIM_PROFILE_END_TICKS(ticks) Profiler::endTicks(ticks)
+#else
+#define ROUTERSIM_PROFILE_SCOPE(phase) static_cast<void>(0)
+#define ROUTERSIM_PROFILE_END_TICK() static_cast<void>(0)
+#define ROUTERSIM_PROFILE_CLOSE_THREAD_TICK(runTick) static_cast<void>(runTick)
+#define ROUTERSIM_PROFILE_END_TICKS(ticks) static_cast<void>(ticks)
+#endif
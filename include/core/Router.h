@@ -1,16 +1,31 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <random>
-#include <unordered_map>
+#include <ranges>
+#include <span>
+#include <vector>
 
 #include "IPAddress.h"
+#include "OutputQueue.h"
 #include "PacketBuffer.h"
 #include "RoutingTable.h"
+#include "TraceEvent.h"
+#include "TrafficCounters.h"
+#include "structures/arena.h"
+#include "structures/bloom_filter.h"
+#include "structures/list.h"
+#include "structures/spsc_ring.h"
+#include "structures/xoshiro256.h"
 
 // Forward declarations
+class CheckpointReader;
+class CheckpointWriter;
 class Terminal;
 class Router;
+class TrafficModel;
 
 /**
  * @class Router
@@ -46,6 +61,8 @@ public:
         size_t outBufferCap;
         /** Output bandwidth, number of packets that can be sent to the router per cycle */
         size_t outBW;
+        /** Queueing discipline and traffic classes of the output buffers */
+        QueueConfig outQueue;
 
         /**
          * @brief Default constructor for Config, initializes with default values.
@@ -56,7 +73,8 @@ public:
               locBufferCap(DEF_LOC_BUF_CAP),
               locBW(DEF_LOC_BW),
               outBufferCap(DEF_OUT_BUF_CAP),
-              outBW(DEF_OUTPUT_BW) {}
+              outBW(DEF_OUTPUT_BW),
+              outQueue() {}
 
         /**
          * @brief Parameterized constructor for Config allows setting custom values.
@@ -75,26 +93,62 @@ public:
               locBufferCap(locBufferCap),
               locBW(locBW),
               outBufferCap(outBufferCap),
-              outBW(outBW) {}
+              outBW(outBW),
+              outQueue() {}
     };
 
 private:
+    /** Slot of a router that is not a neighbor, or next hop of a destination without a route */
+    static constexpr uint16_t NO_SLOT = UINT16_MAX;
+
+    /**
+     * @struct LinkRing
+     * @brief Lock-free queue of a staged link in a pipelined run, framed by tick.
+     *
+     * The sender seals every tick by recording the ring's push count by tick parity, and the
+     * receiver takes exactly one sealed tick per collectInbound(). A sender already running the
+     * next tick therefore never leaks packets into the tick being collected, and it cannot get
+     * two ticks ahead because its next collection waits for the receiver's next compute phase.
+     */
+    struct LinkRing {
+        SpscRing<Packet> packets;                /**< Packets staged over the link */
+        std::array<std::atomic<size_t>, 2> ends; /**< Push count sealing a tick, by tick parity */
+        size_t sealedTicks;                      /**< Ticks sealed, private to the sender */
+        size_t collectedTicks;                   /**< Ticks collected, private to the receiver */
+
+        /**
+         * @brief Constructor for LinkRing.
+         *
+         * @param capacity Packets the link may stage in two ticks.
+         */
+        explicit LinkRing(size_t capacity)
+            : packets(capacity), ends{}, sealedTicks(0), collectedTicks(0) {}
+    };
+
     /**
      * @struct RtrConnection
      * @brief Represents a connection to a neighbor router.
      */
     struct RtrConnection {
-        Router* neighborRouter; /**< Pointer to neighbor router */
-        PacketBuffer outBuffer; /**< Output buffer for this neighbor */
+        Router* neighborRouter;         /**< Pointer to neighbor router */
+        OutputQueue outBuffer;          /**< Output buffer for this neighbor */
+        std::vector<Packet> outbox;     /**< Packets staged for this neighbor in a two-phase tick */
+        std::unique_ptr<LinkRing> ring; /**< Queue replacing the outbox in a pipelined run */
+        uint16_t inboxSlot;             /**< Slot of this router at the neighbor, once resolved */
+        bool staged;                    /**< Whether processOutputBuffers() stages the packets */
 
         /**
          * @brief Constructor for RouterConnection.
          *
          * @param r Pointer to the neighbor router (must not be nullptr).
          * @param capacity Capacity of the output buffer for this connection (default 0).
+         * @param queue Queueing discipline of the output buffer (FIFO by default).
          */
-        explicit RtrConnection(Router* r, size_t capacity = 0)
-            : neighborRouter(r), outBuffer(PacketBuffer{r->getIP(), capacity}) {}
+        explicit RtrConnection(Router* r, size_t capacity = 0, const QueueConfig& queue = {})
+            : neighborRouter(r),
+              outBuffer(r->getIP(), capacity, queue),
+              inboxSlot(NO_SLOT),
+              staged(false) {}
 
         /**
          * @brief Move constructor - defaulted to allow moving of RtrConnection objects
@@ -111,28 +165,50 @@ private:
 
     /** Unique pointer type for managing connected terminals */
     using TerminalPtr  = std::unique_ptr<Terminal>;
-    /** Unordered map of connected terminals, keyed by their IP address for efficient lookup */
-    using TerminalList = std::unordered_map<IPAddress, TerminalPtr>;
-    /** Unordered map of connections to neighbor routers, keyed by the neighbor's IP address */
-    using RoutersList  = std::unordered_map<IPAddress, RtrConnection>;
-
-    IPAddress routerIP;        /**< Router's IP address */
-    RoutingTable routingTable; /**< Routing table for packet forwarding */
-    TerminalList terminals;    /**< Connected terminals */
-    RoutersList connections;   /**< Connections to neighbor routers */
-    size_t outBufferCap;       /**< Capacity of output buffers */
+    /** Connected terminals indexed by terminal ID, with nullptr where no terminal is connected */
+    using TerminalList = std::vector<Terminal*>;
+    /** Connections to neighbor routers in connection order, indexed by neighbor slot */
+    using RoutersList  = std::vector<RtrConnection>;
+    /** Neighbor slot by router ID */
+    using SlotTable    = std::vector<uint16_t>;
+
+    IPAddress routerIP;                    /**< Router's IP address */
+    RoutingTable routingTable;             /**< Routing table for packet forwarding */
+    Arena<Terminal> terminalBlock;         /**< Terminals created with the router, side by side */
+    std::vector<TerminalPtr> adoptedTerms; /**< Terminals handed over with connectTerminal() */
+    TerminalList terminals;                /**< Connected terminals, by terminal ID */
+    size_t terminalCount;                  /**< Number of connected terminals */
+    RoutersList connections;               /**< Connections to neighbor routers, by neighbor slot */
+    SlotTable slotByRouter;                /**< Neighbor slot by router ID, or NO_SLOT */
+    SlotTable routeSlots;                  /**< Next-hop slot by destination ID, or NO_SLOT */
+    SlotTable pathSlots;                   /**< Usable next-hop slots, MAX_PATHS per destination */
+    std::vector<uint8_t> pathCounts;       /**< Usable next hops by destination ID, if multipath */
+    size_t outBufferCap;                   /**< Capacity of output buffers */
+    QueueConfig outQueue;                  /**< Queueing discipline of output buffers */
 
     PacketBuffer inBuffer;  /**< FIFO buffer for incoming packets */
     size_t inProcCap;       /**< Packets per cycle able to process from the input buffer */
     PacketBuffer locBuffer; /**< Buffer for packets destined to local terminals */
     size_t locBufferBW;     /**< Packets per cycle to each local terminal */
     size_t outBufferBW;     /**< Packets per cycle to each neighbor router */
+    bool eagerExpiry;       /**< Whether expired packets are purged from the buffers each tick */
+
+    std::vector<Packet> batch;   /**< Scratch storage for packets moved out of a buffer */
+    std::vector<Packet> expired; /**< Scratch storage for expired packets, while tracing */
+    std::vector<Packet> dropped; /**< Scratch storage for packets dropped by queue management */
+    TraceBuffer* trace;          /**< Buffer receiving the packet events, or nullptr */
+
+    AgingBloomFilter doomedPages;      /**< Pages that lost a packet, whose rest is dropped early */
+    std::vector<uint64_t> dropNotices; /**< Pages of other sources doomed here since last taken */
 
     size_t packetsReceived;  /**< Total packets received */
     size_t packetsDropped;   /**< Total packets dropped due to buffer overflow or no route */
     size_t packetsTimedOut;  /**< Total packets dropped due to expiration while in the buffers */
     size_t packetsForwarded; /**< Total packets forwarded */
     size_t packetsDelivered; /**< Total packets delivered to local terminals */
+    size_t packetsDoomed;    /**< Total packets of doomed pages dropped early */
+
+    TrafficCounters terminalTotals; /**< Running totals of the connected terminals */
 
 public:
     /**
@@ -141,6 +217,8 @@ public:
      * @param ip Router's IP address (must have terminalID = 0).
      * @param terminals Number of terminals to initialize (default 0).
      * @param cfg Configuration struct for bandwidth and buffer settings (optional).
+     * @throws std::invalid_argument if the IP is not a router IP or the output queue
+     * configuration is invalid.
      */
     explicit Router(IPAddress ip, size_t terminals = 0, const Config& cfg = Config{});
 
@@ -202,11 +280,23 @@ public:
      */
     bool receivePacket(const Packet& packet);
 
+    /**
+     * @brief Receives a batch of packets from the network and enqueues them in the input buffer
+     * with a single capacity check. Packets that do not fit are dropped.
+     *
+     * @param packets The packets to receive, in arrival order.
+     * @return Number of packets buffered; the rest of the batch was dropped.
+     */
+    size_t receivePackets(std::span<const Packet> packets);
+
     // =============== Processing ===============
     /**
      * @brief Processes packets in output buffers for neighbor routers, sending them out and
      * updating statistics.
      *
+     * Packets for a link marked as staged (see setLinkStaged()) are moved into its outbox, as
+     * stageOutputBuffers() does, and reach the neighbor when it calls collectInbound().
+     *
      * @param currentTick The current system tick for processing timeouts and expirations.
      * @return Total number of packets sent to neighbor routers.
      */
@@ -246,6 +336,51 @@ public:
      */
     void tick(size_t currentTick);
 
+    /**
+     * @brief Moves packets from the output buffers into the per-neighbor outboxes, applying the
+     * same bandwidth and timeout rules as processOutputBuffers() but without touching the
+     * neighbors. The packets reach the neighbors when they call collectInbound().
+     *
+     * @param currentTick The current system tick for processing timeouts and expirations.
+     * @return Total number of packets staged for neighbor routers.
+     */
+    size_t stageOutputBuffers(size_t currentTick);
+
+    /**
+     * @brief Runs the compute phase of a two-phase tick: stages the output buffers, then processes
+     * the local buffer, terminals and input buffer as tick() does.
+     *
+     * Only this router and its terminals are modified, so the compute phase of different routers
+     * can run concurrently.
+     *
+     * @param currentTick The current system tick for processing timeouts and expirations.
+     */
+    void tickCompute(size_t currentTick);
+
+    /**
+     * @brief Runs the exchange phase of a two-phase tick: pulls the packets every neighbor staged
+     * for this router into the input buffer, and empties those outboxes.
+     *
+     * Each outbox is read by exactly one receiver, so the exchange phase of different routers can
+     * run concurrently once every compute phase has finished. A link with a ring (see
+     * setLinkRings()) only needs its own sender to have finished the compute phase of the tick
+     * being collected, and may already be sending the next one.
+     *
+     * @return Total number of packets pulled from neighbor routers.
+     */
+    size_t collectInbound();
+
+    /**
+     * @brief Gets the next tick at which ticking the router can change its state or that of its
+     * terminals, for discrete-event simulation.
+     *
+     * @param currentTick Last tick the router was ticked at.
+     * @return currentTick + 1 while any of its buffers holds packets; otherwise the earliest
+     * activity of its terminals, or Terminal::NO_ACTIVITY if there is none. Packets arriving from
+     * neighbors are not foreseen.
+     */
+    [[nodiscard]] size_t nextActivityTick(size_t currentTick) const;
+
     // =============== Configuration ===============
     /**
      * @brief Sets the input processing capacity of the router.
@@ -269,13 +404,101 @@ public:
     void setOutBufferBW(size_t bw) noexcept;
 
     /**
-     * @brief Sets the routing table for the router.
+     * @brief Sets the queueing discipline and traffic classes of every output buffer, and resets
+     * their class counters.
+     *
+     * @param config New output queue configuration.
+     * @throws std::invalid_argument if the configuration is invalid, or an output buffer still
+     * holds packets.
+     */
+    void setOutputQueue(const QueueConfig& config);
+
+    /**
+     * @brief Enables or disables the early drop of doomed pages.
+     *
+     * A page is doomed once the router drops one of its packets, since the destination can no
+     * longer reassemble it. The router remembers doomed pages in an AgingBloomFilter and drops
+     * their remaining packets as they arrive instead of forwarding them, and records a drop
+     * notice for the router of the page's source (see getDropNotices()). A false positive of the
+     * filter drops a packet of a healthy page, with a probability of about 0.5%.
+     *
+     * @param bits Bits of each generation of the filter (0 disables the early drop and forgets
+     * every doomed page).
+     */
+    void setDoomedPageFilter(size_t bits);
+
+    /**
+     * @brief Marks a page as doomed, so its packets are dropped as they arrive. Does nothing
+     * while the early drop is disabled.
+     *
+     * @param pageKey Key of the page, as built by Terminal::makePageKey().
+     */
+    void markPageDoomed(uint64_t pageKey);
+
+    /**
+     * @brief Forgets the drop notices returned by getDropNotices().
+     */
+    void clearDropNotices() noexcept;
+
+    /**
+     * @brief Sets the routing table for the router, and translates its next hops into neighbor
+     * slots so that forwarding a packet takes two array lookups.
      *
      * @param table New routing table to use for packet forwarding.
      */
-    void setRoutingTable(RoutingTable&& table) noexcept;
+    void setRoutingTable(RoutingTable&& table);
+
+    /**
+     * @brief Enables or disables eager expiry in every buffer of the router and its terminals.
+     * With eager expiry, expired packets are purged at the start of each tick instead of when they
+     * reach the front of their buffer.
+     *
+     * @param enabled true to purge expired packets every tick, false for lazy expiry.
+     */
+    void setEagerExpiry(bool enabled);
+
+    /**
+     * @brief Sets the buffer that records the packet events of the router and its terminals.
+     *
+     * Packets a router drops on arrival are recorded by the receiving router, so each buffer is
+     * only written by the thread ticking its router.
+     *
+     * @param buffer Trace buffer, or nullptr to stop tracing.
+     */
+    void setTraceBuffer(TraceBuffer* buffer);
+
+    /**
+     * @brief Marks the link to a neighbor as staged or direct for processOutputBuffers().
+     *
+     * Packets sent over a staged link wait in its outbox until the neighbor collects them, so a
+     * neighbor ticked by another thread is never written to during the compute phase. A
+     * partitioned network stages exactly the links that cross a partition boundary.
+     *
+     * @param neighborIP IP address of the neighbor router.
+     * @param staged true to stage the packets for the neighbor, false to deliver them directly.
+     * @throws std::invalid_argument if the router is not connected to the neighbor.
+     */
+    void setLinkStaged(IPAddress neighborIP, bool staged);
+
+    /**
+     * @brief Gives every staged link a lock-free ring sized for two ticks of output bandwidth, or
+     * takes the rings away. Existing rings are emptied and resized, so this must be called
+     * between ticks, before a pipelined run and after any change of the output bandwidth.
+     *
+     * @param enabled true to stage packets into rings, false to go back to the outboxes.
+     */
+    void setLinkRings(bool enabled);
 
     // =============== Getters ===============
+    /**
+     * @brief Checks whether the link to a neighbor is staged.
+     *
+     * @param neighborIP IP address of the neighbor router.
+     * @return true if packets for the neighbor are staged, false if they are delivered directly
+     * or the neighbor is not connected.
+     */
+    [[nodiscard]] bool isLinkStaged(IPAddress neighborIP) const noexcept;
+
 
     /**
      * @brief Gets the IP address of the router.
@@ -298,6 +521,13 @@ public:
      */
     [[nodiscard]] size_t getRouterCount() const noexcept;
 
+    /**
+     * @brief Gets the routing table installed by the last route recalculation.
+     *
+     * @return Router's routing table.
+     */
+    [[nodiscard]] const RoutingTable& getRoutingTable() const noexcept;
+
     /**
      * @brief Gets the input processing capacity of the router.
      *
@@ -319,6 +549,43 @@ public:
      */
     [[nodiscard]] size_t getOutBufferBW() const noexcept;
 
+    /**
+     * @brief Gets the queueing discipline and traffic classes of the output buffers.
+     *
+     * @return Output queue configuration.
+     */
+    [[nodiscard]] const QueueConfig& getOutputQueue() const noexcept;
+
+    /**
+     * @brief Gets the running totals of each traffic class over all output buffers.
+     *
+     * @return Counters of each class, by class (a single class with FIFO).
+     */
+    [[nodiscard]] std::vector<ClassCounters> getClassCounters() const;
+
+    /**
+     * @brief Gets the size of the doomed page filter.
+     *
+     * @return Bits of each generation of the filter, or 0 if the early drop is disabled.
+     */
+    [[nodiscard]] size_t getDoomedFilterBits() const noexcept;
+
+    /**
+     * @brief Gets the pages with a source behind another router that this router doomed since
+     * the drop notices were last cleared. Delivering them to the source router with
+     * markPageDoomed() stops the rest of each page at its first hop.
+     *
+     * @return Keys of the doomed pages, as built by Terminal::makePageKey().
+     */
+    [[nodiscard]] std::span<const uint64_t> getDropNotices() const noexcept;
+
+    /**
+     * @brief Checks if eager expiry is enabled.
+     *
+     * @return true if expired packets are purged every tick, false otherwise.
+     */
+    [[nodiscard]] bool hasEagerExpiry() const noexcept;
+
     /**
      * @brief Gets the total number of packets that have been received by the router.
      *
@@ -355,6 +622,29 @@ public:
      */
     [[nodiscard]] size_t getPacketsDelivered() const noexcept;
 
+    /**
+     * @brief Gets the total number of packets of doomed pages dropped early. They are included in
+     * getPacketsDropped().
+     *
+     * @return Total packets dropped because their page was doomed.
+     */
+    [[nodiscard]] size_t getPacketsDoomed() const noexcept;
+
+    /**
+     * @brief Gets the running totals of the router's terminals, which the terminals update as
+     * they create, send, lose and reassemble packets.
+     *
+     * @return Totals over every terminal built for this router.
+     */
+    [[nodiscard]] TrafficCounters& getTerminalTotals() noexcept;
+
+    /**
+     * @brief Gets the running totals of the router's terminals.
+     *
+     * @return Totals over every terminal built for this router.
+     */
+    [[nodiscard]] const TrafficCounters& getTerminalTotals() const noexcept;
+
     /**
      * @brief Gets the number of packets currently pending in the input buffer.
      *
@@ -362,6 +652,14 @@ public:
      */
     [[nodiscard]] size_t getPacketsInPending() const noexcept;
 
+    /**
+     * @brief Checks if the input buffer has anything left to process, including expirations not
+     * reported yet.
+     *
+     * @return true if the next tick of the router has input to handle.
+     */
+    [[nodiscard]] bool hasPendingInput() const noexcept;
+
     /**
      * @brief Gets the total number of packets currently pending in all output buffers for neighbor
      * routers.
@@ -410,6 +708,15 @@ public:
      */
     [[nodiscard]] List<const Terminal*> getTerminals() const noexcept;
 
+    /**
+     * @brief Visits every connected terminal without building an intermediate list.
+     *
+     * @tparam Visitor Callable invocable as `visitor(const Terminal& terminal)`.
+     * @param visitor Callable invoked once per connected terminal.
+     */
+    template <typename Visitor>
+    void forEachTerminal(Visitor&& visitor) const;
+
     /**
      * @brief Gets the IP addresses of all connected neighbor routers.
      *
@@ -417,6 +724,16 @@ public:
      */
     [[nodiscard]] List<IPAddress> getNeighborIPs() const;
 
+    /**
+     * @brief Visits every connected neighbor router without building an intermediate list.
+     *
+     * @tparam Visitor Callable invocable as `visitor(IPAddress neighborIP, size_t bufferUsage)`.
+     * @param visitor Callable invoked once per neighbor with its IP address and the current size
+     * of the output buffer towards it.
+     */
+    template <typename Visitor>
+    void forEachNeighbor(Visitor&& visitor) const;
+
     /**
      * @brief Gets the IP addresses of all connected terminals.
      *
@@ -431,16 +748,16 @@ public:
      * @param terminalIPs Pointer to the list of terminal IP addresses to share with connected
      * terminals.
      */
-    void shareAddressBook(List<IPAddress>* terminalIPs);
+    void shareAddressBook(const std::vector<IPAddress>* terminalIPs);
 
     /**
      * @brief Shares the random number generator with all connected terminals by setting their
-     * random generator pointer to the provided std::mt19937 pointer.
+     * random generator pointer to the provided Xoshiro256 pointer.
      *
-     * @param r_gen Pointer to the std::mt19937 random number generator to share with connected
+     * @param r_gen Pointer to the Xoshiro256 random number generator to share with connected
      * terminals.
      */
-    void shareRandomGenerator(std::mt19937* r_gen);
+    void shareRandomGenerator(Xoshiro256* r_gen);
 
     /**
      * @brief Shares the traffic generation probability with all connected terminals by setting
@@ -451,6 +768,14 @@ public:
      */
     void shareTrafficProbability(float probability);
 
+    /**
+     * @brief Shares a traffic model with all connected terminals, each of which receives its own
+     * copy made with TrafficModel::clone().
+     *
+     * @param model Prototype of the traffic model to share with connected terminals.
+     */
+    void shareTrafficModel(const TrafficModel& model);
+
     /**
      * @brief Shares the maximum page length for traffic generation with all connected terminals by
      * setting their max page length to the provided value.
@@ -459,6 +784,28 @@ public:
      */
     void shareMaxPageLength(size_t pageLen);
 
+    // =============== Checkpoints ===============
+    /**
+     * @brief Writes the live state of the router: its neighbors, every buffer, the counters, the
+     * terminal totals, the routing table and the state of each terminal.
+     *
+     * Outboxes are not written; they are only filled within a tick.
+     *
+     * @param out Checkpoint being written.
+     */
+    void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Replaces the live state of the router and its terminals with the state written by
+     * saveState(). The router must have the same terminals and the neighbors in the same
+     * connection order; its configuration, expiry mode and shared settings are kept.
+     *
+     * @param in Checkpoint being read.
+     * @throws std::runtime_error if the checkpoint is truncated, was written by a router with
+     * other neighbors or terminals, or holds more packets than a buffer can take.
+     */
+    void restoreState(CheckpointReader& in);
+
     // =============== Utilities ===============
     /**
      * @brief Gets string representation.
@@ -481,19 +828,105 @@ private:
     // =============== Private Helpers ===============
     /**
      * @brief Initializes a specified number of terminals with sequential terminal IDs. The
-     * terminals are added to the list of terminals.
+     * terminals are constructed side by side in one block owned by the router.
      *
      * @param count Number of terminals to initialize.
      */
     void initializeTerminals(size_t count);
 
     /**
-     * @brief Gets a pointer to the output buffer for a specific neighbor router.
+     * @brief Gets the slot of a neighbor router.
+     *
+     * @param neighborIP IP address of the neighbor router.
+     * @return Index of the connection to the neighbor, or NO_SLOT if it is not connected.
+     */
+    [[nodiscard]] uint16_t slotOf(IPAddress neighborIP) const noexcept;
+
+    /**
+     * @brief Gets a connected terminal by its IP address.
      *
-     * @param nextIP IP address of the neighbor router.
-     * @return Pointer to the output buffer, or nullptr if neighbor not found.
+     * @param ip IP address of the terminal.
+     * @return Pointer to the terminal, or nullptr if no terminal with that IP is connected.
      */
-    PacketBuffer* getOutputBuffer(IPAddress nextIP);
+    [[nodiscard]] Terminal* terminalAt(IPAddress ip) const noexcept;
+
+    /**
+     * @brief Gets a view of the connected terminals, skipping the unused terminal IDs.
+     *
+     * @return View of the non-null terminal pointers, in terminal ID order.
+     */
+    [[nodiscard]] auto connectedTerminals() const noexcept;
+
+    /**
+     * @brief Rebuilds the next-hop slot of every destination from the routing table and the
+     * current connections, and with a multipath table the slots of every usable next hop.
+     */
+    void rebuildRouteSlots();
+
+    /**
+     * @brief Picks the next hop of a packet among the equal-cost paths to its destination.
+     *
+     * The choice hashes the page key, so every packet of a page takes the same path and arrives
+     * in order, while the pages spread over the paths. The hash is salted with the router ID so
+     * that routers along the way do not all pick the same path index.
+     *
+     * @param packet Packet to forward.
+     * @param paths Number of usable paths (at least 1).
+     * @return Index of the path, below paths.
+     */
+    [[nodiscard]] size_t pathOf(const Packet& packet, size_t paths) const noexcept;
+
+    /**
+     * @brief Moves the packets a link may send this tick from its output buffer into its outbox.
+     *
+     * @param conn Connection to stage.
+     * @param currentTick The current system tick for processing timeouts and expirations.
+     * @return Number of packets staged.
+     */
+    size_t stageConnection(RtrConnection& conn, size_t currentTick);
+
+    /**
+     * @brief Purges the expired packets of the router's buffers when eager expiry is enabled,
+     * counting them as timed out.
+     *
+     * @param currentTick The current system tick for processing expirations.
+     */
+    void purgeExpiredPackets(size_t currentTick);
+
+    /**
+     * @brief Records the packets collected in the expired scratch storage as timed out, and
+     * empties it.
+     */
+    void traceExpired();
+
+    /**
+     * @brief Records a packet event if tracing is enabled.
+     *
+     * @param type What happened to the packet.
+     * @param packet Packet the event is about.
+     */
+    void traceEvent(TraceEventType type, const Packet& packet);
+
+    /**
+     * @brief Drops a packet: counts and records the drop, and dooms its page.
+     *
+     * @param packet Packet being dropped.
+     */
+    void dropPacket(const Packet& packet);
+
+    /**
+     * @brief Dooms the page of a lost packet when the early drop is enabled, recording a drop
+     * notice if the page comes from another router.
+     *
+     * @param packet Packet that was lost.
+     */
+    void doomPage(const Packet& packet);
+
+    /**
+     * @brief Drops the packets collected in the dropped scratch storage by queue management, and
+     * empties it.
+     */
+    void dropManagedPackets();
 
     /**
      * @brief Routes a single packet to appropriate destination.
@@ -531,8 +964,10 @@ inline void Router::setOutBufferBW(size_t bw) noexcept {
     outBufferBW = bw;
 }
 
-inline void Router::setRoutingTable(RoutingTable&& table) noexcept {
-    routingTable = table;
+inline void Router::traceEvent(TraceEventType type, const Packet& packet) {
+    if (trace) {
+        trace->record(type, packet, routerIP);
+    }
 }
 
 inline IPAddress Router::getIP() const noexcept {
@@ -540,13 +975,17 @@ inline IPAddress Router::getIP() const noexcept {
 }
 
 inline size_t Router::getTerminalCount() const noexcept {
-    return terminals.size();
+    return terminalCount;
 }
 
 inline size_t Router::getRouterCount() const noexcept {
     return connections.size();
 }
 
+inline const RoutingTable& Router::getRoutingTable() const noexcept {
+    return routingTable;
+}
+
 inline size_t Router::getInProcCap() const noexcept {
     return inProcCap;
 }
@@ -559,6 +998,14 @@ inline size_t Router::getOutBufferBW() const noexcept {
     return outBufferBW;
 }
 
+inline const QueueConfig& Router::getOutputQueue() const noexcept {
+    return outQueue;
+}
+
+inline bool Router::hasEagerExpiry() const noexcept {
+    return eagerExpiry;
+}
+
 inline size_t Router::getPacketsReceived() const noexcept {
     return packetsReceived;
 }
@@ -579,10 +1026,38 @@ inline size_t Router::getPacketsDelivered() const noexcept {
     return packetsDelivered;
 }
 
+inline size_t Router::getPacketsDoomed() const noexcept {
+    return packetsDoomed;
+}
+
+inline size_t Router::getDoomedFilterBits() const noexcept {
+    return doomedPages.getBitCount();
+}
+
+inline std::span<const uint64_t> Router::getDropNotices() const noexcept {
+    return dropNotices;
+}
+
+inline void Router::clearDropNotices() noexcept {
+    dropNotices.clear();
+}
+
+inline TrafficCounters& Router::getTerminalTotals() noexcept {
+    return terminalTotals;
+}
+
+inline const TrafficCounters& Router::getTerminalTotals() const noexcept {
+    return terminalTotals;
+}
+
 inline size_t Router::getPacketsInPending() const noexcept {
     return inBuffer.size();
 }
 
+inline bool Router::hasPendingInput() const noexcept {
+    return !inBuffer.isDrained();
+}
+
 inline size_t Router::getPacketsLocPending() const noexcept {
     return locBuffer.size();
 }
@@ -590,3 +1065,34 @@ inline size_t Router::getPacketsLocPending() const noexcept {
 inline size_t Router::getLocalBufferUsage() const noexcept {
     return locBuffer.size();
 }
+
+inline uint16_t Router::slotOf(IPAddress neighborIP) const noexcept {
+    const size_t id = neighborIP.getRouterIP();
+    return id < slotByRouter.size() ? slotByRouter[id] : NO_SLOT;
+}
+
+inline Terminal* Router::terminalAt(IPAddress ip) const noexcept {
+    const size_t id = ip.getTerminalIP();
+    if (ip.getRouterIP() != routerIP.getRouterIP() || id >= terminals.size()) {
+        return nullptr;
+    }
+    return terminals[id];
+}
+
+inline auto Router::connectedTerminals() const noexcept {
+    return terminals | std::views::filter([](const Terminal* t) { return t != nullptr; });
+}
+
+template <typename Visitor>
+void Router::forEachTerminal(Visitor&& visitor) const {
+    for (const auto& terminal : connectedTerminals()) {
+        visitor(static_cast<const Terminal&>(*terminal));
+    }
+}
+
+template <typename Visitor>
+void Router::forEachNeighbor(Visitor&& visitor) const {
+    for (const RtrConnection& conn : connections) {
+        visitor(conn.outBuffer.getDstIP(), conn.outBuffer.size());
+    }
+}
@@ -1,58 +1,173 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "IPAddress.h"
-#include "structures/list.h"
 
 /**
  * @class RoutingTable
  * @brief Represents a routing table for a network router, mapping destination router IPs to next
  * hop IPs.
  *
- * The routing table maintains a list of entries, where each entry consists of a destination router
- * IP and the corresponding next hop IP address to reach that destination. The class provides
- * methods to retrieve and set next hop IPs for given destination IPs, as well as to get the number
- * of entries in the routing table.
+ * The routing table is a dense array indexed by the router ID of the destination, so both lookups
+ * and updates are a single array access. Each slot holds the next hop IP address used to reach
+ * that destination router, or is marked empty when no route exists. The class provides methods to
+ * retrieve and set next hop IPs for given destination IPs, as well as to get the number of entries
+ * in the routing table.
+ *
+ * A destination may also hold up to MAX_PATHS equal-cost next hops for multipath forwarding. The
+ * first one is the primary next hop returned by getNextHopIP(); the others are kept in a separate
+ * array, allocated by the first addNextHopIP(), so single-path tables pay nothing for them.
  */
 class RoutingTable {
+public:
+    static constexpr size_t MAX_PATHS = 8; /**< Most next hops a destination can hold */
+
+private:
     /**
-     * @struct Routes
-     * @brief Represents a routing entry mapping a destination router IP to a next hop IP.
+     * @struct Route
+     * @brief Represents the routing entry for one destination router ID.
      */
-    struct Routes {
-        IPAddress destRouterIP; /**< Neighbor router IP address */
-        IPAddress nextHopIP;    /**< Next hop router IP address to reach destination */
+    struct Route {
+        IPAddress nextHopIP; /**< Primary next hop router IP address to reach the destination */
+        uint8_t pathCount;   /**< Number of next hops, or 0 if this slot holds no route */
     };
 
-    List<Routes> entries; /**< List of routing entries */
+    std::vector<Route> routes;         /**< Routing entries indexed by destination router ID */
+    std::vector<IPAddress> alternates; /**< Next hops after the primary, MAX_PATHS - 1 per slot */
+    size_t routeCount = 0;             /**< Number of slots holding a route */
 
 public:
+    /**
+     * @brief Default constructor, creates an empty routing table.
+     */
+    RoutingTable() = default;
+
+    /**
+     * @brief Creates an empty routing table with slots preallocated for router IDs below
+     * @p routerIDs, so that filling it does not reallocate.
+     *
+     * @param routerIDs Number of router IDs to preallocate.
+     */
+    explicit RoutingTable(size_t routerIDs);
+
     /**
      * @brief Retrieves the next hop IP for a given destination IP.
      *
-     * @param destIP Destination IP address.
+     * @param destIP Destination IP address (only its router ID is used).
      * @return Next hop IP address if found, or an invalid IP if no route exists for the
      * destination.
      */
-    IPAddress getNextHopIP(IPAddress destIP);
+    [[nodiscard]] IPAddress getNextHopIP(IPAddress destIP) const noexcept;
+
+    /**
+     * @brief Retrieves one of the next hops for a given destination IP.
+     *
+     * @param destIP Destination IP address (only its router ID is used).
+     * @param path Index of the next hop, below getPathCount() (0 is the primary next hop).
+     * @return Next hop IP address, or an invalid IP if the destination has no such next hop.
+     */
+    [[nodiscard]] IPAddress getNextHopIP(IPAddress destIP, size_t path) const noexcept;
 
     /**
      * @brief Sets the next hop IP for a given destination IP. If an entry for the destination
-     * already exists, it updates the next hop IP. If no entry exists, it adds a new routing entry
-     * to the table.
+     * already exists, it updates the next hop IP and drops its other next hops. If no entry
+     * exists, it adds a new routing entry to the table.
      *
-     * @param destIP Destination IP address.
+     * @param destIP Destination IP address (only its router ID is used).
      * @param nextHop Next hop IP address.
      */
     void setNextHopIP(IPAddress destIP, IPAddress nextHop);
 
+    /**
+     * @brief Adds a next hop for a given destination IP, after the ones it already holds. Adds a
+     * new routing entry if the destination has none.
+     *
+     * @param destIP Destination IP address (only its router ID is used).
+     * @param nextHop Next hop IP address.
+     * @return true if the next hop was added, false if the destination already holds it or
+     * already holds MAX_PATHS next hops.
+     */
+    bool addNextHopIP(IPAddress destIP, IPAddress nextHop);
+
+    /**
+     * @brief Gets the number of next hops held for a given destination IP.
+     *
+     * @param destIP Destination IP address (only its router ID is used).
+     * @return Number of next hops, or 0 if no route exists for the destination.
+     */
+    [[nodiscard]] size_t getPathCount(IPAddress destIP) const noexcept;
+
+    /**
+     * @brief Checks whether any destination may hold more than one next hop.
+     *
+     * @return true once addNextHopIP() has added a second next hop to the table.
+     */
+    [[nodiscard]] bool isMultipath() const noexcept;
+
+    /**
+     * @brief Checks whether a route exists for a given destination IP.
+     *
+     * @param destIP Destination IP address (only its router ID is used).
+     * @return true if the table holds a next hop for the destination router, false otherwise.
+     */
+    [[nodiscard]] bool hasRoute(IPAddress destIP) const noexcept;
+
+    /**
+     * @brief Removes every route, keeping the allocated slots for reuse.
+     */
+    void clear() noexcept;
+
     /**
      * @brief Gets the number of routing entries currently stored in the routing table.
      *
      * @return Number of routing entries in the table.
      */
-    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Gets the number of router IDs the table has slots for.
+     *
+     * @return One past the highest destination router ID the table can hold without growing.
+     */
+    [[nodiscard]] size_t getRouterIDCount() const noexcept;
 };
 
-inline size_t RoutingTable::size() const {
-    return entries.size();
+inline IPAddress RoutingTable::getNextHopIP(IPAddress destIP) const noexcept {
+    const size_t id = destIP.getRouterIP();
+    if (id < routes.size() && routes[id].pathCount > 0) {
+        return routes[id].nextHopIP;
+    }
+    return {};  // Return invalid IP if not found
+}
+
+inline IPAddress RoutingTable::getNextHopIP(IPAddress destIP, size_t path) const noexcept {
+    const size_t id = destIP.getRouterIP();
+    if (id >= routes.size() || path >= routes[id].pathCount) {
+        return {};
+    }
+    return path == 0 ? routes[id].nextHopIP : alternates[id * (MAX_PATHS - 1) + path - 1];
+}
+
+inline bool RoutingTable::hasRoute(IPAddress destIP) const noexcept {
+    const size_t id = destIP.getRouterIP();
+    return id < routes.size() && routes[id].pathCount > 0;
+}
+
+inline size_t RoutingTable::getPathCount(IPAddress destIP) const noexcept {
+    const size_t id = destIP.getRouterIP();
+    return id < routes.size() ? routes[id].pathCount : 0;
+}
+
+inline bool RoutingTable::isMultipath() const noexcept {
+    return !alternates.empty();
+}
+
+inline size_t RoutingTable::size() const noexcept {
+    return routeCount;
+}
+
+inline size_t RoutingTable::getRouterIDCount() const noexcept {
+    return routes.size();
 }
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <limits>
+#include <memory>
 #include <numeric>
-#include <random>
+#include <span>
 #include <vector>
 
 #include "PacketBuffer.h"
+#include "PageQueue.h"
 #include "PageReassembler.h"
+#include "TraceEvent.h"
+#include "TrafficCounters.h"
+#include "TrafficModel.h"
+#include "structures/flat_hash_map.h"
+#include "structures/timer_wheel.h"
 
 class Router;  // Forward declaration
 
@@ -26,6 +34,11 @@ public:
     static constexpr size_t DEF_OUT_BUF_CAP = 0;
     /** Default input buffer capacity for the terminal */
     static constexpr size_t DEF_IN_BUF_CAP  = 0;
+    /** Activity tick of a node that will not change state until a packet reaches it */
+    static constexpr size_t NO_ACTIVITY     = std::numeric_limits<size_t>::max();
+
+    /** Identifies a page network-wide: source IP in the upper bits, page ID in the lower 32 */
+    using PageKey = uint64_t;
 
     /**
      * @struct Config
@@ -69,28 +82,27 @@ public:
     };
 
 private:
-    /**
-     * @struct QuarantinedID
-     * @brief Represents a page ID currently quarantined due to an expired reassembler.
-     */
-    struct QuarantinedID {
-        size_t pageID;  /**< ID of the discarded page */
-        size_t timeout; /**< System tick when this quarantine entry expires */
-    };
     /** List of active page reassemblers currently processing incoming packets */
-    using AssemblerList   = std::vector<PageReassembler>;
-    /** List of page IDs that are currently quarantined due to expired reassemblers */
-    using QuarantinedList = std::vector<QuarantinedID>;
+    using AssemblerList = std::vector<PageReassembler>;
+    /** Index of the active reassemblers by page, mapping to their position in the list */
+    using AssemblerMap  = FlatHashMap<PageKey, size_t>;
+    /** Pages currently quarantined due to expired reassemblers, mapped to the quarantine end */
+    using QuarantineMap = FlatHashMap<PageKey, size_t>;
+    /** Terminal IPs of the whole network, shared by every terminal as traffic destinations */
+    using AddressBook   = std::vector<IPAddress>;
 
     IPAddress terminalIP; /**< IP address of the terminal */
     Router* rtrConn;      /**< Pointer to the router connected to the terminal */
 
     PacketBuffer inBuffer;  /**< Queue for incoming packets */
     size_t inProcCap;       /**< Packets per cycle able to process from the input buffer */
-    PacketBuffer outBuffer; /**< Queue for outgoing packets */
+    PageQueue outBuffer;    /**< Outgoing pages, fragmented as the bandwidth drains them */
     size_t outBW;           /**< Packets per cycle able to send to router */
 
-    AssemblerList reassemblers; /**< Active page reassemblers */
+    ReassemblyPool reassemblyPool;         /**< Fragment storage shared by the reassemblers */
+    AssemblerList reassemblers;            /**< Active page reassemblers */
+    AssemblerMap reassemblerIndex;         /**< Position of each active reassembler by page */
+    TimerWheel<PageKey> reassemblerTimers; /**< Expiration ticks of the active reassemblers */
 
     size_t pagesCreated;    /**< Total pages created and sent by this terminal */
     size_t pagesSent;       /**< Total pages sent to router */
@@ -110,12 +122,20 @@ private:
 
     size_t nextPageID; /**< ID for the next page to be sent */
 
-    QuarantinedList quarantine; /**< List of page IDs that are currently quarantined due to expired
-                                   reassemblers */
-    List<IPAddress>* addressBook; /**< Pointer to the network's address book */
-    float trafficProbability;     /**< Probability of generating a page in each tick */
-    size_t maxPageLen;            /**< Maximum number of packets in a page for traffic generation */
-    std::mt19937* m_gen;          /**< Random number generator for traffic generation */
+    QuarantineMap quarantine;             /**< Pages quarantined due to expired reassemblers */
+    TimerWheel<PageKey> quarantineTimers; /**< Expiration ticks of the quarantine entries */
+    const AddressBook* addressBook;        /**< Pointer to the network's address book */
+    float trafficProbability;              /**< Probability of generating a page in each tick */
+    size_t maxPageLen;                     /**< Maximum packets in a page for traffic generation */
+    Xoshiro256* m_gen;                     /**< Random number generator for traffic generation */
+    std::unique_ptr<TrafficModel> traffic; /**< Source of the page emission ticks, if any */
+    bool trafficScheduled;                 /**< Whether nextTrafficTick has been drawn */
+    size_t nextTrafficTick;                /**< Tick of the next page emission, if scheduled */
+
+    std::vector<Packet> batch;   /**< Scratch storage for packets moved out of a buffer */
+    std::vector<Packet> expired; /**< Scratch storage for expired packets, while tracing */
+    TraceBuffer* trace;          /**< Buffer receiving the packet events, or nullptr */
+    TrafficCounters* totals;     /**< Running totals of the router's terminals */
 
 public:
     /**
@@ -125,7 +145,7 @@ public:
      * @param router Pointer to connected router.
      * @param cfg Configuration struct for bandwidth and buffer settings (optional).
      */
-    Terminal(Router* router, uint8_t terminalID, const Config& cfg = Config{});
+    Terminal(Router* router, IPAddress::TerminalID terminalID, const Config& cfg = Config{});
 
     /**
      * @brief Destructor - cleans up all active reassemblers.
@@ -158,11 +178,11 @@ public:
 
     // =============== Transmission ===============
     /**
-     * @brief Creates a page and fragments it into packets for transmission.
+     * @brief Creates a page and queues it for transmission.
      *
      * Checks if the output buffer has enough space for all packets. If not, the page is dropped and
-     * statistics are updated. If successful, packets are enqueued in the output buffer and
-     * statistics are updated.
+     * statistics are updated. If successful, the page is queued whole in the output buffer, which
+     * fragments it into packets as processOutputBuffer() sends them, and statistics are updated.
      *
      * @param length Number of packets on the page (must be > 0).
      * @param destIP Destination IP address.
@@ -181,6 +201,16 @@ public:
      */
     bool receivePacket(const Packet& packet);
 
+    /**
+     * @brief Receives a batch of packets from the network. Without quarantined pages, the batch is
+     * buffered with a single capacity check.
+     *
+     * @param packets The packets to receive, in arrival order.
+     * @return Number of packets buffered; the rest were dropped due to quarantine or input buffer
+     * overflow.
+     */
+    size_t receivePackets(std::span<const Packet> packets);
+
     // =============== Processing ===============
     /**
      * @brief Processes up to internalProc packets from the input buffer, attempting to reassemble
@@ -209,13 +239,26 @@ public:
     void tick(size_t currentTick);
 
     /**
-     * @brief Generates traffic by randomly deciding to create and send a page based on the traffic
-     * probability. If a page is generated, it will have a random length up to maxPageLen and a
-     * random destination IP from the address book.
+     * @brief Emits the pages the traffic model schedules for the current tick. Each page has a
+     * random length up to maxPageLen and a random destination IP from the address book.
+     *
+     * The model is only consulted after an emission, so the terminal sleeps between emissions and
+     * the random draws scale with the pages generated. The schedule starts on the first call, and
+     * restarts if the terminal was not ticked at its scheduled emission.
      *
      * @param currentTick The current system tick for processing timeouts and expirations.
      */
     void generateTraffic(size_t currentTick);
+
+    /**
+     * @brief Gets the next tick at which ticking the terminal can change its state.
+     *
+     * @param currentTick Last tick the terminal was ticked at.
+     * @return currentTick + 1 while packets are buffered or before the traffic schedule starts;
+     * otherwise the earliest page emission, reassembler expiry or quarantine end, or NO_ACTIVITY if
+     * there is none.
+     */
+    [[nodiscard]] size_t nextActivityTick(size_t currentTick) const;
     //  =============== Setters ===============
     /**
      * @brief Sets external bandwidth.
@@ -236,21 +279,30 @@ public:
      *
      * @param addBook Pointer to the network's address book.
      */
-    void setAddressBook(List<IPAddress>* addBook) noexcept;
+    void setAddressBook(const std::vector<IPAddress>* addBook) noexcept;
 
     /**
      * @brief Sets the random number generator for traffic generation.
      *
-     * @param gen Pointer to a std::mt19937 random number generator.
+     * @param gen Pointer to a Xoshiro256 random number generator.
      */
-    void setRandomGenerator(std::mt19937* gen) noexcept;
+    void setRandomGenerator(Xoshiro256* gen) noexcept;
 
     /**
-     * @brief Sets the probability of generating traffic in each tick.
+     * @brief Sets the probability of generating traffic in each tick, installing a
+     * BernoulliTraffic model with it.
      *
      * @param probability New traffic generation probability (0.0 to 1.0).
      */
-    void setTrafficProbability(float probability) noexcept;
+    void setTrafficProbability(float probability);
+
+    /**
+     * @brief Sets the model that decides when the terminal emits pages. The schedule restarts at
+     * the next tick.
+     *
+     * @param model New traffic model (nullptr disables traffic generation).
+     */
+    void setTrafficModel(std::unique_ptr<TrafficModel> model) noexcept;
 
     /**
      * @brief Sets the maximum page length for traffic generation.
@@ -259,6 +311,21 @@ public:
      */
     void setMaxPageLength(size_t pageLen) noexcept;
 
+    /**
+     * @brief Enables or disables eager expiry in the terminal's buffers. With eager expiry,
+     * expired packets are purged at the start of each tick instead of when they are dequeued.
+     *
+     * @param enabled true to purge expired packets every tick, false for lazy expiry.
+     */
+    void setEagerExpiry(bool enabled);
+
+    /**
+     * @brief Sets the buffer that records the packet events of the terminal.
+     *
+     * @param buffer Trace buffer, or nullptr to stop tracing.
+     */
+    void setTraceBuffer(TraceBuffer* buffer) noexcept;
+
     // =============== Getters ===============
     /**
      * @brief Gets the terminal's IP address.
@@ -403,9 +470,29 @@ public:
     /**
      * @brief Gets a pointer to the random number generator used for traffic generation.
      *
-     * @return Pointer to the std::mt19937 random number generator.
+     * @return Pointer to the Xoshiro256 random number generator.
+     */
+    [[nodiscard]] Xoshiro256* getRandomGenerator() const noexcept;
+
+    // =============== Checkpoints ===============
+    /**
+     * @brief Writes the live state of the terminal: both buffers, the counters, the active
+     * reassemblers, the quarantined pages and the traffic schedule, including the state of the
+     * traffic model.
+     *
+     * @param out Checkpoint being written.
+     */
+    void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Replaces the live state of the terminal with the state written by saveState(). The
+     * configuration, traffic model type and shared generator of this terminal are kept.
+     *
+     * @param in Checkpoint being read.
+     * @throws std::runtime_error if the checkpoint is truncated, the packets exceed the buffer
+     * capacities, or only one of the two terminals has a traffic model.
      */
-    [[nodiscard]] std::mt19937* getRandomGenerator() const noexcept;
+    void restoreState(CheckpointReader& in);
 
     /**
      * @brief Generates a string representation of the terminal, including its IP address.
@@ -423,6 +510,15 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& os, const Terminal& terminal);
 
+    /**
+     * @brief Builds the key identifying a page across the network.
+     *
+     * @param srcIP Source IP address of the page.
+     * @param pageID ID of the page.
+     * @return Key combining both values.
+     */
+    [[nodiscard]] static constexpr PageKey makePageKey(IPAddress srcIP, size_t pageID) noexcept;
+
 private:
     // =============== Private helpers ===============
     /**
@@ -440,36 +536,92 @@ private:
                                              size_t timeout);
 
     /**
-     * @brief Handles a completed page by packaging it and updating statistics.
+     * @brief Handles a completed page by finishing its reassembler and updating statistics.
      *
-     * @param pageID ID of the completed page.
-     * @param srcIP Source IP address of the completed page.
+     * @param reassembler Complete reassembler, which is removed from the active list.
      */
-    void handleCompletedPage(size_t pageID, IPAddress srcIP);
+    void handleCompletedPage(PageReassembler* reassembler);
+
+    /**
+     * @brief Removes an active reassembler, moving the last one into its position.
+     *
+     * @param index Position of the reassembler in the active list.
+     */
+    void removeReassembler(size_t index);
 
     /**
      * @brief Cleans up expired reassemblers and updates statistics and quarantine list accordingly.
+     * Only the reassemblers whose timeout is reached are visited.
      *
      * @param currentTick The current system tick for processing expirations.
      */
     void cleanupReassemblers(size_t currentTick);
 
     /**
-     * @brief Updates the quarantine list by removing expired entries.
+     * @brief Updates the quarantine list by removing expired entries. Only the entries whose
+     * timeout is reached are visited.
      *
      * @param currentTick The current system tick for processing expirations.
      */
     void updateQuarantine(size_t currentTick);
 
     /**
-     * @brief Checks if a given page ID is currently quarantined.
+     * @brief Records the packets collected in the expired scratch storage as timed out, and
+     * empties it.
+     */
+    void traceExpired();
+
+    /**
+     * @brief Counts packets timed out on input, in the terminal and in its router's totals.
+     *
+     * @param count Number of packets.
+     */
+    void countInTimedOut(size_t count) noexcept;
+
+    /**
+     * @brief Counts packets dropped on input, in the terminal and in its router's totals.
      *
-     * @param id Page ID to check.
-     * @return true if the page ID is in quarantine, false otherwise.
+     * @param count Number of packets.
      */
-    [[nodiscard]] bool isIDQuarantined(size_t id) const;
+    void countInDropped(size_t count) noexcept;
+
+    /**
+     * @brief Counts packets timed out in the output buffer, in the terminal and in its router's
+     * totals.
+     *
+     * @param count Number of packets.
+     */
+    void countOutTimedOut(size_t count) noexcept;
+
+    /**
+     * @brief Checks if the terminal has what it needs to generate traffic.
+     *
+     * @return true if a traffic model, an address book and a random generator are set and the
+     * book is not empty.
+     */
+    [[nodiscard]] bool canGenerateTraffic() const noexcept;
+
+    /**
+     * @brief Creates and sends one page with a random length and destination.
+     *
+     * @param currentTick The current system tick, used for the page timeout.
+     */
+    void emitPage(size_t currentTick);
+
+    /**
+     * @brief Checks if a given page is currently quarantined.
+     *
+     * @param srcIP Source IP address of the page.
+     * @param pageID ID of the page.
+     * @return true if the page is in quarantine, false otherwise.
+     */
+    [[nodiscard]] bool isQuarantined(IPAddress srcIP, size_t pageID) const;
 };
 
+constexpr Terminal::PageKey Terminal::makePageKey(IPAddress srcIP, size_t pageID) noexcept {
+    return static_cast<PageKey>(srcIP.getRawAddress()) << 32 | static_cast<uint32_t>(pageID);
+}
+
 inline size_t Terminal::getPagesCreated() const noexcept {
     return pagesCreated;
 }
@@ -542,7 +694,7 @@ inline size_t Terminal::getMaxPageLength() const noexcept {
     return maxPageLen;
 }
 
-inline std::mt19937* Terminal::getRandomGenerator() const noexcept {
+inline Xoshiro256* Terminal::getRandomGenerator() const noexcept {
     return m_gen;
 }
 
@@ -566,18 +718,19 @@ inline void Terminal::setInternalProc(size_t capacity) noexcept {
     inProcCap = capacity;
 }
 
-inline void Terminal::setAddressBook(List<IPAddress>* addBook) noexcept {
+inline void Terminal::setAddressBook(const std::vector<IPAddress>* addBook) noexcept {
     addressBook = addBook;
 }
 
-inline void Terminal::setRandomGenerator(std::mt19937* gen) noexcept {
+inline void Terminal::setRandomGenerator(Xoshiro256* gen) noexcept {
     m_gen = gen;
 }
 
-inline void Terminal::setTrafficProbability(float probability) noexcept {
-    trafficProbability = probability;
+inline void Terminal::setTraceBuffer(TraceBuffer* buffer) noexcept {
+    trace = buffer;
 }
 
 inline void Terminal::setMaxPageLength(size_t pageLen) noexcept {
     maxPageLen = pageLen;
+    reassemblyPool.setBlockFragments(pageLen);
 }
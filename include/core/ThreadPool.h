@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that execute data-parallel loops.
+ *
+ * The pool runs one loop at a time through parallelFor(). The index space is split into one
+ * contiguous range per thread, which each thread consumes from the front; a thread that runs out
+ * steals the back half of another thread's remaining range. Threads therefore mostly touch
+ * neighboring indices, while uneven iterations still balance themselves. The calling thread
+ * participates in the loop, so a pool of N threads owns N - 1 workers. parallelFor() is not
+ * reentrant and must not be called concurrently.
+ */
+class ThreadPool {
+    /**
+     * @struct StealRange
+     * @brief Remaining iterations of one thread, packed as `begin << 32 | end` so that the owner
+     * and thieves can update it with a single compare-and-swap. Padded to its own cache line.
+     */
+    struct alignas(64) StealRange {
+        std::atomic<uint64_t> bounds{0}; /**< Packed half-open range of iterations */
+    };
+
+    std::vector<std::thread> workers;     /**< Worker threads, not including the caller */
+    std::unique_ptr<StealRange[]> ranges; /**< Iteration range of every thread, caller first */
+
+    std::mutex mutex;                  /**< Guards the job state below */
+    std::condition_variable jobReady;  /**< Signals workers that a new job was published */
+    std::condition_variable jobDone;   /**< Signals the caller that all workers left the job */
+    size_t generation    = 0;          /**< Incremented for every published job */
+    size_t activeWorkers = 0;          /**< Workers that have not finished the current job */
+    bool stopping        = false;      /**< Set when the pool is being destroyed */
+    std::exception_ptr jobError;       /**< First exception thrown by the current job */
+
+    const std::function<void(size_t)>* jobBody = nullptr; /**< Loop body of the current job */
+    std::atomic<bool> cancelled{false};                   /**< Set once an iteration has thrown */
+
+public:
+    /**
+     * @brief Creates a pool using the given number of threads, including the caller.
+     *
+     * @param threads Total number of threads taking part in each loop; 0 selects the number of
+     * hardware threads. A value of 1 creates no workers and runs loops serially.
+     */
+    explicit ThreadPool(size_t threads = 0);
+
+    /**
+     * @brief Stops and joins all worker threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Deleted copy constructor, the pool owns its threads.
+     */
+    ThreadPool(const ThreadPool&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator, the pool owns its threads.
+     *
+     * @return Reference to this pool.
+     */
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Runs `body(i)` for every `i` in `[0, count)` across the pool and waits for all of
+     * them to finish.
+     *
+     * @param count Number of iterations.
+     * @param body Loop body; iterations may run concurrently and in any order.
+     * @throws std::invalid_argument if count does not fit in 32 bits.
+     * @throws Rethrows the first exception thrown by any iteration, after the loop has drained.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    /**
+     * @brief Gets the number of threads taking part in each loop, including the caller.
+     *
+     * @return Thread count of the pool.
+     */
+    [[nodiscard]] size_t threadCount() const noexcept;
+
+private:
+    /**
+     * @brief Main loop of a worker thread, waits for jobs and runs their iterations.
+     *
+     * @param id Index of the worker's range (1 to threadCount() - 1).
+     */
+    void workerLoop(size_t id);
+
+    /**
+     * @brief Runs iterations from the thread's own range, then steals from the other threads
+     * until no work is left anywhere.
+     *
+     * @param id Index of the calling thread's range (0 for the caller).
+     * @param body Loop body of the current job.
+     */
+    void runIterations(size_t id, const std::function<void(size_t)>& body);
+
+    /**
+     * @brief Takes the first iteration of a thread's own range.
+     *
+     * @param id Index of the range.
+     * @param index Set to the taken iteration.
+     * @return true if an iteration was taken, false if the range is empty.
+     */
+    bool takeOwn(size_t id, size_t& index) noexcept;
+
+    /**
+     * @brief Moves the back half of another thread's remaining range into the thread's own range.
+     *
+     * @param id Index of the stealing thread's range.
+     * @return true if any iterations were stolen, false if every other range is empty.
+     */
+    bool steal(size_t id) noexcept;
+};
+
+inline size_t ThreadPool::threadCount() const noexcept {
+    return workers.size() + 1;
+}
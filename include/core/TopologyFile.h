@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "IPAddress.h"
+#include "MappedFile.h"
+
+/**
+ * @struct TopologyFileHeader
+ * @brief Header at the start of a binary topology file.
+ *
+ * The header is followed by arrays of 32-bit words, in this order: the terminal count of each
+ * router, the router IDs in storage order, the start of each router's neighbors (routerCount + 1
+ * offsets), the neighbor router IDs of every router in connection order (neighborCount entries),
+ * and the next hop router ID of every router towards every destination router (routerCount *
+ * routerCount entries, NO_ROUTE for none). Every array except the storage order is indexed by
+ * router ID, so the file can be used in place once mapped.
+ */
+struct TopologyFileHeader {
+    /** File signature */
+    static constexpr char MAGIC[8]     = {'R', 'S', 'T', 'O', 'P', 'O', '\0', '\0'};
+    /** Current format version */
+    static constexpr uint32_t VERSION  = 1;
+    /** Next hop entry of a destination without route */
+    static constexpr uint32_t NO_ROUTE = UINT32_MAX;
+
+    char magic[8];          /**< Always MAGIC */
+    uint32_t version;       /**< Format version of the file */
+    uint8_t routerBits;     /**< IPAddress::ROUTER_BITS of the simulator that wrote the file */
+    uint8_t terminalBits;   /**< IPAddress::TERMINAL_BITS of the simulator that wrote the file */
+    uint16_t reserved;      /**< Padding, always zero */
+    uint64_t seed;          /**< Seed of the network, which its traffic streams derive from */
+    uint32_t routerCount;   /**< Number of routers */
+    uint32_t neighborCount; /**< Number of neighbor entries, two per link */
+};
+
+static_assert(sizeof(TopologyFileHeader) == 32, "Topology file headers are 32 bytes");
+
+/**
+ * @struct TopologyData
+ * @brief Contents of a topology file, as written by TopologyFile::write().
+ */
+struct TopologyData {
+    uint64_t seed = 0;                    /**< Seed of the network */
+    std::vector<uint32_t> terminalCounts; /**< Terminal count by router ID */
+    std::vector<uint32_t> order;          /**< Router IDs in storage order */
+    std::vector<uint32_t> neighborStarts; /**< Start of each router ID's neighbors, plus the end */
+    std::vector<uint32_t> neighbors;      /**< Neighbor router IDs in connection order */
+    std::vector<uint32_t> nextHops;       /**< Next hop by router ID and destination router ID */
+};
+
+/**
+ * @class TopologyFile
+ * @brief Read-only view of a binary topology file.
+ *
+ * The file is memory-mapped, so opening it costs a header check whatever the network size, and
+ * the arrays are read straight from the page cache. Files only open in a simulator built with the
+ * address layout they were written with.
+ */
+class TopologyFile {
+    MappedFile file;           /**< Mapping of the file */
+    TopologyFileHeader header; /**< Header of the file */
+
+public:
+    /**
+     * @brief Maps a topology file and checks its header, size and neighbor offsets.
+     *
+     * @param path Path of the topology file.
+     * @throws std::runtime_error if the file cannot be opened, is not a topology of this version
+     * and address layout, holds more routers than the layout can address, is truncated, or its
+     * neighbor offsets do not split the neighbor array.
+     */
+    explicit TopologyFile(const std::string& path);
+
+    /**
+     * @brief Destructor, unmaps the file.
+     */
+    ~TopologyFile() = default;
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    TopologyFile(const TopologyFile&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     *
+     * @return Reference to this file.
+     */
+    TopologyFile& operator=(const TopologyFile&) = delete;
+
+    /**
+     * @brief Writes a topology file, replacing any file at the path.
+     *
+     * @param path Path of the topology file.
+     * @param topology Contents to write; the array sizes must match as described in
+     * TopologyFileHeader.
+     * @throws std::invalid_argument if the array sizes do not match the router count.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    static void write(const std::string& path, const TopologyData& topology);
+
+    /**
+     * @brief Gets the seed of the network.
+     *
+     * @return Seed from the header.
+     */
+    [[nodiscard]] uint64_t getSeed() const noexcept;
+
+    /**
+     * @brief Gets the number of routers.
+     *
+     * @return Router count from the header.
+     */
+    [[nodiscard]] size_t getRouterCount() const noexcept;
+
+    /**
+     * @brief Gets the terminal count of each router.
+     *
+     * @return Terminal counts by router ID.
+     */
+    [[nodiscard]] std::span<const uint32_t> terminalCounts() const noexcept;
+
+    /**
+     * @brief Gets the order the routers were stored in.
+     *
+     * @return Router IDs in storage order.
+     */
+    [[nodiscard]] std::span<const uint32_t> order() const noexcept;
+
+    /**
+     * @brief Gets the neighbors of a router, in the order they were connected.
+     *
+     * @param routerID Router ID (below getRouterCount()).
+     * @return Neighbor router IDs.
+     */
+    [[nodiscard]] std::span<const uint32_t> neighbors(size_t routerID) const noexcept;
+
+    /**
+     * @brief Gets the routing table of a router.
+     *
+     * @param routerID Router ID (below getRouterCount()).
+     * @return Next hop router ID by destination router ID, or TopologyFileHeader::NO_ROUTE.
+     */
+    [[nodiscard]] std::span<const uint32_t> nextHops(size_t routerID) const noexcept;
+
+private:
+    /**
+     * @brief Gets an array of the file.
+     *
+     * @param index Position of the array after the header (0 for the terminal counts).
+     * @return Words of the array.
+     */
+    [[nodiscard]] std::span<const uint32_t> section(size_t index) const noexcept;
+};
+
+inline uint64_t TopologyFile::getSeed() const noexcept {
+    return header.seed;
+}
+
+inline size_t TopologyFile::getRouterCount() const noexcept {
+    return header.routerCount;
+}
+
+inline std::span<const uint32_t> TopologyFile::terminalCounts() const noexcept {
+    return section(0);
+}
+
+inline std::span<const uint32_t> TopologyFile::order() const noexcept {
+    return section(1);
+}
+
+inline std::span<const uint32_t> TopologyFile::neighbors(size_t routerID) const noexcept {
+    const std::span<const uint32_t> starts = section(2);
+    return section(3).subspan(starts[routerID], starts[routerID + 1] - starts[routerID]);
+}
+
+inline std::span<const uint32_t> TopologyFile::nextHops(size_t routerID) const noexcept {
+    return section(4).subspan(routerID * header.routerCount, header.routerCount);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "IPAddress.h"
+#include "Packet.h"
+
+/**
+ * @enum TraceEventType
+ * @brief What happened to a packet in a trace event.
+ */
+enum class TraceEventType : uint8_t {
+    Enqueue,      /**< A terminal generated the packet and queued it for sending */
+    Forward,      /**< A router sent the packet to a neighbor */
+    Deliver,      /**< A router handed the packet to its destination terminal */
+    Drop,         /**< The packet was lost to a full buffer, a missing route or a bad address */
+    Timeout,      /**< The packet expired before reaching a reassembler */
+    PageComplete  /**< A terminal finished reassembling the page of the packet */
+};
+
+/**
+ * @struct TraceEvent
+ * @brief Fixed-size binary record of one packet event, as stored in trace files.
+ *
+ * Addresses are raw IPs of the address layout the simulator was built with, so records take 20
+ * bytes with 16-bit addresses and 24 with 32-bit ones. A PageComplete event carries the packet
+ * that completed the page. Packets purged by eager expiry and fragments held by an expired
+ * reassembler are counted in the statistics but not traced.
+ */
+struct TraceEvent {
+    uint32_t tick;            /**< Tick the event took place in */
+    uint32_t pageID;          /**< Page ID of the packet */
+    IPAddress::Raw srcIP;     /**< Source terminal of the packet */
+    IPAddress::Raw dstIP;     /**< Destination terminal of the packet */
+    IPAddress::Raw node;      /**< Router or terminal where the event took place */
+    uint16_t pagePos;         /**< Position of the packet in its page */
+    TraceEventType type;      /**< What happened */
+    /** Padding, always zero */
+    uint8_t reserved[sizeof(IPAddress::Raw) == 2 ? 3 : 1];
+};
+
+static_assert(sizeof(TraceEvent) == (sizeof(IPAddress::Raw) == 2 ? 20 : 24),
+              "Trace events are stored as 20-byte records, or 24 with 32-bit addresses");
+
+/**
+ * @class TraceBuffer
+ * @brief Events recorded by one router and its terminals during the current tick.
+ *
+ * Each router owns its buffer, so routers ticked on different threads record without
+ * synchronization; the network hands the buffers to a TraceWriter once the tick is over.
+ */
+class TraceBuffer {
+    std::vector<TraceEvent> events; /**< Events of the current tick, in recording order */
+    uint32_t tick = 0;              /**< Tick stamped on new events */
+
+public:
+    /**
+     * @brief Sets the tick stamped on the events recorded from now on.
+     *
+     * @param currentTick Current tick.
+     */
+    void setTick(size_t currentTick) noexcept { tick = static_cast<uint32_t>(currentTick); }
+
+    /**
+     * @brief Records an event of a packet.
+     *
+     * @param type What happened to the packet.
+     * @param packet Packet the event is about.
+     * @param node Router or terminal where the event took place.
+     */
+    void record(TraceEventType type, const Packet& packet, IPAddress node) {
+        events.push_back({tick, static_cast<uint32_t>(packet.getPageID()),
+                          packet.getSrcIP().getRawAddress(), packet.getDstIP().getRawAddress(),
+                          node.getRawAddress(), static_cast<uint16_t>(packet.getPagePos()), type,
+                          {}});
+    }
+
+    /**
+     * @brief Records the same event for several packets.
+     *
+     * @param type What happened to the packets.
+     * @param packets Packets the event is about.
+     * @param node Router or terminal where the event took place.
+     */
+    void record(TraceEventType type, std::span<const Packet> packets, IPAddress node) {
+        for (const Packet& packet : packets) {
+            record(type, packet, node);
+        }
+    }
+
+    /**
+     * @brief Gets the recorded events.
+     *
+     * @return Events in recording order.
+     */
+    [[nodiscard]] std::span<const TraceEvent> getEvents() const noexcept { return events; }
+
+    /**
+     * @brief Removes the recorded events, keeping the storage.
+     */
+    void clear() noexcept { events.clear(); }
+};
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TraceEvent.h"
+
+/**
+ * @struct TraceFileHeader
+ * @brief Header at the start of a binary trace file, followed by eventCount TraceEvent records.
+ */
+struct TraceFileHeader {
+    /** File signature */
+    static constexpr char MAGIC[8]    = {'R', 'S', 'T', 'R', 'A', 'C', 'E', '\0'};
+    /** Current format version */
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];       /**< Always MAGIC */
+    uint32_t version;    /**< Format version of the file */
+    uint32_t eventSize;  /**< Size of each record, sizeof(TraceEvent) */
+    uint64_t eventCount; /**< Number of records after the header */
+};
+
+static_assert(sizeof(TraceFileHeader) == 24, "Trace file headers are 24 bytes");
+
+/**
+ * @class TraceWriter
+ * @brief Streams trace events to a binary file from a background thread.
+ *
+ * submit() copies the events into a pending block and returns at once; the writer thread swaps the
+ * block out and copies it into a memory-mapped window of the file, which is grown and remapped one
+ * window at a time. The simulation therefore only pays for a memcpy per tick, while the page cache
+ * takes care of the disk. The header, with the final event count, is written by close().
+ *
+ * The pending block is bounded: when the writer falls behind, submit() waits until the block
+ * has been taken, so a slow disk slows the simulation down instead of growing memory without
+ * limit.
+ */
+class TraceWriter {
+public:
+    /** Events per memory-mapped window of the file */
+    static constexpr size_t WINDOW_EVENTS     = size_t{1} << 16;
+    /** Default number of events that may wait for the writer thread before submit() blocks */
+    static constexpr size_t DEF_PENDING_LIMIT = 4 * WINDOW_EVENTS;
+
+private:
+    int fd;                /**< Descriptor of the trace file */
+    unsigned char* window; /**< Mapped window of the file, or nullptr */
+    uint64_t windowStart;  /**< File offset of the mapped window */
+    uint64_t fileSize;     /**< Current size of the file on disk */
+    uint64_t written;      /**< Events written by the writer thread */
+    uint64_t submitted;    /**< Events handed over by submit() */
+    bool failed;           /**< Whether the writer thread hit an I/O error */
+
+    std::mutex mutex;                /**< Guards pending and closing */
+    std::condition_variable wake;    /**< Signals the writer thread that there is work */
+    std::condition_variable taken;   /**< Signals submit() that the writer took the pending block */
+    std::vector<TraceEvent> pending; /**< Events submitted but not yet taken by the writer */
+    size_t pendingLimit;             /**< Events pending beyond which submit() waits */
+    bool closing;                    /**< Whether close() asked the writer thread to finish */
+    bool closed;                     /**< Whether the file has been closed */
+    std::thread worker;              /**< Writer thread */
+
+public:
+    /**
+     * @brief Creates or truncates a trace file and starts the writer thread.
+     *
+     * @param path Path of the trace file.
+     * @param pendingLimit Events that may wait for the writer thread before submit() blocks.
+     * @throws std::runtime_error if the file cannot be opened.
+     * @throws std::invalid_argument if pendingLimit is 0.
+     */
+    explicit TraceWriter(const std::string& path, size_t pendingLimit = DEF_PENDING_LIMIT);
+
+    /**
+     * @brief Destructor, closes the file if close() was not called.
+     */
+    ~TraceWriter();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    TraceWriter(const TraceWriter&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     *
+     * @return Reference to this writer.
+     */
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * @brief Queues events for writing. Only one thread may submit at a time.
+     *
+     * Waits for the writer thread to take the pending events first if adding these would exceed
+     * the pending limit. A block larger than the limit is queued once nothing else is pending.
+     *
+     * @param events Events to append to the file, in order.
+     */
+    void submit(std::span<const TraceEvent> events);
+
+    /**
+     * @brief Writes the remaining events and the header, stops the writer thread and closes the
+     * file. Later calls do nothing.
+     *
+     * @return true if every submitted event reached the file, false after an I/O error.
+     */
+    bool close();
+
+    /**
+     * @brief Gets the number of events submitted so far.
+     *
+     * @return Events passed to submit().
+     */
+    [[nodiscard]] uint64_t getSubmittedCount() const noexcept;
+
+private:
+    /**
+     * @brief Body of the writer thread: writes pending blocks until closing.
+     */
+    void run();
+
+    /**
+     * @brief Appends events to the file through the mapped windows.
+     *
+     * @param events Events to append.
+     * @return true on success, false on an I/O error.
+     */
+    bool append(std::span<const TraceEvent> events);
+
+    /**
+     * @brief Maps the window holding a file offset, growing the file as needed.
+     *
+     * @param offset File offset that must be mapped.
+     * @return true on success, false on an I/O error.
+     */
+    bool mapWindowAt(uint64_t offset);
+
+    /**
+     * @brief Unmaps the current window, if any.
+     */
+    void unmapWindow() noexcept;
+};
+
+/**
+ * @class TraceReader
+ * @brief Reads the events of a binary trace file in order.
+ */
+class TraceReader {
+    std::ifstream in;       /**< Stream positioned at the next record */
+    TraceFileHeader header; /**< Header of the file */
+    uint64_t remaining;     /**< Records left to read */
+
+public:
+    /**
+     * @brief Opens a trace file and checks its header.
+     *
+     * @param path Path of the trace file.
+     * @throws std::runtime_error if the file cannot be opened or is not a trace of this version.
+     */
+    explicit TraceReader(const std::string& path);
+
+    /**
+     * @brief Reads the next event.
+     *
+     * @param event Event that receives the record.
+     * @return true if an event was read, false at the end of the trace (@p event is untouched).
+     */
+    bool next(TraceEvent& event);
+
+    /**
+     * @brief Gets the number of events in the file.
+     *
+     * @return Event count from the header.
+     */
+    [[nodiscard]] uint64_t getEventCount() const noexcept;
+};
+
+/**
+ * @brief Gets the display name of an event type.
+ *
+ * @param type Event type to name.
+ * @return Lowercase name of the event type, as used in CSV exports.
+ */
+[[nodiscard]] const char* traceEventName(TraceEventType type) noexcept;
+
+inline uint64_t TraceWriter::getSubmittedCount() const noexcept {
+    return submitted;
+}
+
+inline uint64_t TraceReader::getEventCount() const noexcept {
+    return header.eventCount;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @struct TrafficCounters
+ * @brief Running totals of the terminals of one router, updated as the events happen.
+ *
+ * Every router owns one block, written only by the thread ticking that router, and the network
+ * merges the blocks when the statistics are read. Each block sits on its own cache lines, so
+ * routers ticked on different threads never write to a shared line.
+ */
+struct alignas(64) TrafficCounters {
+    size_t pagesCreated   = 0; /**< Pages created */
+    size_t pagesDropped   = 0; /**< Pages dropped on output buffer overflow */
+    size_t pagesCompleted = 0; /**< Pages reassembled */
+    size_t pagesTimedOut  = 0; /**< Pages lost to expired reassemblers */
+
+    size_t packetsGenerated = 0; /**< Packets generated */
+    size_t packetsSent      = 0; /**< Packets sent to the router */
+    size_t packetsDelivered = 0; /**< Packets reassembled into pages */
+    size_t packetsDropped   = 0; /**< Packets dropped on input or output */
+    size_t packetsTimedOut  = 0; /**< Packets expired on input or output, or in reassemblers */
+};
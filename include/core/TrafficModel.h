@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "structures/xoshiro256.h"
+
+class CheckpointReader;
+class CheckpointWriter;
+
+/**
+ * @class TrafficModel
+ * @brief Source of the ticks at which a terminal emits pages.
+ *
+ * A model is asked for its next emission tick only after each emission, so the random draws it
+ * makes scale with the pages generated instead of with the ticks simulated. Each terminal owns its
+ * own model; the network hands out copies made with clone() from a shared prototype. Models keep
+ * state between calls, but draw every random number from the generator they are given.
+ */
+class TrafficModel {
+public:
+    /** Emission tick of a model that will not emit again */
+    static constexpr size_t NEVER = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~TrafficModel() = default;
+
+    /**
+     * @brief Starts, or restarts, the emission schedule.
+     *
+     * @param fromTick First tick at which a page can be emitted.
+     * @param rng Generator to draw from.
+     * @return Tick of the first emission (>= fromTick), or NEVER.
+     */
+    virtual size_t firstEmission(size_t fromTick, Xoshiro256& rng) = 0;
+
+    /**
+     * @brief Gets the tick of the emission following one that just took place.
+     *
+     * @param emittedTick Tick of the emission that just took place.
+     * @param rng Generator to draw from.
+     * @return Tick of the next emission (>= emittedTick; equal for several pages in one tick), or
+     * NEVER.
+     */
+    virtual size_t nextEmission(size_t emittedTick, Xoshiro256& rng) = 0;
+
+    /**
+     * @brief Copies the model with its parameters, for another terminal.
+     *
+     * @return A new model with the same parameters and state.
+     */
+    [[nodiscard]] virtual std::unique_ptr<TrafficModel> clone() const = 0;
+
+    /**
+     * @brief Writes the state the model keeps between calls, for a checkpoint. Parameters are
+     * not written; the default writes nothing, for models without state.
+     *
+     * @param out Checkpoint being written.
+     */
+    virtual void saveState(CheckpointWriter& out) const;
+
+    /**
+     * @brief Restores the state written by saveState() into a model of the same type.
+     *
+     * @param in Checkpoint being read.
+     */
+    virtual void restoreState(CheckpointReader& in);
+};
+
+/**
+ * @class BernoulliTraffic
+ * @brief Emits a page in each tick with a fixed probability.
+ *
+ * Instead of a trial per tick, the number of failed trials before the next success is drawn from
+ * the matching geometric distribution, which yields the same process with one draw per page.
+ */
+class BernoulliTraffic final : public TrafficModel {
+    float probability; /**< Probability of emitting in each tick */
+
+public:
+    /**
+     * @brief Constructor for BernoulliTraffic.
+     *
+     * @param probability Probability of emitting a page in each tick (0.0 to 1.0).
+     */
+    explicit BernoulliTraffic(float probability) noexcept;
+
+    size_t firstEmission(size_t fromTick, Xoshiro256& rng) override;
+    size_t nextEmission(size_t emittedTick, Xoshiro256& rng) override;
+    [[nodiscard]] std::unique_ptr<TrafficModel> clone() const override;
+
+private:
+    /**
+     * @brief Draws the first success at or after a tick.
+     *
+     * @param fromTick First tick of the trials.
+     * @param rng Generator to draw from.
+     * @return fromTick plus the number of failed trials, or NEVER.
+     */
+    size_t drawFrom(size_t fromTick, Xoshiro256& rng) const;
+};
+
+/**
+ * @class PoissonTraffic
+ * @brief Emits pages as a Poisson process with a fixed rate.
+ *
+ * Inter-arrival times are exponential and accumulated in continuous time; each emission takes
+ * place in the tick its arrival time falls in, so a tick can hold several emissions.
+ */
+class PoissonTraffic final : public TrafficModel {
+    double rate;  /**< Expected pages per tick */
+    double clock; /**< Arrival time of the last emission */
+
+public:
+    /**
+     * @brief Constructor for PoissonTraffic.
+     *
+     * @param rate Expected number of pages per tick (>= 0).
+     * @throws std::invalid_argument if the rate is negative.
+     */
+    explicit PoissonTraffic(double rate);
+
+    size_t firstEmission(size_t fromTick, Xoshiro256& rng) override;
+    size_t nextEmission(size_t emittedTick, Xoshiro256& rng) override;
+    [[nodiscard]] std::unique_ptr<TrafficModel> clone() const override;
+    void saveState(CheckpointWriter& out) const override;
+    void restoreState(CheckpointReader& in) override;
+
+private:
+    /**
+     * @brief Advances the arrival clock by an exponential gap.
+     *
+     * @param rng Generator to draw from.
+     * @return Tick of the new arrival, or NEVER.
+     */
+    size_t advance(Xoshiro256& rng);
+};
+
+/**
+ * @class OnOffTraffic
+ * @brief Bursty source alternating between on periods, in which it emits like BernoulliTraffic,
+ * and silent off periods.
+ *
+ * Period lengths are geometric with the given means (at least one tick each), and the source
+ * starts in an off period.
+ */
+class OnOffTraffic final : public TrafficModel {
+    float onProbability; /**< Probability of emitting in each tick of an on period */
+    double meanOn;       /**< Mean length of an on period, in ticks */
+    double meanOff;      /**< Mean length of an off period, in ticks */
+    size_t onStart;      /**< First tick of the current or next on period */
+    size_t onEnd;        /**< First tick after the current or next on period */
+
+public:
+    /**
+     * @brief Constructor for OnOffTraffic.
+     *
+     * @param onProbability Probability of emitting a page in each tick of an on period.
+     * @param meanOn Mean length of an on period, in ticks (>= 1).
+     * @param meanOff Mean length of an off period, in ticks (>= 1).
+     * @throws std::invalid_argument if a mean period length is below one tick.
+     */
+    OnOffTraffic(float onProbability, double meanOn, double meanOff);
+
+    size_t firstEmission(size_t fromTick, Xoshiro256& rng) override;
+    size_t nextEmission(size_t emittedTick, Xoshiro256& rng) override;
+    [[nodiscard]] std::unique_ptr<TrafficModel> clone() const override;
+    void saveState(CheckpointWriter& out) const override;
+    void restoreState(CheckpointReader& in) override;
+
+private:
+    /**
+     * @brief Finds the first emission at or after a tick, drawing new periods as needed.
+     *
+     * @param fromTick First tick at which a page can be emitted.
+     * @param rng Generator to draw from.
+     * @return Tick of the emission, or NEVER if the source never emits.
+     */
+    size_t emitFrom(size_t fromTick, Xoshiro256& rng);
+
+    /**
+     * @brief Draws the length of a period.
+     *
+     * @param mean Mean length of the period.
+     * @param rng Generator to draw from.
+     * @return Length in ticks (>= 1).
+     */
+    static size_t drawPeriod(double mean, Xoshiro256& rng);
+};
+
+/**
+ * @class TraceTraffic
+ * @brief Replays a recorded list of emission ticks.
+ */
+class TraceTraffic final : public TrafficModel {
+    std::vector<size_t> ticks; /**< Emission ticks in ascending order */
+    size_t cursor;             /**< Position of the next emission in ticks */
+
+public:
+    /**
+     * @brief Constructor for TraceTraffic.
+     *
+     * @param ticks Emission ticks; sorted on construction, repeated ticks emit several pages.
+     */
+    explicit TraceTraffic(std::vector<size_t> ticks);
+
+    size_t firstEmission(size_t fromTick, Xoshiro256& rng) override;
+    size_t nextEmission(size_t emittedTick, Xoshiro256& rng) override;
+    [[nodiscard]] std::unique_ptr<TrafficModel> clone() const override;
+    void saveState(CheckpointWriter& out) const override;
+    void restoreState(CheckpointReader& in) override;
+};
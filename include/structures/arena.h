@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @class Arena
+ * @brief A fixed-capacity contiguous block of objects that never move once constructed.
+ *
+ * The storage for every element is allocated up front, aligned to a cache line, and elements are
+ * constructed in place one after another, so objects that cannot be moved (or that other objects
+ * point to) still end up packed side by side in memory. Elements are destroyed in reverse order of
+ * construction when the arena is destroyed or cleared.
+ *
+ * @tparam T The type of the elements stored in the arena.
+ */
+template <typename T>
+class Arena {
+    T* slots;         /**< Raw storage for @c slotCount elements. */
+    size_t slotCount; /**< Number of slots allocated. */
+    size_t count;     /**< Number of elements constructed. */
+
+public:
+    /**
+     * @brief Constructs an arena with storage for a fixed number of elements.
+     *
+     * @param capacity Number of elements the arena can hold (default 0).
+     * @throws std::bad_alloc if the storage cannot be allocated.
+     */
+    explicit Arena(size_t capacity = 0)
+        : slots(allocate(capacity)), slotCount(capacity), count(0) {}
+
+    /**
+     * @brief Destructor, destroys the elements and releases the storage.
+     */
+    ~Arena() {
+        clear();
+        release(slots);
+    }
+
+    /**
+     * @brief Copy constructor - deleted, elements are never relocated.
+     */
+    Arena(const Arena&) = delete;
+
+    /**
+     * @brief Copy assignment operator - deleted, elements are never relocated.
+     *
+     * @return Reference to this arena.
+     */
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Move constructor, takes over the storage without moving the elements.
+     *
+     * @param other Arena to take the storage from; left empty.
+     */
+    Arena(Arena&& other) noexcept
+        : slots(std::exchange(other.slots, nullptr)),
+          slotCount(std::exchange(other.slotCount, 0)),
+          count(std::exchange(other.count, 0)) {}
+
+    /**
+     * @brief Move assignment operator, takes over the storage without moving the elements.
+     *
+     * @param other Arena to take the storage from; left empty.
+     * @return Reference to this arena.
+     */
+    Arena& operator=(Arena&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release(slots);
+            slots     = std::exchange(other.slots, nullptr);
+            slotCount = std::exchange(other.slotCount, 0);
+            count     = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Constructs a new element in place, right after the last one.
+     *
+     * @tparam Args Types of the constructor arguments.
+     * @param args Arguments forwarded to the constructor of @c T.
+     * @return Reference to the new element.
+     * @throws std::length_error if the arena is full.
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (count == slotCount) {
+            throw std::length_error("Arena is full");
+        }
+        T* element = std::construct_at(slots + count, std::forward<Args>(args)...);
+        count++;
+        return *element;
+    }
+
+    /**
+     * @brief Destroys every element, in reverse order of construction, keeping the storage.
+     */
+    void clear() noexcept {
+        while (count > 0) {
+            std::destroy_at(slots + --count);
+        }
+    }
+
+    /**
+     * @brief Accesses an element by index.
+     *
+     * @param index Position of the element.
+     * @return Reference to the element.
+     * @pre @p index < size().
+     */
+    T& operator[](size_t index) noexcept { return slots[index]; }
+
+    /**
+     * @brief Accesses an element by index.
+     *
+     * @param index Position of the element.
+     * @return Const reference to the element.
+     * @pre @p index < size().
+     */
+    const T& operator[](size_t index) const noexcept { return slots[index]; }
+
+    /**
+     * @brief Gets the number of elements constructed.
+     *
+     * @return Number of elements.
+     */
+    [[nodiscard]] size_t size() const noexcept { return count; }
+
+    /**
+     * @brief Gets the number of elements the arena can hold.
+     *
+     * @return Capacity of the arena.
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return slotCount; }
+
+    /**
+     * @brief Checks whether the arena holds no elements.
+     *
+     * @return true if no element has been constructed.
+     */
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+    // =============== Iterators ===============
+    /** @return Pointer to the first element. */
+    T* begin() noexcept { return slots; }
+    /** @return Pointer past the last element. */
+    T* end() noexcept { return slots + count; }
+    /** @return Const pointer to the first element. */
+    const T* begin() const noexcept { return slots; }
+    /** @return Const pointer past the last element. */
+    const T* end() const noexcept { return slots + count; }
+
+private:
+    /**
+     * @brief Gets the alignment of the storage block, at least one cache line. A function rather
+     * than a constant so that arenas can be declared while @c T is still incomplete.
+     *
+     * @return Alignment of the storage.
+     */
+    static constexpr std::align_val_t blockAlign() noexcept {
+        return std::align_val_t{std::max<size_t>(alignof(T), 64)};
+    }
+
+    /**
+     * @brief Allocates cache-line aligned storage for a number of elements.
+     *
+     * @param capacity Number of elements.
+     * @return Pointer to the storage, or nullptr when @p capacity is 0.
+     */
+    static T* allocate(size_t capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+        return static_cast<T*>(::operator new(capacity * sizeof(T), blockAlign()));
+    }
+
+    /**
+     * @brief Releases storage obtained from allocate().
+     *
+     * @param storage Storage to release (may be nullptr).
+     */
+    static void release(T* storage) noexcept {
+        if (storage) {
+            ::operator delete(storage, blockAlign());
+        }
+    }
+};
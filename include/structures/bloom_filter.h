@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @class AgingBloomFilter
+ * @brief Bloom filter of 64-bit keys that forgets old keys by rotating two generations.
+ *
+ * Keys are inserted into the current generation and looked up in both. Once the current
+ * generation holds getGenerationKeys() keys it becomes the previous one and a cleared generation
+ * takes its place, so a key is remembered for at least one full generation and the false positive
+ * rate stays bounded however many keys go through the filter: about 0.5% with 16 bits per key and
+ * HASHES probes. There are no false negatives within the memory of the filter.
+ *
+ * Both generations are arrays of 64-bit words with a power-of-two bit count, so each probe is a
+ * shift and a mask, and the filter never allocates after construction.
+ */
+class AgingBloomFilter {
+public:
+    static constexpr size_t HASHES       = 4;  /**< Bits probed per key */
+    static constexpr size_t BITS_PER_KEY = 16; /**< Bits per key held by a generation */
+
+private:
+    std::vector<uint64_t> current;  /**< Generation receiving the inserted keys */
+    std::vector<uint64_t> previous; /**< Generation before, still looked up */
+    size_t mask;                    /**< Bit count of a generation minus one */
+    size_t inserted;                /**< Keys inserted into the current generation */
+
+public:
+    /**
+     * @brief Constructor for AgingBloomFilter.
+     *
+     * @param bits Bits of each generation, rounded up to a power of two of at least 64 bits (0
+     * builds an empty filter that holds nothing).
+     */
+    explicit AgingBloomFilter(size_t bits = 0)
+        : current(words(bits), 0), previous(current.size(), 0), mask(0), inserted(0) {
+        if (!current.empty()) {
+            mask = current.size() * 64 - 1;
+        }
+    }
+
+    /**
+     * @brief Checks whether the filter holds any bits.
+     *
+     * @return true if keys can be inserted, false for an empty filter.
+     */
+    [[nodiscard]] bool isEnabled() const noexcept { return !current.empty(); }
+
+    /**
+     * @brief Gets the number of bits of each generation.
+     *
+     * @return Bits per generation (0 for an empty filter).
+     */
+    [[nodiscard]] size_t getBitCount() const noexcept { return current.size() * 64; }
+
+    /**
+     * @brief Gets the number of keys a generation holds before it is rotated out.
+     *
+     * @return Keys per generation.
+     */
+    [[nodiscard]] size_t getGenerationKeys() const noexcept {
+        return std::max<size_t>(getBitCount() / BITS_PER_KEY, 1);
+    }
+
+    /**
+     * @brief Checks whether a key may have been inserted.
+     *
+     * @param key Key to look up.
+     * @return true if the key was inserted within the memory of the filter, or on a false
+     * positive; false if it was not inserted, or the filter is empty.
+     */
+    [[nodiscard]] bool contains(uint64_t key) const noexcept {
+        if (!isEnabled()) {
+            return false;
+        }
+        const uint64_t h = hash(key);
+        return test(current, h) || test(previous, h);
+    }
+
+    /**
+     * @brief Inserts a key, rotating the generations when the current one is full.
+     *
+     * @param key Key to insert.
+     * @pre The filter is enabled.
+     */
+    void insert(uint64_t key) noexcept {
+        if (inserted == getGenerationKeys()) {
+            previous.swap(current);
+            std::fill(current.begin(), current.end(), 0);
+            inserted = 0;
+        }
+
+        const uint64_t h = hash(key);
+        for (size_t i = 0; i < HASHES; i++) {
+            const size_t bit = probe(h, i);
+            current[bit >> 6] |= uint64_t{1} << (bit & 63);
+        }
+        inserted++;
+    }
+
+    /**
+     * @brief Forgets every key.
+     */
+    void clear() noexcept {
+        std::fill(current.begin(), current.end(), 0);
+        std::fill(previous.begin(), previous.end(), 0);
+        inserted = 0;
+    }
+
+    /**
+     * @brief Gets the words of the current generation, to save the filter.
+     *
+     * @return Words of the current generation.
+     */
+    [[nodiscard]] std::span<const uint64_t> currentWords() const noexcept { return current; }
+
+    /**
+     * @brief Gets the words of the previous generation, to save the filter.
+     *
+     * @return Words of the previous generation.
+     */
+    [[nodiscard]] std::span<const uint64_t> previousWords() const noexcept { return previous; }
+
+    /**
+     * @brief Gets the number of keys inserted into the current generation.
+     *
+     * @return Keys in the current generation.
+     */
+    [[nodiscard]] size_t getInserted() const noexcept { return inserted; }
+
+    /**
+     * @brief Replaces the contents of the filter with saved generations of the same size.
+     *
+     * @param currentGen Words of the current generation.
+     * @param previousGen Words of the previous generation.
+     * @param insertedKeys Keys inserted into the current generation.
+     * @throws std::invalid_argument if the generations do not match the size of the filter.
+     */
+    void restore(std::span<const uint64_t> currentGen, std::span<const uint64_t> previousGen,
+                 size_t insertedKeys) {
+        if (currentGen.size() != current.size() || previousGen.size() != previous.size() ||
+            insertedKeys > getGenerationKeys()) {
+            throw std::invalid_argument("Bloom filter generations do not match the filter");
+        }
+        std::ranges::copy(currentGen, current.begin());
+        std::ranges::copy(previousGen, previous.begin());
+        inserted = insertedKeys;
+    }
+
+private:
+    /**
+     * @brief Counts the words of a generation.
+     *
+     * @param bits Requested bits.
+     * @return Words of a power-of-two bit count of at least 64 bits, or 0 for 0 bits.
+     */
+    static size_t words(size_t bits) noexcept {
+        return bits == 0 ? 0 : std::bit_ceil(std::max<size_t>(bits, 64)) / 64;
+    }
+
+    /**
+     * @brief Mixes a key into a hash whose halves drive the probes (SplitMix64 finalizer).
+     *
+     * @param key Key to hash.
+     * @return Hash of the key.
+     */
+    static constexpr uint64_t hash(uint64_t key) noexcept {
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+    }
+
+    /**
+     * @brief Computes a probed bit by double hashing.
+     *
+     * @param h Hash of the key.
+     * @param i Index of the probe.
+     * @return Bit index within a generation.
+     */
+    [[nodiscard]] size_t probe(uint64_t h, size_t i) const noexcept {
+        const uint64_t step = (h >> 32) | 1;
+        return static_cast<size_t>((h + i * step) & mask);
+    }
+
+    /**
+     * @brief Checks whether every probed bit of a hash is set in a generation.
+     *
+     * @param gen Generation to check.
+     * @param h Hash of the key.
+     * @return true if all probed bits are set.
+     */
+    [[nodiscard]] bool test(const std::vector<uint64_t>& gen, uint64_t h) const noexcept {
+        for (size_t i = 0; i < HASHES; i++) {
+            const size_t bit = probe(h, i);
+            if ((gen[bit >> 6] >> (bit & 63) & 1) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
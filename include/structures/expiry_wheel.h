@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @class ExpiryWheel
+ * @brief Two-level timing wheel that counts items by deadline tick.
+ *
+ * The wheel does not store the items themselves, only how many expire at each tick, so owners can
+ * learn how many of their items expired without visiting them. Deadlines within one revolution
+ * of the current tick are counted in a near level with one slot per tick; later deadlines are
+ * kept in a far level and cascaded into the near level once they come within range. Advancing
+ * the wheel therefore costs O(elapsed ticks + expired items), and each far deadline is revisited
+ * at most once per revolution.
+ */
+class ExpiryWheel {
+public:
+    static constexpr size_t NEAR_SLOTS = 256; /**< Ticks covered by the near level */
+
+private:
+    static constexpr size_t MASK = NEAR_SLOTS - 1; /**< Slot index mask of the near level */
+
+    std::vector<uint32_t> near; /**< Items per deadline in (current, current + NEAR_SLOTS] */
+    std::vector<size_t> far;    /**< Deadlines beyond the near level, unordered */
+    size_t farMin;              /**< Lower bound of the deadlines in the far level */
+    size_t current;             /**< Last tick the wheel was advanced to */
+    size_t count;               /**< Number of items not yet expired */
+
+public:
+    /**
+     * @brief Constructor for ExpiryWheel.
+     *
+     * @param currentTick Tick the wheel starts at; only later deadlines can be added.
+     */
+    explicit ExpiryWheel(size_t currentTick = 0)
+        : near(NEAR_SLOTS, 0),
+          farMin(std::numeric_limits<size_t>::max()),
+          current(currentTick),
+          count(0) {}
+
+    /**
+     * @brief Counts an item expiring at a deadline.
+     *
+     * @param deadline Tick at which the item expires.
+     * @pre deadline > getCurrentTick().
+     */
+    void add(size_t deadline) {
+        if (deadline <= current + NEAR_SLOTS) {
+            near[deadline & MASK]++;
+        } else {
+            far.push_back(deadline);
+            farMin = std::min(farMin, deadline);
+        }
+        count++;
+    }
+
+    /**
+     * @brief Stops counting an item that left before its deadline.
+     *
+     * @param deadline Deadline the item was added with.
+     * @pre The item was added and has not expired yet.
+     */
+    void remove(size_t deadline) noexcept {
+        if (deadline <= current + NEAR_SLOTS) {
+            near[deadline & MASK]--;
+        } else {
+            const auto it = std::find(far.begin(), far.end(), deadline);
+            *it           = far.back();
+            far.pop_back();
+        }
+        count--;
+    }
+
+    /**
+     * @brief Advances the wheel, expiring every item whose deadline is at or before a tick.
+     *
+     * @param now Tick to advance to; ticks before the current one are ignored.
+     * @return Number of items that expired.
+     */
+    size_t advance(size_t now) noexcept {
+        if (now <= current) {
+            return 0;
+        }
+
+        // Slots of elapsed ticks are emptied; they now stand for the ticks one revolution later
+        const size_t steps = std::min(now - current, NEAR_SLOTS);
+        size_t expired     = 0;
+        for (size_t tick = current + 1; tick <= current + steps; ++tick) {
+            expired += near[tick & MASK];
+            near[tick & MASK] = 0;
+        }
+        current = now;
+
+        if (farMin <= current + NEAR_SLOTS) {
+            farMin = std::numeric_limits<size_t>::max();
+            for (size_t i = 0; i < far.size();) {
+                const size_t deadline = far[i];
+                if (deadline > current + NEAR_SLOTS) {
+                    farMin = std::min(farMin, deadline);
+                    ++i;
+                    continue;
+                }
+                if (deadline <= current) {
+                    expired++;
+                } else {
+                    near[deadline & MASK]++;
+                }
+                far[i] = far.back();
+                far.pop_back();
+            }
+        }
+
+        count -= expired;
+        return expired;
+    }
+
+    /**
+     * @brief Forgets every item, keeping the current tick.
+     */
+    void clear() noexcept {
+        std::fill(near.begin(), near.end(), 0);
+        far.clear();
+        farMin = std::numeric_limits<size_t>::max();
+        count  = 0;
+    }
+
+    /**
+     * @brief Gets the number of items not yet expired.
+     *
+     * @return Number of counted items.
+     */
+    [[nodiscard]] size_t size() const noexcept { return count; }
+
+    /**
+     * @brief Gets the last tick the wheel was advanced to.
+     *
+     * @return Current tick of the wheel.
+     */
+    [[nodiscard]] size_t getCurrentTick() const noexcept { return current; }
+};
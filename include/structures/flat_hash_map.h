@@ -0,0 +1,349 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FlatHashMap
+ * @brief Open-addressing hash map with linear probing, for small trivially movable entries.
+ *
+ * Entries live directly in a single power-of-two array of slots, so a lookup touches one or two
+ * cache lines instead of chasing bucket nodes. Erasing shifts the following entries of the probe
+ * run back instead of leaving tombstones, so lookups stay short under constant insert/erase
+ * churn. The table doubles when it becomes three quarters full.
+ *
+ * Pointers returned by find() and insert() are invalidated by any insertion or erasure.
+ *
+ * @tparam Key The key type; must be default constructible and equality comparable.
+ * @tparam Value The mapped type; must be default constructible.
+ * @tparam Hash Hash function object for the keys.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+    static constexpr size_t MIN_SLOTS = 16; /**< Slots allocated on the first insertion */
+
+    /**
+     * @struct Slot
+     * @brief One entry of the table.
+     */
+    struct Slot {
+        Key key{};         /**< Key of the entry */
+        Value value{};     /**< Mapped value of the entry */
+        bool used = false; /**< Whether the slot holds an entry */
+    };
+
+    std::vector<Slot> slots;           /**< Table of slots (empty or a power of two). */
+    size_t count = 0;                  /**< Number of entries currently stored. */
+    [[no_unique_address]] Hash hasher; /**< Hash function for the keys. */
+
+public:
+    /**
+     * @brief Default constructor. Creates an empty map without allocating.
+     */
+    FlatHashMap() = default;
+
+    /**
+     * @brief Creates an empty map with room for the given number of entries.
+     * @param expected Number of entries the map should hold without growing.
+     */
+    explicit FlatHashMap(size_t expected);
+
+    // =============== Capacity ===============
+    /**
+     * @brief Gets the number of entries.
+     * @return Number of entries currently stored.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Checks if the map is empty.
+     * @return @c true if the map has no entries; otherwise @c false.
+     */
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    /**
+     * @brief Gets the number of slots of the table.
+     * @return Number of allocated slots.
+     */
+    [[nodiscard]] size_t slotCapacity() const noexcept;
+
+    /**
+     * @brief Grows the table so that it can hold the given number of entries without growing.
+     * @param expected Number of entries.
+     */
+    void reserve(size_t expected);
+
+    // =============== Lookup ===============
+    /**
+     * @brief Finds the value mapped to a key.
+     * @param key Key to look up.
+     * @return Pointer to the mapped value, or @c nullptr if the key is not present.
+     */
+    [[nodiscard]] Value* find(const Key& key) noexcept;
+
+    /**
+     * @brief Finds the value mapped to a key.
+     * @param key Key to look up.
+     * @return Pointer to the mapped value, or @c nullptr if the key is not present.
+     */
+    [[nodiscard]] const Value* find(const Key& key) const noexcept;
+
+    /**
+     * @brief Checks if a key is present.
+     * @param key Key to look up.
+     * @return @c true if the key is present; otherwise @c false.
+     */
+    [[nodiscard]] bool contains(const Key& key) const noexcept;
+
+    // =============== Modifiers ===============
+    /**
+     * @brief Inserts an entry if the key is not present yet.
+     * @param key Key of the entry.
+     * @param value Value to map to the key.
+     * @return Pointer to the value mapped to the key, and @c true if the entry was inserted or
+     * @c false if the key was already present (its value is left unchanged).
+     */
+    std::pair<Value*, bool> insert(const Key& key, Value value);
+
+    /**
+     * @brief Inserts an entry or replaces the value of an existing one.
+     * @param key Key of the entry.
+     * @param value Value to map to the key.
+     * @return Pointer to the value mapped to the key.
+     */
+    Value* insertOrAssign(const Key& key, Value value);
+
+    /**
+     * @brief Removes the entry of a key.
+     * @param key Key to remove.
+     * @return @c true if an entry was removed; @c false if the key was not present.
+     */
+    bool erase(const Key& key) noexcept;
+
+    /**
+     * @brief Removes every entry, keeping the table allocated.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Calls a visitor for every entry, in unspecified order.
+     * @param visitor Callable taking (const Key&, Value&).
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visitor);
+
+    /**
+     * @brief Calls a visitor for every entry, in unspecified order.
+     * @param visitor Callable taking (const Key&, const Value&).
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const;
+
+private:
+    /**
+     * @brief Gets the home slot of a key.
+     * @param key Key to hash.
+     * @return Index of the first slot of the key's probe run.
+     * @pre The table must not be empty.
+     */
+    [[nodiscard]] size_t homeOf(const Key& key) const noexcept;
+
+    /**
+     * @brief Finds the slot holding a key.
+     * @param key Key to look up.
+     * @return Index of the slot, or slotCapacity() if the key is not present.
+     */
+    [[nodiscard]] size_t slotOf(const Key& key) const noexcept;
+
+    /**
+     * @brief Rebuilds the table with a new number of slots.
+     * @param newSlots New number of slots (a power of two larger than the entry count).
+     */
+    void rehash(size_t newSlots);
+};
+
+// =============== Constructors ===============
+template <typename Key, typename Value, typename Hash>
+FlatHashMap<Key, Value, Hash>::FlatHashMap(size_t expected) {
+    reserve(expected);
+}
+
+// =============== Capacity ===============
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::size() const noexcept {
+    return count;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool FlatHashMap<Key, Value, Hash>::isEmpty() const noexcept {
+    return count == 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::slotCapacity() const noexcept {
+    return slots.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::reserve(size_t expected) {
+    size_t needed = MIN_SLOTS;
+    while (needed / 4 * 3 < expected) {
+        needed *= 2;
+    }
+    if (needed > slots.size()) {
+        rehash(needed);
+    }
+}
+
+// =============== Lookup ===============
+template <typename Key, typename Value, typename Hash>
+Value* FlatHashMap<Key, Value, Hash>::find(const Key& key) noexcept {
+    const size_t pos = slotOf(key);
+    return pos == slots.size() ? nullptr : &slots[pos].value;
+}
+
+template <typename Key, typename Value, typename Hash>
+const Value* FlatHashMap<Key, Value, Hash>::find(const Key& key) const noexcept {
+    const size_t pos = slotOf(key);
+    return pos == slots.size() ? nullptr : &slots[pos].value;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool FlatHashMap<Key, Value, Hash>::contains(const Key& key) const noexcept {
+    return slotOf(key) != slots.size();
+}
+
+// =============== Modifiers ===============
+template <typename Key, typename Value, typename Hash>
+std::pair<Value*, bool> FlatHashMap<Key, Value, Hash>::insert(const Key& key, Value value) {
+    if (Value* existing = find(key)) {
+        return {existing, false};
+    }
+
+    if ((count + 1) > slots.size() / 4 * 3) {
+        rehash(slots.empty() ? MIN_SLOTS : slots.size() * 2);
+    }
+
+    const size_t mask = slots.size() - 1;
+    size_t pos        = homeOf(key);
+    while (slots[pos].used) {
+        pos = (pos + 1) & mask;
+    }
+
+    slots[pos].key   = key;
+    slots[pos].value = std::move(value);
+    slots[pos].used  = true;
+    count++;
+
+    return {&slots[pos].value, true};
+}
+
+template <typename Key, typename Value, typename Hash>
+Value* FlatHashMap<Key, Value, Hash>::insertOrAssign(const Key& key, Value value) {
+    if (Value* existing = find(key)) {
+        *existing = std::move(value);
+        return existing;
+    }
+    return insert(key, std::move(value)).first;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool FlatHashMap<Key, Value, Hash>::erase(const Key& key) noexcept {
+    size_t hole = slotOf(key);
+    if (hole == slots.size()) {
+        return false;
+    }
+
+    // Backward-shift deletion: move later entries of the run into the hole when the hole lies
+    // between their home slot and their current slot, so no lookup ever crosses an empty slot
+    const size_t mask = slots.size() - 1;
+    for (size_t next = (hole + 1) & mask; slots[next].used; next = (next + 1) & mask) {
+        const size_t home = homeOf(slots[next].key);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = std::move(slots[next]);
+            hole        = next;
+        }
+    }
+
+    slots[hole] = Slot{};
+    count--;
+
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::clear() noexcept {
+    for (Slot& slot : slots) {
+        slot = Slot{};
+    }
+    count = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Visitor>
+void FlatHashMap<Key, Value, Hash>::forEach(Visitor&& visitor) {
+    for (Slot& slot : slots) {
+        if (slot.used) {
+            visitor(std::as_const(slot.key), slot.value);
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Visitor>
+void FlatHashMap<Key, Value, Hash>::forEach(Visitor&& visitor) const {
+    for (const Slot& slot : slots) {
+        if (slot.used) {
+            visitor(slot.key, slot.value);
+        }
+    }
+}
+
+// =============== Private Helpers ===============
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::homeOf(const Key& key) const noexcept {
+    // Standard hashes of integers are the identity; mix the bits so that keys differing only in
+    // their high bits do not share a home slot
+    auto h = static_cast<uint64_t>(hasher(key));
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+
+    return static_cast<size_t>(h) & (slots.size() - 1);
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t FlatHashMap<Key, Value, Hash>::slotOf(const Key& key) const noexcept {
+    if (count == 0) {
+        return slots.size();
+    }
+
+    const size_t mask = slots.size() - 1;
+    for (size_t pos = homeOf(key); slots[pos].used; pos = (pos + 1) & mask) {
+        if (slots[pos].key == key) {
+            return pos;
+        }
+    }
+    return slots.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+void FlatHashMap<Key, Value, Hash>::rehash(size_t newSlots) {
+    std::vector<Slot> old(newSlots);
+    old.swap(slots);
+
+    const size_t mask = slots.size() - 1;
+    for (Slot& slot : old) {
+        if (!slot.used) {
+            continue;
+        }
+        size_t pos = homeOf(slot.key);
+        while (slots[pos].used) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = std::move(slot);
+    }
+}
@@ -3,11 +3,14 @@
 #include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <utility>
 
+#include "structures/pool_allocator.h"
+
 /**
  * @class List
  * @brief A generic singly linked list implementation.
@@ -15,15 +18,24 @@
  * This class provides a dynamic sequence container that allows for O(1) insertion
  * and removal at both ends. It implements the "Rule of Five" for proper resource management.
  *
+ * Nodes are obtained from the allocator rebound to the node type. The default PoolAllocator
+ * recycles nodes through a per-thread free list, so lists that are built and dropped on every
+ * call do not go back to the system allocator.
+ *
  * @tparam T The type of the elements stored in the list.
+ * @tparam Allocator Allocator for the elements, rebound internally to allocate nodes.
  */
-template <typename T>
+template <typename T, typename Allocator = PoolAllocator<T>>
 class List {
     struct Node;
 
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits    = std::allocator_traits<NodeAllocator>;
+
     Node* pHead;      /**< Pointer to the first node of the list. */
     Node* pTail;      /**< Pointer to the last node of the list. */
     size_t nodeCount; /**< Number of elements currently in the list. */
+    [[no_unique_address]] NodeAllocator nodeAlloc; /**< Allocator used for the nodes. */
 
 public:
     // =============== Iterators ===============
@@ -193,6 +205,12 @@ public:
      */
     List();
 
+    /**
+     * @brief Creates an empty list that allocates its nodes with the given allocator.
+     * @param alloc The allocator to copy.
+     */
+    explicit List(const Allocator& alloc);
+
     /**
      * @brief Copy constructor (Deep copy).
      * @param other The list to be copied.
@@ -532,14 +550,34 @@ private:
      * Only swaps pointers and the count, not the actual nodes.
      */
     void swap(List& other) noexcept;
+
+    /**
+     * @brief Allocates and constructs a node with the list's allocator.
+     * @param val The value to store, copied or moved into the node.
+     * @return Pointer to the new, unlinked node.
+     * @note Strong exception safety: if the element constructor throws, the storage is released.
+     */
+    template <typename U>
+    Node* createNode(U&& val);
+
+    /**
+     * @brief Destroys a node and returns its storage to the list's allocator.
+     * @param node Pointer to an unlinked node created by createNode().
+     */
+    void destroyNode(Node* node) noexcept;
 };
 
 // =============== Constructors & Destructor ===============
-template <typename T>
-List<T>::List() : pHead(nullptr), pTail(nullptr), nodeCount(0) {}
+template <typename T, typename Allocator>
+List<T, Allocator>::List() : List(Allocator()) {}
+
+template <typename T, typename Allocator>
+List<T, Allocator>::List(const Allocator& alloc)
+    : pHead(nullptr), pTail(nullptr), nodeCount(0), nodeAlloc(alloc) {}
 
-template <typename T>
-List<T>::List(const List& other) : List() {
+template <typename T, typename Allocator>
+List<T, Allocator>::List(const List& other)
+    : List(Allocator(NodeTraits::select_on_container_copy_construction(other.nodeAlloc))) {
     try {
         for (const auto& item : other) {
             pushBack(item);
@@ -550,8 +588,8 @@ List<T>::List(const List& other) : List() {
     }
 }
 
-template <typename T>
-List<T>& List<T>::operator=(const List& other) {
+template <typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator=(const List& other) {
     if (this != &other) {
         List temp(other);
         this->swap(temp);
@@ -559,135 +597,138 @@ List<T>& List<T>::operator=(const List& other) {
     return *this;
 }
 
-template <typename T>
-List<T>::List(List&& other) noexcept
-    : pHead(other.pHead), pTail(other.pTail), nodeCount(other.nodeCount) {
+template <typename T, typename Allocator>
+List<T, Allocator>::List(List&& other) noexcept
+    : pHead(other.pHead),
+      pTail(other.pTail),
+      nodeCount(other.nodeCount),
+      nodeAlloc(std::move(other.nodeAlloc)) {
     other.pHead     = nullptr;
     other.pTail     = nullptr;
     other.nodeCount = 0;
 }
 
-template <typename T>
-List<T>& List<T>::operator=(List&& other) noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>& List<T, Allocator>::operator=(List&& other) noexcept {
     this->swap(other);
     return *this;
 }
 
-template <typename T>
-List<T>::~List() noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::~List() noexcept {
     clear();
 }
 
 // =============== Capacity ===============
-template <typename T>
-size_t List<T>::size() const noexcept {
+template <typename T, typename Allocator>
+size_t List<T, Allocator>::size() const noexcept {
     return nodeCount;
 }
 
-template <typename T>
-bool List<T>::isEmpty() const noexcept {
+template <typename T, typename Allocator>
+bool List<T, Allocator>::isEmpty() const noexcept {
     return nodeCount == 0;
 }
 
 // =============== Element access ===============
-template <typename T>
-T& List<T>::getHead() {
+template <typename T, typename Allocator>
+T& List<T, Allocator>::getHead() {
     if (!pHead) {
         throw std::runtime_error("List is empty");
     }
     return pHead->data;
 }
 
-template <typename T>
-const T& List<T>::getHead() const {
+template <typename T, typename Allocator>
+const T& List<T, Allocator>::getHead() const {
     if (!pHead) {
         throw std::runtime_error("List is empty");
     }
     return pHead->data;
 }
 
-template <typename T>
-T& List<T>::getTail() {
+template <typename T, typename Allocator>
+T& List<T, Allocator>::getTail() {
     if (!pTail) {
         throw std::runtime_error("List is empty");
     }
     return pTail->data;
 }
 
-template <typename T>
-const T& List<T>::getTail() const {
+template <typename T, typename Allocator>
+const T& List<T, Allocator>::getTail() const {
     if (!pTail) {
         throw std::runtime_error("List is empty");
     }
     return pTail->data;
 }
 
-template <typename T>
-T& List<T>::getAt(size_t pos) {
+template <typename T, typename Allocator>
+T& List<T, Allocator>::getAt(size_t pos) {
     if (pos >= nodeCount) {
         throw std::out_of_range("getAt: Index out of bounds");
     }
     return getNodeAt(pos)->data;
 }
 
-template <typename T>
-const T& List<T>::getAt(size_t pos) const {
+template <typename T, typename Allocator>
+const T& List<T, Allocator>::getAt(size_t pos) const {
     if (pos >= nodeCount) {
         throw std::out_of_range("getAt: Index out of bounds");
     }
     return getNodeAt(pos)->data;
 }
 
-template <typename T>
-T& List<T>::operator[](size_t pos) {
+template <typename T, typename Allocator>
+T& List<T, Allocator>::operator[](size_t pos) {
     return getAt(pos);
 }
 
-template <typename T>
-const T& List<T>::operator[](size_t pos) const {
+template <typename T, typename Allocator>
+const T& List<T, Allocator>::operator[](size_t pos) const {
     return getAt(pos);
 }
 
 // =============== Modifiers ===============
-template <typename T>
-void List<T>::clear() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::clear() noexcept {
     while (pHead != nullptr) {
         Node* temp = pHead;
 
         pHead = pHead->next;
-        delete temp;
+        destroyNode(temp);
     }
     pTail = nullptr;
 
     nodeCount = 0;
 }
 
-template <typename T>
-void List<T>::pushFront(const T& val) {
-    Node* newNode = new Node(val);
+template <typename T, typename Allocator>
+void List<T, Allocator>::pushFront(const T& val) {
+    Node* newNode = createNode(val);
     prependNode(newNode);
 }
 
-template <typename T>
-void List<T>::pushFront(T&& val) {
-    Node* newNode = new Node(std::move(val));
+template <typename T, typename Allocator>
+void List<T, Allocator>::pushFront(T&& val) {
+    Node* newNode = createNode(std::move(val));
     prependNode(newNode);
 }
 
-template <typename T>
-void List<T>::pushBack(const T& val) {
-    Node* newNode = new Node(val);
+template <typename T, typename Allocator>
+void List<T, Allocator>::pushBack(const T& val) {
+    Node* newNode = createNode(val);
     appendNode(newNode);
 }
 
-template <typename T>
-void List<T>::pushBack(T&& val) {
-    Node* newNode = new Node(std::move(val));
+template <typename T, typename Allocator>
+void List<T, Allocator>::pushBack(T&& val) {
+    Node* newNode = createNode(std::move(val));
     appendNode(newNode);
 }
 
-template <typename T>
-void List<T>::insertAt(const T& val, size_t pos) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::insertAt(const T& val, size_t pos) {
     if (pos > nodeCount) {
         throw std::out_of_range("Index out of bounds");
     }
@@ -699,13 +740,13 @@ void List<T>::insertAt(const T& val, size_t pos) {
         return pushBack(val);
     }
 
-    Node* newNode = new Node(val);
+    Node* newNode = createNode(val);
     Node* prev    = getNodeAt(pos - 1);
     insertAfter(prev, newNode);
 }
 
-template <typename T>
-void List<T>::insertAt(T&& val, size_t pos) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::insertAt(T&& val, size_t pos) {
     if (pos > nodeCount) {
         throw std::out_of_range("Index out of bounds");
     }
@@ -718,13 +759,13 @@ void List<T>::insertAt(T&& val, size_t pos) {
         return pushBack(std::move(val));
     }
 
-    Node* newNode = new Node(val);
+    Node* newNode = createNode(std::move(val));
     Node* prev    = getNodeAt(pos - 1);
     insertAfter(prev, newNode);
 }
 
-template <typename T>
-void List<T>::popFront() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::popFront() {
     if (pHead == nullptr) {
         throw std::runtime_error("List is empty");
     }
@@ -738,12 +779,12 @@ void List<T>::popFront() {
         pHead = pHead->next;
     }
 
-    delete oldHead;
+    destroyNode(oldHead);
     nodeCount--;
 }
 
-template <typename T>
-void List<T>::popBack() {
+template <typename T, typename Allocator>
+void List<T, Allocator>::popBack() {
     if (pHead == nullptr) {
         throw std::runtime_error("List is empty");
     }
@@ -759,12 +800,12 @@ void List<T>::popBack() {
         pTail         = newTail;
     }
 
-    delete oldTail;
+    destroyNode(oldTail);
     nodeCount--;
 }
 
-template <typename T>
-void List<T>::removeAt(size_t pos) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::removeAt(size_t pos) {
     if (pos >= nodeCount) {
         throw std::out_of_range("Index out of bounds");
     }
@@ -782,12 +823,12 @@ void List<T>::removeAt(size_t pos) {
 
     prevNode->next = nodeToDelete->next;
 
-    delete nodeToDelete;
+    destroyNode(nodeToDelete);
     nodeCount--;
 }
 
-template <typename T>
-void List<T>::swap(size_t pos1, size_t pos2) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::swap(size_t pos1, size_t pos2) {
     if (pos1 == pos2)
         return;
     if (pos1 >= nodeCount || pos2 >= nodeCount) {
@@ -800,8 +841,8 @@ void List<T>::swap(size_t pos1, size_t pos2) {
     std::swap(node1->data, node2->data);
 }
 
-template <typename T>
-void List<T>::reverse() noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::reverse() noexcept {
     if (nodeCount <= 1) {
         return;
     }
@@ -822,39 +863,39 @@ void List<T>::reverse() noexcept {
 }
 
 // =============== Iteration ===============
-template <typename T>
-List<T>::Iterator List<T>::begin() noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::Iterator List<T, Allocator>::begin() noexcept {
     return Iterator(pHead);
 }
 
-template <typename T>
-List<T>::Iterator List<T>::end() noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::Iterator List<T, Allocator>::end() noexcept {
     return Iterator(nullptr);
 }
 
-template <typename T>
-List<T>::ConstIterator List<T>::begin() const noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::ConstIterator List<T, Allocator>::begin() const noexcept {
     return ConstIterator(pHead);
 }
 
-template <typename T>
-List<T>::ConstIterator List<T>::end() const noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::ConstIterator List<T, Allocator>::end() const noexcept {
     return ConstIterator(nullptr);
 }
 
-template <typename T>
-List<T>::ConstIterator List<T>::cbegin() const noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::ConstIterator List<T, Allocator>::cbegin() const noexcept {
     return ConstIterator(pHead);
 }
 
-template <typename T>
-List<T>::ConstIterator List<T>::cend() const noexcept {
+template <typename T, typename Allocator>
+List<T, Allocator>::ConstIterator List<T, Allocator>::cend() const noexcept {
     return ConstIterator(nullptr);
 }
 
 // =============== Utilities ===============
-template <typename T>
-std::string List<T>::toString() const {
+template <typename T, typename Allocator>
+std::string List<T, Allocator>::toString() const {
     if (isEmpty())
         return "List is empty";
 
@@ -869,13 +910,13 @@ std::string List<T>::toString() const {
     return ss.str();
 }
 
-template <typename T>
-void List<T>::print() const {
+template <typename T, typename Allocator>
+void List<T, Allocator>::print() const {
     std::cout << toString() << std::endl;
 }
 
-template <typename T>
-bool List<T>::contains(const T& val) const {
+template <typename T, typename Allocator>
+bool List<T, Allocator>::contains(const T& val) const {
     // cppcheck-suppress useStlAlgorithm
     for (const auto& item : *this) {
         if (item == val) {
@@ -889,8 +930,8 @@ bool List<T>::contains(const T& val) const {
     */
 }
 
-template <typename T>
-std::optional<size_t> List<T>::find(const T& val) const {
+template <typename T, typename Allocator>
+std::optional<size_t> List<T, Allocator>::find(const T& val) const {
     size_t index = 0;
     // cppcheck-suppress useStlAlgorithm
     for (const auto& item : *this) {
@@ -910,8 +951,8 @@ std::optional<size_t> List<T>::find(const T& val) const {
 }
 
 // =============== Private Helpers ===============
-template <typename T>
-void List<T>::appendNode(Node* newNode) noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::appendNode(Node* newNode) noexcept {
     if (!pHead) {
         pHead = pTail = newNode;
     } else {
@@ -921,8 +962,8 @@ void List<T>::appendNode(Node* newNode) noexcept {
     nodeCount++;
 }
 
-template <typename T>
-void List<T>::prependNode(Node* newNode) noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::prependNode(Node* newNode) noexcept {
     if (!pHead) {
         pHead = pTail = newNode;
     } else {
@@ -932,8 +973,8 @@ void List<T>::prependNode(Node* newNode) noexcept {
     nodeCount++;
 }
 
-template <typename T>
-List<T>::Node* List<T>::getNodeAt(size_t index) const {
+template <typename T, typename Allocator>
+List<T, Allocator>::Node* List<T, Allocator>::getNodeAt(size_t index) const {
     Node* curr = pHead;
     for (int i = 0; i < index; ++i) {
         curr = curr->next;
@@ -941,16 +982,36 @@ List<T>::Node* List<T>::getNodeAt(size_t index) const {
     return curr;
 }
 
-template <typename T>
-void List<T>::insertAfter(Node* prevNode, Node* newNode) {
+template <typename T, typename Allocator>
+void List<T, Allocator>::insertAfter(Node* prevNode, Node* newNode) {
     newNode->next  = prevNode->next;
     prevNode->next = newNode;
     nodeCount++;
 }
 
-template <typename T>
-void List<T>::swap(List& other) noexcept {
+template <typename T, typename Allocator>
+void List<T, Allocator>::swap(List& other) noexcept {
     std::swap(pHead, other.pHead);
     std::swap(pTail, other.pTail);
     std::swap(nodeCount, other.nodeCount);
+    std::swap(nodeAlloc, other.nodeAlloc);
+}
+
+template <typename T, typename Allocator>
+template <typename U>
+List<T, Allocator>::Node* List<T, Allocator>::createNode(U&& val) {
+    Node* node = NodeTraits::allocate(nodeAlloc, 1);
+    try {
+        NodeTraits::construct(nodeAlloc, node, std::forward<U>(val));
+    } catch (...) {
+        NodeTraits::deallocate(nodeAlloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <typename T, typename Allocator>
+void List<T, Allocator>::destroyNode(Node* node) noexcept {
+    NodeTraits::destroy(nodeAlloc, node);
+    NodeTraits::deallocate(nodeAlloc, node, 1);
 }
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace detail {
+/**
+ * @class NodePool
+ * @brief Process-wide pool of fixed-size blocks with a free list per thread.
+ *
+ * Blocks are carved from slabs that are never returned to the system. A freed block goes onto
+ * the free list of the thread that frees it, and allocations are served from that list first, so
+ * containers that are rebuilt over and over recycle the same memory without any locking. When a
+ * thread's list grows past a limit, or when the thread exits, its blocks are handed to a shared
+ * depot that other threads refill from before carving new slabs.
+ *
+ * There is one pool per (size, alignment) pair, shared by every type with that layout.
+ *
+ * @tparam Size Size of each block in bytes.
+ * @tparam Align Alignment of each block in bytes.
+ */
+template <size_t Size, size_t Align>
+class NodePool {
+    /**
+     * @struct FreeBlock
+     * @brief Link stored in a block while it sits on a free list.
+     */
+    struct FreeBlock {
+        FreeBlock* next; /**< Next free block */
+    };
+
+    /** Alignment of the blocks, large enough to hold a free list link */
+    static constexpr size_t BLOCK_ALIGN = std::max(Align, alignof(FreeBlock));
+    /** Size of a block, rounded up to the block alignment */
+    static constexpr size_t BLOCK_SIZE =
+        (std::max(Size, sizeof(FreeBlock)) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+    /** Number of blocks carved from each slab */
+    static constexpr size_t SLAB_BLOCKS = std::max<size_t>(1, 16384 / BLOCK_SIZE);
+    /** Free blocks a thread keeps before spilling them to the depot */
+    static constexpr size_t LOCAL_LIMIT = 4 * SLAB_BLOCKS;
+
+    /**
+     * @struct FreeList
+     * @brief Intrusive LIFO list of free blocks that can be spliced in O(1).
+     */
+    struct FreeList {
+        FreeBlock* head = nullptr; /**< Most recently freed block */
+        FreeBlock* tail = nullptr; /**< Least recently freed block */
+        size_t count    = 0;       /**< Number of blocks in the list */
+
+        /**
+         * @brief Moves every block of another list to the front of this one.
+         *
+         * @param other List to empty into this one.
+         */
+        void splice(FreeList& other) noexcept {
+            if (!other.head) {
+                return;
+            }
+            other.tail->next = head;
+            if (!head) {
+                tail = other.tail;
+            }
+            head  = other.head;
+            count += other.count;
+            other = FreeList{};
+        }
+    };
+
+    /**
+     * @struct Depot
+     * @brief Free blocks released by threads, shared by all threads.
+     */
+    struct Depot {
+        std::mutex mutex; /**< Guards the list */
+        FreeList blocks;  /**< Released blocks */
+    };
+
+    /**
+     * @struct LocalCache
+     * @brief Free blocks owned by one thread; returned to the depot when the thread exits.
+     */
+    struct LocalCache {
+        FreeList blocks; /**< Free blocks of this thread */
+
+        ~LocalCache() { spill(blocks); }
+    };
+
+public:
+    /**
+     * @brief Takes a block from the pool.
+     *
+     * @return Pointer to an uninitialized block of Size bytes aligned to Align.
+     * @throws std::bad_alloc if a new slab cannot be allocated.
+     */
+    [[nodiscard]] static void* allocate() {
+        FreeList& local = cache().blocks;
+
+        if (!local.head) {
+            refill(local);
+        }
+
+        FreeBlock* block = local.head;
+        local.head       = block->next;
+        if (--local.count == 0) {
+            local.tail = nullptr;
+        }
+        return block;
+    }
+
+    /**
+     * @brief Returns a block to the calling thread's free list.
+     *
+     * @param ptr Block obtained from allocate() on any thread.
+     */
+    static void deallocate(void* ptr) noexcept {
+        FreeList& local = cache().blocks;
+
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = local.head;
+        if (!local.head) {
+            local.tail = block;
+        }
+        local.head = block;
+
+        if (++local.count > LOCAL_LIMIT) {
+            spill(local);
+        }
+    }
+
+private:
+    /**
+     * @brief Gets the free list of the calling thread.
+     *
+     * @return Reference to the thread's cache.
+     */
+    static LocalCache& cache() noexcept {
+        thread_local LocalCache local;
+        return local;
+    }
+
+    /**
+     * @brief Gets the shared depot. It is intentionally leaked so that it outlives the caches of
+     * threads that exit during static destruction.
+     *
+     * @return Reference to the depot.
+     */
+    static Depot& depot() {
+        static Depot* instance = new Depot();
+        return *instance;
+    }
+
+    /**
+     * @brief Moves every block of a list to the depot.
+     *
+     * @param blocks List to empty.
+     */
+    static void spill(FreeList& blocks) noexcept {
+        if (!blocks.head) {
+            return;
+        }
+        Depot& shared = depot();
+        std::lock_guard lock(shared.mutex);
+        shared.blocks.splice(blocks);
+    }
+
+    /**
+     * @brief Fills an empty list from the depot, or from a new slab if the depot is empty too.
+     *
+     * @param local Empty list of the calling thread.
+     * @throws std::bad_alloc if a new slab cannot be allocated.
+     */
+    static void refill(FreeList& local) {
+        {
+            Depot& shared = depot();
+            std::lock_guard lock(shared.mutex);
+            local.splice(shared.blocks);
+        }
+        if (local.head) {
+            return;
+        }
+
+        auto* slab = static_cast<std::byte*>(
+            ::operator new(SLAB_BLOCKS * BLOCK_SIZE, std::align_val_t{BLOCK_ALIGN}));
+
+        // Thread the slab so that blocks are handed out in address order
+        for (size_t i = SLAB_BLOCKS; i-- > 0;) {
+            auto* block = reinterpret_cast<FreeBlock*>(slab + i * BLOCK_SIZE);
+            block->next = local.head;
+            if (!local.head) {
+                local.tail = block;
+            }
+            local.head = block;
+        }
+        local.count = SLAB_BLOCKS;
+    }
+};
+}  // namespace detail
+
+/**
+ * @class PoolAllocator
+ * @brief Stateless allocator that serves single objects from a per-thread slab pool.
+ *
+ * Single-object allocations, which is all node-based containers request, are taken from the
+ * detail::NodePool of the object's size and alignment; array allocations fall back to
+ * std::allocator. All instances compare equal, so containers can exchange memory freely, and a
+ * block may be freed on a different thread than the one that allocated it.
+ *
+ * @tparam T The type of the objects to allocate.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T; /**< Type of the allocated objects */
+
+    /**
+     * @brief Default constructor.
+     */
+    PoolAllocator() noexcept = default;
+
+    /**
+     * @brief Converting constructor used when rebinding to another type.
+     */
+    template <typename U>
+    explicit(false) PoolAllocator(const PoolAllocator<U>& /*other*/) noexcept {}
+
+    /**
+     * @brief Allocates storage for n objects.
+     *
+     * @param n Number of objects.
+     * @return Pointer to uninitialized storage.
+     * @throws std::bad_alloc if the storage cannot be allocated.
+     */
+    [[nodiscard]] T* allocate(size_t n) {
+        if (n != 1) {
+            return std::allocator<T>{}.allocate(n);
+        }
+        return static_cast<T*>(detail::NodePool<sizeof(T), alignof(T)>::allocate());
+    }
+
+    /**
+     * @brief Releases storage obtained from allocate().
+     *
+     * @param ptr Pointer returned by allocate().
+     * @param n Number of objects passed to allocate().
+     */
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (n != 1) {
+            std::allocator<T>{}.deallocate(ptr, n);
+            return;
+        }
+        detail::NodePool<sizeof(T), alignof(T)>::deallocate(ptr);
+    }
+
+    /**
+     * @brief All pool allocators are interchangeable.
+     *
+     * @return Always true.
+     */
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+};
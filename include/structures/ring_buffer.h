@@ -0,0 +1,663 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class RingBuffer
+ * @brief A generic contiguous circular FIFO container.
+ *
+ * Elements live in a single power-of-two sized block of slots that is reused as the queue wraps
+ * around, so pushing to the back and popping from the front never allocate once the buffer has
+ * reached its working size. When the buffer is full, the storage grows geometrically (doubling).
+ * It implements the "Rule of Five" for proper resource management.
+ *
+ * @tparam T The type of the elements stored in the buffer.
+ */
+template <typename T>
+class RingBuffer {
+    static constexpr size_t MIN_SLOTS = 8; /**< Slots allocated on the first growth */
+
+    T* slots;         /**< Raw storage for @c slotCount elements. */
+    size_t slotCount; /**< Number of allocated slots (0 or a power of two). */
+    size_t head;      /**< Slot index of the first element. */
+    size_t count;     /**< Number of elements currently stored. */
+
+public:
+    // =============== Iterators ===============
+    /**
+     * @class RingBuffer::BasicIterator
+     * @brief Forward iterator over the logical (FIFO) order of a @c RingBuffer<T>.
+     *
+     * @tparam IsConst Whether the iterator gives read-only access to the elements.
+     */
+    template <bool IsConst>
+    class BasicIterator {
+        /** @brief Pointer to the owning buffer, const-qualified for const iterators. */
+        using Owner = std::conditional_t<IsConst, const RingBuffer, RingBuffer>;
+
+    public:
+        /** @brief Iterator category (required for STL algorithm compatibility) */
+        using iterator_category = std::forward_iterator_tag;
+        /** @brief Type of the element pointed to by the iterator */
+        using value_type        = T;
+        /** @brief Type to represent the distance between two iterators */
+        using difference_type   = std::ptrdiff_t;
+        /** @brief Type for a pointer to the value */
+        using pointer           = std::conditional_t<IsConst, const T*, T*>;
+        /** @brief Type for a reference to the value */
+        using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+        /**
+         * @brief Construct an iterator at a logical position of a buffer.
+         * @param owner Buffer being iterated.
+         * @param pos Logical position (0 = front, size() = end).
+         */
+        BasicIterator(Owner* owner, size_t pos) : owner(owner), pos(pos) {}
+
+        /**
+         * @brief Dereference the iterator.
+         * @return Reference to the element pointed by the iterator.
+         * @pre The iterator must not be @c end().
+         */
+        reference operator*() const { return (*owner)[pos]; }
+
+        /**
+         * @brief Member access through iterator.
+         * @return Pointer to the element pointed by the iterator.
+         * @pre The iterator must not be @c end().
+         */
+        pointer operator->() const { return &(*owner)[pos]; }
+
+        /**
+         * @brief Compare two iterators for equality.
+         * @param other Iterator to compare with.
+         * @return @c true if both iterators refer to the same position; otherwise @c false.
+         */
+        bool operator==(const BasicIterator& other) const { return pos == other.pos; }
+
+        /**
+         * @brief Compare two iterators for inequality.
+         * @param other Iterator to compare with.
+         * @return @c true if iterators refer to different positions; otherwise @c false.
+         */
+        bool operator!=(const BasicIterator& other) const { return pos != other.pos; }
+
+        /**
+         * @brief Pre-increment: advance iterator to the next element.
+         * @return Reference to the advanced iterator.
+         */
+        BasicIterator& operator++() {
+            ++pos;
+            return *this;
+        }
+
+        /**
+         * @brief Post-increment: advance iterator to the next element.
+         * @return Copy of the iterator before advancement.
+         */
+        BasicIterator operator++(int) {
+            BasicIterator temp = *this;
+            ++pos;
+            return temp;
+        }
+
+    private:
+        Owner* owner; /**< Buffer being iterated. */
+        size_t pos;   /**< Logical position inside the buffer. */
+    };
+
+    /** @brief Mutable iterator type. */
+    using Iterator      = BasicIterator<false>;
+    /** @brief Read-only iterator type. */
+    using ConstIterator = BasicIterator<true>;
+
+    // =============== Constructors & Destructor ===============
+    /**
+     * @brief Default constructor. Creates an empty buffer without allocating.
+     */
+    RingBuffer() noexcept;
+
+    /**
+     * @brief Creates an empty buffer with room for at least @p initialSlots elements.
+     * @param initialSlots Minimum number of slots to preallocate (rounded up to a power of two).
+     */
+    explicit RingBuffer(size_t initialSlots);
+
+    /**
+     * @brief Copy constructor (Deep copy). The copy keeps the same slot count as @p other.
+     * @param other The buffer to be copied.
+     */
+    RingBuffer(const RingBuffer& other);
+
+    /**
+     * @brief Copy assignment operator using the copy-and-swap idiom.
+     * @param other The buffer to be copied.
+     * @return Reference to this buffer.
+     */
+    RingBuffer& operator=(const RingBuffer& other);
+
+    /**
+     * @brief Move constructor. Transfers ownership of the storage.
+     * @param other The buffer to move from (left empty, without storage).
+     */
+    RingBuffer(RingBuffer&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator. Exchanges storage between buffers.
+     * @param other The buffer to move from.
+     * @return Reference to this buffer.
+     */
+    RingBuffer& operator=(RingBuffer&& other) noexcept;
+
+    /**
+     * @brief Destructor. Destroys all elements and releases the storage.
+     */
+    ~RingBuffer() noexcept;
+
+    // =============== Capacity ===============
+    /**
+     * @brief Returns the number of elements in the buffer.
+     * @return The current size of the buffer.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Checks if the buffer contains no elements.
+     * @return true if the buffer is empty, false otherwise.
+     */
+    [[nodiscard]] bool isEmpty() const noexcept;
+
+    /**
+     * @brief Returns the number of allocated slots.
+     * @return Number of elements the buffer can hold before it has to grow.
+     */
+    [[nodiscard]] size_t slotCapacity() const noexcept;
+
+    /**
+     * @brief Ensures room for at least @p minSlots elements without further allocation.
+     * @param minSlots Minimum number of slots required (rounded up to a power of two).
+     * @note Complexity: O(n) if the storage has to grow, O(1) otherwise.
+     */
+    void reserve(size_t minSlots);
+
+    // =============== Element access ===============
+    /**
+     * @brief Access the first element.
+     * @return A mutable reference to the front element.
+     * @throw std::runtime_error if the buffer is empty.
+     */
+    [[nodiscard]] T& front();
+
+    /**
+     * @brief Access the first element.
+     * @return A const reference to the front element.
+     * @throw std::runtime_error if the buffer is empty.
+     */
+    [[nodiscard]] const T& front() const;
+
+    /**
+     * @brief Access an element at a specific logical position with bounds checking.
+     * @param pos Zero-based position counted from the front.
+     * @return A mutable reference to the element.
+     * @throw std::out_of_range if the position is invalid.
+     */
+    [[nodiscard]] T& getAt(size_t pos);
+
+    /**
+     * @brief Access an element at a specific logical position with bounds checking.
+     * @param pos Zero-based position counted from the front.
+     * @return A const reference to the element.
+     * @throw std::out_of_range if the position is invalid.
+     */
+    [[nodiscard]] const T& getAt(size_t pos) const;
+
+    /**
+     * @brief Access an element at a specific logical position without bounds checking.
+     * @param pos Zero-based position counted from the front.
+     * @return A mutable reference to the element.
+     * @pre pos < size().
+     */
+    [[nodiscard]] T& operator[](size_t pos) noexcept;
+
+    /**
+     * @brief Access an element at a specific logical position without bounds checking.
+     * @param pos Zero-based position counted from the front.
+     * @return A const reference to the element.
+     * @pre pos < size().
+     */
+    [[nodiscard]] const T& operator[](size_t pos) const noexcept;
+
+    // =============== Modifiers ===============
+    /**
+     * @brief Destroys all elements. The storage is kept for reuse.
+     * @note Complexity: O(n).
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Adds an element to the back of the buffer by copying.
+     * @param val The value to be copied.
+     * @note Complexity: amortized O(1).
+     */
+    void pushBack(const T& val);
+
+    /**
+     * @brief Adds an element to the back of the buffer by moving.
+     * @param val The value to be moved.
+     * @note Complexity: amortized O(1).
+     */
+    void pushBack(T&& val);
+
+    /**
+     * @brief Constructs an element in place at the back of the buffer.
+     * @param args Arguments forwarded to the constructor of T.
+     * @return Reference to the new element.
+     * @note Complexity: amortized O(1).
+     */
+    template <typename... Args>
+    T& emplaceBack(Args&&... args);
+
+    /**
+     * @brief Removes the first element of the buffer.
+     * @throw std::runtime_error if the buffer is empty.
+     * @note Complexity: O(1).
+     */
+    void popFront();
+
+    /**
+     * @brief Removes the first element of the buffer and returns it by moving it out of its slot.
+     * @return The former front element.
+     * @throw std::runtime_error if the buffer is empty.
+     * @note Complexity: O(1).
+     */
+    T takeFront();
+
+    /**
+     * @brief Moves the first n elements, in order, to an output iterator and removes them.
+     * @param n Number of elements to take.
+     * @param out Iterator receiving the elements.
+     * @return The output iterator past the last element written.
+     * @throw std::out_of_range if n > size().
+     * @note Complexity: O(n), as at most two contiguous runs of slots.
+     */
+    template <typename OutputIt>
+    OutputIt takeFront(size_t n, OutputIt out);
+
+    /**
+     * @brief Removes the element at the specified logical position, preserving the order of the
+     * remaining elements.
+     * @param pos Zero-based position of the element to remove.
+     * @throw std::out_of_range if pos >= size().
+     * @note Complexity: O(min(pos, size() - pos)).
+     */
+    void removeAt(size_t pos);
+
+    // =============== Iteration ===============
+    /**
+     * @brief Returns an iterator to the front element.
+     * @return An Iterator at logical position 0.
+     */
+    [[nodiscard]] Iterator begin() noexcept;
+
+    /**
+     * @brief Returns an iterator past the back element.
+     * @return An Iterator at logical position size().
+     */
+    [[nodiscard]] Iterator end() noexcept;
+
+    /**
+     * @brief Returns a constant iterator to the front element.
+     * @return A ConstIterator at logical position 0.
+     */
+    [[nodiscard]] ConstIterator begin() const noexcept;
+
+    /**
+     * @brief Returns a constant iterator past the back element.
+     * @return A ConstIterator at logical position size().
+     */
+    [[nodiscard]] ConstIterator end() const noexcept;
+
+private:
+    // =============== Private Helpers ===============
+    /**
+     * @brief Maps a logical position to its slot index.
+     * @param pos Logical position counted from the front.
+     * @return Slot index inside @c slots.
+     * @pre slotCount > 0.
+     */
+    [[nodiscard]] size_t slotOf(size_t pos) const noexcept;
+
+    /**
+     * @brief Moves every element into a new block of @p newSlots slots, front first.
+     *
+     * If copying an element throws, the buffer is left unchanged.
+     *
+     * @param newSlots Slot count of the new block (power of two, >= size()).
+     */
+    void reallocate(size_t newSlots);
+
+    /**
+     * @brief Makes room for one more element, growing geometrically if the buffer is full.
+     */
+    void growIfFull();
+
+    /**
+     * @brief Rounds a slot request up to the next power of two.
+     * @param n Requested number of slots.
+     * @return Smallest power of two >= max(n, MIN_SLOTS).
+     */
+    [[nodiscard]] static size_t roundUpSlots(size_t n) noexcept;
+
+    /**
+     * @brief Efficiently swaps the internal state of two RingBuffer objects.
+     * @param other Buffer to swap with.
+     */
+    void swap(RingBuffer& other) noexcept;
+};
+
+// =============== Constructors & Destructor ===============
+template <typename T>
+RingBuffer<T>::RingBuffer() noexcept : slots(nullptr), slotCount(0), head(0), count(0) {}
+
+template <typename T>
+RingBuffer<T>::RingBuffer(size_t initialSlots) : RingBuffer() {
+    reserve(initialSlots);
+}
+
+template <typename T>
+RingBuffer<T>::RingBuffer(const RingBuffer& other) : RingBuffer() {
+    if (other.slotCount == 0) {
+        return;
+    }
+    slots     = std::allocator<T>{}.allocate(other.slotCount);
+    slotCount = other.slotCount;
+    try {
+        for (const auto& item : other) {
+            std::construct_at(slots + count, item);
+            ++count;
+        }
+    } catch (...) {
+        clear();
+        std::allocator<T>{}.deallocate(slots, slotCount);
+        throw;
+    }
+}
+
+template <typename T>
+RingBuffer<T>& RingBuffer<T>::operator=(const RingBuffer& other) {
+    if (this != &other) {
+        RingBuffer temp(other);
+        this->swap(temp);
+    }
+    return *this;
+}
+
+template <typename T>
+RingBuffer<T>::RingBuffer(RingBuffer&& other) noexcept
+    : slots(other.slots), slotCount(other.slotCount), head(other.head), count(other.count) {
+    other.slots     = nullptr;
+    other.slotCount = 0;
+    other.head      = 0;
+    other.count     = 0;
+}
+
+template <typename T>
+RingBuffer<T>& RingBuffer<T>::operator=(RingBuffer&& other) noexcept {
+    this->swap(other);
+    return *this;
+}
+
+template <typename T>
+RingBuffer<T>::~RingBuffer() noexcept {
+    clear();
+    if (slots) {
+        std::allocator<T>{}.deallocate(slots, slotCount);
+    }
+}
+
+// =============== Capacity ===============
+template <typename T>
+size_t RingBuffer<T>::size() const noexcept {
+    return count;
+}
+
+template <typename T>
+bool RingBuffer<T>::isEmpty() const noexcept {
+    return count == 0;
+}
+
+template <typename T>
+size_t RingBuffer<T>::slotCapacity() const noexcept {
+    return slotCount;
+}
+
+template <typename T>
+void RingBuffer<T>::reserve(size_t minSlots) {
+    if (minSlots > slotCount) {
+        reallocate(roundUpSlots(minSlots));
+    }
+}
+
+// =============== Element access ===============
+template <typename T>
+T& RingBuffer<T>::front() {
+    if (count == 0) {
+        throw std::runtime_error("RingBuffer is empty");
+    }
+    return slots[head];
+}
+
+template <typename T>
+const T& RingBuffer<T>::front() const {
+    if (count == 0) {
+        throw std::runtime_error("RingBuffer is empty");
+    }
+    return slots[head];
+}
+
+template <typename T>
+T& RingBuffer<T>::getAt(size_t pos) {
+    if (pos >= count) {
+        throw std::out_of_range("getAt: Index out of bounds");
+    }
+    return slots[slotOf(pos)];
+}
+
+template <typename T>
+const T& RingBuffer<T>::getAt(size_t pos) const {
+    if (pos >= count) {
+        throw std::out_of_range("getAt: Index out of bounds");
+    }
+    return slots[slotOf(pos)];
+}
+
+template <typename T>
+T& RingBuffer<T>::operator[](size_t pos) noexcept {
+    return slots[slotOf(pos)];
+}
+
+template <typename T>
+const T& RingBuffer<T>::operator[](size_t pos) const noexcept {
+    return slots[slotOf(pos)];
+}
+
+// =============== Modifiers ===============
+template <typename T>
+void RingBuffer<T>::clear() noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        std::destroy_at(slots + slotOf(i));
+    }
+    head  = 0;
+    count = 0;
+}
+
+template <typename T>
+void RingBuffer<T>::pushBack(const T& val) {
+    emplaceBack(val);
+}
+
+template <typename T>
+void RingBuffer<T>::pushBack(T&& val) {
+    emplaceBack(std::move(val));
+}
+
+template <typename T>
+template <typename... Args>
+T& RingBuffer<T>::emplaceBack(Args&&... args) {
+    growIfFull();
+    T* slot = std::construct_at(slots + slotOf(count), std::forward<Args>(args)...);
+    ++count;
+    return *slot;
+}
+
+template <typename T>
+void RingBuffer<T>::popFront() {
+    if (count == 0) {
+        throw std::runtime_error("RingBuffer is empty");
+    }
+    std::destroy_at(slots + head);
+    head = (head + 1) & (slotCount - 1);
+    --count;
+}
+
+template <typename T>
+T RingBuffer<T>::takeFront() {
+    if (count == 0) {
+        throw std::runtime_error("RingBuffer is empty");
+    }
+    T value(std::move(slots[head]));
+    std::destroy_at(slots + head);
+    head = (head + 1) & (slotCount - 1);
+    --count;
+    return value;
+}
+
+template <typename T>
+template <typename OutputIt>
+OutputIt RingBuffer<T>::takeFront(size_t n, OutputIt out) {
+    if (n > count) {
+        throw std::out_of_range("Not enough elements in RingBuffer");
+    }
+    if (n == 0) {
+        return out;
+    }
+
+    // The taken elements span the tail of the slot block and then, if they wrap, its start
+    const size_t firstRun = std::min(n, slotCount - head);
+    out = std::move(slots + head, slots + head + firstRun, out);
+    out = std::move(slots, slots + (n - firstRun), out);
+    std::destroy(slots + head, slots + head + firstRun);
+    std::destroy(slots, slots + (n - firstRun));
+
+    head = (head + n) & (slotCount - 1);
+    count -= n;
+    return out;
+}
+
+template <typename T>
+void RingBuffer<T>::removeAt(size_t pos) {
+    if (pos >= count) {
+        throw std::out_of_range("Index out of bounds");
+    }
+
+    if (pos < count / 2) {
+        // Closer to the front: shift the preceding elements one slot towards the back
+        for (size_t i = pos; i > 0; --i) {
+            (*this)[i] = std::move((*this)[i - 1]);
+        }
+        std::destroy_at(slots + head);
+        head = (head + 1) & (slotCount - 1);
+    } else {
+        // Closer to the back: shift the following elements one slot towards the front
+        for (size_t i = pos; i + 1 < count; ++i) {
+            (*this)[i] = std::move((*this)[i + 1]);
+        }
+        std::destroy_at(slots + slotOf(count - 1));
+    }
+    --count;
+}
+
+// =============== Iteration ===============
+template <typename T>
+RingBuffer<T>::Iterator RingBuffer<T>::begin() noexcept {
+    return Iterator(this, 0);
+}
+
+template <typename T>
+RingBuffer<T>::Iterator RingBuffer<T>::end() noexcept {
+    return Iterator(this, count);
+}
+
+template <typename T>
+RingBuffer<T>::ConstIterator RingBuffer<T>::begin() const noexcept {
+    return ConstIterator(this, 0);
+}
+
+template <typename T>
+RingBuffer<T>::ConstIterator RingBuffer<T>::end() const noexcept {
+    return ConstIterator(this, count);
+}
+
+// =============== Private Helpers ===============
+template <typename T>
+size_t RingBuffer<T>::slotOf(size_t pos) const noexcept {
+    return (head + pos) & (slotCount - 1);
+}
+
+template <typename T>
+void RingBuffer<T>::reallocate(size_t newSlots) {
+    T* newStorage = std::allocator<T>{}.allocate(newSlots);
+
+    // Elements are only moved when that cannot throw, so if a copy throws the old slots are
+    // intact and dropping the partial copy keeps the buffer unchanged
+    size_t built = 0;
+    try {
+        for (; built < count; ++built) {
+            std::construct_at(newStorage + built, std::move_if_noexcept(slots[slotOf(built)]));
+        }
+    } catch (...) {
+        std::destroy_n(newStorage, built);
+        std::allocator<T>{}.deallocate(newStorage, newSlots);
+        throw;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        std::destroy_at(slots + slotOf(i));
+    }
+
+    if (slots) {
+        std::allocator<T>{}.deallocate(slots, slotCount);
+    }
+    slots     = newStorage;
+    slotCount = newSlots;
+    head      = 0;
+}
+
+template <typename T>
+void RingBuffer<T>::growIfFull() {
+    if (count == slotCount) {
+        reallocate(slotCount == 0 ? MIN_SLOTS : slotCount * 2);
+    }
+}
+
+template <typename T>
+size_t RingBuffer<T>::roundUpSlots(size_t n) noexcept {
+    size_t slots = MIN_SLOTS;
+    while (slots < n) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+template <typename T>
+void RingBuffer<T>::swap(RingBuffer& other) noexcept {
+    std::swap(slots, other.slots);
+    std::swap(slotCount, other.slotCount);
+    std::swap(head, other.head);
+    std::swap(count, other.count);
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SpscRing
+ * @brief Bounded lock-free queue between exactly one producer thread and one consumer thread.
+ *
+ * Elements live in a power-of-two block of slots indexed by two ever-growing counters: the
+ * producer owns the tail and the consumer the head, each on its own cache line. A batch is
+ * published with a single release store of the tail and claimed with a single release store of
+ * the head, and each side keeps a private copy of the other side's counter so that it only reads
+ * the shared one when its copy says the ring is full or empty.
+ *
+ * Construction, moves and clear() are not thread-safe and must happen while neither side runs.
+ *
+ * @tparam T Trivially copyable type of the elements.
+ */
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "Ring slots are copied as raw values");
+
+    static constexpr size_t LINE = 64; /**< Cache line size used to separate the counters */
+
+    T* slots;    /**< Raw storage for mask + 1 elements */
+    size_t mask; /**< Slot count minus one (slot count is a power of two) */
+
+    alignas(LINE) std::atomic<size_t> head; /**< Elements consumed, written by the consumer */
+    size_t cachedTail;                      /**< Consumer's last view of the tail */
+
+    alignas(LINE) std::atomic<size_t> tail; /**< Elements published, written by the producer */
+    size_t cachedHead;                      /**< Producer's last view of the head */
+
+public:
+    // =============== Constructors & Destructor ===============
+    /**
+     * @brief Constructor for SpscRing.
+     *
+     * @param capacity Elements the ring must hold, rounded up to a power of two (at least 1).
+     */
+    explicit SpscRing(size_t capacity = 1)
+        : slots(nullptr), mask(0), head(0), cachedTail(0), tail(0), cachedHead(0) {
+        const size_t slotCount = std::bit_ceil(std::max<size_t>(capacity, 1));
+        slots                  = std::allocator<T>{}.allocate(slotCount);
+        mask                   = slotCount - 1;
+    }
+
+    /**
+     * @brief Destructor, releases the slots. Elements are trivially destructible.
+     */
+    ~SpscRing() {
+        if (slots) {
+            std::allocator<T>{}.deallocate(slots, mask + 1);
+        }
+    }
+
+    /**
+     * @brief Deleted copy constructor, a ring is shared by reference between its two threads.
+     */
+    SpscRing(const SpscRing&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator, a ring is shared by reference between its two
+     * threads.
+     *
+     * @return Reference to this ring.
+     */
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Move constructor, takes over the slots and contents of another ring.
+     *
+     * @param other Ring to move from, left without slots.
+     */
+    SpscRing(SpscRing&& other) noexcept
+        : slots(std::exchange(other.slots, nullptr)),
+          mask(std::exchange(other.mask, 0)),
+          head(other.head.load(std::memory_order_relaxed)),
+          cachedTail(other.cachedTail),
+          tail(other.tail.load(std::memory_order_relaxed)),
+          cachedHead(other.cachedHead) {}
+
+    /**
+     * @brief Move assignment operator, takes over the slots and contents of another ring.
+     *
+     * @param other Ring to move from, left without slots.
+     * @return Reference to this ring.
+     */
+    SpscRing& operator=(SpscRing&& other) noexcept {
+        if (this != &other) {
+            this->~SpscRing();
+            std::construct_at(this, std::move(other));
+        }
+        return *this;
+    }
+
+    // =============== Producer ===============
+    /**
+     * @brief Appends elements in order until the ring is full, publishing them all at once.
+     * Called by the producer only.
+     *
+     * @param values Elements to append.
+     * @return Number of elements appended, always a prefix of @p values.
+     */
+    size_t pushBatch(std::span<const T> values) noexcept {
+        const size_t end = tail.load(std::memory_order_relaxed);
+        if (end - cachedHead + values.size() > mask + 1) {
+            cachedHead = head.load(std::memory_order_acquire);
+        }
+        const size_t count = std::min(values.size(), mask + 1 - (end - cachedHead));
+        for (size_t i = 0; i < count; ++i) {
+            std::construct_at(slots + ((end + i) & mask), values[i]);
+        }
+        tail.store(end + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Appends an element if the ring has room. Called by the producer only.
+     *
+     * @param value Element to append.
+     * @return true if the element was appended, false if the ring is full.
+     */
+    bool tryPush(const T& value) noexcept { return pushBatch(std::span(&value, 1)) == 1; }
+
+    /**
+     * @brief Gets the number of elements pushed since the ring was built or cleared. Called by
+     * the producer only; the consumer can pass the value to popUntil() to take exactly the
+     * elements pushed so far.
+     *
+     * @return Elements pushed.
+     */
+    [[nodiscard]] size_t pushedCount() const noexcept {
+        return tail.load(std::memory_order_relaxed);
+    }
+
+    // =============== Consumer ===============
+    /**
+     * @brief Moves every published element to the back of a vector and frees their slots.
+     * Called by the consumer only.
+     *
+     * @param out Vector receiving the elements, in FIFO order.
+     * @return Number of elements moved.
+     */
+    size_t popAll(std::vector<T>& out) {
+        if (head.load(std::memory_order_relaxed) == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+        }
+        return popUntil(cachedTail, out);
+    }
+
+    /**
+     * @brief Moves the elements pushed before the producer's pushedCount() reached @p end to the
+     * back of a vector and frees their slots. Called by the consumer only.
+     *
+     * @param end Value of pushedCount() the producer published, at or after the elements
+     * consumed so far.
+     * @param out Vector receiving the elements, in FIFO order.
+     * @return Number of elements moved.
+     */
+    size_t popUntil(size_t end, std::vector<T>& out) {
+        const size_t begin = head.load(std::memory_order_relaxed);
+        const size_t count = end - begin;
+        out.reserve(out.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            out.push_back(slots[(begin + i) & mask]);
+        }
+        head.store(end, std::memory_order_release);
+        return count;
+    }
+
+    // =============== Query methods ===============
+    /**
+     * @brief Gets the number of elements the ring holds when full.
+     *
+     * @return Slot count.
+     */
+    [[nodiscard]] size_t capacity() const noexcept { return mask + 1; }
+
+    /**
+     * @brief Gets the number of published elements not consumed yet. Exact only when neither
+     * side is running.
+     *
+     * @return Elements in the ring.
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Checks whether the ring holds no elements. Exact only when neither side is running.
+     *
+     * @return true if the ring is empty.
+     */
+    [[nodiscard]] bool isEmpty() const noexcept { return size() == 0; }
+
+    // =============== Buffer Management ===============
+    /**
+     * @brief Drops every element. Not thread-safe.
+     */
+    void clear() noexcept {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        cachedHead = 0;
+        cachedTail = 0;
+    }
+};
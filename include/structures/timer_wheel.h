@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @class TimerWheel
+ * @brief Hashed timing wheel that releases scheduled entries once their deadline tick is reached.
+ *
+ * Entries are filed in the slot of their deadline modulo the number of slots, and advancing the
+ * wheel only visits the slots of the ticks that elapsed. Expiring entries therefore costs
+ * O(expired) as long as deadlines stay within one revolution of the wheel; an entry further away
+ * is simply carried over each time its slot comes around until its deadline is reached.
+ *
+ * The wheel does not support cancelling: owners that drop an entry early keep it scheduled and
+ * ignore it when it fires.
+ *
+ * @tparam T The type of the scheduled entries.
+ */
+template <typename T>
+class TimerWheel {
+public:
+    static constexpr size_t DEF_SLOTS = 256; /**< Default number of slots (ticks per revolution) */
+
+private:
+    /**
+     * @struct Timer
+     * @brief A scheduled entry.
+     */
+    struct Timer {
+        size_t deadline; /**< Tick at which the entry expires */
+        T value;         /**< Scheduled entry */
+    };
+
+    std::vector<std::vector<Timer>> slots; /**< One bucket per tick, indexed by tick & mask */
+    size_t mask;                           /**< Number of slots minus one */
+    size_t current;                        /**< Last tick the wheel was advanced to */
+    size_t count;                          /**< Number of scheduled entries */
+
+public:
+    /**
+     * @brief Constructor for TimerWheel.
+     * @param slotCount Minimum number of slots; rounded up to a power of two.
+     */
+    explicit TimerWheel(size_t slotCount = DEF_SLOTS);
+
+    /**
+     * @brief Schedules an entry.
+     * @param deadline Tick at which the entry expires. Deadlines that have already passed expire
+     * on the next advance.
+     * @param value Entry to schedule.
+     */
+    void schedule(size_t deadline, T value);
+
+    /**
+     * @brief Advances the wheel, releasing every entry whose deadline is at or before a tick.
+     * @param now Tick to advance to; ticks before the current one are ignored.
+     * @param onExpire Callable invoked with each expired entry; it must not schedule on this wheel.
+     * @return Number of entries released.
+     */
+    template <typename Callback>
+    size_t advance(size_t now, Callback&& onExpire);
+
+    /**
+     * @brief Gets the number of scheduled entries.
+     * @return Number of entries not yet released.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Gets the last tick the wheel was advanced to.
+     * @return Current tick of the wheel.
+     */
+    [[nodiscard]] size_t getCurrentTick() const noexcept;
+};
+
+template <typename T>
+TimerWheel<T>::TimerWheel(size_t slotCount) : current(0), count(0) {
+    size_t rounded = 1;
+    while (rounded < slotCount) {
+        rounded *= 2;
+    }
+    slots.resize(rounded);
+    mask = rounded - 1;
+}
+
+template <typename T>
+void TimerWheel<T>::schedule(size_t deadline, T value) {
+    const size_t tick = std::max(deadline, current + 1);
+    slots[tick & mask].push_back({deadline, std::move(value)});
+    count++;
+}
+
+template <typename T>
+template <typename Callback>
+size_t TimerWheel<T>::advance(size_t now, Callback&& onExpire) {
+    if (now <= current) {
+        return 0;
+    }
+
+    // A jump of a full revolution or more visits every slot exactly once
+    const size_t steps = std::min(now - current, slots.size());
+    size_t released    = 0;
+
+    for (size_t tick = current + 1; tick <= current + steps; ++tick) {
+        std::vector<Timer>& bucket = slots[tick & mask];
+
+        size_t kept = 0;
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            if (bucket[i].deadline <= now) {
+                onExpire(std::move(bucket[i].value));
+                released++;
+            } else {
+                if (kept != i) {
+                    bucket[kept] = std::move(bucket[i]);
+                }
+                kept++;
+            }
+        }
+        bucket.erase(bucket.begin() + static_cast<std::ptrdiff_t>(kept), bucket.end());
+    }
+
+    current = now;
+    count -= released;
+
+    return released;
+}
+
+template <typename T>
+size_t TimerWheel<T>::size() const noexcept {
+    return count;
+}
+
+template <typename T>
+size_t TimerWheel<T>::getCurrentTick() const noexcept {
+    return current;
+}
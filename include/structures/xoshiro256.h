@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Xoshiro256
+ * @brief xoshiro256** pseudo-random generator with jump-ahead, usable with the standard
+ * distributions.
+ *
+ * jump() advances the generator by 2^128 draws and longJump() by 2^192, so copies of one master
+ * generator, each jumped a different number of times, form independent streams that never overlap.
+ * Handing those out by position instead of by thread keeps every result reproducible from a single
+ * seed, whatever the number of threads drawing from them.
+ */
+class Xoshiro256 {
+    std::array<uint64_t, 4> state; /**< Generator state, never all zero */
+
+public:
+    using result_type = uint64_t; /**< Type of the generated numbers */
+
+    /** Seed used when none is given */
+    static constexpr uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+
+    /**
+     * @brief Constructor for Xoshiro256.
+     *
+     * @param seed Seed expanded into the full state with SplitMix64.
+     */
+    explicit Xoshiro256(uint64_t seed = DEFAULT_SEED) noexcept { this->seed(seed); }
+
+    /**
+     * @brief Reseeds the generator.
+     *
+     * @param seed Seed expanded into the full state with SplitMix64.
+     */
+    void seed(uint64_t seed) noexcept {
+        for (uint64_t& word : state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word       = z ^ (z >> 31);
+        }
+    }
+
+    /**
+     * @brief Gets the smallest value the generator returns.
+     *
+     * @return 0.
+     */
+    static constexpr result_type min() noexcept { return 0; }
+
+    /**
+     * @brief Gets the largest value the generator returns.
+     *
+     * @return The largest 64-bit value.
+     */
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * @brief Draws the next number.
+     *
+     * @return A uniformly distributed 64-bit value.
+     */
+    result_type operator()() noexcept {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t      = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * @brief Advances the generator by 2^128 draws.
+     */
+    void jump() noexcept {
+        static constexpr std::array<uint64_t, 4> JUMP = {
+            0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+            0x39ABDC4529B1661CULL};
+        advance(JUMP);
+    }
+
+    /**
+     * @brief Advances the generator by 2^192 draws.
+     */
+    void longJump() noexcept {
+        static constexpr std::array<uint64_t, 4> LONG_JUMP = {
+            0x76E15D3EFEFDCBBFULL, 0xC5004E441C522FB3ULL, 0x77710069854EE241ULL,
+            0x39109BB02ACBE635ULL};
+        advance(LONG_JUMP);
+    }
+
+    /**
+     * @brief Compares the state of two generators.
+     *
+     * @return true if both generators will draw the same sequence.
+     */
+    friend bool operator==(const Xoshiro256&, const Xoshiro256&) = default;
+
+private:
+    /**
+     * @brief Rotates a word left.
+     *
+     * @param x Word to rotate.
+     * @param k Number of bits (0 < k < 64).
+     * @return The rotated word.
+     */
+    static constexpr uint64_t rotl(uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /**
+     * @brief Applies a jump polynomial to the state.
+     *
+     * @param polynomial Jump polynomial, lowest word first.
+     */
+    void advance(const std::array<uint64_t, 4>& polynomial) noexcept {
+        std::array<uint64_t, 4> jumped{};
+        for (const uint64_t word : polynomial) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (uint64_t{1} << bit)) {
+                    for (size_t i = 0; i < state.size(); ++i) {
+                        jumped[i] ^= state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        state = jumped;
+    }
+};
@@ -1,4 +1,5 @@
 #include "core/Admin.h"
+#include "core/Profiler.h"
 
 int main() {
     Network network{};
@@ -8,6 +9,9 @@ int main() {
 
     std::cout << "\n=== FINAL REPORT ===\n";
     admin.printReport();
+    if constexpr (Profiler::ENABLED) {
+        admin.printProfile();
+    }
 
     return 0;
 }
@@ -1,116 +1,295 @@
 #include "algorithms/Dijkstra.h"
 
 #include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "core/Router.h"
+#include "core/ThreadPool.h"
 
 RoutingTable DijkstraAlgorithm::computeRoutingTable(const List<const Router*>& routers,
                                                     IPAddress sourceIP) {
-    const size_t routerCount = routers.size();
-    // Initialize distances, visited and parents
-    List<DistanceInfo> distances;
-    for (size_t i = 0; i < routerCount; ++i) {
-        distances.pushBack(DistanceInfo{});
+    const TopologySnapshot topology(routers);
+
+    const size_t sourceIndex = topology.indexOf(sourceIP);
+    if (sourceIndex == TopologySnapshot::NO_INDEX ||
+        topology.getRouterIP(sourceIndex) != sourceIP) {
+        throw std::runtime_error("No such router");
     }
 
-    // Get index of source router
-    const size_t sourceIndex = getRouterIndex(routers, sourceIP);
+    return computeRoutingTable(topology, sourceIndex);
+}
 
-    // Set source router distance to 0 and parent to itself
-    distances[sourceIndex].distance = 0;
-    distances[sourceIndex].parent   = sourceIP;
+RoutingTable DijkstraAlgorithm::computeRoutingTable(const TopologySnapshot& topology,
+                                                    size_t sourceIndex, size_t maxPaths,
+                                                    size_t slack) {
+    const size_t routerCount = topology.routerCount();
+    if (sourceIndex >= routerCount) {
+        throw std::out_of_range("Source router index out of range");
+    }
+    checkPathCount(maxPaths);
+    if (maxPaths > 1 && slack > 0) {
+        // Only the rows of the source and its neighbors are read
+        std::vector<std::vector<Cost>> costs(routerCount);
+        costs[sourceIndex] = pathCosts(topology, sourceIndex);
+        for (const size_t neighbor : topology.neighbors(sourceIndex)) {
+            costs[neighbor] = pathCosts(topology, neighbor);
+        }
+        return computeNearEqualTable(topology, sourceIndex, maxPaths, slack, costs);
+    }
+    if (maxPaths > 1) {
+        return computeMultipathTable(topology, sourceIndex, maxPaths);
+    }
 
-    // Dijkstra's algorithm main loop
-    for (size_t i = 0; i < routerCount; ++i) {
-        // Find an unvisited router with minimum distance
-        const size_t currentIndex = findMinDistance(distances, routerCount);
+    // Distance and first hop (router index) of every router, as seen from the source
+    std::vector<size_t> distances(routerCount, INF);
+    std::vector<size_t> firstHops(routerCount, TopologySnapshot::NO_INDEX);
 
-        if (currentIndex == std::numeric_limits<size_t>::max()) {
-            break;  // All reachable routers visited, exit the main loop
-        }
+    // Min-heap of (distance, router index); stale entries are skipped when popped. Ties pop the
+    // lowest index first, matching the order of the former linear minimum search.
+    using HeapEntry = std::pair<size_t, size_t>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<>> heap;
 
-        distances[currentIndex].visited = true;  // Mark the current router as visited
+    distances[sourceIndex] = 0;
+    heap.emplace(0, sourceIndex);
 
-        // Get connections of the current router
-        auto neighborIPs = routers[currentIndex]->getNeighborIPs();
-        // Update distances for neighbors
-        for (const IPAddress& neighborIP : neighborIPs) {
-            const size_t neighborIndex = getRouterIndex(routers, neighborIP);
-            if (distances[neighborIndex].visited) {
-                continue;
-            }
+    while (!heap.empty()) {
+        const auto [distance, current] = heap.top();
+        heap.pop();
+
+        if (distance != distances[current]) {
+            continue;  // Stale entry, a shorter path was already settled
+        }
 
-            const size_t bufferLoad = routers[currentIndex]->getNeighborBufferUsage(neighborIP);
-            const size_t newDist    = distances[currentIndex].distance + bufferLoad;
+        const auto neighbors = topology.neighbors(current);
+        const auto weights   = topology.weights(current);
 
-            if (newDist < distances[neighborIndex].distance) {
-                distances[neighborIndex].distance = newDist;
-                distances[neighborIndex].parent   = routers[currentIndex]->getIP();
+        for (size_t e = 0; e < neighbors.size(); ++e) {
+            const size_t neighbor = neighbors[e];
+            const size_t newDist  = distance + weights[e];
+
+            if (newDist < distances[neighbor]) {
+                distances[neighbor] = newDist;
+                // Direct neighbors of the source are their own first hop
+                firstHops[neighbor] = current == sourceIndex ? neighbor : firstHops[current];
+                heap.emplace(newDist, neighbor);
             }
         }
     }
 
-    // Build routing table from distances
-    RoutingTable routingTable{};
+    // Build routing table from first hops
+    RoutingTable routingTable(routerCount);
 
     for (size_t i = 0; i < routerCount; ++i) {
         // Ignore the source router itself and unreachable routers
-        if (i == sourceIndex || distances[i].distance == INF) {
+        if (i == sourceIndex || distances[i] == INF) {
             continue;
         }
 
-        // Get the destination router IP
-        const IPAddress destIP = routers[i]->getIP();
+        routingTable.setNextHopIP(topology.getRouterIP(i), topology.getRouterIP(firstHops[i]));
+    }
+
+    return routingTable;
+}
+
+RoutingTable DijkstraAlgorithm::computeMultipathTable(const TopologySnapshot& topology,
+                                                      size_t sourceIndex, size_t maxPaths) {
+    const size_t routerCount = topology.routerCount();
+
+    // Cost of every router as (total weight, hops), and its first hops, maxPaths per router
+    std::vector<Cost> costs(routerCount, Cost{INF, INF});
+    std::vector<size_t> firstHops(routerCount * maxPaths);
+    std::vector<size_t> hopCounts(routerCount, 0);
+
+    // Merges the first hops of a router into those of its successor on a shortest path
+    const auto mergeFirstHops = [&](size_t target, size_t current) {
+        size_t* targetHops  = &firstHops[target * maxPaths];
+        size_t& targetCount = hopCounts[target];
+        const auto addHop   = [&](size_t hop) {
+            if (targetCount < maxPaths &&
+                std::find(targetHops, targetHops + targetCount, hop) == targetHops + targetCount) {
+                targetHops[targetCount++] = hop;
+            }
+        };
+
+        if (current == sourceIndex) {
+            addHop(target);  // Direct neighbors of the source are their own first hop
+            return;
+        }
+        for (size_t k = 0; k < hopCounts[current]; ++k) {
+            addHop(firstHops[current * maxPaths + k]);
+        }
+    };
+
+    using HeapEntry = std::pair<Cost, size_t>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<>> heap;
 
-        // Trace back from destination to source to find the next hop
-        IPAddress currentIP = destIP;
-        IPAddress parentIP  = distances[i].parent;
+    costs[sourceIndex] = Cost{0, 0};
+    heap.emplace(costs[sourceIndex], sourceIndex);
 
-        while (parentIP != sourceIP) {
-            currentIP = parentIP;
+    while (!heap.empty()) {
+        const auto [cost, current] = heap.top();
+        heap.pop();
 
-            // Get index of the parent router to continue tracing back
-            const size_t pIdx = getRouterIndex(routers, parentIP);
-            parentIP          = distances[pIdx].parent;
+        if (cost != costs[current]) {
+            continue;  // Stale entry
         }
 
-        // Set the next hop for this destination in the routing table
-        routingTable.setNextHopIP(destIP, currentIP);
+        // Every router tied on a shortest path to current was settled before it, so its first
+        // hops are final by now
+        const auto neighbors = topology.neighbors(current);
+        const auto weights   = topology.weights(current);
+
+        for (size_t e = 0; e < neighbors.size(); ++e) {
+            const size_t neighbor = neighbors[e];
+            const Cost newCost{cost.first + weights[e], cost.second + 1};
+
+            if (newCost < costs[neighbor]) {
+                costs[neighbor]     = newCost;
+                hopCounts[neighbor] = 0;
+                mergeFirstHops(neighbor, current);
+                heap.emplace(newCost, neighbor);
+            } else if (newCost == costs[neighbor]) {
+                mergeFirstHops(neighbor, current);
+            }
+        }
+    }
+
+    RoutingTable routingTable(routerCount);
+    for (size_t i = 0; i < routerCount; ++i) {
+        if (i == sourceIndex || costs[i].first == INF) {
+            continue;
+        }
+
+        const IPAddress destIP = topology.getRouterIP(i);
+        for (size_t k = 0; k < hopCounts[i]; ++k) {
+            routingTable.addNextHopIP(destIP, topology.getRouterIP(firstHops[i * maxPaths + k]));
+        }
     }
 
     return routingTable;
 }
 
-void DijkstraAlgorithm::computeAllRoutingTables(const List<const Router*>& routers,
-                                                List<RoutingTable>& tables) {
-    tables.clear();
+RoutingTable DijkstraAlgorithm::computeNearEqualTable(const TopologySnapshot& topology,
+                                                      size_t sourceIndex, size_t maxPaths,
+                                                      size_t slack,
+                                                      const std::vector<std::vector<Cost>>& costs) {
+    const size_t routerCount = topology.routerCount();
+    const std::vector<Cost>& sourceCosts = costs[sourceIndex];
+
+    const auto neighbors = topology.neighbors(sourceIndex);
+    const auto weights   = topology.weights(sourceIndex);
+
+    RoutingTable routingTable(routerCount);
+    std::vector<std::pair<Cost, size_t>> candidates;
+    for (size_t i = 0; i < routerCount; ++i) {
+        if (i == sourceIndex || sourceCosts[i].first == INF) {
+            continue;
+        }
 
-    for (const auto* router : routers) {
-        RoutingTable table = computeRoutingTable(routers, router->getIP());
+        // A neighbor strictly closer to the destination never routes back through the source, so
+        // every hop of a forwarded packet gets closer and the paths cannot loop
+        candidates.clear();
+        for (size_t e = 0; e < neighbors.size(); ++e) {
+            const Cost& rest = costs[neighbors[e]][i];
+            if (rest < sourceCosts[i] && rest.first + weights[e] - sourceCosts[i].first <= slack) {
+                candidates.emplace_back(Cost{rest.first + weights[e], rest.second + 1}, e);
+            }
+        }
+        std::ranges::sort(candidates);
 
-        tables.pushBack(table);
+        const IPAddress destIP = topology.getRouterIP(i);
+        for (size_t k = 0; k < candidates.size() && k < maxPaths; ++k) {
+            const size_t hop = neighbors[candidates[k].second];
+            routingTable.addNextHopIP(destIP, topology.getRouterIP(hop));
+        }
     }
+
+    return routingTable;
 }
 
-size_t DijkstraAlgorithm::getRouterIndex(const List<const Router*>& routers, IPAddress routerIP) {
-    const auto it = std::find_if(routers.begin(), routers.end(),
-                                 [&routerIP](const auto& r) { return r->getIP() == routerIP; });
+auto DijkstraAlgorithm::pathCosts(const TopologySnapshot& topology, size_t sourceIndex)
+    -> std::vector<Cost> {
+    std::vector<Cost> costs(topology.routerCount(), Cost{INF, INF});
 
-    if (it == routers.end()) {
-        throw std::runtime_error("No such router");
+    using HeapEntry = std::pair<Cost, size_t>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<>> heap;
+
+    costs[sourceIndex] = Cost{0, 0};
+    heap.emplace(costs[sourceIndex], sourceIndex);
+
+    while (!heap.empty()) {
+        const auto [cost, current] = heap.top();
+        heap.pop();
+
+        if (cost != costs[current]) {
+            continue;  // Stale entry
+        }
+
+        const auto neighbors = topology.neighbors(current);
+        const auto weights   = topology.weights(current);
+
+        for (size_t e = 0; e < neighbors.size(); ++e) {
+            const Cost newCost{cost.first + weights[e], cost.second + 1};
+            if (newCost < costs[neighbors[e]]) {
+                costs[neighbors[e]] = newCost;
+                heap.emplace(newCost, neighbors[e]);
+            }
+        }
     }
 
-    return std::distance(routers.begin(), it);
+    return costs;
+}
+
+void DijkstraAlgorithm::checkPathCount(size_t maxPaths) {
+    if (maxPaths == 0 || maxPaths > RoutingTable::MAX_PATHS) {
+        throw std::invalid_argument("Path count out of range");
+    }
+}
+
+void DijkstraAlgorithm::computeAllRoutingTables(const List<const Router*>& routers,
+                                                List<RoutingTable>& tables) {
+    tables.clear();
+
+    const TopologySnapshot topology(routers);
+
+    for (size_t i = 0; i < topology.routerCount(); ++i) {
+        tables.pushBack(computeRoutingTable(topology, i));
+    }
 }
 
-size_t DijkstraAlgorithm::findMinDistance(const List<DistanceInfo>& distances, size_t routerCount) {
-    size_t minDistance  = INF;
-    size_t currentIndex = std::numeric_limits<size_t>::max();
-    for (size_t j = 0; j < routerCount; j++) {
-        if (!distances[j].visited && distances[j].distance < minDistance) {
-            minDistance  = distances[j].distance;
-            currentIndex = j;
+void DijkstraAlgorithm::computeAllRoutingTables(const TopologySnapshot& topology,
+                                                std::vector<RoutingTable>& tables,
+                                                ThreadPool* pool, size_t maxPaths,
+                                                size_t slack) {
+    const size_t routerCount = topology.routerCount();
+    checkPathCount(maxPaths);
+    tables.clear();
+    tables.resize(routerCount);
+
+    // Each iteration writes only its own slot, so no synchronization is needed
+    const auto forEachRouter = [&](const std::function<void(size_t)>& body) {
+        if (!pool) {
+            for (size_t i = 0; i < routerCount; ++i) {
+                body(i);
+            }
+            return;
         }
+        pool->parallelFor(routerCount, body);
+    };
+
+    if (maxPaths > 1 && slack > 0) {
+        // Every source reads the rows of its neighbors, so each row is computed once and shared
+        std::vector<std::vector<Cost>> costs(routerCount);
+        forEachRouter([&](size_t i) { costs[i] = pathCosts(topology, i); });
+        forEachRouter([&](size_t i) {
+            tables[i] = computeNearEqualTable(topology, i, maxPaths, slack, costs);
+        });
+        return;
     }
-    return currentIndex;
+
+    forEachRouter([&](size_t i) { tables[i] = computeRoutingTable(topology, i, maxPaths, slack); });
 }
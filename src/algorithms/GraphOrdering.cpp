@@ -0,0 +1,82 @@
+#include "algorithms/GraphOrdering.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+std::vector<size_t> GraphOrdering::breadthFirst(size_t nodeCount, const std::vector<Link>& links) {
+    const std::vector<std::vector<size_t>> neighbors = adjacency(nodeCount, links);
+
+    std::vector<size_t> roots(nodeCount);
+    std::iota(roots.begin(), roots.end(), size_t{0});
+    return search(neighbors, roots);
+}
+
+std::vector<size_t> GraphOrdering::reverseCuthillMcKee(size_t nodeCount,
+                                                       const std::vector<Link>& links) {
+    std::vector<std::vector<size_t>> neighbors = adjacency(nodeCount, links);
+
+    const auto byDegree = [&neighbors](size_t a, size_t b) {
+        const size_t degreeA = neighbors[a].size();
+        const size_t degreeB = neighbors[b].size();
+        return degreeA != degreeB ? degreeA < degreeB : a < b;
+    };
+    for (auto& list : neighbors) {
+        std::ranges::sort(list, byDegree);
+    }
+
+    std::vector<size_t> roots(nodeCount);
+    std::iota(roots.begin(), roots.end(), size_t{0});
+    std::ranges::sort(roots, byDegree);
+
+    std::vector<size_t> order = search(neighbors, roots);
+    std::ranges::reverse(order);
+    return order;
+}
+
+std::vector<size_t> GraphOrdering::search(const std::vector<std::vector<size_t>>& neighbors,
+                                          const std::vector<size_t>& roots) {
+    std::vector<size_t> order;
+    order.reserve(neighbors.size());
+    std::vector<bool> visited(neighbors.size(), false);
+
+    for (size_t root : roots) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        order.push_back(root);
+
+        // The order itself serves as the queue: nodes past `head` are still to be expanded
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            for (size_t next : neighbors[order[head]]) {
+                if (!visited[next]) {
+                    visited[next] = true;
+                    order.push_back(next);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+std::vector<std::vector<size_t>> GraphOrdering::adjacency(size_t nodeCount,
+                                                          const std::vector<Link>& links) {
+    std::vector<std::vector<size_t>> neighbors(nodeCount);
+    for (const auto& [a, b] : links) {
+        if (a >= nodeCount || b >= nodeCount) {
+            throw std::invalid_argument("Link refers to a node outside the graph");
+        }
+        if (a != b) {
+            neighbors[a].push_back(b);
+            neighbors[b].push_back(a);
+        }
+    }
+
+    for (auto& list : neighbors) {
+        std::ranges::sort(list);
+        const auto [first, last] = std::ranges::unique(list);
+        list.erase(first, last);
+    }
+    return neighbors;
+}
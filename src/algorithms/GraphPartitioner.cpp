@@ -0,0 +1,113 @@
+#include "algorithms/GraphPartitioner.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "algorithms/GraphOrdering.h"
+
+std::vector<size_t> GraphPartitioner::partition(const TopologySnapshot& topology, size_t parts) {
+    const size_t count = topology.routerCount();
+    if (parts == 0 || parts > count) {
+        throw std::invalid_argument("Part count must be between 1 and the number of routers");
+    }
+
+    std::vector<GraphOrdering::Link> links;
+    links.reserve(topology.edgeCount());
+    for (size_t edge = 0; edge < topology.edgeCount(); ++edge) {
+        links.emplace_back(topology.edgeSource(edge), topology.edgeTarget(edge));
+    }
+
+    // Each part is grown breadth-first from the first unassigned router of a breadth-first order
+    // of the whole graph, over unassigned routers only, until it reaches its quota; the first
+    // `count % parts` parts take one router more
+    const std::vector<size_t> order = GraphOrdering::breadthFirst(count, links);
+    std::vector<size_t> partOf(count, NO_PART);
+    std::vector<size_t> sizes(parts, 0);
+    std::vector<size_t> region;
+    size_t nextSeed = 0;
+
+    for (size_t part = 0; part < parts; ++part) {
+        const size_t quota = count / parts + (part < count % parts ? 1 : 0);
+        region.clear();
+
+        for (size_t head = 0; sizes[part] < quota;) {
+            if (head == region.size()) {
+                // Start the region, or restart it elsewhere once other parts enclose it
+                while (partOf[order[nextSeed]] != NO_PART) {
+                    nextSeed++;
+                }
+                partOf[order[nextSeed]] = part;
+                sizes[part]++;
+                region.push_back(order[nextSeed]);
+                continue;
+            }
+
+            for (size_t neighbor : topology.neighbors(region[head++])) {
+                if (sizes[part] < quota && partOf[neighbor] == NO_PART) {
+                    partOf[neighbor] = part;
+                    sizes[part]++;
+                    region.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    const double ideal   = static_cast<double>(count) / static_cast<double>(parts);
+    const size_t maxSize = static_cast<size_t>(std::ceil(ideal * (1.0 + IMBALANCE)));
+    for (size_t pass = 0; pass < MAX_PASSES; ++pass) {
+        if (refine(topology, partOf, sizes, maxSize) == 0) {
+            break;
+        }
+    }
+    return partOf;
+}
+
+size_t GraphPartitioner::cutEdges(const TopologySnapshot& topology,
+                                  const std::vector<size_t>& partOf) {
+    size_t cut = 0;
+    for (size_t edge = 0; edge < topology.edgeCount(); ++edge) {
+        if (partOf[topology.edgeSource(edge)] != partOf[topology.edgeTarget(edge)]) {
+            cut++;
+        }
+    }
+    return cut;
+}
+
+size_t GraphPartitioner::refine(const TopologySnapshot& topology, std::vector<size_t>& partOf,
+                                std::vector<size_t>& sizes, size_t maxSize) {
+    size_t moved = 0;
+    std::vector<size_t> linksTo(sizes.size(), 0);
+
+    for (size_t router = 0; router < topology.routerCount(); ++router) {
+        const size_t from = partOf[router];
+        if (sizes[from] == 1) {
+            continue;  // Parts never become empty
+        }
+
+        const auto neighbors = topology.neighbors(router);
+        for (size_t neighbor : neighbors) {
+            linksTo[partOf[neighbor]]++;
+        }
+
+        // The part holding most of the links wins, ties going to the lowest part
+        size_t best = from;
+        for (size_t neighbor : neighbors) {
+            const size_t to = partOf[neighbor];
+            if (to != best && sizes[to] < maxSize &&
+                (linksTo[to] > linksTo[best] || (linksTo[to] == linksTo[best] && to < best))) {
+                best = to;
+            }
+        }
+        if (best != from && linksTo[best] > linksTo[from]) {
+            partOf[router] = best;
+            sizes[from]--;
+            sizes[best]++;
+            moved++;
+        }
+
+        for (size_t neighbor : neighbors) {
+            linksTo[partOf[neighbor]] = 0;
+        }
+    }
+    return moved;
+}
@@ -0,0 +1,268 @@
+#include "algorithms/IncrementalRouting.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "core/ThreadPool.h"
+
+namespace {
+using HeapEntry = std::pair<size_t, size_t>;
+
+void pushSeed(std::vector<HeapEntry>& heap, size_t distance, size_t index) {
+    heap.emplace_back(distance, index);
+    std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+}
+}  // namespace
+
+IncrementalRouting::IncrementalRouting(const Config& cfg) : config(cfg) {
+    if (config.fullRecomputeRatio < 0.0) {
+        throw std::invalid_argument("Full recompute ratio cannot be negative");
+    }
+}
+
+size_t IncrementalRouting::update(const TopologySnapshot& snapshot, ThreadPool* pool) {
+    const size_t routerCount = snapshot.routerCount();
+    const size_t edgeCount   = snapshot.edgeCount();
+
+    // Collect the edges that moved past the threshold; the others keep their previous weight
+    std::vector<EdgeChange> changes;
+    const bool sameGraph = graph && graph->sameTopology(snapshot);
+    if (sameGraph) {
+        for (size_t edge = 0; edge < edgeCount; ++edge) {
+            const size_t oldWeight = weights[edge];
+            const size_t newWeight = snapshot.edgeWeight(edge);
+            const size_t delta =
+                newWeight > oldWeight ? newWeight - oldWeight : oldWeight - newWeight;
+
+            if (delta > config.weightThreshold) {
+                changes.push_back({edge, oldWeight});
+                weights[edge] = newWeight;
+            }
+        }
+    }
+    lastChangedEdges = changes.size();
+
+    const double changedRatio =
+        edgeCount > 0 ? static_cast<double>(changes.size()) / static_cast<double>(edgeCount) : 0.0;
+    const bool full = !sameGraph || changedRatio > config.fullRecomputeRatio;
+
+    if (full) {
+        graph = snapshot;
+        weights.resize(edgeCount);
+        for (size_t edge = 0; edge < edgeCount; ++edge) {
+            weights[edge] = snapshot.edgeWeight(edge);
+        }
+        trees.resize(routerCount);
+        fullRecomputes++;
+    } else if (changes.empty()) {
+        for (auto& tree : trees) {
+            tree.changed = false;
+        }
+        return 0;
+    } else {
+        incrementalUpdates++;
+    }
+
+    // Sources are independent: each one reads the shared weights and writes its own tree
+    const auto body = [&](size_t source) {
+        if (full) {
+            rebuildTree(source);
+        } else {
+            repairTree(source, changes);
+        }
+    };
+
+    if (pool) {
+        pool->parallelFor(routerCount, body);
+    } else {
+        for (size_t source = 0; source < routerCount; ++source) {
+            body(source);
+        }
+    }
+
+    return static_cast<size_t>(
+        std::ranges::count_if(trees, [](const SourceTree& tree) { return tree.changed; }));
+}
+
+RoutingTable IncrementalRouting::buildRoutingTable(size_t source) const {
+    checkIndex(source);
+
+    const SourceTree& tree = trees[source];
+    RoutingTable routingTable(trees.size());
+
+    for (size_t i = 0; i < trees.size(); ++i) {
+        // Ignore the source router itself and unreachable routers
+        if (i == source || tree.distance[i] == INF) {
+            continue;
+        }
+
+        routingTable.setNextHopIP(graph->getRouterIP(i), graph->getRouterIP(tree.firstHop[i]));
+    }
+
+    return routingTable;
+}
+
+bool IncrementalRouting::routesChanged(size_t source) const {
+    checkIndex(source);
+    return trees[source].changed;
+}
+
+size_t IncrementalRouting::getDistance(size_t source, size_t target) const {
+    checkIndex(source);
+    checkIndex(target);
+    return trees[source].distance[target];
+}
+
+void IncrementalRouting::rebuildTree(size_t source) {
+    const size_t routerCount               = graph->routerCount();
+    SourceTree& tree                       = trees[source];
+    const std::vector<size_t> previousHops = std::move(tree.firstHop);
+
+    tree.distance.assign(routerCount, INF);
+    tree.parent.assign(routerCount, TopologySnapshot::NO_INDEX);
+    tree.firstHop.assign(routerCount, TopologySnapshot::NO_INDEX);
+
+    tree.distance[source] = 0;
+    tree.parent[source]   = source;
+
+    std::vector<HeapEntry> heap;
+    pushSeed(heap, 0, source);
+    propagate(tree, source, heap);
+
+    tree.changed = tree.firstHop != previousHops;
+}
+
+void IncrementalRouting::repairTree(size_t source, const std::vector<EdgeChange>& changes) {
+    const size_t routerCount               = graph->routerCount();
+    SourceTree& tree                       = trees[source];
+    const std::vector<size_t> previousHops = tree.firstHop;
+
+    // Roots of the invalidated subtrees: targets of tree edges that became heavier
+    std::vector<size_t> stack;
+    for (const auto& [edge, oldWeight] : changes) {
+        const size_t target = graph->edgeTarget(edge);
+        if (weights[edge] > oldWeight && tree.parent[target] == graph->edgeSource(edge) &&
+            target != source) {
+            stack.push_back(target);
+        }
+    }
+
+    std::vector<HeapEntry> heap;
+
+    if (!stack.empty()) {
+        // Child lists of the current tree, as singly linked lists over router indices
+        std::vector<size_t> firstChild(routerCount, TopologySnapshot::NO_INDEX);
+        std::vector<size_t> nextSibling(routerCount, TopologySnapshot::NO_INDEX);
+        for (size_t i = 0; i < routerCount; ++i) {
+            const size_t parent = tree.parent[i];
+            if (i != source && parent != TopologySnapshot::NO_INDEX) {
+                nextSibling[i]     = firstChild[parent];
+                firstChild[parent] = i;
+            }
+        }
+
+        std::vector<bool> invalid(routerCount, false);
+        std::vector<size_t> invalidated;
+        while (!stack.empty()) {
+            const size_t node = stack.back();
+            stack.pop_back();
+            if (invalid[node]) {
+                continue;
+            }
+            invalid[node] = true;
+            invalidated.push_back(node);
+            for (size_t child = firstChild[node]; child != TopologySnapshot::NO_INDEX;
+                 child         = nextSibling[child]) {
+                stack.push_back(child);
+            }
+        }
+
+        for (const size_t node : invalidated) {
+            tree.distance[node] = INF;
+            tree.parent[node]   = TopologySnapshot::NO_INDEX;
+            tree.firstHop[node] = TopologySnapshot::NO_INDEX;
+        }
+
+        // Reseed every invalidated router from its best still valid in-neighbor
+        for (const size_t node : invalidated) {
+            for (const size_t edge : graph->incomingEdges(node)) {
+                const size_t from = graph->edgeSource(edge);
+                if (invalid[from] || tree.distance[from] == INF) {
+                    continue;
+                }
+
+                const size_t candidate = tree.distance[from] + weights[edge];
+                if (candidate < tree.distance[node]) {
+                    tree.distance[node] = candidate;
+                    tree.parent[node]   = from;
+                    tree.firstHop[node] = from == source ? node : tree.firstHop[from];
+                }
+            }
+
+            if (tree.distance[node] != INF) {
+                pushSeed(heap, tree.distance[node], node);
+            }
+        }
+    }
+
+    // Lighter edges seed their target when they now offer a shorter path
+    for (const auto& [edge, oldWeight] : changes) {
+        if (weights[edge] >= oldWeight) {
+            continue;
+        }
+
+        const size_t from   = graph->edgeSource(edge);
+        const size_t target = graph->edgeTarget(edge);
+        if (tree.distance[from] == INF) {
+            continue;
+        }
+
+        const size_t candidate = tree.distance[from] + weights[edge];
+        if (candidate < tree.distance[target]) {
+            tree.distance[target] = candidate;
+            tree.parent[target]   = from;
+            tree.firstHop[target] = from == source ? target : tree.firstHop[from];
+            pushSeed(heap, candidate, target);
+        }
+    }
+
+    propagate(tree, source, heap);
+
+    tree.changed = tree.firstHop != previousHops;
+}
+
+void IncrementalRouting::propagate(SourceTree& tree, size_t source,
+                                   std::vector<HeapEntry>& heap) const {
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+        const auto [distance, current] = heap.back();
+        heap.pop_back();
+
+        if (distance != tree.distance[current]) {
+            continue;  // Stale entry, a shorter path was already settled
+        }
+
+        const auto neighbors = graph->neighbors(current);
+        const size_t first   = graph->firstEdge(current);
+
+        for (size_t k = 0; k < neighbors.size(); ++k) {
+            const size_t neighbor = neighbors[k];
+            const size_t newDist  = distance + weights[first + k];
+
+            if (newDist < tree.distance[neighbor]) {
+                tree.distance[neighbor] = newDist;
+                tree.parent[neighbor]   = current;
+                // Direct neighbors of the source are their own first hop
+                tree.firstHop[neighbor] = current == source ? neighbor : tree.firstHop[current];
+                pushSeed(heap, newDist, neighbor);
+            }
+        }
+    }
+}
+
+void IncrementalRouting::checkIndex(size_t index) const {
+    if (index >= trees.size()) {
+        throw std::out_of_range("Router index out of range");
+    }
+}
@@ -0,0 +1,68 @@
+#include "algorithms/TopologySnapshot.h"
+
+#include <stdexcept>
+
+#include "core/Router.h"
+
+TopologySnapshot::TopologySnapshot(const List<const Router*>& routers) {
+    capture(routers);
+}
+
+TopologySnapshot::TopologySnapshot(std::span<const Router* const> routers) {
+    capture(routers);
+}
+
+template <typename Routers>
+void TopologySnapshot::capture(const Routers& routers) {
+    const size_t count = routers.size();
+    routerIPs.reserve(count);
+    offsets.reserve(count + 1);
+
+    // Number the routers first so edges can be resolved to indices
+    for (const auto* router : routers) {
+        const size_t id = router->getIP().getRouterIP();
+        if (id >= indexByRouterID.size()) {
+            indexByRouterID.resize(id + 1, NO_INDEX);
+        }
+        indexByRouterID[id] = routerIPs.size();
+        routerIPs.push_back(router->getIP());
+    }
+
+    size_t totalEdges = 0;
+    for (const auto* router : routers) {
+        totalEdges += router->getRouterCount();
+    }
+    neighborIndices.reserve(totalEdges);
+    edgeWeights.reserve(totalEdges);
+    edgeSources.reserve(totalEdges);
+
+    for (const auto* router : routers) {
+        const size_t source = offsets.size();
+        offsets.push_back(neighborIndices.size());
+        router->forEachNeighbor([this, source](IPAddress neighborIP, size_t bufferUsage) {
+            const size_t neighborIndex = indexOf(neighborIP);
+            if (neighborIndex == NO_INDEX) {
+                throw std::runtime_error("No such router");
+            }
+            neighborIndices.push_back(neighborIndex);
+            edgeWeights.push_back(bufferUsage);
+            edgeSources.push_back(source);
+        });
+    }
+    offsets.push_back(neighborIndices.size());
+
+    // Reverse CSR: count incoming edges per router, then place the edge ids by target
+    inOffsets.assign(count + 1, 0);
+    for (const size_t target : neighborIndices) {
+        inOffsets[target + 1]++;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        inOffsets[i + 1] += inOffsets[i];
+    }
+
+    inEdgeIDs.resize(neighborIndices.size());
+    std::vector<size_t> cursor(inOffsets.begin(), inOffsets.end() - 1);
+    for (size_t edge = 0; edge < neighborIndices.size(); ++edge) {
+        inEdgeIDs[cursor[neighborIndices[edge]]++] = edge;
+    }
+}
@@ -1,5 +1,9 @@
 #include "core/Admin.h"
 
+#include <algorithm>
+
+#include "core/Profiler.h"
+
 void Admin::printReport() const {
     const NetworkStats s = network->getStats();
 
@@ -36,12 +40,38 @@ void Admin::printReport() const {
 }
 
 void Admin::runFor(size_t ticks, size_t reportInterval) const {
-    for (size_t i = 1; i <= ticks; ++i) {
-        network->simulate(1);
+    const size_t chunk = reportInterval > 0 ? reportInterval : ticks;
+    for (size_t done = 0; done < ticks;) {
+        const size_t run = std::min(chunk, ticks - done);
+        network->simulate(run);
+        done += run;
 
-        if (reportInterval > 0 && i % reportInterval == 0) {
-            std::cout << "── Tick " << std::setw(4) << i << " ──────────────────────────\n";
+        if (reportInterval > 0 && done % reportInterval == 0) {
+            std::cout << "── Tick " << std::setw(4) << done << " ──────────────────────────\n";
             printReport();
         }
     }
 }
+
+void Admin::printProfile() const {
+    if (!Profiler::ENABLED) {
+        std::cout << "Profiling disabled (build with -DROUTERSIM_PROFILING=ON)\n";
+        return;
+    }
+
+    std::cout << "\n=== TICK PROFILE (us per tick) ===\n";
+    std::cout << std::left << std::setw(18) << "Phase" << std::right << std::setw(10) << "Mean"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "Max"
+              << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t p = 0; p < Profiler::PHASE_COUNT; ++p) {
+        const auto phase = static_cast<Profiler::Phase>(p);
+        const Profiler::Histogram& h = Profiler::histogram(phase);
+
+        std::cout << std::left << std::setw(18) << Profiler::phaseName(phase) << std::right
+                  << std::setw(10) << h.meanNanos() / 1000.0 << std::setw(10)
+                  << static_cast<double>(h.percentile(0.5)) / 1000.0 << std::setw(10)
+                  << static_cast<double>(h.percentile(0.99)) / 1000.0 << std::setw(10)
+                  << static_cast<double>(h.maxNanos) / 1000.0 << "\n";
+    }
+}
@@ -0,0 +1,59 @@
+#include "core/MappedFile.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =============== Constructors & Destructor ===============
+MappedFile::MappedFile(const std::string& path, const std::string& kind) : data(nullptr), size(0) {
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + kind + " file " + path);
+    }
+    copy.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(copy.data()), static_cast<std::streamsize>(copy.size()))) {
+        throw std::runtime_error("Cannot read " + kind + " file " + path);
+    }
+    data = copy.data();
+    size = copy.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + kind + " file " + path);
+    }
+    struct stat info{};
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        size       = static_cast<uint64_t>(info.st_size);
+        void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        data       = view == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(view);
+    }
+    ::close(fd);
+    if (!data && size > 0) {
+        throw std::runtime_error("Cannot map " + kind + " file " + path);
+    }
+#endif
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+// =============== Mapping ===============
+void MappedFile::unmap() noexcept {
+#ifndef _WIN32
+    if (data) {
+        ::munmap(const_cast<unsigned char*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    copy.clear();
+}
@@ -1,52 +1,289 @@
 #include "core/Network.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+
+#include "algorithms/GraphPartitioner.h"
+#include "core/Checkpoint.h"
+#include "core/MappedFile.h"
+#include "core/Profiler.h"
 #include "core/Terminal.h"
 
-Network::Network(const Config& config) : currentTick(1) {
-    generateRandomNetwork(config.routerCount, config.maxTerminalCount, config.complexity,
-                          config.trafficProbability, config.maxPageLen);
-    recalculateAllRoutes();
+namespace {
+uint64_t resolveSeed(uint64_t seed) {
+    if (seed != 0) {
+        return seed;
+    }
+    std::random_device device;
+    return static_cast<uint64_t>(device()) << 32 | device();
 }
+}  // namespace
+
+// Config only becomes complete after Network, so its defaults cannot be a default argument
+Network::Network() : Network(Config{}) {}
+
+Network::Network(const Config& config)
+    : currentTick(1),
+      seed(resolveSeed(config.seed)),
+      pipelined(config.pipelined),
+      routeInterval(config.routeInterval),
+      routePaths(config.routePaths),
+      routeSlack(config.routeSlack),
+      routePolicy(config.routePolicy),
+      routeLoadThreshold(config.routeLoadThreshold),
+      routeRecomputes(0),
+      nextCallbackID(0),
+      eventDriven(config.eventDriven),
+      earlyDrop(config.doomedFilterBits > 0) {
+    if (routeInterval == 0) {
+        throw std::invalid_argument("Route interval must be greater than 0");
+    }
+    if (config.maxPageLen > Packet::MAX_PAGE_LEN) {
+        throw std::invalid_argument("Maximum page length does not fit in a packet");
+    }
+    if (eventDriven && config.tickThreads != 1) {
+        throw std::invalid_argument("Event-driven simulation runs on a single tick thread");
+    }
+    if (eventDriven && config.partitions != 1) {
+        throw std::invalid_argument("Event-driven simulation cannot be partitioned");
+    }
+    if (routePaths == 0 || routePaths > RoutingTable::MAX_PATHS) {
+        throw std::invalid_argument("Route path count out of range");
+    }
+    if (routePaths > 1 && config.incrementalRoutes) {
+        throw std::invalid_argument("Incremental routes keep a single path per destination");
+    }
+    if (routeSlack > 0 && routePaths == 1) {
+        throw std::invalid_argument("Route slack needs more than one path per destination");
+    }
+    if (pipelined && config.partitions < 2) {
+        throw std::invalid_argument("Pipelined ticks need more than one partition");
+    }
+    if (pipelined && (routePolicy == RoutePolicy::LoadChange || !config.tracePath.empty() ||
+                      earlyDrop)) {
+        throw std::invalid_argument(
+            "Pipelined ticks cannot follow link loads, trace events or deliver drop notices");
+    }
+
+    std::optional<TopologyFile> topology;
+    if (!config.topologyPath.empty()) {
+        topology.emplace(config.topologyPath);
+        seed = topology->getSeed();
+    }
+    const size_t routerCount = topology ? topology->getRouterCount() : config.routerCount;
+    if (routerCount > size_t{IPAddress::MAX_ROUTER_ID} + 1) {
+        throw std::invalid_argument("Router count exceeds the router IDs of the address layout");
+    }
+    if (config.partitions == 0 || config.partitions > std::max<size_t>(routerCount, 1)) {
+        throw std::invalid_argument("Partition count must be between 1 and the number of routers");
+    }
+
+    std::seed_seq topologySeed{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    m_rng.seed(topologySeed);
+    trafficStreams.seed(seed);
+
+    if (config.tickThreads != 1) {
+        tickPool = std::make_unique<ThreadPool>(config.tickThreads);
+    }
+    // Partitions wait on each other, so each one needs a thread of its own
+    if (pipelined && (!tickPool || tickPool->threadCount() < config.partitions)) {
+        throw std::invalid_argument("Pipelined ticks need a tick thread per partition");
+    }
+    if (config.routeThreads != 1) {
+        routePool = std::make_unique<ThreadPool>(config.routeThreads);
+    }
+    if (config.incrementalRoutes) {
+        routeEngine = std::make_unique<IncrementalRouting>();
+    }
+    if (!config.tracePath.empty()) {
+        traceWriter = std::make_unique<TraceWriter>(config.tracePath);
+    }
+    if (topology) {
+        loadTopology(*topology, config.trafficProbability, config.maxPageLen);
+    } else {
+        generateRandomNetwork(config.routerCount, config.maxTerminalCount, config.complexity,
+                              config.trafficProbability, config.maxPageLen, config.layout);
+    }
+    if (config.trafficModel) {
+        for (Router& rtr : routers) {
+            rtr.shareTrafficModel(*config.trafficModel);
+        }
+    }
+    if (config.outQueue.discipline != QueueDiscipline::Fifo ||
+        config.outQueue.aqm.mode != AqmMode::None) {
+        for (Router& rtr : routers) {
+            rtr.setOutputQueue(config.outQueue);
+        }
+    }
+    if (earlyDrop) {
+        for (Router& rtr : routers) {
+            rtr.setDoomedPageFilter(config.doomedFilterBits);
+        }
+    }
+    if (config.eagerExpiry) {
+        for (Router& rtr : routers) {
+            rtr.setEagerExpiry(true);
+        }
+    }
+    if (config.partitions > 1) {
+        assignPartitions(config.partitions);
+    }
+    if (eventDriven) {
+        nextVisit.assign(routers.size(), Terminal::NO_ACTIVITY);
+        for (size_t i = 0; i < routers.size(); i++) {
+            scheduleVisit(i, routers[i].nextActivityTick(currentTick - 1));
+        }
+    }
+    // Loaded routes are current; the incremental engine still needs its first full update
+    if (!topology || routeEngine) {
+        recalculateAllRoutes();
+    } else if (routePolicy == RoutePolicy::LoadChange) {
+        captureRoutedLoads();
+    }
+}
+
+void Network::generateRandomNetwork(IPAddress::RouterID routerCount,
+                                    IPAddress::TerminalID TerminalCount, size_t complexity,
+                                    float probability, size_t pageLen, Layout layout) {
+    std::vector<Link> links;
+    drawMinimalLinks(routerCount, links);
+    drawAdditionalLinks(routerCount, complexity, links);
+
+    // Traffic streams are handed out by router ID, so they do not depend on the layout
+    for (size_t i = 0; i < routerCount; i++) {
+        routerRngs.push_back(trafficStreams);
+        trafficStreams.jump();
+    }
+
+    routers = Arena<Router>(routerCount);
+    cRouters.reserve(routerCount);
+    for (size_t id : layoutOrder(routerCount, links, layout)) {
+        addRouter(static_cast<IPAddress::RouterID>(id), TerminalCount, probability, pageLen);
+    }
+
+    addressBook.reserve(routerCount * TerminalCount);
+    buildAddressBook();
+
+    for (const auto& [a, b] : links) {
+        establishLink(&routers[indexByRouter[a]], &routers[indexByRouter[b]]);
+    }
+}
+
+void Network::loadTopology(const TopologyFile& file, float probability, size_t pageLen) {
+    const size_t routerCount               = file.getRouterCount();
+    const std::span<const uint32_t> order  = file.order();
+    const std::span<const uint32_t> counts = file.terminalCounts();
+    const auto outOfRange = [routerCount](uint32_t id) { return id >= routerCount; };
+
+    // The storage order must be a permutation of the router IDs
+    std::vector<bool> stored(routerCount, false);
+    for (size_t id = 0; id < routerCount; id++) {
+        if (outOfRange(order[id]) || stored[order[id]] ||
+            counts[id] > IPAddress::MAX_TERMINAL_ID ||
+            std::ranges::any_of(file.neighbors(id), outOfRange)) {
+            throw std::runtime_error("Corrupt topology file");
+        }
+        stored[order[id]] = true;
+    }
 
-void Network::generateRandomNetwork(uint8_t routerCount, uint8_t TerminalCount, size_t complexity,
-                                    float probability, size_t pageLen) {
+    // Traffic streams are handed out by router ID, as in generateRandomNetwork()
     for (size_t i = 0; i < routerCount; i++) {
-        addRouter(i, TerminalCount, probability, pageLen);
+        routerRngs.push_back(trafficStreams);
+        trafficStreams.jump();
     }
 
-    for (auto& rtr : routers) {
-        auto ips = rtr->getTerminalIPs();
-        for (auto ip : ips) {
-            addressBook.pushBack(ip);
+    routers = Arena<Router>(routerCount);
+    cRouters.reserve(routerCount);
+    for (uint32_t id : order) {
+        addRouter(static_cast<IPAddress::RouterID>(id),
+                  static_cast<IPAddress::TerminalID>(counts[id]), probability, pageLen);
+    }
+    buildAddressBook();
+
+    // Each router connects its neighbors in the stored order, before any route is installed, so
+    // that every connection stays O(1)
+    for (size_t id = 0; id < routerCount; id++) {
+        Router& rtr = routers[indexByRouter[id]];
+        for (uint32_t neighbor : file.neighbors(id)) {
+            rtr.connectRouter(&routers[indexByRouter[neighbor]]);
         }
     }
 
-    connectMinimal(routerCount);
-    addAdditionalConnections(complexity);
+    for (size_t id = 0; id < routerCount; id++) {
+        RoutingTable table(routerCount);
+        const std::span<const uint32_t> hops = file.nextHops(id);
+        for (size_t dest = 0; dest < routerCount; dest++) {
+            if (hops[dest] == TopologyFileHeader::NO_ROUTE) {
+                continue;
+            }
+            if (outOfRange(hops[dest])) {
+                throw std::runtime_error("Corrupt topology file");
+            }
+            table.setNextHopIP(IPAddress{static_cast<IPAddress::RouterID>(dest)},
+                               IPAddress{static_cast<IPAddress::RouterID>(hops[dest])});
+        }
+        routers[indexByRouter[id]].setRoutingTable(std::move(table));
+    }
+}
+
+void Network::buildAddressBook() {
+    for (size_t id = 0; id < indexByRouter.size(); id++) {
+        for (auto ip : routers[indexByRouter[id]].getTerminalIPs()) {
+            addressBook.push_back(ip);
+        }
+    }
 }
 
-void Network::connectMinimal(uint8_t routerCount) {
+void Network::drawMinimalLinks(IPAddress::RouterID routerCount, std::vector<Link>& links) {
     for (size_t i = 1; i < routerCount; i++) {
         std::uniform_int_distribution<size_t> connectedDist(0, i - 1);
-        establishLink(routers[i].get(), routers[connectedDist(m_rng)].get());
+        links.emplace_back(i, connectedDist(m_rng));
     }
 }
 
-void Network::addAdditionalConnections(size_t complexity) {
-    if (complexity == 0 || routers.isEmpty())
+void Network::drawAdditionalLinks(size_t routerCount, size_t complexity,
+                                  std::vector<Link>& links) {
+    if (complexity == 0 || routerCount == 0)
         return;
 
-    std::uniform_int_distribution<size_t> dist(0, routers.size() - 1);
+    std::uniform_int_distribution<size_t> dist(0, routerCount - 1);
 
-    for (size_t i = 0; i < routers.size(); i++) {
-        Router* source = routers[i].get();
+    for (size_t i = 0; i < routerCount; i++) {
         for (size_t c = 0; c < complexity; c++) {
-            Router* target = routers[dist(m_rng)].get();
-            establishLink(source, target);
+            links.emplace_back(i, dist(m_rng));
         }
     }
 }
 
+void Network::addAdditionalConnections(size_t complexity) {
+    std::vector<Link> links;
+    drawAdditionalLinks(routers.size(), complexity, links);
+    for (const auto& [a, b] : links) {
+        establishLink(&routers[indexByRouter[a]], &routers[indexByRouter[b]]);
+    }
+}
+
+std::vector<size_t> Network::layoutOrder(size_t routerCount, const std::vector<Link>& links,
+                                         Layout layout) {
+    switch (layout) {
+        case Layout::BreadthFirst:
+            return GraphOrdering::breadthFirst(routerCount, links);
+        case Layout::ReverseCuthillMcKee:
+            return GraphOrdering::reverseCuthillMcKee(routerCount, links);
+        case Layout::Creation:
+            break;
+    }
+
+    std::vector<size_t> order(routerCount);
+    std::iota(order.begin(), order.end(), size_t{0});
+    return order;
+}
+
 void Network::establishLink(Router* rtrA, Router* rtrB) {
     if (rtrA == rtrB)
         return;
@@ -55,64 +292,517 @@ void Network::establishLink(Router* rtrA, Router* rtrB) {
 }
 
 void Network::simulate(size_t ticks) {
-    for (size_t i = 0; i < ticks; i++) {
-        tick();
-        if (i % 5 == 0) {
-            recalculateAllRoutes();
+    checkTickRange(ticks);
+    if (!pipelined) {
+        for (size_t i = 0; i < ticks; i++) {
+            step();
         }
+        return;
+    }
+
+    // Only the last tick of each run can have routes or callbacks due
+    for (size_t done = 0; done < ticks;) {
+        const size_t run = std::min(ticks - done, ticksToNextEvent());
+        tickPipelined(run);
+        finishTick(currentTick - 1);
+        ROUTERSIM_PROFILE_END_TICKS(run);
+        done += run;
+    }
+}
+
+void Network::step() {
+    checkTickRange(1);
+    const size_t tickNumber = currentTick;
+    tick();
+    finishTick(tickNumber);
+    ROUTERSIM_PROFILE_END_TICK();
+}
+
+void Network::finishTick(size_t tickNumber) {
+    if (routesDue(tickNumber)) {
+        recalculateAllRoutes();
     }
+    for (const PeriodicCallback& entry : callbacks) {
+        if (tickNumber % entry.interval == 0) {
+            entry.callback(*this);
+        }
+    }
+}
+
+void Network::checkTickRange(size_t ticks) const {
+    // currentTick never passes MAX_TICK + 1, so the subtraction cannot wrap
+    if (ticks > MAX_TICK + 1 - currentTick) {
+        throw std::out_of_range("Simulation would run past the last tick packets can expire on");
+    }
+}
+
+size_t Network::ticksToNextEvent() const noexcept {
+    // Ticks up to the next multiple of the interval, counting the current tick
+    const auto ticksUntil = [this](size_t interval) {
+        return interval - (currentTick - 1) % interval;
+    };
+
+    size_t next = SIZE_MAX;
+    if (routePolicy == RoutePolicy::Interval) {
+        next = ticksUntil(routeInterval);
+    }
+    for (const PeriodicCallback& entry : callbacks) {
+        next = std::min(next, ticksUntil(entry.interval));
+    }
+    return next;
+}
+
+void Network::recomputeRoutes() {
     recalculateAllRoutes();
 }
 
+size_t Network::addPeriodicCallback(size_t interval, TickCallback callback) {
+    if (interval == 0 || !callback) {
+        throw std::invalid_argument("Periodic callbacks need an interval and a function");
+    }
+    callbacks.push_back(PeriodicCallback{nextCallbackID, interval, std::move(callback)});
+    return nextCallbackID++;
+}
+
+bool Network::removePeriodicCallback(size_t id) {
+    return std::erase_if(callbacks, [id](const PeriodicCallback& entry) {
+               return entry.id == id;
+           }) > 0;
+}
+
+void Network::saveTopology(const std::string& path) const {
+    const size_t routerCount = routers.size();
+
+    TopologyData topology;
+    topology.seed = seed;
+    topology.terminalCounts.resize(routerCount);
+    topology.nextHops.assign(routerCount * routerCount, TopologyFileHeader::NO_ROUTE);
+    for (const Router& rtr : routers) {
+        const size_t id = rtr.getIP().getRouterIP();
+        topology.order.push_back(static_cast<uint32_t>(id));
+        topology.terminalCounts[id] = static_cast<uint32_t>(rtr.getTerminalCount());
+
+        const RoutingTable& table = rtr.getRoutingTable();
+        for (size_t dest = 0; dest < routerCount; dest++) {
+            const IPAddress destIP{static_cast<IPAddress::RouterID>(dest)};
+            if (table.hasRoute(destIP)) {
+                topology.nextHops[id * routerCount + dest] =
+                    table.getNextHopIP(destIP).getRouterIP();
+            }
+        }
+    }
+
+    topology.neighborStarts.push_back(0);
+    for (size_t id = 0; id < routerCount; id++) {
+        for (IPAddress neighbor : routers[indexByRouter[id]].getNeighborIPs()) {
+            topology.neighbors.push_back(neighbor.getRouterIP());
+        }
+        topology.neighborStarts.push_back(static_cast<uint32_t>(topology.neighbors.size()));
+    }
+
+    TopologyFile::write(path, topology);
+}
+
+void Network::saveCheckpoint(std::ostream& out) const {
+    CheckpointHeader header{};
+    std::memcpy(header.magic, CheckpointHeader::MAGIC, sizeof(header.magic));
+    header.version       = CheckpointHeader::VERSION;
+    header.routerBits    = static_cast<uint8_t>(IPAddress::ROUTER_BITS);
+    header.terminalBits  = static_cast<uint8_t>(IPAddress::TERMINAL_BITS);
+    header.seed          = seed;
+    header.currentTick   = currentTick;
+    header.routerCount   = static_cast<uint32_t>(routers.size());
+    header.terminalCount = static_cast<uint32_t>(addressBook.size());
+
+    CheckpointWriter writer(out);
+    writer.write(header);
+
+    // The standard generator only exposes its state as text
+    std::ostringstream topologyRng;
+    topologyRng << m_rng;
+    const std::string rngState = topologyRng.str();
+    writer.write<uint64_t>(rngState.size());
+    writer.writeArray(std::span<const char>(rngState));
+
+    for (size_t id = 0; id < routers.size(); id++) {
+        writer.write(routerRngs[id]);
+        routers[indexByRouter[id]].saveState(writer);
+    }
+    writer.write<uint64_t>(routedLoads.size());
+    writer.writeArray(std::span<const size_t>(routedLoads));
+
+    if (!writer.good()) {
+        throw std::runtime_error("Cannot write checkpoint");
+    }
+}
+
+void Network::restoreCheckpoint(const std::string& path) {
+    const MappedFile file(path, "checkpoint");
+    restoreCheckpoint(file.bytes());
+}
+
+void Network::restoreCheckpoint(std::istream& in) {
+    // Heap blocks are aligned for any word, as the in-place reader needs
+    const std::vector<unsigned char> bytes{std::istreambuf_iterator<char>(in),
+                                           std::istreambuf_iterator<char>()};
+    restoreCheckpoint(std::span<const unsigned char>(bytes));
+}
+
+void Network::restoreCheckpoint(std::span<const unsigned char> bytes) {
+    CheckpointReader reader(bytes);
+    const auto header = reader.read<CheckpointHeader>();
+
+    const char* problem = nullptr;
+    if (std::memcmp(header.magic, CheckpointHeader::MAGIC, sizeof(header.magic)) != 0) {
+        problem = "Not a checkpoint";
+    } else if (header.version != CheckpointHeader::VERSION) {
+        problem = "Unsupported checkpoint version";
+    } else if (header.routerBits != IPAddress::ROUTER_BITS ||
+               header.terminalBits != IPAddress::TERMINAL_BITS) {
+        problem = "Checkpoint written for another address layout";
+    } else if (header.seed != seed || header.routerCount != routers.size() ||
+               header.terminalCount != addressBook.size()) {
+        problem = "Checkpoint written for another network";
+    } else if (header.currentTick == 0 || header.currentTick > MAX_TICK + 1) {
+        problem = "Corrupt checkpoint";
+    }
+    if (problem) {
+        throw std::runtime_error(problem);
+    }
+
+    const std::span<const char> rngState = reader.readArray<char>(reader.read<uint64_t>());
+    std::istringstream topologyRng(std::string(rngState.begin(), rngState.end()));
+    topologyRng >> m_rng;
+
+    for (size_t id = 0; id < routers.size(); id++) {
+        routerRngs[id] = reader.read<Xoshiro256>();
+        routers[indexByRouter[id]].restoreState(reader);
+    }
+    const std::span<const size_t> loads = reader.readArray<size_t>(reader.read<uint64_t>());
+    routedLoads.assign(loads.begin(), loads.end());
+    if (!reader.atEnd()) {
+        throw std::runtime_error("Corrupt checkpoint");
+    }
+
+    currentTick = header.currentTick;
+    statsCache.reset();
+    if (eventDriven) {
+        agenda = Agenda();
+        nextVisit.assign(routers.size(), Terminal::NO_ACTIVITY);
+        for (size_t i = 0; i < routers.size(); i++) {
+            scheduleVisit(i, routers[i].nextActivityTick(currentTick - 1));
+        }
+    }
+    // The incremental engine is rebuilt from the restored loads; the restored tables stay in place
+    if (routeEngine) {
+        routeEngine = std::make_unique<IncrementalRouting>();
+        routeEngine->update(TopologySnapshot(cRouters), routePool.get());
+    }
+}
+
+bool Network::closeTrace() {
+    if (!traceWriter) {
+        return true;
+    }
+
+    for (Router& rtr : routers) {
+        rtr.setTraceBuffer(nullptr);
+    }
+    const bool complete = traceWriter->close();
+    traceWriter.reset();
+    traceBuffers.clear();
+    return complete;
+}
+
 NetworkStats Network::getStats() const {
+    if (statsCache) {
+        return *statsCache;
+    }
+
     NetworkStats stats;
     stats.currentTick = currentTick - 1;
-    for (auto& rtr : routers) {
+    for (const Router& rtr : routers) {
+        const TrafficCounters& totals = rtr.getTerminalTotals();
         stats.totalRouters++;
-        stats.totalTerminals += rtr->getTerminalCount();
-        stats.packetsDropped += rtr->getPacketsDropped();
-        stats.packetsTimedOut += rtr->getPacketsTimedOut();
-        stats.packetsInFlight += rtr->getPacketsInPending();
-        stats.packetsInFlight += rtr->getPacketsOutPending();
-        stats.packetsInFlight += rtr->getPacketsLocPending();
-        for (auto& terminal : rtr->getTerminals()) {
-            stats.pagesCreated += terminal->getPagesCreated();
-            stats.pagesDropped += terminal->getPagesDropped();
-            stats.pagesCompleted += terminal->getPagesCompleted();
-            stats.pagesTimedOut += terminal->getPagesTimedOut();
-            stats.packetsGenerated += terminal->getPacketsGenerated();
-            stats.packetsSent += terminal->getPacketsSent();
-            stats.packetsDropped += terminal->getPacketsInDropped();
-            stats.packetsDropped += terminal->getPacketsOutDropped();
-            stats.packetsTimedOut += terminal->getPacketsOutTimedOut();
-            stats.packetsTimedOut += terminal->getPacketsInTimedOut();
-            stats.packetsInFlight += terminal->getPacketsInPending();
-            stats.packetsInFlight += terminal->getPacketsOutPending();
-            stats.packetsDelivered += terminal->getPacketsSuccProcessed();
-        }
+        stats.totalTerminals += rtr.getTerminalCount();
+        stats.pagesCreated += totals.pagesCreated;
+        stats.pagesDropped += totals.pagesDropped;
+        stats.pagesCompleted += totals.pagesCompleted;
+        stats.pagesTimedOut += totals.pagesTimedOut;
+        stats.packetsGenerated += totals.packetsGenerated;
+        stats.packetsSent += totals.packetsSent;
+        stats.packetsDelivered += totals.packetsDelivered;
+        stats.packetsDropped += totals.packetsDropped + rtr.getPacketsDropped();
+        stats.packetsTimedOut += totals.packetsTimedOut + rtr.getPacketsTimedOut();
+        stats.packetsDoomed += rtr.getPacketsDoomed();
     }
+
+    // Every generated packet is either resolved or still somewhere in the network
+    stats.packetsInFlight = stats.packetsGenerated - stats.packetsDelivered -
+                            stats.packetsDropped - stats.packetsTimedOut;
+    statsCache = stats;
     return stats;
 }
 
-void Network::addRouter(uint8_t rtrID, uint8_t TerminalCount, float probability, size_t PageLen) {
-    auto rtr = std::make_unique<Router>(IPAddress{rtrID}, TerminalCount);
-    rtr->shareAddressBook(&addressBook);
-    rtr->shareRandomGenerator(&m_rng);
-    rtr->shareTrafficProbability(probability);
-    rtr->shareMaxPageLength(PageLen);
-    cRouters.pushBack(rtr.get());
-    routers.pushBack(std::move(rtr));
+std::vector<ClassCounters> Network::getClassCounters() const {
+    std::vector<ClassCounters> totals;
+    for (const Router& rtr : routers) {
+        const std::vector<ClassCounters> counters = rtr.getClassCounters();
+        totals.resize(counters.size());
+        for (size_t k = 0; k < counters.size(); k++) {
+            totals[k] += counters[k];
+        }
+    }
+    return totals;
+}
+
+void Network::addRouter(IPAddress::RouterID rtrID, IPAddress::TerminalID TerminalCount,
+                        float probability, size_t PageLen) {
+    // Each router draws its traffic from its own non-overlapping stream, so results do not depend
+    // on which thread ticks the router
+    Router& rtr = routers.emplace(IPAddress{rtrID}, TerminalCount);
+    rtr.shareAddressBook(&addressBook);
+    rtr.shareRandomGenerator(&routerRngs[rtrID]);
+    rtr.shareTrafficProbability(probability);
+    rtr.shareMaxPageLength(PageLen);
+    if (rtrID >= indexByRouter.size()) {
+        indexByRouter.resize(rtrID + 1);
+    }
+    indexByRouter[rtrID] = routers.size() - 1;
+    if (traceWriter) {
+        traceBuffers.emplace_back();
+        rtr.setTraceBuffer(&traceBuffers.back());
+    }
+    cRouters.push_back(&rtr);
 }
 
 void Network::recalculateAllRoutes() {
-    for (auto& rtr : routers) {
-        rtr->setRoutingTable(DijkstraAlgorithm::computeRoutingTable(cRouters, rtr->getIP()));
+    ROUTERSIM_PROFILE_SCOPE(Routing);
+    const TopologySnapshot topology(cRouters);
+    routeRecomputes++;
+    if (routePolicy == RoutePolicy::LoadChange) {
+        captureRoutedLoads();
+    }
+
+    if (routeEngine) {
+        routeEngine->update(topology, routePool.get());
+
+        size_t index = 0;
+        for (Router& rtr : routers) {
+            if (routeEngine->routesChanged(index)) {
+                rtr.setRoutingTable(routeEngine->buildRoutingTable(index));
+            }
+            index++;
+        }
+        return;
+    }
+
+    DijkstraAlgorithm::computeAllRoutingTables(topology, routeTables, routePool.get(),
+                                               routePaths, routeSlack);
+
+    size_t index = 0;
+    for (Router& rtr : routers) {
+        rtr.setRoutingTable(std::move(routeTables[index++]));
+    }
+}
+
+bool Network::routesDue(size_t tick) const {
+    switch (routePolicy) {
+        case RoutePolicy::Interval:
+            return tick % routeInterval == 0;
+        case RoutePolicy::Manual:
+            return false;
+        case RoutePolicy::LoadChange:
+            break;
+    }
+
+    // Sum of the load changes over every link, in the order captureRoutedLoads() records them
+    size_t edge   = 0;
+    size_t change = 0;
+    for (const Router* rtr : cRouters) {
+        rtr->forEachNeighbor([&](IPAddress, size_t load) {
+            const size_t routed = edge < routedLoads.size() ? routedLoads[edge] : 0;
+            change += load > routed ? load - routed : routed - load;
+            edge++;
+        });
+    }
+    return edge != routedLoads.size() || change > routeLoadThreshold;
+}
+
+void Network::captureRoutedLoads() {
+    routedLoads.clear();
+    for (const Router* rtr : cRouters) {
+        rtr->forEachNeighbor([this](IPAddress, size_t load) { routedLoads.push_back(load); });
     }
 }
 
 void Network::tick() {
-    for (auto& router : routers) {
-        router->tick(currentTick);
+    if (traceWriter) {
+        for (TraceBuffer& buffer : traceBuffers) {
+            buffer.setTick(currentTick);
+        }
     }
+
+    if (eventDriven) {
+        tickScheduledRouters();
+    } else if (!partitions.empty()) {
+        tickPartitions();
+    } else if (tickPool) {
+        tickPool->parallelFor(routers.size(),
+                              [this](size_t i) { routers[i].tickCompute(currentTick); });
+        tickPool->parallelFor(routers.size(), [this](size_t i) { routers[i].collectInbound(); });
+    } else {
+        for (Router& router : routers) {
+            router.tick(currentTick);
+        }
+    }
+    if (earlyDrop) {
+        deliverDropNotices();
+    }
+    if (traceWriter) {
+        for (TraceBuffer& buffer : traceBuffers) {
+            traceWriter->submit(buffer.getEvents());
+            buffer.clear();
+        }
+    }
+    statsCache.reset();
     currentTick++;
 }
+
+void Network::deliverDropNotices() {
+    for (Router& rtr : routers) {
+        for (const uint64_t pageKey : rtr.getDropNotices()) {
+            const auto srcIP = IPAddress::fromRaw(static_cast<IPAddress::Raw>(pageKey >> 32));
+            routers[indexByRouter[srcIP.getRouterIP()]].markPageDoomed(pageKey);
+        }
+        rtr.clearDropNotices();
+    }
+}
+
+void Network::assignPartitions(size_t parts) {
+    const TopologySnapshot topology(cRouters);
+    const std::vector<size_t> partOf = GraphPartitioner::partition(topology, parts);
+
+    partitions.assign(parts, {});
+    for (size_t i = 0; i < routers.size(); i++) {
+        partitions[partOf[i]].push_back(i);
+    }
+
+    partitionSources.assign(parts, {});
+    for (size_t edge = 0; edge < topology.edgeCount(); edge++) {
+        const size_t source = topology.edgeSource(edge);
+        const size_t target = topology.edgeTarget(edge);
+        if (partOf[source] != partOf[target]) {
+            routers[source].setLinkStaged(topology.getRouterIP(target), true);
+            partitionSources[partOf[target]].push_back(partOf[source]);
+        }
+    }
+    for (std::vector<size_t>& sources : partitionSources) {
+        std::ranges::sort(sources);
+        sources.erase(std::ranges::unique(sources).begin(), sources.end());
+    }
+    partitionClocks = std::make_unique<PartitionClock[]>(parts);
+}
+
+void Network::tickPartitions() {
+    const auto runPartitions = [this](const std::function<void(size_t)>& body) {
+        if (tickPool) {
+            tickPool->parallelFor(partitions.size(), body);
+            return;
+        }
+        for (size_t p = 0; p < partitions.size(); p++) {
+            body(p);
+        }
+    };
+
+    runPartitions([this](size_t p) {
+        for (size_t index : partitions[p]) {
+            routers[index].tick(currentTick);
+        }
+    });
+    runPartitions([this](size_t p) {
+        for (size_t index : partitions[p]) {
+            routers[index].collectInbound();
+        }
+    });
+}
+
+void Network::tickPipelined(size_t ticks) {
+    const size_t first = currentTick;
+    for (Router& rtr : routers) {
+        rtr.setLinkRings(true);
+    }
+    for (size_t p = 0; p < partitions.size(); p++) {
+        partitionClocks[p].computed.store(0, std::memory_order_relaxed);
+    }
+
+    tickPool->parallelFor(partitions.size(), [this, first, ticks](size_t p) {
+        std::atomic<size_t>& clock = partitionClocks[p].computed;
+        try {
+            for (size_t i = 0; i < ticks; i++) {
+                for (size_t index : partitions[p]) {
+                    routers[index].tick(first + i);
+                }
+                clock.store(i + 1, std::memory_order_release);
+                clock.notify_all();
+
+                for (size_t source : partitionSources[p]) {
+                    awaitPartition(source, i + 1);
+                }
+                for (size_t index : partitions[p]) {
+                    routers[index].collectInbound();
+                }
+                ROUTERSIM_PROFILE_CLOSE_THREAD_TICK(i);
+            }
+        } catch (...) {
+            // Release the partitions waiting on this one so that the run unwinds
+            clock.store(PIPELINE_ABORTED, std::memory_order_release);
+            clock.notify_all();
+            throw;
+        }
+    });
+
+    statsCache.reset();
+    currentTick += ticks;
+}
+
+void Network::awaitPartition(size_t partition, size_t ticks) const {
+    const std::atomic<size_t>& clock = partitionClocks[partition].computed;
+    size_t seen = clock.load(std::memory_order_acquire);
+    while (seen < ticks) {
+        clock.wait(seen, std::memory_order_acquire);
+        seen = clock.load(std::memory_order_acquire);
+    }
+    if (seen == PIPELINE_ABORTED) {
+        throw std::runtime_error("Pipelined tick aborted by another partition");
+    }
+}
+
+void Network::tickScheduledRouters() {
+    while (!agenda.empty() && agenda.top().first <= currentTick) {
+        const auto [tick, index] = agenda.top();
+        agenda.pop();
+        if (nextVisit[index] != tick) {
+            continue;  // Superseded by an earlier visit
+        }
+
+        Router& router = routers[index];
+        router.tick(currentTick);
+        nextVisit[index] = Terminal::NO_ACTIVITY;
+        scheduleVisit(index, router.nextActivityTick(currentTick));
+
+        router.forEachNeighbor([this, index](IPAddress neighborIP, size_t /*bufferUsage*/) {
+            const size_t neighbor = indexByRouter[neighborIP.getRouterIP()];
+            if (routers[neighbor].hasPendingInput()) {
+                scheduleVisit(neighbor, neighbor > index ? currentTick : currentTick + 1);
+            }
+        });
+    }
+}
+
+void Network::scheduleVisit(size_t index, size_t tick) {
+    if (tick < nextVisit[index]) {
+        nextVisit[index] = tick;
+        agenda.emplace(tick, index);
+    }
+}
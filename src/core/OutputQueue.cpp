@@ -0,0 +1,456 @@
+#include "core/OutputQueue.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+#include "core/Checkpoint.h"
+
+namespace {
+/**
+ * @brief Heap order of the earliest-deadline queue: the top is the packet with the earliest
+ * timeout, and the earliest arrival among equal timeouts.
+ */
+constexpr auto later = [](const auto& a, const auto& b) noexcept {
+    const size_t ta = a.packet.getTimeout();
+    const size_t tb = b.packet.getTimeout();
+    return ta > tb || (ta == tb && a.seq > b.seq);
+};
+}  // namespace
+
+// =============== Constructors ===============
+OutputQueue::OutputQueue(IPAddress dstIP, size_t capacity, const QueueConfig& config)
+    : discipline(config.discipline),
+      dstIP(dstIP),
+      capacity(capacity),
+      turn(0),
+      nextSeq(0),
+      eagerExpiry(false),
+      lastPurge(0),
+      expiredOnEntry(0),
+      counters(classCount(config)),
+      aqm(config.aqm) {
+    switch (discipline) {
+        case QueueDiscipline::Fifo:
+            // A single bounded buffer behaves exactly like a plain PacketBuffer
+            classes.emplace_back(dstIP, capacity);
+            return;
+        case QueueDiscipline::DeficitRoundRobin:
+            quanta = config.quanta.empty() ? std::vector<size_t>(counters.size(), 1)
+                                           : config.quanta;
+            deficits.assign(counters.size(), 0);
+            [[fallthrough]];
+        case QueueDiscipline::StrictPriority:
+            classes.assign(counters.size(), PacketBuffer(dstIP));
+            break;
+        case QueueDiscipline::EarliestDeadline:
+            break;
+    }
+    classLimits = config.classLimits;
+}
+
+// =============== Getters ===============
+size_t OutputQueue::classOf(const Packet& packet) const noexcept {
+    return static_cast<size_t>(
+        std::lower_bound(classLimits.begin(), classLimits.end(), packet.getPageLen()) -
+        classLimits.begin());
+}
+
+size_t OutputQueue::classCount(const QueueConfig& config) {
+    const AqmConfig& aqm = config.aqm;
+    if (aqm.mode == AqmMode::Red &&
+        !(aqm.weight > 0 && aqm.weight <= 1 && aqm.minThreshold >= 0 &&
+          aqm.minThreshold < aqm.maxThreshold && aqm.maxProbability > 0 &&
+          aqm.maxProbability <= 1)) {
+        throw std::invalid_argument("RED parameters are out of range");
+    }
+    if (aqm.mode == AqmMode::CoDel && !(aqm.target > 0 && aqm.interval > 0)) {
+        throw std::invalid_argument("CoDel parameters are out of range");
+    }
+
+    if (config.discipline == QueueDiscipline::Fifo) {
+        return 1;
+    }
+
+    const std::vector<size_t>& limits = config.classLimits;
+    if (std::adjacent_find(limits.begin(), limits.end(), std::greater_equal<>()) != limits.end()) {
+        throw std::invalid_argument("Class limits must be strictly ascending");
+    }
+    const size_t count = limits.size() + 1;
+    if (count > MAX_CLASSES) {
+        throw std::invalid_argument("Too many traffic classes");
+    }
+
+    const std::vector<size_t>& quanta = config.quanta;
+    if (config.discipline == QueueDiscipline::DeficitRoundRobin && !quanta.empty() &&
+        (quanta.size() != count || std::ranges::find(quanta, size_t{0}) != quanta.end())) {
+        throw std::invalid_argument("Every class needs a positive quantum");
+    }
+
+    return count;
+}
+
+// =============== Queue Operations ===============
+bool OutputQueue::enqueue(const Packet& packet) {
+    const size_t k         = classOf(packet);
+    ClassCounters& counter = counters[k];
+
+    if (aqm.mode == AqmMode::Red && redDrops()) {
+        counter.aqmDropped++;
+        return false;
+    }
+
+    if (discipline == QueueDiscipline::Fifo) {
+        const bool accepted = classes[0].enqueue(packet);
+        (accepted ? counter.enqueued : counter.dropped)++;
+        return accepted;
+    }
+
+    if (capacity > 0 && size() >= capacity) {
+        counter.dropped++;
+        return false;
+    }
+    counter.enqueued++;
+
+    if (discipline != QueueDiscipline::EarliestDeadline) {
+        classes[k].enqueue(packet);
+        return true;
+    }
+
+    // Already past the last purge: report it on the next purge without storing it
+    if (eagerExpiry && packet.getTimeout() <= lastPurge) {
+        counter.timedOut++;
+        expiredOnEntry++;
+        return true;
+    }
+    deadlines.push_back({packet, nextSeq++});
+    std::push_heap(deadlines.begin(), deadlines.end(), later);
+    return true;
+}
+
+size_t OutputQueue::dequeueLive(size_t n, size_t currentTick, std::vector<Packet>& out,
+                                std::vector<Packet>* expiredOut,
+                                std::vector<Packet>* droppedOut) {
+    size_t expired = 0;
+    if (aqm.mode == AqmMode::CoDel && n > 0) {
+        expired += controlDelay(n, currentTick, expiredOut, droppedOut);
+    }
+    return expired + dequeueNext(n, currentTick, out, expiredOut);
+}
+
+size_t OutputQueue::dequeueNext(size_t n, size_t currentTick, std::vector<Packet>& out,
+                                std::vector<Packet>* expiredOut) {
+    switch (discipline) {
+        case QueueDiscipline::DeficitRoundRobin:
+            return dequeueRoundRobin(n, currentTick, out, expiredOut);
+        case QueueDiscipline::EarliestDeadline:
+            return dequeueDeadline(n, currentTick, out, expiredOut);
+        default:
+            return dequeuePriority(n, currentTick, out, expiredOut);
+    }
+}
+
+// =============== Query methods ===============
+size_t OutputQueue::size() const noexcept {
+    if (discipline == QueueDiscipline::EarliestDeadline) {
+        return deadlines.size();
+    }
+    return std::accumulate(classes.begin(), classes.end(), size_t{0},
+                           [](size_t acc, const PacketBuffer& c) { return acc + c.size(); });
+}
+
+bool OutputQueue::isDrained() const noexcept {
+    if (discipline == QueueDiscipline::EarliestDeadline) {
+        return deadlines.empty() && expiredOnEntry == 0;
+    }
+    return std::ranges::all_of(classes, [](const PacketBuffer& c) { return c.isDrained(); });
+}
+
+// =============== Eager expiry ===============
+void OutputQueue::setEagerExpiry(bool enabled, size_t currentTick) {
+    if (eagerExpiry != enabled) {
+        lastPurge      = currentTick;
+        expiredOnEntry = 0;
+    }
+    eagerExpiry = enabled;
+    for (PacketBuffer& c : classes) {
+        c.setEagerExpiry(enabled, currentTick);
+    }
+}
+
+size_t OutputQueue::purgeExpired(size_t currentTick) {
+    if (!eagerExpiry) {
+        return 0;
+    }
+
+    if (discipline != QueueDiscipline::EarliestDeadline) {
+        size_t expired = 0;
+        for (size_t k = 0; k < classes.size(); k++) {
+            const size_t classExpired = classes[k].purgeExpired(currentTick);
+            counters[k].timedOut += classExpired;
+            expired += classExpired;
+        }
+        return expired;
+    }
+
+    // Expired packets sit on top of the heap
+    size_t expired = expiredOnEntry;
+    while (!deadlines.empty() && deadlines.front().packet.getTimeout() <= currentTick) {
+        counters[classOf(popDeadline())].timedOut++;
+        expired++;
+    }
+    lastPurge      = currentTick;
+    expiredOnEntry = 0;
+    return expired;
+}
+
+// =============== Checkpoints ===============
+void OutputQueue::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(static_cast<uint64_t>(discipline));
+    out.write<uint64_t>(counters.size());
+
+    if (discipline == QueueDiscipline::EarliestDeadline) {
+        out.write<uint64_t>(deadlines.size());
+        out.align();
+        for (const Deadline& d : deadlines) {
+            out.write(d.packet);
+        }
+        out.align();
+        for (const Deadline& d : deadlines) {
+            out.write<uint64_t>(d.seq);
+        }
+        out.write<uint64_t>(nextSeq);
+        out.write<uint64_t>(expiredOnEntry);
+        out.write<uint64_t>(lastPurge);
+    } else {
+        for (const PacketBuffer& c : classes) {
+            c.saveState(out);
+        }
+        out.write<uint64_t>(turn);
+        for (size_t deficit : deficits) {
+            out.write<uint64_t>(deficit);
+        }
+    }
+    out.write(aqmState.averageSize);
+    out.write(aqmState.dropCredit);
+    out.write<uint64_t>(aqmState.firstAbove);
+    out.write(aqmState.dropNext);
+    out.write<uint64_t>(aqmState.dropCount);
+    out.write<uint64_t>(aqmState.dropping);
+    out.writeArray(std::span<const ClassCounters>(counters));
+}
+
+void OutputQueue::restoreState(CheckpointReader& in) {
+    if (in.read<uint64_t>() != static_cast<uint64_t>(discipline) ||
+        in.read<uint64_t>() != counters.size()) {
+        throw std::runtime_error("Checkpoint queue discipline does not match");
+    }
+
+    if (discipline == QueueDiscipline::EarliestDeadline) {
+        const auto count                     = in.read<uint64_t>();
+        const std::span<const Packet> stored = in.readArray<Packet>(count);
+        const std::span<const uint64_t> seqs = in.readArray<uint64_t>(count);
+        nextSeq                              = in.read<uint64_t>();
+        const auto pending                   = in.read<uint64_t>();
+        const auto purged                    = in.read<uint64_t>();
+        if (capacity > 0 && count > capacity) {
+            throw std::runtime_error("Checkpoint packets exceed the buffer capacity");
+        }
+
+        deadlines.clear();
+        for (size_t i = 0; i < count; i++) {
+            deadlines.push_back({stored[i], seqs[i]});
+        }
+        std::make_heap(deadlines.begin(), deadlines.end(), later);
+        lastPurge      = eagerExpiry ? purged : 0;
+        expiredOnEntry = eagerExpiry ? pending : 0;
+    } else {
+        for (PacketBuffer& c : classes) {
+            c.restoreState(in);
+        }
+        turn = in.read<uint64_t>();
+        for (size_t& deficit : deficits) {
+            deficit = in.read<uint64_t>();
+        }
+        if (turn >= classes.size()) {
+            throw std::runtime_error("Corrupt checkpoint");
+        }
+        if (capacity > 0 && size() > capacity) {
+            throw std::runtime_error("Checkpoint packets exceed the buffer capacity");
+        }
+    }
+
+    aqmState.averageSize = in.read<double>();
+    aqmState.dropCredit  = in.read<double>();
+    aqmState.firstAbove  = in.read<uint64_t>();
+    aqmState.dropNext    = in.read<double>();
+    aqmState.dropCount   = in.read<uint64_t>();
+    aqmState.dropping    = in.read<uint64_t>() != 0;
+
+    const std::span<const ClassCounters> saved = in.readArray<ClassCounters>(counters.size());
+    std::ranges::copy(saved, counters.begin());
+}
+
+// =============== Private helpers ===============
+bool OutputQueue::redDrops() noexcept {
+    AqmState& st = aqmState;
+    st.averageSize += aqm.weight * (static_cast<double>(size()) - st.averageSize);
+
+    if (st.averageSize < aqm.minThreshold) {
+        st.dropCredit = 0;
+        return false;
+    }
+    if (st.averageSize >= aqm.maxThreshold) {
+        return true;
+    }
+
+    // Accumulate the probability so drops are spaced evenly instead of drawn at random
+    st.dropCredit += aqm.maxProbability * (st.averageSize - aqm.minThreshold) /
+                     (aqm.maxThreshold - aqm.minThreshold);
+    if (st.dropCredit < 1) {
+        return false;
+    }
+    st.dropCredit -= 1;
+    return true;
+}
+
+size_t OutputQueue::controlDelay(size_t n, size_t currentTick, std::vector<Packet>* expiredOut,
+                                 std::vector<Packet>* droppedOut) {
+    AqmState& st   = aqmState;
+    const auto now = static_cast<double>(currentTick);
+    size_t expired = 0;
+
+    // Ticks the backlog needs to drain, as CoDel would measure on the packet at the head
+    const auto okToDrop = [&] {
+        if (static_cast<double>(size()) / static_cast<double>(n) < aqm.target) {
+            st.firstAbove = NOT_ABOVE;
+            return false;
+        }
+        if (st.firstAbove == NOT_ABOVE) {
+            st.firstAbove = currentTick + static_cast<size_t>(aqm.interval);
+            return false;
+        }
+        return currentTick >= st.firstAbove;
+    };
+
+    if (st.dropping) {
+        if (!okToDrop()) {
+            st.dropping = false;
+        }
+        while (st.dropping && now >= st.dropNext) {
+            expired += dropHead(currentTick, expiredOut, droppedOut);
+            st.dropCount++;
+            if (!okToDrop()) {
+                st.dropping = false;
+            } else {
+                st.dropNext += aqm.interval / std::sqrt(static_cast<double>(st.dropCount));
+            }
+        }
+    } else if (okToDrop()) {
+        expired += dropHead(currentTick, expiredOut, droppedOut);
+        st.dropping = true;
+        // Resume near the last drop rate if the queue went back above target soon
+        const bool recent = st.dropCount > 2 && now - st.dropNext < 16 * aqm.interval;
+        st.dropCount      = recent ? st.dropCount - 2 : 1;
+        st.dropNext       = now + aqm.interval / std::sqrt(static_cast<double>(st.dropCount));
+    }
+    return expired;
+}
+
+size_t OutputQueue::dropHead(size_t currentTick, std::vector<Packet>* expiredOut,
+                             std::vector<Packet>* droppedOut) {
+    head.clear();
+    const size_t expired = dequeueNext(1, currentTick, head, expiredOut);
+    if (!head.empty()) {
+        ClassCounters& counter = counters[classOf(head.front())];
+        counter.sent--;
+        counter.aqmDropped++;
+        if (droppedOut) {
+            droppedOut->push_back(std::move(head.front()));
+        }
+    }
+    return expired;
+}
+
+size_t OutputQueue::dequeuePriority(size_t n, size_t currentTick, std::vector<Packet>& out,
+                                    std::vector<Packet>* expiredOut) {
+    const size_t start = out.size();
+    size_t expired     = 0;
+
+    for (size_t k = 0; k < classes.size() && out.size() - start < n; k++) {
+        expired += dequeueClass(k, n - (out.size() - start), currentTick, out, expiredOut);
+    }
+    return expired;
+}
+
+size_t OutputQueue::dequeueRoundRobin(size_t n, size_t currentTick, std::vector<Packet>& out,
+                                      std::vector<Packet>* expiredOut) {
+    const size_t start = out.size();
+    size_t expired     = 0;
+    size_t idle        = 0;  // Classes found empty in a row
+
+    while (out.size() - start < n && idle < classes.size()) {
+        if (classes[turn].isEmpty()) {
+            deficits[turn] = 0;
+            turn           = (turn + 1) % classes.size();
+            idle++;
+            continue;
+        }
+        idle = 0;
+
+        if (deficits[turn] == 0) {
+            deficits[turn] = quanta[turn];
+        }
+        const size_t before = out.size();
+        expired += dequeueClass(turn, std::min(deficits[turn], n - (before - start)), currentTick,
+                                out, expiredOut);
+        deficits[turn] -= out.size() - before;
+
+        // A class still holding packets and deficit ran out of bandwidth and keeps its turn
+        if (deficits[turn] == 0 || classes[turn].isEmpty()) {
+            deficits[turn] = 0;
+            turn           = (turn + 1) % classes.size();
+        }
+    }
+    return expired;
+}
+
+size_t OutputQueue::dequeueDeadline(size_t n, size_t currentTick, std::vector<Packet>& out,
+                                    std::vector<Packet>* expiredOut) {
+    const size_t start = out.size();
+    size_t expired     = 0;
+
+    while (out.size() - start < n && !deadlines.empty()) {
+        Packet packet          = popDeadline();
+        ClassCounters& counter = counters[classOf(packet)];
+        if (packet.getTimeout() > currentTick) {
+            counter.sent++;
+            out.push_back(std::move(packet));
+            continue;
+        }
+        counter.timedOut++;
+        expired++;
+        if (expiredOut) {
+            expiredOut->push_back(std::move(packet));
+        }
+    }
+    return expired;
+}
+
+Packet OutputQueue::popDeadline() {
+    std::pop_heap(deadlines.begin(), deadlines.end(), later);
+    Packet packet = std::move(deadlines.back().packet);
+    deadlines.pop_back();
+    return packet;
+}
+
+size_t OutputQueue::dequeueClass(size_t k, size_t n, size_t currentTick,
+                                 std::vector<Packet>& out, std::vector<Packet>* expiredOut) {
+    const size_t before  = out.size();
+    const size_t expired = classes[k].dequeueLive(n, currentTick, out, expiredOut);
+    counters[k].sent += out.size() - before;
+    counters[k].timedOut += expired;
+    return expired;
+}
@@ -2,13 +2,22 @@
 
 Packet::Packet(size_t pageID, size_t pagePos, size_t pageLen, IPAddress srcIP, IPAddress dstIP,
                size_t timeout)
-    : pageID(pageID),
-      pagePos(pagePos),
-      pageLen(pageLen),
-      timeout(timeout),
+    : pageID(static_cast<uint32_t>(pageID)),
+      timeout(static_cast<uint32_t>(timeout)),
+      pagePos(static_cast<uint16_t>(pagePos)),
+      pageLen(static_cast<uint16_t>(pageLen)),
       srcIP(srcIP),
       dstIP(dstIP) {
 
+    if (pageID > MAX_PAGE_ID) {
+        throw std::out_of_range("pageID does not fit in 32 bits");
+    }
+    if (pageLen > MAX_PAGE_LEN) {
+        throw std::out_of_range("pageLength does not fit in 16 bits");
+    }
+    if (timeout > MAX_TIMEOUT) {
+        throw std::out_of_range("timeout does not fit in 32 bits");
+    }
     if (pagePos >= pageLen) {
         throw std::invalid_argument("pagePosition must be in the range [0, pageLength)");
     }
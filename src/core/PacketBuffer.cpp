@@ -1,20 +1,54 @@
 #include "core/PacketBuffer.h"
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <sstream>
 
+#include "core/Checkpoint.h"
+
+namespace {
+/** Limit of a buffer of the given capacity, so that capacity checks need no unlimited branch */
+constexpr size_t limitOf(size_t capacity) noexcept {
+    return capacity == 0 ? std::numeric_limits<size_t>::max() : capacity;
+}
+}  // namespace
+
 // =============== Constructors & Destructor ===============
-PacketBuffer::PacketBuffer(size_t capacity) : capacity(capacity), dstIP(IPAddress{}) {}
+PacketBuffer::PacketBuffer(size_t capacity)
+    : packets(capacity),
+      capacity(capacity),
+      limit(limitOf(capacity)),
+      dstIP(IPAddress{}),
+      retired(0),
+      expiredOnEntry(0) {}
 
-PacketBuffer::PacketBuffer(IPAddress dstIP, size_t capacity) : capacity(capacity), dstIP(dstIP) {}
+PacketBuffer::PacketBuffer(IPAddress dstIP, size_t capacity)
+    : packets(capacity),
+      capacity(capacity),
+      limit(limitOf(capacity)),
+      dstIP(dstIP),
+      retired(0),
+      expiredOnEntry(0) {}
 
 // =============== Queue Operations ===============
 bool PacketBuffer::enqueue(const Packet& packet) {
+    return enqueue(Packet(packet));
+}
+
+bool PacketBuffer::enqueue(Packet&& packet) {
     if (isFull()) {
         return false;
     }
-    packets.pushBack(packet);
+    if (expiry) {
+        // Already past the last purge: account for it on the next purge without storing it
+        if (packet.getTimeout() <= expiry->getCurrentTick()) {
+            expiredOnEntry++;
+            return true;
+        }
+        expiry->add(packet.getTimeout());
+    }
+    packets.pushBack(std::move(packet));
     return true;
 }
 
@@ -23,56 +57,220 @@ Packet PacketBuffer::dequeue() {
         throw std::runtime_error("Cannot dequeue from empty buffer");
     }
 
-    const Packet front = packets[0];
+    discardRetiredFront();
+    Packet packet = packets.takeFront();
+    if (expiry) {
+        expiry->remove(packet.getTimeout());
+    }
+    return packet;
+}
+
+bool PacketBuffer::tryDequeue(Packet& out) noexcept {
+    if (isEmpty()) {
+        return false;
+    }
+
+    discardRetiredFront();
+    out = std::move(packets[0]);
     packets.popFront();
-    return front;
+    if (expiry) {
+        expiry->remove(out.getTimeout());
+    }
+    return true;
+}
+
+size_t PacketBuffer::enqueueBatch(std::span<const Packet> batch) {
+    if (expiry) {
+        size_t accepted = 0;
+        while (accepted < batch.size() && enqueue(batch[accepted])) {
+            accepted++;
+        }
+        return accepted;
+    }
+
+    const size_t accepted = std::min(batch.size(), availableSpace());
+    packets.reserve(packets.size() + accepted);
+    for (size_t i = 0; i < accepted; ++i) {
+        packets.pushBack(batch[i]);
+    }
+    return accepted;
+}
+
+size_t PacketBuffer::dequeueBatch(size_t n, std::vector<Packet>& out) {
+    const size_t taken = std::min(n, size());
+    if (taken == 0) {
+        return 0;
+    }
+    out.reserve(out.size() + taken);
+
+    if (!expiry) {
+        packets.takeFront(taken, std::back_inserter(out));
+        return taken;
+    }
+
+    for (size_t i = 0; i < taken; ++i) {
+        discardRetiredFront();
+        expiry->remove(packets[0].getTimeout());
+        out.push_back(packets.takeFront());
+    }
+    return taken;
+}
+
+size_t PacketBuffer::dequeueLive(size_t n, size_t currentTick, std::vector<Packet>& out,
+                                 std::vector<Packet>* expiredOut) {
+    const size_t start = out.size();
+    size_t expired     = 0;
+
+    while (out.size() - start < n && !isEmpty()) {
+        const size_t from = out.size();
+        dequeueBatch(n - (from - start), out);
+
+        // Compact the live packets in place, handing the expired ones to expiredOut if requested
+        size_t kept = from;
+        for (size_t i = from; i < out.size(); ++i) {
+            if (out[i].getTimeout() > currentTick) {
+                if (kept != i) {
+                    out[kept] = std::move(out[i]);
+                }
+                kept++;
+            } else if (expiredOut) {
+                expiredOut->push_back(std::move(out[i]));
+            }
+        }
+        expired += out.size() - kept;
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(kept), out.end());
+    }
+    return expired;
 }
 
 // =============== Query methods ===============
 size_t PacketBuffer::availableSpace() const noexcept {
-    if (capacity == 0) {
-        return std::numeric_limits<int>::max();
-    }
-    return capacity - packets.size();
+    // Clamped so that an unlimited buffer reports std::numeric_limits<int>::max()
+    return std::min<size_t>(limit - size(), std::numeric_limits<int>::max());
 }
 
 double PacketBuffer::getUtilization() const noexcept {
     if (capacity == 0) {
         return 0.0;
     }
-    return static_cast<double>(packets.size()) / static_cast<double>(capacity);
+    return static_cast<double>(size()) / static_cast<double>(capacity);
 }
 
 bool PacketBuffer::contains(size_t pageID, size_t pagePos) const {
     return std::any_of(packets.begin(), packets.end(),
-                       [pageID, pagePos](const Packet& packet) noexcept {
-                           return packet.getPageID() == pageID && packet.getPagePos() == pagePos;
+                       [this, pageID, pagePos](const Packet& packet) noexcept {
+                           return packet.getPageID() == pageID &&
+                                  packet.getPagePos() == pagePos && !isRetired(packet);
                        });
 }
 
 // =============== Buffer Management ===============
 void PacketBuffer::clear() noexcept {
     packets.clear();
+    retired        = 0;
+    expiredOnEntry = 0;
+    if (expiry) {
+        expiry->clear();
+    }
 }
 
 void PacketBuffer::setCapacity(size_t newCapacity) {
-    if (newCapacity > 0 && packets.size() > newCapacity) {
+    if (newCapacity > 0 && size() > newCapacity) {
         throw std::invalid_argument("Cannot set capacity lower than current size");
     }
     capacity = newCapacity;
+    limit    = limitOf(newCapacity);
+    packets.reserve(newCapacity);
 }
 
 void PacketBuffer::removeAt(size_t index) {
-    if (index >= packets.size()) {
+    if (index >= size()) {
         throw std::out_of_range("Index out of range");
     }
-    packets.removeAt(index);
+    const size_t pos = storageIndex(index);
+    if (expiry) {
+        expiry->remove(packets[pos].getTimeout());
+    }
+    packets.removeAt(pos);
+}
+
+// =============== Eager expiry ===============
+void PacketBuffer::setEagerExpiry(bool enabled, size_t currentTick) {
+    if (!enabled) {
+        compact();
+        expiry.reset();
+        expiredOnEntry = 0;
+        return;
+    }
+    if (expiry) {
+        return;
+    }
+
+    // Packets already expired are retired straight away and reported on the next purge
+    expiry.emplace(currentTick);
+    for (const Packet& packet : packets) {
+        if (packet.getTimeout() > currentTick) {
+            expiry->add(packet.getTimeout());
+        } else {
+            retired++;
+            expiredOnEntry++;
+        }
+    }
+}
+
+size_t PacketBuffer::purgeExpired(size_t currentTick) {
+    if (!expiry) {
+        return 0;
+    }
+
+    const size_t expired = expiry->advance(currentTick);
+    retired += expired;
+
+    // Retired packets are normally dropped as they reach the front; compact when they dominate
+    // the storage so a stalled buffer does not keep growing
+    if (retired > packets.size() / 2) {
+        compact();
+    }
+
+    const size_t reported = expired + expiredOnEntry;
+    expiredOnEntry        = 0;
+    return reported;
+}
+
+// =============== Checkpoints ===============
+void PacketBuffer::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(size());
+    out.align();
+    for (const Packet& packet : packets) {
+        if (!isRetired(packet)) {
+            out.write(packet);
+        }
+    }
+    out.write<uint64_t>(expiredOnEntry);
+    out.write<uint64_t>(expiry ? expiry->getCurrentTick() : 0);
+}
+
+void PacketBuffer::restoreState(CheckpointReader& in) {
+    const std::span<const Packet> stored = in.readArray<Packet>(in.read<uint64_t>());
+    const auto pending                   = in.read<uint64_t>();
+    const auto lastPurge                 = in.read<uint64_t>();
+
+    clear();
+    if (expiry) {
+        expiry.emplace(lastPurge);
+    }
+    if (enqueueBatch(stored) != stored.size()) {
+        throw std::runtime_error("Checkpoint packets exceed the buffer capacity");
+    }
+    if (expiry) {
+        expiredOnEntry += pending;
+    }
 }
 
 // =============== Utilities ===============
 std::string PacketBuffer::toString() const {
     std::ostringstream oss;
-    oss << "PacketBuffer{Usage: " << packets.size();
+    oss << "PacketBuffer{Usage: " << size();
     if (capacity > 0) {
         oss << "/" << capacity;
     }
@@ -84,3 +282,44 @@ std::ostream& operator<<(std::ostream& os, const PacketBuffer& buffer) {
     os << buffer.toString();
     return os;
 }
+
+// =============== Private helpers ===============
+void PacketBuffer::discardRetiredFront() noexcept {
+    while (retired > 0 && isRetired(packets[0])) {
+        packets.popFront();
+        retired--;
+    }
+}
+
+void PacketBuffer::compact() noexcept {
+    if (retired == 0) {
+        return;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        if (!isRetired(packets[i])) {
+            if (kept != i) {
+                packets[kept] = std::move(packets[i]);
+            }
+            kept++;
+        }
+    }
+    while (packets.size() > kept) {
+        packets.removeAt(packets.size() - 1);
+    }
+    retired = 0;
+}
+
+size_t PacketBuffer::storageIndex(size_t index) const noexcept {
+    if (retired == 0) {
+        return index;
+    }
+
+    size_t pos = 0;
+    for (;; ++pos) {
+        if (!isRetired(packets[pos]) && index-- == 0) {
+            return pos;
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#include "core/PageQueue.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "core/Checkpoint.h"
+
+// =============== Constructors & Destructor ===============
+PageQueue::PageQueue(size_t capacity)
+    : capacity(capacity),
+      limit(capacity == 0 ? std::numeric_limits<size_t>::max() : capacity),
+      pending(0),
+      expiredOnEntry(0) {}
+
+// =============== Queue Operations ===============
+bool PageQueue::enqueue(const Page& page, size_t timeout) {
+    // The first packet validates the page against the packed layout shared by every fragment
+    const Packet first(page.getPageID(), 0, page.getPageLen(), page.getSrcIP(), page.getDstIP(),
+                       timeout);
+    const size_t length = first.getPageLen();
+    if (availableSpace() < length) {
+        return false;
+    }
+    if (expiry) {
+        // Already past the last purge: account for it on the next purge without storing it
+        if (timeout <= expiry->getCurrentTick()) {
+            expiredOnEntry += length;
+            return true;
+        }
+        expiry->add(timeout);
+    }
+
+    pages.pushBack(Descriptor{static_cast<uint32_t>(first.getPageID()),
+                              static_cast<uint32_t>(first.getTimeout()), 0,
+                              static_cast<uint16_t>(length), first.getSrcIP(), first.getDstIP()});
+    pending += length;
+    return true;
+}
+
+size_t PageQueue::dequeueLive(size_t n, size_t currentTick, std::vector<Packet>& out,
+                              std::vector<Packet>* expiredOut) {
+    size_t emitted = 0;
+    size_t expired = 0;
+
+    while (emitted < n && !pages.isEmpty()) {
+        Descriptor& page = pages[0];
+
+        if (page.timeout <= currentTick) {
+            if (expiredOut) {
+                for (size_t pos = page.nextPos; pos < page.pageLen; ++pos) {
+                    expiredOut->push_back(page.packetAt(pos));
+                }
+            }
+            expired += page.remaining();
+            popFront();
+            continue;
+        }
+
+        const size_t taken = std::min(n - emitted, page.remaining());
+        for (size_t i = 0; i < taken; ++i) {
+            out.push_back(page.packetAt(page.nextPos + i));
+        }
+        page.nextPos += static_cast<uint16_t>(taken);
+        pending -= taken;
+        emitted += taken;
+        if (page.remaining() == 0) {
+            popFront();
+        }
+    }
+    return expired;
+}
+
+// =============== Query methods ===============
+size_t PageQueue::availableSpace() const noexcept {
+    // Clamped so that an unlimited queue reports std::numeric_limits<int>::max()
+    return std::min<size_t>(limit - size(), std::numeric_limits<int>::max());
+}
+
+// =============== Buffer Management ===============
+void PageQueue::clear() noexcept {
+    pages.clear();
+    pending        = 0;
+    expiredOnEntry = 0;
+    if (expiry) {
+        expiry->clear();
+    }
+}
+
+// =============== Eager expiry ===============
+void PageQueue::setEagerExpiry(bool enabled, size_t currentTick) {
+    if (!enabled) {
+        expiry.reset();
+        expiredOnEntry = 0;
+        return;
+    }
+    if (expiry) {
+        return;
+    }
+
+    // Pages already expired are dropped straight away and reported on the next purge
+    expiredOnEntry += dropExpired(currentTick);
+    expiry.emplace(currentTick);
+    for (size_t i = 0; i < pages.size(); ++i) {
+        expiry->add(pages[i].timeout);
+    }
+}
+
+size_t PageQueue::purgeExpired(size_t currentTick) {
+    if (!expiry) {
+        return 0;
+    }
+
+    // The wheel only counts the pages, so the queue is walked when at least one has expired
+    const size_t expired  = expiry->advance(currentTick) > 0 ? dropExpired(currentTick) : 0;
+    const size_t reported = expired + expiredOnEntry;
+    expiredOnEntry        = 0;
+    return reported;
+}
+
+// =============== Checkpoints ===============
+void PageQueue::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(pages.size());
+    out.align();
+    for (size_t i = 0; i < pages.size(); ++i) {
+        out.write(pages[i]);
+    }
+    out.write<uint64_t>(expiredOnEntry);
+    out.write<uint64_t>(expiry ? expiry->getCurrentTick() : 0);
+}
+
+void PageQueue::restoreState(CheckpointReader& in) {
+    const std::span<const Descriptor> stored = in.readArray<Descriptor>(in.read<uint64_t>());
+    const auto pendingExpired                = in.read<uint64_t>();
+    const auto lastPurge                     = in.read<uint64_t>();
+
+    clear();
+    if (expiry) {
+        expiry.emplace(lastPurge);
+    }
+    for (const Descriptor& page : stored) {
+        if (page.nextPos >= page.pageLen) {
+            throw std::runtime_error("Checkpoint holds a page with no packets left");
+        }
+        if (pending + page.remaining() > limit) {
+            throw std::runtime_error("Checkpoint packets exceed the buffer capacity");
+        }
+        if (expiry) {
+            if (page.timeout <= expiry->getCurrentTick()) {
+                expiredOnEntry += page.remaining();
+                continue;
+            }
+            expiry->add(page.timeout);
+        }
+        pages.pushBack(page);
+        pending += page.remaining();
+    }
+    if (expiry) {
+        expiredOnEntry += pendingExpired;
+    }
+}
+
+// =============== Private helpers ===============
+void PageQueue::popFront() noexcept {
+    if (expiry) {
+        expiry->remove(pages[0].timeout);
+    }
+    pending -= pages[0].remaining();
+    pages.popFront();
+}
+
+size_t PageQueue::dropExpired(size_t currentTick) noexcept {
+    size_t expired = 0;
+    size_t kept    = 0;
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if (pages[i].timeout <= currentTick) {
+            expired += pages[i].remaining();
+        } else {
+            if (kept != i) {
+                pages[kept] = pages[i];
+            }
+            kept++;
+        }
+    }
+    while (pages.size() > kept) {
+        pages.removeAt(pages.size() - 1);
+    }
+    pending -= expired;
+    return expired;
+}
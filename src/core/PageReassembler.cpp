@@ -1,56 +1,96 @@
+#include <algorithm>
+
 #include "core/PageReassembler.h"
 
-// =============== Constructors & Destructor ===============
-PageReassembler::PageReassembler(size_t id, IPAddress ip, size_t length, size_t timeout)
-    : pageID(id), srcIP(ip), total(length), count(0), timeout(timeout), packets(nullptr) {
-    if (length == 0) {
-        throw std::invalid_argument("expectedPackets must be positive");
-    }
+#include "core/Checkpoint.h"
+
+// =============== ReassemblyPool ===============
+ReassemblyPool::Block::Block() noexcept : capacity(0), owner(nullptr) {}
+
+ReassemblyPool::Block::Block(std::unique_ptr<uint64_t[]> words, size_t capacity,
+                             ReassemblyPool* owner) noexcept
+    : words(std::move(words)), capacity(capacity), owner(owner) {}
 
-    packets = new Packet*[length];
-    for (int i = 0; i < length; ++i) {
-        packets[i] = nullptr;
+ReassemblyPool::Block::Block(Block&& other) noexcept
+    : words(std::move(other.words)), capacity(other.capacity), owner(other.owner) {
+    other.capacity = 0;
+}
+
+ReassemblyPool::Block& ReassemblyPool::Block::operator=(Block&& other) noexcept {
+    if (this != &other) {
+        release();
+        words          = std::move(other.words);
+        capacity       = other.capacity;
+        owner          = other.owner;
+        other.capacity = 0;
     }
+    return *this;
 }
 
-PageReassembler::PageReassembler(PageReassembler&& other) noexcept
-    : pageID(other.pageID),
-      srcIP(other.srcIP),
-      total(other.total),
-      count(other.count),
-      timeout(other.timeout),
-      packets(other.packets) {
-    other.packets = nullptr;
+ReassemblyPool::Block::~Block() {
+    release();
 }
 
-PageReassembler& PageReassembler::operator=(PageReassembler&& other) noexcept {
-    if (this != &other) {
-        if (packets) {
-            for (int i = 0; i < total; ++i) {
-                delete packets[i];
-            }
-            delete[] packets;
+void ReassemblyPool::Block::release() noexcept {
+    if (words && owner) {
+        owner->release(std::move(words), capacity);
+    }
+    words.reset();
+    capacity = 0;
+}
+
+ReassemblyPool::ReassemblyPool(size_t blockFragments) : blockFragments(blockFragments) {}
+
+ReassemblyPool::Block ReassemblyPool::acquire(size_t fragments) {
+    std::unique_ptr<uint64_t[]> words;
+    size_t capacity = fragments;
+
+    if (fragments <= blockFragments) {
+        capacity = blockFragments;
+        if (!freeBlocks.empty()) {
+            words = std::move(freeBlocks.back());
+            freeBlocks.pop_back();
         }
+    }
+    if (!words) {
+        words = std::make_unique_for_overwrite<uint64_t[]>(wordsFor(capacity));
+    }
 
-        pageID  = other.pageID;
-        srcIP   = other.srcIP;
-        total   = other.total;
-        count   = other.count;
-        timeout = other.timeout;
-        packets = other.packets;
+    std::fill_n(words.get(), bitmapWords(fragments), 0);
+    return {std::move(words), capacity, this};
+}
 
-        other.packets = nullptr;
+void ReassemblyPool::setBlockFragments(size_t fragments) noexcept {
+    if (fragments != blockFragments) {
+        blockFragments = fragments;
+        freeBlocks.clear();
     }
+}
 
-    return *this;
+void ReassemblyPool::release(std::unique_ptr<uint64_t[]> words, size_t capacity) noexcept {
+    if (capacity != blockFragments) {
+        return;
+    }
+    try {
+        freeBlocks.push_back(std::move(words));
+    } catch (...) {
+        // Dropping the block only costs a future allocation
+    }
 }
 
-PageReassembler::~PageReassembler() {
-    if (packets != nullptr) {
-        for (int i = 0; i < total; ++i) {
-            delete packets[i];
-        }
-        delete[] packets;
+// =============== Constructors & Destructor ===============
+PageReassembler::PageReassembler(size_t id, IPAddress ip, size_t length, size_t timeout,
+                                 ReassemblyPool* pool)
+    : pageID(id), srcIP(ip), total(length), count(0), timeout(timeout) {
+    if (length == 0) {
+        throw std::invalid_argument("expectedPackets must be positive");
+    }
+
+    if (pool) {
+        fragments = pool->acquire(length);
+    } else {
+        auto words = std::make_unique<uint64_t[]>(ReassemblyPool::wordsFor(length));
+        fragments  = ReassemblyPool::Block(std::move(words), length, nullptr);
     }
 }
 
@@ -59,7 +99,7 @@ bool PageReassembler::hasPacketAt(size_t position) const {
     if (position >= total) {
         throw std::out_of_range("Position out of range in hasPacketAt");
     }
-    return packets[position] != nullptr;
+    return (fragments.data()[position / 64] >> (position % 64)) & 1;
 }
 
 // =============== Modifiers ===============
@@ -76,17 +116,29 @@ bool PageReassembler::addPacket(const Packet& p) {
         return false;
     }
 
+    if (count > 0 && p.getDstIP() != dstIP) {
+        return false;
+    }
+
     const size_t pos = p.getPagePos();
 
     if (pos >= total) {
         return false;
     }
 
-    if (packets[pos] != nullptr) {
+    uint64_t* words     = fragments.data();
+    const uint64_t mask = uint64_t{1} << (pos % 64);
+    if (words[pos / 64] & mask) {
         return false;
     }
+    words[pos / 64] |= mask;
+
+    // Timeouts are packed two per word after the bitmap; Packet guarantees they fit in 32 bits
+    uint64_t& slot   = words[ReassemblyPool::bitmapWords(total) + pos / 2];
+    const auto shift = 32 * (pos % 2);
+    slot = (slot & ~(uint64_t{0xFFFFFFFF} << shift)) | (uint64_t{p.getTimeout()} << shift);
 
-    packets[pos] = new Packet(p);
+    dstIP = p.getDstIP();
     count++;
 
     return true;
@@ -100,30 +152,61 @@ List<Packet> PageReassembler::package() {
 
     List<Packet> readyList;
 
-    for (int i = 0; i < total; ++i) {
-        if (packets[i] != nullptr) {
-            readyList.pushBack(*packets[i]);
-
-            delete packets[i];
-            packets[i] = nullptr;
-        } else {
-            throw std::runtime_error("Missing packet at position " + std::to_string(i));
-        }
+    for (size_t i = 0; i < total; ++i) {
+        readyList.pushBack(Packet(pageID, i, total, srcIP, dstIP, timeoutAt(i)));
     }
 
-    count = 0;
+    reset();
 
     return readyList;
 }
 
-void PageReassembler::reset() {
-    for (int i = 0; i < total; ++i) {
-        delete packets[i];
-        packets[i] = nullptr;
+size_t PageReassembler::finish() {
+    if (!isComplete()) {
+        throw std::runtime_error("Cannot finish incomplete page: " + std::to_string(count) + "/" +
+                                 std::to_string(total) + " packets received");
     }
+
+    reset();
+
+    return total;
+}
+
+void PageReassembler::reset() {
+    std::fill_n(fragments.data(), ReassemblyPool::bitmapWords(total), 0);
     count = 0;
 }
 
+// =============== Checkpoints ===============
+void PageReassembler::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(pageID);
+    out.write(srcIP);
+    out.write(dstIP);
+    out.write<uint64_t>(total);
+    out.write<uint64_t>(count);
+    out.write<uint64_t>(timeout);
+    out.writeArray(std::span<const uint64_t>(fragments.data(), ReassemblyPool::wordsFor(total)));
+}
+
+PageReassembler PageReassembler::restoreState(CheckpointReader& in, ReassemblyPool* pool) {
+    const auto id       = in.read<uint64_t>();
+    const auto src      = in.read<IPAddress>();
+    const auto dst      = in.read<IPAddress>();
+    const auto length   = in.read<uint64_t>();
+    const auto received = in.read<uint64_t>();
+    const auto expiry   = in.read<uint64_t>();
+    if (length == 0 || length > Packet::MAX_PAGE_LEN || received > length) {
+        throw std::runtime_error("Corrupt checkpoint");
+    }
+
+    PageReassembler reassembler(id, src, length, expiry, pool);
+    const std::span<const uint64_t> words = in.readArray<uint64_t>(ReassemblyPool::wordsFor(length));
+    std::ranges::copy(words, reassembler.fragments.data());
+    reassembler.dstIP = dst;
+    reassembler.count = received;
+    return reassembler;
+}
+
 std::string PageReassembler::toString() const {
     std::ostringstream oss;
     oss << "PageReassembler{ID: " << pageID << " | srcIP: " << srcIP << " | " << count << "/"
@@ -143,3 +226,9 @@ bool PageReassembler::operator==(const PageReassembler& other) const noexcept {
 bool PageReassembler::operator!=(const PageReassembler& other) const noexcept {
     return !(*this == other);
 }
+
+// =============== Private helpers ===============
+size_t PageReassembler::timeoutAt(size_t position) const noexcept {
+    const uint64_t slot = fragments.data()[ReassemblyPool::bitmapWords(total) + position / 2];
+    return static_cast<uint32_t>(slot >> (32 * (position % 2)));
+}
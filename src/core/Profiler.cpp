@@ -0,0 +1,205 @@
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+namespace {
+/** Time spent in each phase */
+using PhaseTotals = std::array<uint64_t, Profiler::PHASE_COUNT>;
+
+/**
+ * @struct ThreadTotals
+ * @brief Phase times recorded by one thread and not yet moved into the histograms.
+ */
+struct alignas(64) ThreadTotals {
+    PhaseTotals open{};              /**< Time recorded since the last closed tick */
+    std::vector<PhaseTotals> closed; /**< Time of the ticks closed so far in the run, by index */
+
+    /**
+     * @brief Adds the totals of another thread to these.
+     *
+     * @param other Totals to add.
+     */
+    void merge(const ThreadTotals& other) {
+        if (closed.size() < other.closed.size()) {
+            closed.resize(other.closed.size());
+        }
+        for (size_t p = 0; p < Profiler::PHASE_COUNT; ++p) {
+            open[p] += other.open[p];
+            for (size_t t = 0; t < other.closed.size(); ++t) {
+                closed[t][p] += other.closed[t][p];
+            }
+        }
+    }
+
+    /**
+     * @brief Drops every recorded time.
+     */
+    void clear() noexcept {
+        open.fill(0);
+        closed.clear();
+    }
+};
+
+/** Guards the registry and the totals of exited threads */
+std::mutex registryMutex;
+/** Totals of every live thread that recorded time */
+std::vector<ThreadTotals*> registry;
+/** Totals left by threads that exited before their time was merged */
+ThreadTotals exited;
+/** Per-tick time distribution of each phase */
+std::array<Profiler::Histogram, Profiler::PHASE_COUNT> histograms{};
+
+/**
+ * @class ThreadSlot
+ * @brief Registers the totals of a thread while it lives and hands them over when it exits.
+ */
+class ThreadSlot {
+public:
+    ThreadTotals totals; /**< Totals of the owning thread */
+
+    /**
+     * @brief Constructor, registers the totals.
+     */
+    ThreadSlot() {
+        const std::lock_guard lock(registryMutex);
+        registry.push_back(&totals);
+    }
+
+    /**
+     * @brief Destructor, keeps the unmerged time of the exiting thread.
+     */
+    ~ThreadSlot() {
+        const std::lock_guard lock(registryMutex);
+        exited.merge(totals);
+        std::erase(registry, &totals);
+    }
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    ThreadSlot(const ThreadSlot&) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     *
+     * @return Reference to this slot.
+     */
+    ThreadSlot& operator=(const ThreadSlot&) = delete;
+};
+
+/** Totals of the calling thread, registered on first use */
+ThreadTotals& localTotals() {
+    thread_local ThreadSlot slot;
+    return slot.totals;
+}
+
+size_t bucketOf(uint64_t nanos) noexcept {
+    const size_t bucket = nanos == 0 ? 0 : static_cast<size_t>(std::bit_width(nanos)) - 1;
+    return std::min(bucket, Profiler::BUCKET_COUNT - 1);
+}
+}  // namespace
+
+// =============== Histogram ===============
+void Profiler::Histogram::add(uint64_t nanos) noexcept {
+    buckets[bucketOf(nanos)]++;
+    ticks++;
+    totalNanos += nanos;
+    maxNanos = std::max(maxNanos, nanos);
+}
+
+uint64_t Profiler::Histogram::percentile(double q) const noexcept {
+    if (ticks == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(ticks));
+    uint64_t seen   = 0;
+    for (size_t b = 0; b < BUCKET_COUNT; ++b) {
+        seen += buckets[b];
+        if (seen > rank || seen == ticks) {
+            return std::min((uint64_t{2} << b) - 1, maxNanos);
+        }
+    }
+    return maxNanos;
+}
+
+double Profiler::Histogram::meanNanos() const noexcept {
+    return ticks > 0 ? static_cast<double>(totalNanos) / static_cast<double>(ticks) : 0.0;
+}
+
+// =============== Profiler ===============
+void Profiler::record(Phase phase, uint64_t nanos) noexcept {
+    localTotals().open[static_cast<size_t>(phase)] += nanos;
+}
+
+void Profiler::endTick() {
+    endTicks(1);
+}
+
+void Profiler::closeThreadTick(size_t runTick) {
+    ThreadTotals& totals = localTotals();
+    if (totals.closed.size() <= runTick) {
+        totals.closed.resize(runTick + 1);
+    }
+    for (size_t p = 0; p < PHASE_COUNT; ++p) {
+        totals.closed[runTick][p] += totals.open[p];
+    }
+    totals.open.fill(0);
+}
+
+void Profiler::endTicks(size_t ticks) {
+    if (ticks == 0) {
+        return;
+    }
+
+    const std::lock_guard lock(registryMutex);
+    ThreadTotals run = std::move(exited);
+    exited.clear();
+    for (ThreadTotals* totals : registry) {
+        run.merge(*totals);
+        totals->clear();
+    }
+
+    // Time recorded after the last mark of each thread belongs to the last tick of the run
+    run.closed.resize(std::max(run.closed.size(), ticks));
+    for (size_t p = 0; p < PHASE_COUNT; ++p) {
+        run.closed[ticks - 1][p] += run.open[p];
+        for (size_t t = 0; t < ticks; ++t) {
+            histograms[p].add(run.closed[t][p]);
+        }
+    }
+}
+
+const Profiler::Histogram& Profiler::histogram(Phase phase) noexcept {
+    return histograms[static_cast<size_t>(phase)];
+}
+
+void Profiler::reset() {
+    const std::lock_guard lock(registryMutex);
+    exited.clear();
+    for (ThreadTotals* totals : registry) {
+        totals->clear();
+    }
+    histograms.fill(Histogram{});
+}
+
+const char* Profiler::phaseName(Phase phase) noexcept {
+    switch (phase) {
+        case Phase::RouterOutput:
+            return "Router output";
+        case Phase::RouterLocal:
+            return "Router local";
+        case Phase::RouterTerminals:
+            return "Router terminals";
+        case Phase::RouterInput:
+            return "Router input";
+        case Phase::Routing:
+            return "Routing";
+        case Phase::Reassembly:
+            return "Reassembly";
+    }
+    return "Unknown";
+}
@@ -1,25 +1,34 @@
 #include <algorithm>
+#include <array>
 #include <ranges>
 
+#include "core/Checkpoint.h"
+#include "core/Profiler.h"
 #include "core/Router.h"
 #include "core/Terminal.h"
 
 Router::Router(IPAddress ip, size_t terminals, const Config& cfg)
     : routerIP(ip),
+      terminalCount(0),
       outBufferCap(cfg.outBufferCap),
+      outQueue(cfg.outQueue),
       inBuffer(cfg.inBufferCap),
       inProcCap(cfg.inProcCap),
       locBuffer(cfg.locBufferCap),
       locBufferBW(cfg.locBW),
       outBufferBW(cfg.outBW),
+      eagerExpiry(false),
+      trace(nullptr),
       packetsReceived(0),
       packetsDropped(0),
       packetsTimedOut(0),
       packetsForwarded(0),
-      packetsDelivered(0) {
+      packetsDelivered(0),
+      packetsDoomed(0) {
     if (!routerIP.isRouter()) {
         throw std::invalid_argument("Router IP must have terminalID = 0");
     }
+    OutputQueue::classCount(outQueue);
     initializeTerminals(terminals);
 }
 
@@ -38,8 +47,16 @@ bool Router::connectTerminal(TerminalPtr terminal) {
         throw std::invalid_argument("Terminal does not belong to this router");
     }
 
-    const IPAddress terminalIP = terminal->getTerminalIP();
-    terminals[terminalIP]      = std::move(terminal);
+    terminal->setEagerExpiry(eagerExpiry);
+    terminal->setTraceBuffer(trace);
+
+    const size_t id = terminal->getTerminalIP().getTerminalIP();
+    if (id >= terminals.size()) {
+        terminals.resize(id + 1);
+    }
+    terminals[id] = terminal.get();
+    adoptedTerms.push_back(std::move(terminal));
+    terminalCount++;
 
     return true;
 }
@@ -49,95 +66,143 @@ bool Router::connectRouter(Router* neighbor) {
         throw std::invalid_argument("Neighbor router cannot be nullptr");
     }
 
-    if (neighbor == this) {
+    if (neighbor == this || slotOf(neighbor->getIP()) != NO_SLOT) {
         return false;
     }
 
-    auto [it, inserted] =
-        connections.try_emplace(neighbor->getIP(), RtrConnection(neighbor, outBufferCap));
-    return inserted;
+    const size_t id = neighbor->getIP().getRouterIP();
+    if (id >= slotByRouter.size()) {
+        slotByRouter.resize(id + 1, NO_SLOT);
+    }
+    slotByRouter[id] = static_cast<uint16_t>(connections.size());
+    connections.emplace_back(neighbor, outBufferCap, outQueue);
+    connections.back().outBuffer.setEagerExpiry(eagerExpiry);
+
+    // A route through the new neighbor may already be in the table
+    rebuildRouteSlots();
+    return true;
 }
 
 bool Router::receivePacket(const Packet& packet) {
     packetsReceived++;
 
     if (!inBuffer.enqueue(packet)) {
-        packetsDropped++;
+        dropPacket(packet);
         return false;
     }
 
     return true;
 }
 
+size_t Router::receivePackets(std::span<const Packet> packets) {
+    packetsReceived += packets.size();
+
+    const size_t accepted = inBuffer.enqueueBatch(packets);
+    packetsDropped += packets.size() - accepted;
+    if (trace) {
+        trace->record(TraceEventType::Drop, packets.subspan(accepted), routerIP);
+    }
+    if (doomedPages.isEnabled()) {
+        for (const Packet& packet : packets.subspan(accepted)) {
+            doomPage(packet);
+        }
+    }
+
+    return accepted;
+}
+
 size_t Router::processOutputBuffers(size_t currentTick) {
+    ROUTERSIM_PROFILE_SCOPE(RouterOutput);
     size_t totalSent = 0;
 
-    for (auto& [rtr, buff] : connections | std::views::values) {
-        size_t sent = 0;
-        while (sent < outBufferBW && !buff.isEmpty()) {
-            Packet packet = buff.dequeue();
-
-            if (packet.getTimeout() <= currentTick) {
-                packetsTimedOut++;
-                continue;
-            }
+    std::vector<Packet>* expiredOut = trace ? &expired : nullptr;
+    for (RtrConnection& conn : connections) {
+        if (conn.staged) {
+            totalSent += stageConnection(conn, currentTick);
+            continue;
+        }
 
-            if (rtr) {
-                rtr->receivePacket(packet);
-                sent++;
-                packetsForwarded++;
-            } else {
-                packetsDropped++;
+        Router* rtr       = conn.neighborRouter;
+        OutputQueue& buff = conn.outBuffer;
+
+        batch.clear();
+        if (!rtr) {
+            // Nothing is sent over a dangling link, so the whole buffer is drained
+            packetsTimedOut +=
+                buff.dequeueLive(buff.size(), currentTick, batch, expiredOut, &dropped);
+            packetsDropped += batch.size();
+            traceExpired();
+            dropManagedPackets();
+            if (trace) {
+                trace->record(TraceEventType::Drop, batch, routerIP);
             }
+            continue;
         }
 
-        totalSent += sent;
+        packetsTimedOut +=
+            buff.dequeueLive(outBufferBW, currentTick, batch, expiredOut, &dropped);
+        traceExpired();
+        dropManagedPackets();
+        if (trace) {
+            trace->record(TraceEventType::Forward, batch, routerIP);
+        }
+        rtr->receivePackets(batch);
+        packetsForwarded += batch.size();
+        totalSent += batch.size();
     }
 
     return totalSent;
 }
 
 size_t Router::processLocalBuffer(size_t currentTick) {
-    size_t delivered = 0;
+    ROUTERSIM_PROFILE_SCOPE(RouterLocal);
+    size_t delivered                = 0;
+    std::vector<Packet>* expiredOut = trace ? &expired : nullptr;
 
+    // Undeliverable packets do not use bandwidth, so refill until it is used up
     while (delivered < locBufferBW && !locBuffer.isEmpty()) {
-        Packet packet = locBuffer.dequeue();
-
-        if (packet.getTimeout() <= currentTick) {
-            packetsTimedOut++;
-            continue;
-        }
-
-        auto it = terminals.find(packet.getDstIP());
-
-        if (it != terminals.end()) {
-            it->second->receivePacket(packet);
-            packetsDelivered++;
-            delivered++;
-        } else {
-            packetsDropped++;
+        batch.clear();
+        packetsTimedOut +=
+            locBuffer.dequeueLive(locBufferBW - delivered, currentTick, batch, expiredOut);
+        traceExpired();
+
+        for (const Packet& packet : batch) {
+            if (Terminal* terminal = terminalAt(packet.getDstIP())) {
+                traceEvent(TraceEventType::Deliver, packet);
+                terminal->receivePacket(packet);
+                packetsDelivered++;
+                delivered++;
+            } else {
+                dropPacket(packet);
+            }
         }
     }
     return delivered;
 }
 
 void Router::tickTerminals(size_t currentTick) {
-    for (auto& terminal : terminals | std::views::values) {
-        if (terminal) {
-            terminal->tick(currentTick);
-        }
+    ROUTERSIM_PROFILE_SCOPE(RouterTerminals);
+    for (const auto& terminal : connectedTerminals()) {
+        terminal->tick(currentTick);
     }
 }
 
 size_t Router::processInputBuffer(size_t currentTick) {
-    size_t processed = 0;
-
-    while (processed < inProcCap && !inBuffer.isEmpty()) {
-        processed++;
-        Packet packet = inBuffer.dequeue();
+    ROUTERSIM_PROFILE_SCOPE(RouterInput);
+    batch.clear();
+    const size_t processed = inBuffer.dequeueBatch(inProcCap, batch);
 
+    for (const Packet& packet : batch) {
         if (packet.getTimeout() <= currentTick) {
             packetsTimedOut++;
+            traceEvent(TraceEventType::Timeout, packet);
+            continue;
+        }
+        if (doomedPages.contains(Terminal::makePageKey(packet.getSrcIP(), packet.getPageID()))) {
+            // The page already lost a packet, so forwarding the rest only wastes bandwidth
+            packetsDoomed++;
+            packetsDropped++;
+            traceEvent(TraceEventType::Drop, packet);
             continue;
         }
 
@@ -147,86 +212,216 @@ size_t Router::processInputBuffer(size_t currentTick) {
 }
 
 void Router::tick(size_t currentTick) {
+    purgeExpiredPackets(currentTick);
     processOutputBuffers(currentTick);
     processLocalBuffer(currentTick);
     tickTerminals(currentTick);
     processInputBuffer(currentTick);
 }
 
+size_t Router::stageOutputBuffers(size_t currentTick) {
+    ROUTERSIM_PROFILE_SCOPE(RouterOutput);
+    size_t totalStaged = 0;
+
+    for (RtrConnection& conn : connections) {
+        totalStaged += stageConnection(conn, currentTick);
+    }
+
+    return totalStaged;
+}
+
+size_t Router::stageConnection(RtrConnection& conn, size_t currentTick) {
+    std::vector<Packet>* expiredOut = trace ? &expired : nullptr;
+    const size_t before             = conn.outbox.size();
+    packetsTimedOut +=
+        conn.outBuffer.dequeueLive(outBufferBW, currentTick, conn.outbox, expiredOut, &dropped);
+    traceExpired();
+    dropManagedPackets();
+
+    const size_t staged = conn.outbox.size() - before;
+    if (trace) {
+        trace->record(TraceEventType::Forward, std::span(conn.outbox).subspan(before), routerIP);
+    }
+    packetsForwarded += staged;
+
+    if (LinkRing* ring = conn.ring.get()) {
+        // Sized for two ticks, so the packets always fit; sealing an empty tick keeps the framing
+        ring->packets.pushBatch(conn.outbox);
+        ring->ends[ring->sealedTicks++ & 1].store(ring->packets.pushedCount(),
+                                                  std::memory_order_release);
+        conn.outbox.clear();
+    }
+    return staged;
+}
+
+void Router::tickCompute(size_t currentTick) {
+    purgeExpiredPackets(currentTick);
+    stageOutputBuffers(currentTick);
+    processLocalBuffer(currentTick);
+    tickTerminals(currentTick);
+    processInputBuffer(currentTick);
+}
+
+size_t Router::collectInbound() {
+    ROUTERSIM_PROFILE_SCOPE(RouterOutput);
+    size_t received = 0;
+
+    for (RtrConnection& conn : connections) {
+        if (conn.inboxSlot == NO_SLOT) {
+            conn.inboxSlot = conn.neighborRouter->slotOf(routerIP);
+            if (conn.inboxSlot == NO_SLOT) {
+                continue;  // One-way link, the neighbor never sends to this router
+            }
+        }
+
+        RtrConnection& link = conn.neighborRouter->connections[conn.inboxSlot];
+        if (LinkRing* ring = link.ring.get()) {
+            batch.clear();
+            const size_t tickEnd =
+                ring->ends[ring->collectedTicks++ & 1].load(std::memory_order_acquire);
+            ring->packets.popUntil(tickEnd, batch);
+            receivePackets(batch);
+            received += batch.size();
+            continue;
+        }
+
+        std::vector<Packet>& inbox = link.outbox;
+        receivePackets(inbox);
+        received += inbox.size();
+        inbox.clear();
+    }
+
+    return received;
+}
+
+size_t Router::nextActivityTick(size_t currentTick) const {
+    const bool buffered =
+        !inBuffer.isDrained() || !locBuffer.isDrained() ||
+        std::ranges::any_of(connections,
+                            [](const RtrConnection& conn) { return !conn.outBuffer.isDrained(); });
+    if (buffered) {
+        return currentTick + 1;
+    }
+
+    size_t next = Terminal::NO_ACTIVITY;
+    for (const auto& terminal : connectedTerminals()) {
+        next = std::min(next, terminal->nextActivityTick(currentTick));
+    }
+    return next;
+}
+
 size_t Router::getPacketsOutPending() const noexcept {
     return std::accumulate(connections.begin(), connections.end(), size_t{0},
-                           [](size_t acc, const auto& conn) {
-                               const auto& [rtr, rtrConn] = conn;
-                               return acc + rtrConn.outBuffer.size();
+                           [](size_t acc, const RtrConnection& conn) {
+                               return acc + conn.outBuffer.size();
                            });
 }
 
-size_t Router::getNeighborBufferUsage(IPAddress neighborIP) const {
-    if (const auto it = connections.find(neighborIP); it != connections.end()) {
-        return it->second.outBuffer.size();
+void Router::setLinkStaged(IPAddress neighborIP, bool staged) {
+    const uint16_t slot = slotOf(neighborIP);
+    if (slot == NO_SLOT) {
+        throw std::invalid_argument("Router is not connected to the neighbor");
     }
+    connections[slot].staged = staged;
+}
 
-    return 0;
+void Router::setLinkRings(bool enabled) {
+    const size_t capacity = 2 * std::max<size_t>(outBufferBW, 1);
+    for (RtrConnection& conn : connections) {
+        if (!enabled || !conn.staged) {
+            conn.ring.reset();
+        } else if (!conn.ring || conn.ring->packets.capacity() < capacity) {
+            conn.ring = std::make_unique<LinkRing>(capacity);
+        } else {
+            conn.ring->packets.clear();
+            conn.ring->sealedTicks    = 0;
+            conn.ring->collectedTicks = 0;
+        }
+    }
 }
 
-const Terminal* Router::getTerminal(IPAddress ip) const noexcept {
-    if (const auto it = terminals.find(ip); it != terminals.end()) {
-        return it->second.get();
+bool Router::isLinkStaged(IPAddress neighborIP) const noexcept {
+    const uint16_t slot = slotOf(neighborIP);
+    return slot != NO_SLOT && connections[slot].staged;
+}
+
+std::vector<ClassCounters> Router::getClassCounters() const {
+    std::vector<ClassCounters> totals(OutputQueue::classCount(outQueue));
+    for (const RtrConnection& conn : connections) {
+        const std::span<const ClassCounters> counters = conn.outBuffer.getClassCounters();
+        for (size_t k = 0; k < totals.size(); k++) {
+            totals[k] += counters[k];
+        }
     }
-    return nullptr;
+    return totals;
+}
+
+size_t Router::getNeighborBufferUsage(IPAddress neighborIP) const {
+    const uint16_t slot = slotOf(neighborIP);
+    return slot != NO_SLOT ? connections[slot].outBuffer.size() : 0;
+}
+
+const Terminal* Router::getTerminal(IPAddress ip) const noexcept {
+    return terminalAt(ip);
 }
 
 List<const Terminal*> Router::getTerminals() const noexcept {
     List<const Terminal*> list;
-    for (const auto& terminal : terminals | std::views::values) {
-        list.pushBack(terminal.get());
+    for (const auto& terminal : connectedTerminals()) {
+        list.pushBack(terminal);
     }
     return list;
 }
 
 List<IPAddress> Router::getNeighborIPs() const {
     List<IPAddress> ips;
-    for (const auto& ip : connections | std::views::keys) {
-        ips.pushBack(ip);
+    for (const RtrConnection& conn : connections) {
+        ips.pushBack(conn.outBuffer.getDstIP());
     }
     return ips;
 }
 
 List<IPAddress> Router::getTerminalIPs() const {
     List<IPAddress> ips;
-    for (const auto& ip : terminals | std::views::keys) {
-        ips.pushBack(ip);
+    for (const auto& terminal : connectedTerminals()) {
+        ips.pushBack(terminal->getTerminalIP());
     }
     return ips;
 }
 
-void Router::shareAddressBook(List<IPAddress>* terminalIPs) {
-    for (const auto& ip : terminals | std::views::values) {
+void Router::shareAddressBook(const std::vector<IPAddress>* terminalIPs) {
+    for (const auto& ip : connectedTerminals()) {
         ip->setAddressBook(terminalIPs);
     }
 }
 
-void Router::shareRandomGenerator(std::mt19937* r_gen) {
-    for (const auto& ip : terminals | std::views::values) {
+void Router::shareRandomGenerator(Xoshiro256* r_gen) {
+    for (const auto& ip : connectedTerminals()) {
         ip->setRandomGenerator(r_gen);
     }
 }
 
 void Router::shareTrafficProbability(float probability) {
-    for (const auto& ip : terminals | std::views::values) {
+    for (const auto& ip : connectedTerminals()) {
         ip->setTrafficProbability(probability);
     }
 }
 
+void Router::shareTrafficModel(const TrafficModel& model) {
+    for (const auto& ip : connectedTerminals()) {
+        ip->setTrafficModel(model.clone());
+    }
+}
+
 void Router::shareMaxPageLength(size_t pageLen) {
-    for (const auto& ip : terminals | std::views::values) {
+    for (const auto& ip : connectedTerminals()) {
         ip->setMaxPageLength(pageLen);
     }
 }
 
 std::string Router::toString() const {
     std::ostringstream oss;
-    oss << "Router{IP: " << routerIP << " | ConnectedTerminals: " << terminals.size()
+    oss << "Router{IP: " << routerIP << " | ConnectedTerminals: " << terminalCount
         << " | ConnectedRouters: " << connections.size() << "}";
     return oss.str();
 }
@@ -236,19 +431,276 @@ std::ostream& operator<<(std::ostream& os, const Router& router) {
     return os;
 }
 
+void Router::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(connections.size());
+    for (const RtrConnection& conn : connections) {
+        out.write(conn.outBuffer.getDstIP());
+    }
+    out.write<uint64_t>(terminalCount);
+
+    inBuffer.saveState(out);
+    locBuffer.saveState(out);
+    for (const RtrConnection& conn : connections) {
+        conn.outBuffer.saveState(out);
+    }
+
+    const std::array<uint64_t, 6> counters = {packetsReceived,  packetsDropped,
+                                              packetsTimedOut,  packetsForwarded,
+                                              packetsDelivered, packetsDoomed};
+    out.writeArray(std::span<const uint64_t>(counters));
+    out.write(terminalTotals);
+
+    out.write<uint64_t>(doomedPages.getBitCount());
+    out.writeArray(doomedPages.currentWords());
+    out.writeArray(doomedPages.previousWords());
+    out.write<uint64_t>(doomedPages.getInserted());
+
+    std::vector<uint32_t> nextHops(routingTable.getRouterIDCount(), CheckpointHeader::NO_ROUTE);
+    for (size_t dest = 0; dest < nextHops.size(); dest++) {
+        const IPAddress destIP{static_cast<IPAddress::RouterID>(dest)};
+        if (routingTable.hasRoute(destIP)) {
+            nextHops[dest] = routingTable.getNextHopIP(destIP).getRouterIP();
+        }
+    }
+    out.write<uint64_t>(nextHops.size());
+    out.writeArray(std::span<const uint32_t>(nextHops));
+
+    // Further equal-cost next hops, as (destination, next hop) pairs
+    std::vector<uint32_t> alternates;
+    for (size_t dest = 0; dest < nextHops.size(); dest++) {
+        const IPAddress destIP{static_cast<IPAddress::RouterID>(dest)};
+        for (size_t path = 1; path < routingTable.getPathCount(destIP); path++) {
+            alternates.push_back(static_cast<uint32_t>(dest));
+            alternates.push_back(routingTable.getNextHopIP(destIP, path).getRouterIP());
+        }
+    }
+    out.write<uint64_t>(alternates.size());
+    out.writeArray(std::span<const uint32_t>(alternates));
+
+    for (const auto& terminal : connectedTerminals()) {
+        terminal->saveState(out);
+    }
+}
+
+void Router::restoreState(CheckpointReader& in) {
+    bool sameLinks = in.read<uint64_t>() == connections.size();
+    for (size_t slot = 0; sameLinks && slot < connections.size(); slot++) {
+        sameLinks = in.read<IPAddress>() == connections[slot].outBuffer.getDstIP();
+    }
+    if (!sameLinks || in.read<uint64_t>() != terminalCount) {
+        throw std::runtime_error("Checkpoint does not match router " + routerIP.toString());
+    }
+
+    inBuffer.restoreState(in);
+    locBuffer.restoreState(in);
+    for (RtrConnection& conn : connections) {
+        conn.outBuffer.restoreState(in);
+        conn.outbox.clear();
+    }
+
+    const std::span<const uint64_t> counters = in.readArray<uint64_t>(6);
+    packetsReceived  = counters[0];
+    packetsDropped   = counters[1];
+    packetsTimedOut  = counters[2];
+    packetsForwarded = counters[3];
+    packetsDelivered = counters[4];
+    packetsDoomed    = counters[5];
+    terminalTotals   = in.read<TrafficCounters>();
+
+    // A fork may run with another filter size, which then starts out empty
+    const auto filterWords                  = in.read<uint64_t>() / 64;
+    const std::span<const uint64_t> current = in.readArray<uint64_t>(filterWords);
+    const std::span<const uint64_t> prev    = in.readArray<uint64_t>(filterWords);
+    const auto inserted                     = in.read<uint64_t>();
+    if (filterWords * 64 == doomedPages.getBitCount()) {
+        doomedPages.restore(current, prev, inserted);
+    } else {
+        doomedPages.clear();
+    }
+    dropNotices.clear();
+
+    const auto routerIDs                     = in.read<uint64_t>();
+    const std::span<const uint32_t> nextHops = in.readArray<uint32_t>(routerIDs);
+    RoutingTable table(routerIDs);
+    for (size_t dest = 0; dest < routerIDs; dest++) {
+        if (nextHops[dest] == CheckpointHeader::NO_ROUTE) {
+            continue;
+        }
+        if (nextHops[dest] > IPAddress::MAX_ROUTER_ID) {
+            throw std::runtime_error("Corrupt checkpoint");
+        }
+        table.setNextHopIP(IPAddress{static_cast<IPAddress::RouterID>(dest)},
+                           IPAddress{static_cast<IPAddress::RouterID>(nextHops[dest])});
+    }
+
+    const auto alternateCount                  = in.read<uint64_t>();
+    const std::span<const uint32_t> alternates = in.readArray<uint32_t>(alternateCount);
+    if (alternateCount % 2 != 0) {
+        throw std::runtime_error("Corrupt checkpoint");
+    }
+    for (size_t i = 0; i < alternates.size(); i += 2) {
+        const uint32_t dest = alternates[i];
+        const uint32_t hop  = alternates[i + 1];
+        if (dest >= routerIDs || nextHops[dest] == CheckpointHeader::NO_ROUTE ||
+            hop > IPAddress::MAX_ROUTER_ID) {
+            throw std::runtime_error("Corrupt checkpoint");
+        }
+        table.addNextHopIP(IPAddress{static_cast<IPAddress::RouterID>(dest)},
+                           IPAddress{static_cast<IPAddress::RouterID>(hop)});
+    }
+    setRoutingTable(std::move(table));
+
+    for (const auto& terminal : connectedTerminals()) {
+        terminal->restoreState(in);
+    }
+}
+
+void Router::setEagerExpiry(bool enabled) {
+    eagerExpiry = enabled;
+
+    inBuffer.setEagerExpiry(enabled);
+    locBuffer.setEagerExpiry(enabled);
+    for (RtrConnection& conn : connections) {
+        conn.outBuffer.setEagerExpiry(enabled);
+    }
+    for (const auto& terminal : connectedTerminals()) {
+        terminal->setEagerExpiry(enabled);
+    }
+}
+
+void Router::setOutputQueue(const QueueConfig& config) {
+    OutputQueue::classCount(config);
+    const auto holdsPackets = [](const RtrConnection& conn) { return !conn.outBuffer.isDrained(); };
+    if (std::ranges::any_of(connections, holdsPackets)) {
+        throw std::invalid_argument("Cannot change the output queues while they hold packets");
+    }
+
+    outQueue = config;
+    for (RtrConnection& conn : connections) {
+        conn.outBuffer = OutputQueue(conn.outBuffer.getDstIP(), outBufferCap, outQueue);
+        conn.outBuffer.setEagerExpiry(eagerExpiry);
+    }
+}
+
+void Router::setDoomedPageFilter(size_t bits) {
+    doomedPages = AgingBloomFilter(bits);
+    dropNotices.clear();
+}
+
+void Router::markPageDoomed(uint64_t pageKey) {
+    if (doomedPages.isEnabled() && !doomedPages.contains(pageKey)) {
+        doomedPages.insert(pageKey);
+    }
+}
+
+void Router::setRoutingTable(RoutingTable&& table) {
+    routingTable = std::move(table);
+    rebuildRouteSlots();
+}
+
+void Router::setTraceBuffer(TraceBuffer* buffer) {
+    trace = buffer;
+    for (const auto& terminal : connectedTerminals()) {
+        terminal->setTraceBuffer(buffer);
+    }
+}
+
+void Router::purgeExpiredPackets(size_t currentTick) {
+    if (!eagerExpiry) {
+        return;
+    }
+
+    packetsTimedOut += inBuffer.purgeExpired(currentTick);
+    packetsTimedOut += locBuffer.purgeExpired(currentTick);
+    for (RtrConnection& conn : connections) {
+        packetsTimedOut += conn.outBuffer.purgeExpired(currentTick);
+    }
+}
+
+void Router::traceExpired() {
+    if (trace && !expired.empty()) {
+        trace->record(TraceEventType::Timeout, expired, routerIP);
+        expired.clear();
+    }
+}
+
 void Router::initializeTerminals(size_t count) {
+    terminalBlock = Arena<Terminal>(count);
+    terminals.resize(std::max(terminals.size(), count + 1));
     for (size_t i = 1; i <= count; ++i) {
-        auto terminal = std::make_unique<Terminal>(this, i);
-        IPAddress terminalIP(routerIP.getRouterIP(), i);
-        terminals[terminalIP] = std::move(terminal);
+        terminals[i] = &terminalBlock.emplace(this, i);
     }
+    terminalCount = count;
 }
 
-PacketBuffer* Router::getOutputBuffer(IPAddress nextIP) {
-    if (const auto it = connections.find(nextIP); it != connections.end()) {
-        return &(it->second.outBuffer);
+void Router::rebuildRouteSlots() {
+    routeSlots.assign(routingTable.getRouterIDCount(), NO_SLOT);
+    if (!routingTable.isMultipath()) {
+        pathSlots.clear();
+        pathCounts.clear();
+        for (size_t id = 0; id < routeSlots.size(); ++id) {
+            const IPAddress dest{static_cast<IPAddress::RouterID>(id)};
+            if (routingTable.hasRoute(dest)) {
+                routeSlots[id] = slotOf(routingTable.getNextHopIP(dest));
+            }
+        }
+        return;
+    }
+
+    // Next hops that are not connected yet are skipped until they are
+    constexpr size_t MAX_PATHS = RoutingTable::MAX_PATHS;
+    pathSlots.assign(routeSlots.size() * MAX_PATHS, NO_SLOT);
+    pathCounts.assign(routeSlots.size(), 0);
+    for (size_t id = 0; id < routeSlots.size(); ++id) {
+        const IPAddress dest{static_cast<IPAddress::RouterID>(id)};
+        for (size_t path = 0; path < routingTable.getPathCount(dest); ++path) {
+            const uint16_t slot = slotOf(routingTable.getNextHopIP(dest, path));
+            if (slot != NO_SLOT) {
+                pathSlots[id * MAX_PATHS + pathCounts[id]++] = slot;
+            }
+        }
+        routeSlots[id] = pathSlots[id * MAX_PATHS];
+    }
+}
+
+size_t Router::pathOf(const Packet& packet, size_t paths) const noexcept {
+    uint64_t h = Terminal::makePageKey(packet.getSrcIP(), packet.getPageID()) ^
+                 uint64_t{routerIP.getRouterIP()} * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return static_cast<size_t>((h >> 32) * paths >> 32);
+}
+
+void Router::dropPacket(const Packet& packet) {
+    packetsDropped++;
+    traceEvent(TraceEventType::Drop, packet);
+    doomPage(packet);
+}
+
+void Router::doomPage(const Packet& packet) {
+    // A page of a single packet has nothing left to drop
+    if (!doomedPages.isEnabled() || packet.getPageLen() <= 1) {
+        return;
+    }
+
+    const Terminal::PageKey key = Terminal::makePageKey(packet.getSrcIP(), packet.getPageID());
+    if (doomedPages.contains(key)) {
+        return;
+    }
+    doomedPages.insert(key);
+    if (packet.getSrcIP().getRouterIP() != routerIP.getRouterIP()) {
+        dropNotices.push_back(key);
     }
-    return nullptr;
+}
+
+void Router::dropManagedPackets() {
+    for (const Packet& packet : dropped) {
+        dropPacket(packet);
+    }
+    dropped.clear();
 }
 
 bool Router::routePacket(const Packet& packet) {
@@ -258,29 +710,32 @@ bool Router::routePacket(const Packet& packet) {
         if (locBuffer.enqueue(packet)) {
             return true;
         }
-        packetsDropped++;
+        dropPacket(packet);
         return false;
     }
 
-    const IPAddress nextHopIP = routingTable.getNextHopIP(destIP);
-    PacketBuffer* outBuffer   = getOutputBuffer(nextHopIP);
+    const size_t destID = destIP.getRouterIP();
+    uint16_t slot       = destID < routeSlots.size() ? routeSlots[destID] : NO_SLOT;
+    if (destID < pathCounts.size() && pathCounts[destID] > 1) {
+        slot = pathSlots[destID * RoutingTable::MAX_PATHS + pathOf(packet, pathCounts[destID])];
+    }
 
-    if (!outBuffer) {
-        packetsDropped++;
+    if (slot == NO_SLOT) {
+        dropPacket(packet);
         return false;
     }
 
-    if (outBuffer->enqueue(packet)) {
+    if (connections[slot].outBuffer.enqueue(packet)) {
         return true;
     }
-    packetsDropped++;
+    dropPacket(packet);
     return false;
 }
 
 bool Router::routerIsConnected(const IPAddress& neighborIP) const {
-    return connections.contains(neighborIP);
+    return slotOf(neighborIP) != NO_SLOT;
 }
 
 bool Router::terminalIsConnected(const IPAddress& terminalIP) const {
-    return terminals.contains(terminalIP);
+    return terminalAt(terminalIP) != nullptr;
 }
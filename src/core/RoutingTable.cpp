@@ -1,21 +1,52 @@
 #include "core/RoutingTable.h"
 
-IPAddress RoutingTable::getNextHopIP(IPAddress destIP) {
-    const IPAddress routerIP(destIP.getRouterIP());
-    for (const auto& [destRouterIP, nextHopIP] : entries) {
-        if (destRouterIP == routerIP) {
-            return nextHopIP;
-        }
+#include <algorithm>
+
+RoutingTable::RoutingTable(size_t routerIDs) : routes(routerIDs, Route{IPAddress{}, 0}) {}
+
+void RoutingTable::setNextHopIP(IPAddress destIP, IPAddress nextHop) {
+    const size_t id = destIP.getRouterIP();
+    if (id >= routes.size()) {
+        routes.resize(id + 1, Route{IPAddress{}, 0});
     }
-    return {};  // Return invalid IP if not found
+
+    Route& route = routes[id];
+    if (route.pathCount == 0) {
+        routeCount++;
+    }
+    route.nextHopIP = nextHop;
+    route.pathCount = 1;
 }
 
-void RoutingTable::setNextHopIP(IPAddress destIP, IPAddress nextHop) {
-    for (auto& [destRouterIP, nextHopIP] : entries) {
-        if (destRouterIP == destIP) {
-            nextHopIP = nextHop;
-            return;
-        }
+bool RoutingTable::addNextHopIP(IPAddress destIP, IPAddress nextHop) {
+    const size_t id = destIP.getRouterIP();
+    if (id >= routes.size() || routes[id].pathCount == 0) {
+        setNextHopIP(destIP, nextHop);
+        return true;
+    }
+
+    Route& route = routes[id];
+    if (route.pathCount == MAX_PATHS || route.nextHopIP == nextHop) {
+        return false;
+    }
+    if (alternates.size() < routes.size() * (MAX_PATHS - 1)) {
+        alternates.resize(routes.size() * (MAX_PATHS - 1));
+    }
+
+    const auto first = alternates.begin() + static_cast<std::ptrdiff_t>(id * (MAX_PATHS - 1));
+    const auto last  = first + route.pathCount - 1;
+    if (std::find(first, last, nextHop) != last) {
+        return false;
+    }
+    *last = nextHop;
+    route.pathCount++;
+    return true;
+}
+
+void RoutingTable::clear() noexcept {
+    for (auto& route : routes) {
+        route.pathCount = 0;
     }
-    entries.pushBack(Routes{destIP, nextHop});
+    alternates.clear();
+    routeCount = 0;
 }
@@ -1,10 +1,14 @@
 #include <algorithm>
+#include <array>
+#include <random>
 
+#include "core/Checkpoint.h"
 #include "core/Page.h"
+#include "core/Profiler.h"
 #include "core/Router.h"
 #include "core/Terminal.h"
 
-Terminal::Terminal(Router* router, uint8_t terminalID, const Config& cfg)
+Terminal::Terminal(Router* router, IPAddress::TerminalID terminalID, const Config& cfg)
     : terminalIP(router->getIP().getRouterIP(), terminalID),
       rtrConn(router),
       inBuffer(cfg.inBufferCap),
@@ -28,7 +32,12 @@ Terminal::Terminal(Router* router, uint8_t terminalID, const Config& cfg)
       addressBook(nullptr),
       trafficProbability(0),
       maxPageLen(0),
-      m_gen(nullptr) {
+      m_gen(nullptr),
+      traffic(nullptr),
+      trafficScheduled(false),
+      nextTrafficTick(NO_ACTIVITY),
+      trace(nullptr),
+      totals(&router->getTerminalTotals()) {
     if (terminalID == 0) {
         throw std::invalid_argument("Terminal ID must be greater than 0");
     }
@@ -37,19 +46,31 @@ Terminal::Terminal(Router* router, uint8_t terminalID, const Config& cfg)
 bool Terminal::sendPage(size_t length, IPAddress destIP, size_t timeout) {
     const Page page(nextPageID++, length, terminalIP, destIP);
 
-    List<Packet> packets  = page.toPackets(timeout);
-    const auto numPackets = packets.size();
+    // The page is queued as a single descriptor; its packets only exist once they are sent
+    const bool queued     = outBuffer.enqueue(page, timeout);
+    const auto numPackets = page.getPageLen();
     pagesCreated++;
     packetsGenerated += numPackets;
+    totals->pagesCreated++;
+    totals->packetsGenerated += numPackets;
 
-    if (outBuffer.availableSpace() < numPackets) {
+    if (!queued) {
         pagesOutDropped++;
         packetsOutDropped += numPackets;
+        totals->pagesDropped++;
+        totals->packetsDropped += numPackets;
+        if (trace) {
+            for (const auto& packet : page.toPackets(timeout)) {
+                trace->record(TraceEventType::Drop, packet, terminalIP);
+            }
+        }
         return false;
     }
 
-    for (const auto& packet : packets) {
-        outBuffer.enqueue(packet);
+    if (trace) {
+        for (const auto& packet : page.toPackets(timeout)) {
+            trace->record(TraceEventType::Enqueue, packet, terminalIP);
+        }
     }
     pagesSent++;
 
@@ -59,33 +80,64 @@ bool Terminal::sendPage(size_t length, IPAddress destIP, size_t timeout) {
 bool Terminal::receivePacket(const Packet& packet) {
     packetsReceived++;
 
-    if (isIDQuarantined(packet.getPageID())) {
-        packetsInTimedOut++;
+    if (isQuarantined(packet.getSrcIP(), packet.getPageID())) {
+        countInTimedOut(1);
+        if (trace) {
+            trace->record(TraceEventType::Timeout, packet, terminalIP);
+        }
         return false;
     }
 
     if (!inBuffer.enqueue(packet)) {
-        packetsInDropped++;
+        countInDropped(1);
+        if (trace) {
+            trace->record(TraceEventType::Drop, packet, terminalIP);
+        }
         return false;
     }
 
     return true;
 }
 
-size_t Terminal::processInputBuffer(size_t currentTick) {
-    size_t processedCount = 0;
+size_t Terminal::receivePackets(std::span<const Packet> packets) {
+    if (!quarantine.isEmpty()) {
+        size_t accepted = 0;
+        for (const Packet& packet : packets) {
+            accepted += receivePacket(packet) ? 1 : 0;
+        }
+        return accepted;
+    }
 
-    while (processedCount < inProcCap && !inBuffer.isEmpty()) {
-        Packet packet = inBuffer.dequeue();
-        processedCount++;
+    packetsReceived += packets.size();
+
+    const size_t accepted = inBuffer.enqueueBatch(packets);
+    countInDropped(packets.size() - accepted);
+    if (trace) {
+        trace->record(TraceEventType::Drop, packets.subspan(accepted), terminalIP);
+    }
+
+    return accepted;
+}
+
+size_t Terminal::processInputBuffer(size_t currentTick) {
+    ROUTERSIM_PROFILE_SCOPE(Reassembly);
+    batch.clear();
+    const size_t processedCount = inBuffer.dequeueBatch(inProcCap, batch);
 
+    for (const Packet& packet : batch) {
         if (currentTick >= packet.getTimeout()) {
-            packetsInTimedOut++;
+            countInTimedOut(1);
+            if (trace) {
+                trace->record(TraceEventType::Timeout, packet, terminalIP);
+            }
             continue;
         }
 
         if (packet.getDstIP() != terminalIP) {
-            packetsInDropped++;
+            countInDropped(1);
+            if (trace) {
+                trace->record(TraceEventType::Drop, packet, terminalIP);
+            }
             continue;
         }
 
@@ -94,43 +146,48 @@ size_t Terminal::processInputBuffer(size_t currentTick) {
                                     currentTick + MAX_ASSEMBLER_TTL);
 
         if (!reassembler) {
-            packetsInTimedOut++;
+            countInTimedOut(1);
+            if (trace) {
+                trace->record(TraceEventType::Timeout, packet, terminalIP);
+            }
             continue;
         }
 
         if (!reassembler->addPacket(packet)) {
-            packetsInDropped++;
+            countInDropped(1);
+            if (trace) {
+                trace->record(TraceEventType::Drop, packet, terminalIP);
+            }
             continue;
         }
 
         if (reassembler->isComplete()) {
-            packetsSuccProcessed += reassembler->getTotalPackets();
-            handleCompletedPage(reassembler->getPageID(), reassembler->getSrcIP());
+            handleCompletedPage(reassembler);
+            if (trace) {
+                trace->record(TraceEventType::PageComplete, packet, terminalIP);
+            }
         }
     }
     return processedCount;
 }
 
 size_t Terminal::processOutputBuffer(size_t currentTick) {
-    size_t processedCount = 0;
+    batch.clear();
+    std::vector<Packet>* expiredOut = trace ? &expired : nullptr;
+    countOutTimedOut(outBuffer.dequeueLive(outBW, currentTick, batch, expiredOut));
+    traceExpired();
 
-    while (processedCount < outBW && !outBuffer.isEmpty()) {
-        const Packet packet = outBuffer.dequeue();
+    rtrConn->receivePackets(batch);
+    packetsSent += batch.size();
+    totals->packetsSent += batch.size();
 
-        if (currentTick >= packet.getTimeout()) {
-            packetsOutTimedOut++;
-            continue;
-        }
-
-        rtrConn->receivePacket(packet);
-        packetsSent++;
-        processedCount++;
-    }
-
-    return processedCount;
+    return batch.size();
 }
 
 void Terminal::tick(size_t currentTick) {
+    countInTimedOut(inBuffer.purgeExpired(currentTick));
+    countOutTimedOut(outBuffer.purgeExpired(currentTick));
+
     updateQuarantine(currentTick);
     cleanupReassemblers(currentTick);
 
@@ -140,76 +197,202 @@ void Terminal::tick(size_t currentTick) {
 }
 
 void Terminal::generateTraffic(size_t currentTick) {
-    if (!addressBook || addressBook->isEmpty() || !m_gen) {
+    if (!canGenerateTraffic()) {
         return;
     }
 
-    std::bernoulli_distribution decision(trafficProbability);
-    if (!decision(*m_gen)) {
-        return;
+    // Emissions of ticks the terminal was not ticked at are skipped
+    if (!trafficScheduled || nextTrafficTick < currentTick) {
+        nextTrafficTick  = traffic->firstEmission(currentTick, *m_gen);
+        trafficScheduled = true;
     }
+    while (nextTrafficTick == currentTick) {
+        emitPage(currentTick);
+        nextTrafficTick = traffic->nextEmission(currentTick, *m_gen);
+    }
+}
 
-    std::uniform_int_distribution<size_t> indexDist(0, addressBook->size() - 1);
-    const size_t targetIdx = indexDist(*m_gen);
-
-    const IPAddress dest = (*addressBook)[targetIdx];
+size_t Terminal::nextActivityTick(size_t currentTick) const {
+    if (!inBuffer.isDrained() || !outBuffer.isDrained()) {
+        return currentTick + 1;
+    }
 
-    if (dest == this->terminalIP) {
-        return;
+    size_t next = NO_ACTIVITY;
+    if (canGenerateTraffic()) {
+        next = trafficScheduled ? nextTrafficTick : currentTick + 1;
     }
+    for (const PageReassembler& reassembler : reassemblers) {
+        next = std::min(next, reassembler.getTimeout());
+    }
+    quarantine.forEach([&next](PageKey /*key*/, size_t end) { next = std::min(next, end); });
 
-    std::uniform_int_distribution<size_t> burstDist(2, maxPageLen);
-    const size_t numPackets = burstDist(*m_gen);
+    return std::max(next, currentTick + 1);
+}
 
-    sendPage(numPackets, dest, currentTick + PACKET_TTL);
+void Terminal::setTrafficProbability(float probability) {
+    trafficProbability = probability;
+    setTrafficModel(std::make_unique<BernoulliTraffic>(probability));
+}
+
+void Terminal::setTrafficModel(std::unique_ptr<TrafficModel> model) noexcept {
+    traffic          = std::move(model);
+    trafficScheduled = false;
+}
+
+void Terminal::setEagerExpiry(bool enabled) {
+    inBuffer.setEagerExpiry(enabled);
+    outBuffer.setEagerExpiry(enabled);
 }
 
 PageReassembler* Terminal::findOrCreateReassembler(size_t pageID, IPAddress srcIP,
                                                    size_t pageLength, size_t timeout) {
-    auto it = std::ranges::find_if(reassemblers, [&](const auto& r) {
-        return (r.getPageID() == pageID) && (r.getSrcIP() == srcIP);
-    });
+    const PageKey key = makePageKey(srcIP, pageID);
 
-    if (it != reassemblers.end()) {
-        return (it->getTotalPackets() == pageLength) ? &(*it) : nullptr;
+    if (const size_t* index = reassemblerIndex.find(key)) {
+        PageReassembler& existing = reassemblers[*index];
+        return (existing.getTotalPackets() == pageLength) ? &existing : nullptr;
     }
 
-    return &reassemblers.emplace_back(pageID, srcIP, pageLength, timeout);
-}
+    reassemblers.emplace_back(pageID, srcIP, pageLength, timeout, &reassemblyPool);
+    reassemblerIndex.insert(key, reassemblers.size() - 1);
+    reassemblerTimers.schedule(timeout, key);
 
-void Terminal::handleCompletedPage(size_t pageID, IPAddress srcIP) {
-    auto it = std::ranges::find_if(reassemblers, [&](const auto& r) {
-        return (r.getPageID() == pageID) && (r.getSrcIP() == srcIP);
-    });
+    return &reassemblers.back();
+}
 
-    if (it == reassemblers.end()) {
-        return;
-    }
+void Terminal::handleCompletedPage(PageReassembler* reassembler) {
+    const size_t packets = reassembler->finish();
+    packetsSuccProcessed += packets;
+    pagesCompleted++;
+    totals->packetsDelivered += packets;
+    totals->pagesCompleted++;
 
-    List<Packet> packets = it->package();
+    removeReassembler(reassembler - reassemblers.data());
+}
 
-    [[maybe_unused]]
-    const Page completedPage(std::move(packets));
+void Terminal::removeReassembler(size_t index) {
+    reassemblerIndex.erase(
+        makePageKey(reassemblers[index].getSrcIP(), reassemblers[index].getPageID()));
 
-    pagesCompleted++;
-    reassemblers.erase(it);
+    const size_t last = reassemblers.size() - 1;
+    if (index != last) {
+        reassemblers[index] = std::move(reassemblers[last]);
+        *reassemblerIndex.find(
+            makePageKey(reassemblers[index].getSrcIP(), reassemblers[index].getPageID())) = index;
+    }
+    reassemblers.pop_back();
 }
 
 void Terminal::cleanupReassemblers(size_t currentTick) {
-    std::erase_if(reassemblers, [this, currentTick](const PageReassembler& ra) {
-        if (ra.getTimeout() <= currentTick) {
-            this->pagesTimedOut++;
-            this->packetsInTimedOut += ra.getReceivedPackets();
-            this->quarantine.push_back({ra.getPageID(), currentTick + PACKET_TTL});
-            return true;
+    reassemblerTimers.advance(currentTick, [this, currentTick](PageKey key) {
+        const size_t* index = reassemblerIndex.find(key);
+
+        // The page completed, or a later reassembler for it owns its own timer
+        if (!index || reassemblers[*index].getTimeout() > currentTick) {
+            return;
         }
-        return false;
+
+        const PageReassembler& ra = reassemblers[*index];
+        pagesTimedOut++;
+        totals->pagesTimedOut++;
+        countInTimedOut(ra.getReceivedPackets());
+
+        const size_t quarantineEnd = currentTick + PACKET_TTL;
+        quarantine.insertOrAssign(key, quarantineEnd);
+        quarantineTimers.schedule(quarantineEnd, key);
+
+        removeReassembler(*index);
     });
 }
 
 void Terminal::updateQuarantine(size_t currentTick) {
-    std::erase_if(quarantine,
-                  [currentTick](const QuarantinedID& q) { return q.timeout <= currentTick; });
+    quarantineTimers.advance(currentTick, [this, currentTick](PageKey key) {
+        // A later quarantine of the same page extends it past this timer
+        const size_t* end = quarantine.find(key);
+        if (end && *end <= currentTick) {
+            quarantine.erase(key);
+        }
+    });
+}
+
+void Terminal::saveState(CheckpointWriter& out) const {
+    inBuffer.saveState(out);
+    outBuffer.saveState(out);
+
+    const std::array<uint64_t, 14> counters = {
+        pagesCreated, pagesSent, pagesOutDropped, pagesCompleted, pagesTimedOut,
+        packetsGenerated, packetsSent, packetsOutDropped, packetsOutTimedOut,
+        packetsReceived, packetsInTimedOut, packetsInDropped, packetsSuccProcessed, nextPageID};
+    out.writeArray(std::span<const uint64_t>(counters));
+
+    out.write<uint8_t>(traffic ? 1 : 0);
+    out.write<uint8_t>(trafficScheduled ? 1 : 0);
+    out.write<uint64_t>(nextTrafficTick);
+    if (traffic) {
+        traffic->saveState(out);
+    }
+
+    out.write<uint64_t>(reassemblers.size());
+    for (const PageReassembler& reassembler : reassemblers) {
+        reassembler.saveState(out);
+    }
+
+    out.write<uint64_t>(quarantine.size());
+    quarantine.forEach([&out](PageKey key, size_t end) {
+        out.write<uint64_t>(key);
+        out.write<uint64_t>(end);
+    });
+}
+
+void Terminal::restoreState(CheckpointReader& in) {
+    inBuffer.restoreState(in);
+    outBuffer.restoreState(in);
+
+    const std::span<const uint64_t> counters = in.readArray<uint64_t>(14);
+    pagesCreated         = counters[0];
+    pagesSent            = counters[1];
+    pagesOutDropped      = counters[2];
+    pagesCompleted       = counters[3];
+    pagesTimedOut        = counters[4];
+    packetsGenerated     = counters[5];
+    packetsSent          = counters[6];
+    packetsOutDropped    = counters[7];
+    packetsOutTimedOut   = counters[8];
+    packetsReceived      = counters[9];
+    packetsInTimedOut    = counters[10];
+    packetsInDropped     = counters[11];
+    packetsSuccProcessed = counters[12];
+    nextPageID           = counters[13];
+
+    if ((in.read<uint8_t>() != 0) != (traffic != nullptr)) {
+        throw std::runtime_error("Checkpoint traffic model does not match the terminal");
+    }
+    trafficScheduled = in.read<uint8_t>() != 0;
+    nextTrafficTick  = in.read<uint64_t>();
+    if (traffic) {
+        traffic->restoreState(in);
+    }
+
+    // Timers are rescheduled for the live entries only; the wheels catch up on their next advance
+    reassemblers.clear();
+    reassemblerIndex.clear();
+    reassemblerTimers = TimerWheel<PageKey>();
+    for (auto remaining = in.read<uint64_t>(); remaining > 0; --remaining) {
+        reassemblers.push_back(PageReassembler::restoreState(in, &reassemblyPool));
+        const PageReassembler& reassembler = reassemblers.back();
+        const PageKey key = makePageKey(reassembler.getSrcIP(), reassembler.getPageID());
+        reassemblerIndex.insert(key, reassemblers.size() - 1);
+        reassemblerTimers.schedule(reassembler.getTimeout(), key);
+    }
+
+    quarantine.clear();
+    quarantineTimers = TimerWheel<PageKey>();
+    for (auto remaining = in.read<uint64_t>(); remaining > 0; --remaining) {
+        const auto key = in.read<uint64_t>();
+        const auto end = in.read<uint64_t>();
+        quarantine.insertOrAssign(key, end);
+        quarantineTimers.schedule(end, key);
+    }
 }
 
 std::string Terminal::toString() const {
@@ -224,7 +407,48 @@ std::ostream& operator<<(std::ostream& os, const Terminal& terminal) {
     return os;
 }
 
-bool Terminal::isIDQuarantined(size_t id) const {
-    return std::ranges::any_of(
-        quarantine, [id](size_t qID) { return qID == id; }, &QuarantinedID::pageID);
+bool Terminal::canGenerateTraffic() const noexcept {
+    return traffic && addressBook && !addressBook->empty() && m_gen;
+}
+
+void Terminal::traceExpired() {
+    if (trace && !expired.empty()) {
+        trace->record(TraceEventType::Timeout, expired, terminalIP);
+        expired.clear();
+    }
+}
+
+void Terminal::countInTimedOut(size_t count) noexcept {
+    packetsInTimedOut += count;
+    totals->packetsTimedOut += count;
+}
+
+void Terminal::countInDropped(size_t count) noexcept {
+    packetsInDropped += count;
+    totals->packetsDropped += count;
+}
+
+void Terminal::countOutTimedOut(size_t count) noexcept {
+    packetsOutTimedOut += count;
+    totals->packetsTimedOut += count;
+}
+
+void Terminal::emitPage(size_t currentTick) {
+    std::uniform_int_distribution<size_t> indexDist(0, addressBook->size() - 1);
+    const size_t targetIdx = indexDist(*m_gen);
+
+    const IPAddress dest = (*addressBook)[targetIdx];
+
+    if (dest == this->terminalIP) {
+        return;
+    }
+
+    std::uniform_int_distribution<size_t> burstDist(2, maxPageLen);
+    const size_t numPackets = burstDist(*m_gen);
+
+    sendPage(numPackets, dest, currentTick + PACKET_TTL);
+}
+
+bool Terminal::isQuarantined(IPAddress srcIP, size_t pageID) const {
+    return quarantine.contains(makePageKey(srcIP, pageID));
 }
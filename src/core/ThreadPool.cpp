@@ -0,0 +1,186 @@
+#include "core/ThreadPool.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+constexpr uint64_t pack(uint64_t begin, uint64_t end) noexcept {
+    return begin << 32 | end;
+}
+
+constexpr uint64_t rangeBegin(uint64_t bounds) noexcept {
+    return bounds >> 32;
+}
+
+constexpr uint64_t rangeEnd(uint64_t bounds) noexcept {
+    return bounds & 0xFFFFFFFFu;
+}
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    ranges = std::make_unique<StealRange[]>(threads);
+
+    workers.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    if (count > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Too many iterations for a parallel loop");
+    }
+
+    {
+        std::lock_guard lock(mutex);
+
+        // Split the iterations evenly, the first `count % threads` ranges get one extra
+        const size_t threads = threadCount();
+        size_t begin         = 0;
+        for (size_t t = 0; t < threads; ++t) {
+            const size_t length = count / threads + (t < count % threads ? 1 : 0);
+            ranges[t].bounds.store(pack(begin, begin + length), std::memory_order_relaxed);
+            begin += length;
+        }
+
+        jobBody       = &body;
+        jobError      = nullptr;
+        activeWorkers = workers.size();
+        cancelled.store(false, std::memory_order_relaxed);
+        generation++;
+    }
+    jobReady.notify_all();
+
+    runIterations(0, body);
+
+    std::unique_lock lock(mutex);
+    jobDone.wait(lock, [this] { return activeWorkers == 0; });
+    jobBody = nullptr;
+
+    if (jobError) {
+        std::rethrow_exception(std::exchange(jobError, nullptr));
+    }
+}
+
+void ThreadPool::workerLoop(size_t id) {
+    size_t seenGeneration = 0;
+
+    while (true) {
+        const std::function<void(size_t)>* body;
+        {
+            std::unique_lock lock(mutex);
+            jobReady.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+            body           = jobBody;
+        }
+
+        runIterations(id, *body);
+
+        std::lock_guard lock(mutex);
+        if (--activeWorkers == 0) {
+            jobDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runIterations(size_t id, const std::function<void(size_t)>& body) {
+    size_t index = 0;
+
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        if (!takeOwn(id, index)) {
+            if (steal(id)) {
+                continue;
+            }
+            return;
+        }
+
+        try {
+            body(index);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!jobError) {
+                jobError = std::current_exception();
+            }
+            // Stop every thread from taking further iterations
+            cancelled.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ThreadPool::takeOwn(size_t id, size_t& index) noexcept {
+    std::atomic<uint64_t>& bounds = ranges[id].bounds;
+    uint64_t current              = bounds.load(std::memory_order_acquire);
+
+    while (true) {
+        const uint64_t begin = rangeBegin(current);
+        const uint64_t end   = rangeEnd(current);
+        if (begin >= end) {
+            return false;
+        }
+        if (bounds.compare_exchange_weak(current, pack(begin + 1, end),
+                                         std::memory_order_acq_rel)) {
+            index = begin;
+            return true;
+        }
+    }
+}
+
+bool ThreadPool::steal(size_t id) noexcept {
+    const size_t threads = threadCount();
+
+    // Visit the victims in a fixed rotation starting after the thief
+    for (size_t offset = 1; offset < threads; ++offset) {
+        std::atomic<uint64_t>& victim = ranges[(id + offset) % threads].bounds;
+        uint64_t current              = victim.load(std::memory_order_acquire);
+
+        while (true) {
+            const uint64_t begin = rangeBegin(current);
+            const uint64_t end   = rangeEnd(current);
+            if (begin >= end) {
+                break;
+            }
+
+            // Take the back half, rounded up so that a single remaining iteration can be stolen
+            const uint64_t mid = begin + (end - begin) / 2;
+            if (victim.compare_exchange_weak(current, pack(begin, mid),
+                                             std::memory_order_acq_rel)) {
+                ranges[id].bounds.store(pack(mid, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
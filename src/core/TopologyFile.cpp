@@ -0,0 +1,117 @@
+#include "core/TopologyFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Counts the words of each array of a topology file.
+ *
+ * @param routerCount Number of routers.
+ * @param neighborCount Number of neighbor entries.
+ * @param index Position of the array after the header.
+ * @return Number of 32-bit words of the array.
+ */
+uint64_t sectionWords(uint64_t routerCount, uint64_t neighborCount, size_t index) noexcept {
+    switch (index) {
+        case 0:
+        case 1:
+            return routerCount;
+        case 2:
+            return routerCount + 1;
+        case 3:
+            return neighborCount;
+        default:
+            return routerCount * routerCount;
+    }
+}
+
+/**
+ * @brief Computes the size of a topology file.
+ *
+ * @param routerCount Number of routers.
+ * @param neighborCount Number of neighbor entries.
+ * @return Bytes of the header and every array.
+ */
+uint64_t fileBytes(uint64_t routerCount, uint64_t neighborCount) noexcept {
+    uint64_t bytes = sizeof(TopologyFileHeader);
+    for (size_t i = 0; i < 5; ++i) {
+        bytes += sectionWords(routerCount, neighborCount, i) * sizeof(uint32_t);
+    }
+    return bytes;
+}
+}  // namespace
+
+// =============== Constructors & Destructor ===============
+TopologyFile::TopologyFile(const std::string& path) : file(path, "topology"), header{} {
+    const std::span<const unsigned char> bytes = file.bytes();
+    if (bytes.size() < sizeof(header)) {
+        throw std::runtime_error("Not a topology file: " + path);
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    const char* problem = nullptr;
+    if (std::memcmp(header.magic, TopologyFileHeader::MAGIC, sizeof(header.magic)) != 0) {
+        problem = "Not a topology file: ";
+    } else if (header.version != TopologyFileHeader::VERSION) {
+        problem = "Unsupported topology file version: ";
+    } else if (header.routerBits != IPAddress::ROUTER_BITS ||
+               header.terminalBits != IPAddress::TERMINAL_BITS) {
+        problem = "Topology file written for another address layout: ";
+    } else if (header.routerCount > uint64_t{IPAddress::MAX_ROUTER_ID} + 1) {
+        problem = "Topology file has more routers than the address layout holds: ";
+    } else if (bytes.size() != fileBytes(header.routerCount, header.neighborCount)) {
+        problem = "Truncated topology file: ";
+    } else if (const std::span<const uint32_t> starts = section(2);
+               starts.front() != 0 || starts.back() != header.neighborCount ||
+               !std::ranges::is_sorted(starts)) {
+        // neighbors() slices the neighbor array by these offsets without checking them
+        problem = "Corrupt neighbor offsets in topology file: ";
+    }
+    if (problem) {
+        throw std::runtime_error(problem + path);
+    }
+}
+
+// =============== Writing ===============
+void TopologyFile::write(const std::string& path, const TopologyData& topology) {
+    const size_t routers = topology.terminalCounts.size();
+    if (topology.order.size() != routers || topology.neighborStarts.size() != routers + 1 ||
+        topology.neighborStarts.back() != topology.neighbors.size() ||
+        topology.nextHops.size() != routers * routers) {
+        throw std::invalid_argument("Topology arrays do not match the router count");
+    }
+
+    TopologyFileHeader header{};
+    std::memcpy(header.magic, TopologyFileHeader::MAGIC, sizeof(header.magic));
+    header.version       = TopologyFileHeader::VERSION;
+    header.routerBits    = static_cast<uint8_t>(IPAddress::ROUTER_BITS);
+    header.terminalBits  = static_cast<uint8_t>(IPAddress::TERMINAL_BITS);
+    header.seed          = topology.seed;
+    header.routerCount   = static_cast<uint32_t>(routers);
+    header.neighborCount = static_cast<uint32_t>(topology.neighbors.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const std::vector<uint32_t>* array :
+         {&topology.terminalCounts, &topology.order, &topology.neighborStarts, &topology.neighbors,
+          &topology.nextHops}) {
+        out.write(reinterpret_cast<const char*>(array->data()),
+                  static_cast<std::streamsize>(array->size() * sizeof(uint32_t)));
+    }
+    if (!out.flush()) {
+        throw std::runtime_error("Cannot write topology file " + path);
+    }
+}
+
+// =============== Queries ===============
+std::span<const uint32_t> TopologyFile::section(size_t index) const noexcept {
+    uint64_t offset = sizeof(TopologyFileHeader);
+    for (size_t i = 0; i < index; ++i) {
+        offset += sectionWords(header.routerCount, header.neighborCount, i) * sizeof(uint32_t);
+    }
+    return {reinterpret_cast<const uint32_t*>(file.bytes().data() + offset),
+            static_cast<size_t>(sectionWords(header.routerCount, header.neighborCount, index))};
+}
@@ -0,0 +1,268 @@
+#include "core/TraceFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+/** Bytes of the file before the first record */
+constexpr uint64_t HEADER_BYTES = sizeof(TraceFileHeader);
+/** Bytes per mapped window, a multiple of any page size up to 64 KiB */
+constexpr uint64_t WINDOW_BYTES = TraceWriter::WINDOW_EVENTS * sizeof(TraceEvent);
+
+static_assert(WINDOW_BYTES % 65536 == 0, "Mapped windows must start on page boundaries");
+
+// =============== Platform shims ===============
+#ifdef _WIN32
+int openFile(const std::string& path) {
+    return _open(path.c_str(), _O_RDWR | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+bool resizeFile(int fd, uint64_t size) {
+    return _chsize_s(fd, static_cast<__int64>(size)) == 0;
+}
+
+bool writeAt(int fd, const void* data, size_t size, uint64_t offset) {
+    if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0) {
+        return false;
+    }
+    return _write(fd, data, static_cast<unsigned>(size)) == static_cast<int>(size);
+}
+
+void closeFile(int fd) {
+    _close(fd);
+}
+#else
+int openFile(const std::string& path) {
+    return ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+}
+
+bool resizeFile(int fd, uint64_t size) {
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+}
+
+bool writeAt(int fd, const void* data, size_t size, uint64_t offset) {
+    return ::pwrite(fd, data, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+}
+
+void closeFile(int fd) {
+    ::close(fd);
+}
+#endif
+}  // namespace
+
+// =============== TraceWriter ===============
+TraceWriter::TraceWriter(const std::string& path, size_t pendingLimit)
+    : fd(-1),
+      window(nullptr),
+      windowStart(0),
+      fileSize(0),
+      written(0),
+      submitted(0),
+      failed(false),
+      pendingLimit(pendingLimit),
+      closing(false),
+      closed(false) {
+    if (pendingLimit == 0) {
+        throw std::invalid_argument("Trace pending limit must be positive");
+    }
+    fd = openFile(path);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open trace file " + path);
+    }
+    worker = std::thread([this] { run(); });
+}
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+void TraceWriter::submit(std::span<const TraceEvent> events) {
+    if (events.empty()) {
+        return;
+    }
+
+    {
+        std::unique_lock lock(mutex);
+        taken.wait(lock, [this, &events] {
+            return pending.empty() || pending.size() + events.size() <= pendingLimit;
+        });
+        pending.insert(pending.end(), events.begin(), events.end());
+    }
+    submitted += events.size();
+    wake.notify_one();
+}
+
+bool TraceWriter::close() {
+    if (closed) {
+        return !failed;
+    }
+    closed = true;
+
+    {
+        const std::scoped_lock lock(mutex);
+        closing = true;
+    }
+    wake.notify_one();
+    worker.join();
+    unmapWindow();
+
+    TraceFileHeader header{};
+    std::memcpy(header.magic, TraceFileHeader::MAGIC, sizeof(header.magic));
+    header.version    = TraceFileHeader::VERSION;
+    header.eventSize  = sizeof(TraceEvent);
+    header.eventCount = written;
+    failed = failed || !resizeFile(fd, HEADER_BYTES + written * sizeof(TraceEvent)) ||
+             !writeAt(fd, &header, sizeof(header), 0);
+    closeFile(fd);
+
+    return !failed;
+}
+
+void TraceWriter::run() {
+    std::vector<TraceEvent> block;
+
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [this] { return closing || !pending.empty(); });
+            if (pending.empty()) {
+                return;  // Closing with nothing left to write
+            }
+            // The emptied block goes back to submit(), so both keep their storage
+            block.swap(pending);
+        }
+        taken.notify_one();
+
+        failed = failed || !append(block);
+        block.clear();
+    }
+}
+
+bool TraceWriter::append(std::span<const TraceEvent> events) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(events.data());
+    uint64_t offset   = HEADER_BYTES + written * sizeof(TraceEvent);
+    size_t left       = events.size_bytes();
+
+#ifdef _WIN32
+    if (!writeAt(fd, bytes, left, offset)) {
+        return false;
+    }
+#else
+    // Records may straddle two windows, so the copy is split at window boundaries
+    while (left > 0) {
+        if (!window || offset < windowStart || offset >= windowStart + WINDOW_BYTES) {
+            if (!mapWindowAt(offset)) {
+                return false;
+            }
+        }
+
+        const size_t room = static_cast<size_t>(windowStart + WINDOW_BYTES - offset);
+        const size_t n    = std::min(left, room);
+        std::memcpy(window + (offset - windowStart), bytes, n);
+
+        bytes += n;
+        offset += n;
+        left -= n;
+    }
+#endif
+
+    written += events.size();
+    return true;
+}
+
+bool TraceWriter::mapWindowAt(uint64_t offset) {
+#ifdef _WIN32
+    static_cast<void>(offset);
+    return false;
+#else
+    unmapWindow();
+
+    const uint64_t start = offset / WINDOW_BYTES * WINDOW_BYTES;
+    if (fileSize < start + WINDOW_BYTES) {
+        if (!resizeFile(fd, start + WINDOW_BYTES)) {
+            return false;
+        }
+        fileSize = start + WINDOW_BYTES;
+    }
+
+    void* mapped = ::mmap(nullptr, WINDOW_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                          static_cast<off_t>(start));
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    window      = static_cast<unsigned char*>(mapped);
+    windowStart = start;
+    return true;
+#endif
+}
+
+void TraceWriter::unmapWindow() noexcept {
+#ifndef _WIN32
+    if (window) {
+        ::munmap(window, WINDOW_BYTES);
+        window = nullptr;
+    }
+#endif
+}
+
+// =============== TraceReader ===============
+TraceReader::TraceReader(const std::string& path)
+    : in(path, std::ios::binary), header{}, remaining(0) {
+    if (!in) {
+        throw std::runtime_error("Cannot open trace file " + path);
+    }
+
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, TraceFileHeader::MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a trace file: " + path);
+    }
+    if (header.version != TraceFileHeader::VERSION || header.eventSize != sizeof(TraceEvent)) {
+        throw std::runtime_error("Unsupported trace file version: " + path);
+    }
+    remaining = header.eventCount;
+}
+
+bool TraceReader::next(TraceEvent& event) {
+    if (remaining == 0) {
+        return false;
+    }
+
+    TraceEvent record;
+    if (!in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        remaining = 0;  // Truncated file
+        return false;
+    }
+    remaining--;
+    event = record;
+    return true;
+}
+
+// =============== Names ===============
+const char* traceEventName(TraceEventType type) noexcept {
+    switch (type) {
+        case TraceEventType::Enqueue:
+            return "enqueue";
+        case TraceEventType::Forward:
+            return "forward";
+        case TraceEventType::Deliver:
+            return "deliver";
+        case TraceEventType::Drop:
+            return "drop";
+        case TraceEventType::Timeout:
+            return "timeout";
+        case TraceEventType::PageComplete:
+            return "page_complete";
+    }
+    return "unknown";
+}
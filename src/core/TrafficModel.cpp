@@ -0,0 +1,166 @@
+#include "core/TrafficModel.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "core/Checkpoint.h"
+
+// =============== TrafficModel ===============
+void TrafficModel::saveState(CheckpointWriter& /*out*/) const {}
+
+void TrafficModel::restoreState(CheckpointReader& /*in*/) {}
+
+// =============== BernoulliTraffic ===============
+BernoulliTraffic::BernoulliTraffic(float probability) noexcept : probability(probability) {}
+
+size_t BernoulliTraffic::firstEmission(size_t fromTick, Xoshiro256& rng) {
+    return drawFrom(fromTick, rng);
+}
+
+size_t BernoulliTraffic::nextEmission(size_t emittedTick, Xoshiro256& rng) {
+    return drawFrom(emittedTick + 1, rng);
+}
+
+std::unique_ptr<TrafficModel> BernoulliTraffic::clone() const {
+    return std::make_unique<BernoulliTraffic>(*this);
+}
+
+size_t BernoulliTraffic::drawFrom(size_t fromTick, Xoshiro256& rng) const {
+    if (probability <= 0) {
+        return NEVER;
+    }
+    if (probability >= 1) {
+        return fromTick;
+    }
+    std::geometric_distribution<size_t> failures(probability);
+    return fromTick + failures(rng);
+}
+
+// =============== PoissonTraffic ===============
+PoissonTraffic::PoissonTraffic(double rate) : rate(rate), clock(0) {
+    if (rate < 0) {
+        throw std::invalid_argument("Poisson rate must not be negative");
+    }
+}
+
+size_t PoissonTraffic::firstEmission(size_t fromTick, Xoshiro256& rng) {
+    clock = static_cast<double>(fromTick);
+    return advance(rng);
+}
+
+size_t PoissonTraffic::nextEmission(size_t /*emittedTick*/, Xoshiro256& rng) {
+    return advance(rng);
+}
+
+std::unique_ptr<TrafficModel> PoissonTraffic::clone() const {
+    return std::make_unique<PoissonTraffic>(*this);
+}
+
+void PoissonTraffic::saveState(CheckpointWriter& out) const {
+    out.write(clock);
+}
+
+void PoissonTraffic::restoreState(CheckpointReader& in) {
+    clock = in.read<double>();
+}
+
+size_t PoissonTraffic::advance(Xoshiro256& rng) {
+    if (rate <= 0) {
+        return NEVER;
+    }
+    std::exponential_distribution<double> gap(rate);
+    clock += gap(rng);
+    return clock >= static_cast<double>(NEVER) ? NEVER : static_cast<size_t>(clock);
+}
+
+// =============== OnOffTraffic ===============
+OnOffTraffic::OnOffTraffic(float onProbability, double meanOn, double meanOff)
+    : onProbability(onProbability), meanOn(meanOn), meanOff(meanOff), onStart(0), onEnd(0) {
+    if (meanOn < 1 || meanOff < 1) {
+        throw std::invalid_argument("Mean period lengths must be at least one tick");
+    }
+}
+
+size_t OnOffTraffic::firstEmission(size_t fromTick, Xoshiro256& rng) {
+    onStart = fromTick + drawPeriod(meanOff, rng);
+    onEnd   = onStart + drawPeriod(meanOn, rng);
+    return emitFrom(fromTick, rng);
+}
+
+size_t OnOffTraffic::nextEmission(size_t emittedTick, Xoshiro256& rng) {
+    return emitFrom(emittedTick + 1, rng);
+}
+
+std::unique_ptr<TrafficModel> OnOffTraffic::clone() const {
+    return std::make_unique<OnOffTraffic>(*this);
+}
+
+void OnOffTraffic::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(onStart);
+    out.write<uint64_t>(onEnd);
+}
+
+void OnOffTraffic::restoreState(CheckpointReader& in) {
+    onStart = in.read<uint64_t>();
+    onEnd   = in.read<uint64_t>();
+}
+
+size_t OnOffTraffic::emitFrom(size_t fromTick, Xoshiro256& rng) {
+    if (onProbability <= 0) {
+        return NEVER;
+    }
+
+    for (;;) {
+        const size_t start = std::max(fromTick, onStart);
+        if (start < onEnd) {
+            size_t tick = start;
+            if (onProbability < 1) {
+                std::geometric_distribution<size_t> failures(onProbability);
+                tick += failures(rng);
+            }
+            if (tick < onEnd) {
+                return tick;
+            }
+        }
+
+        // Every trial left in the period failed; move on to the next one
+        onStart = onEnd + drawPeriod(meanOff, rng);
+        onEnd   = onStart + drawPeriod(meanOn, rng);
+    }
+}
+
+size_t OnOffTraffic::drawPeriod(double mean, Xoshiro256& rng) {
+    if (mean <= 1) {
+        return 1;
+    }
+    std::geometric_distribution<size_t> extra(1 / mean);
+    return 1 + extra(rng);
+}
+
+// =============== TraceTraffic ===============
+TraceTraffic::TraceTraffic(std::vector<size_t> ticks) : ticks(std::move(ticks)), cursor(0) {
+    std::ranges::sort(this->ticks);
+}
+
+size_t TraceTraffic::firstEmission(size_t fromTick, Xoshiro256& /*rng*/) {
+    cursor = static_cast<size_t>(std::ranges::lower_bound(ticks, fromTick) - ticks.begin());
+    return cursor < ticks.size() ? ticks[cursor] : NEVER;
+}
+
+size_t TraceTraffic::nextEmission(size_t /*emittedTick*/, Xoshiro256& /*rng*/) {
+    cursor = std::min(cursor + 1, ticks.size());
+    return cursor < ticks.size() ? ticks[cursor] : NEVER;
+}
+
+std::unique_ptr<TrafficModel> TraceTraffic::clone() const {
+    return std::make_unique<TraceTraffic>(*this);
+}
+
+void TraceTraffic::saveState(CheckpointWriter& out) const {
+    out.write<uint64_t>(cursor);
+}
+
+void TraceTraffic::restoreState(CheckpointReader& in) {
+    cursor = std::min<size_t>(in.read<uint64_t>(), ticks.size());
+}
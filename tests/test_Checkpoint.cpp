@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "core/Network.h"
+
+// =============== Fixture ===============
+class CheckpointTest : public testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override {
+        const auto* info   = testing::UnitTest::GetInstance()->current_test_info();
+        const auto tempDir = std::filesystem::temp_directory_path();
+        path = (tempDir / (std::string("routersim_") + info->name() + ".ckpt")).string();
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    static Network::Config config(uint64_t seed = 42) {
+        Network::Config c{.routerCount = 12, .maxTerminalCount = 4, .complexity = 2,
+                          .trafficProbability = 0.6f, .maxPageLen = 8};
+        c.seed = seed;
+        return c;
+    }
+
+    static std::string save(const Network& network) {
+        std::ostringstream out;
+        network.saveCheckpoint(out);
+        return out.str();
+    }
+
+    static void expectSameStats(const NetworkStats& a, const NetworkStats& b) {
+        EXPECT_EQ(a.currentTick, b.currentTick);
+        EXPECT_EQ(a.packetsGenerated, b.packetsGenerated);
+        EXPECT_EQ(a.packetsSent, b.packetsSent);
+        EXPECT_EQ(a.packetsDelivered, b.packetsDelivered);
+        EXPECT_EQ(a.packetsDropped, b.packetsDropped);
+        EXPECT_EQ(a.packetsTimedOut, b.packetsTimedOut);
+        EXPECT_EQ(a.packetsInFlight, b.packetsInFlight);
+        EXPECT_EQ(a.pagesCreated, b.pagesCreated);
+        EXPECT_EQ(a.pagesCompleted, b.pagesCompleted);
+        EXPECT_EQ(a.pagesDropped, b.pagesDropped);
+        EXPECT_EQ(a.pagesTimedOut, b.pagesTimedOut);
+    }
+
+    /** Warms a network up, forks it through a checkpoint and checks both runs stay identical */
+    static void expectForkMatches(const Network::Config& c) {
+        Network original(c);
+        original.simulate(120);
+        std::istringstream checkpoint(save(original));
+
+        Network fork(c);
+        fork.restoreCheckpoint(checkpoint);
+        expectSameStats(fork.getStats(), original.getStats());
+
+        original.simulate(150);
+        fork.simulate(150);
+        expectSameStats(fork.getStats(), original.getStats());
+    }
+};
+
+// =============== Round trip tests ===============
+TEST_F(CheckpointTest, Fork_ContinuesLikeTheOriginal) {
+    expectForkMatches(config());
+}
+
+TEST_F(CheckpointTest, Fork_RestoresTrafficModelState) {
+    Network::Config c   = config();
+    c.trafficModel      = std::make_shared<OnOffTraffic>(0.8f, 6.0, 4.0);
+    c.eagerExpiry       = true;
+    c.incrementalRoutes = true;
+    expectForkMatches(c);
+}
+
+TEST_F(CheckpointTest, Fork_RestoresEventDrivenSchedule) {
+    Network::Config c = config();
+    c.trafficModel    = std::make_shared<PoissonTraffic>(0.05);
+    c.eventDriven     = true;
+    expectForkMatches(c);
+}
+
+TEST_F(CheckpointTest, Fork_RestoresDoomedPages) {
+    Network::Config c     = config();
+    c.outQueue.aqm.mode   = AqmMode::CoDel;
+    c.outQueue.aqm.target = 1;
+    c.doomedFilterBits    = 1 << 10;
+    expectForkMatches(c);
+}
+
+TEST_F(CheckpointTest, Fork_RestoresMultipathRoutes) {
+    Network::Config c = config();
+    c.routePaths      = 3;
+    expectForkMatches(c);
+}
+
+TEST_F(CheckpointTest, Fork_RestoresLoadChangeBaseline) {
+    Network::Config c    = config();
+    c.routePolicy        = Network::RoutePolicy::LoadChange;
+    c.routeLoadThreshold = 4;
+    expectForkMatches(c);
+}
+
+TEST_F(CheckpointTest, Fork_RestoresMappedFile) {
+    Network original(config());
+    original.simulate(80);
+    {
+        std::ofstream out(path, std::ios::binary);
+        original.saveCheckpoint(out);
+    }
+
+    Network fork(config());
+    fork.restoreCheckpoint(path);
+    original.simulate(60);
+    fork.simulate(60);
+    expectSameStats(fork.getStats(), original.getStats());
+}
+
+TEST_F(CheckpointTest, Fork_RestoresPacketsInFlight) {
+    Network original(config());
+    original.simulate(40);
+    ASSERT_GT(original.getStats().packetsInFlight, 0);
+
+    std::istringstream checkpoint(save(original));
+    Network fork(config());
+    fork.restoreCheckpoint(checkpoint);
+
+    for (size_t i = 0; i < original.getRouters().size(); i++) {
+        const Router& a = *original.getRouters()[i];
+        const Router& b = *fork.getRouters()[i];
+        EXPECT_EQ(a.getPacketsInPending(), b.getPacketsInPending());
+        EXPECT_EQ(a.getPacketsOutPending(), b.getPacketsOutPending());
+        EXPECT_EQ(a.getPacketsLocPending(), b.getPacketsLocPending());
+    }
+}
+
+// =============== Validation tests ===============
+TEST_F(CheckpointTest, Restore_OtherNetworkThrows) {
+    Network original(config(42));
+    std::istringstream checkpoint(save(original));
+
+    Network other(config(43));
+    EXPECT_THROW(other.restoreCheckpoint(checkpoint), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, Restore_TruncatedThrows) {
+    Network original(config());
+    original.simulate(20);
+    const std::string saved = save(original);
+    std::istringstream checkpoint(saved.substr(0, saved.size() / 2));
+
+    Network fork(config());
+    EXPECT_THROW(fork.restoreCheckpoint(checkpoint), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, Restore_NotACheckpointThrows) {
+    std::istringstream garbage(std::string(64, 'x'));
+
+    Network network(config());
+    EXPECT_THROW(network.restoreCheckpoint(garbage), std::runtime_error);
+}
+
+TEST_F(CheckpointTest, Restore_MissingFileThrows) {
+    Network network(config());
+    EXPECT_THROW(network.restoreCheckpoint(path), std::runtime_error);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "algorithms/Dijkstra.h"
 #include "core/Router.h"
+#include "core/ThreadPool.h"
 
 class DijkstraTestFixture : public ::testing::Test {
 protected:
@@ -257,3 +258,237 @@ TEST_F(DijkstraTestFixture, ComputeAllTables_LinearTopology) {
     // Table for R3 (Index 2)
     EXPECT_EQ(allTables[2].getNextHopIP(r1->getIP()), r2->getIP());
 }
+
+// =============== Snapshot tests ===============
+TEST_F(DijkstraTestFixture, UnknownSourceThrows) {
+    createRouter(1);
+    createRouter(2);
+
+    EXPECT_THROW((void)DijkstraAlgorithm::computeRoutingTable(pRouters, IPAddress(9, 0)),
+                 std::runtime_error);
+    EXPECT_THROW((void)DijkstraAlgorithm::computeRoutingTable(TopologySnapshot(pRouters), 2),
+                 std::out_of_range);
+}
+
+TEST_F(DijkstraTestFixture, SnapshotMatchesRouterList) {
+    // Topology: R0 -- R1 -- R2 -- R3
+    //            \__________/
+    Router* r0 = createRouter(0);
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+
+    connectRouters(r0, r1);
+    connectRouters(r1, r2);
+    connectRouters(r2, r3);
+    connectRouters(r0, r2);
+
+    const TopologySnapshot topology(pRouters);
+
+    for (size_t i = 0; i < pRouters.size(); ++i) {
+        const RoutingTable fromList =
+            DijkstraAlgorithm::computeRoutingTable(pRouters, pRouters[i]->getIP());
+        const RoutingTable fromSnapshot = DijkstraAlgorithm::computeRoutingTable(topology, i);
+
+        ASSERT_EQ(fromList.size(), fromSnapshot.size());
+        for (const Router* dst : pRouters) {
+            EXPECT_EQ(fromList.getNextHopIP(dst->getIP()), fromSnapshot.getNextHopIP(dst->getIP()));
+        }
+    }
+
+    // Routes towards router 0 use the 0.0 next hop
+    const RoutingTable table3 = DijkstraAlgorithm::computeRoutingTable(topology, 3);
+    EXPECT_EQ(table3.getNextHopIP(r0->getIP()), r2->getIP());
+    const RoutingTable table2 = DijkstraAlgorithm::computeRoutingTable(topology, 2);
+    EXPECT_TRUE(table2.hasRoute(r0->getIP()));
+    EXPECT_EQ(table2.getNextHopIP(r0->getIP()), r0->getIP());
+}
+
+TEST_F(DijkstraTestFixture, ParallelMatchesSerial) {
+    // Ring of 30 routers with chords, and uneven link loads
+    constexpr uint8_t count = 30;
+    for (uint8_t i = 0; i < count; ++i) {
+        createRouter(i);
+    }
+    List<Router*> raw;
+    for (auto& r : routers) {
+        raw.pushBack(r.get());
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        connectRouters(raw[i], raw[(i + 1) % count]);
+        if (i % 3 == 0) {
+            connectRouters(raw[i], raw[(i * 7 + 5) % count]);
+        }
+    }
+    for (uint8_t i = 4; i < count; i += 4) {
+        const IPAddress dst = raw[(i + 1) % count]->getIP();
+        for (size_t p = 0; p < size_t{i} % 5 + 1; ++p) {
+            raw[i]->receivePacket(Packet(10, p, 6, raw[i]->getIP(), dst, 10));
+        }
+        RoutingTable rt;
+        rt.setNextHopIP(dst, dst);
+        raw[i]->setRoutingTable(std::move(rt));
+        raw[i]->processInputBuffer(1);
+    }
+
+    const TopologySnapshot topology(pRouters);
+    std::vector<RoutingTable> serial;
+    std::vector<RoutingTable> parallel;
+    ThreadPool pool(4);
+
+    DijkstraAlgorithm::computeAllRoutingTables(topology, serial);
+    DijkstraAlgorithm::computeAllRoutingTables(topology, parallel, &pool);
+
+    ASSERT_EQ(serial.size(), count);
+    ASSERT_EQ(parallel.size(), count);
+    for (size_t src = 0; src < count; ++src) {
+        EXPECT_EQ(serial[src].size(), count - 1);
+        ASSERT_EQ(parallel[src].size(), serial[src].size());
+        for (const Router* dst : pRouters) {
+            EXPECT_EQ(parallel[src].getNextHopIP(dst->getIP()),
+                      serial[src].getNextHopIP(dst->getIP()));
+        }
+    }
+}
+
+// =============== Multipath tests ===============
+TEST_F(DijkstraTestFixture, Multipath_DiamondKeepsBothPaths) {
+    // Topology: R0 -- R1 -- R3
+    //            \__ R2 __/
+    Router* r0 = createRouter(0);
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+
+    connectRouters(r0, r1);
+    connectRouters(r0, r2);
+    connectRouters(r1, r3);
+    connectRouters(r2, r3);
+
+    const TopologySnapshot topology(pRouters);
+    const RoutingTable single = DijkstraAlgorithm::computeRoutingTable(topology, 0);
+    const RoutingTable multi  = DijkstraAlgorithm::computeRoutingTable(topology, 0, 4);
+
+    EXPECT_FALSE(single.isMultipath());
+    EXPECT_EQ(single.getPathCount(r3->getIP()), 1);
+    ASSERT_EQ(multi.getPathCount(r3->getIP()), 2);
+    EXPECT_EQ(multi.getNextHopIP(r3->getIP(), 0), r1->getIP());
+    EXPECT_EQ(multi.getNextHopIP(r3->getIP(), 1), r2->getIP());
+
+    // Zero-weight links do not make the detour through R3 as short as the direct link
+    EXPECT_EQ(multi.getPathCount(r1->getIP()), 1);
+    EXPECT_EQ(multi.getNextHopIP(r1->getIP()), r1->getIP());
+}
+
+TEST_F(DijkstraTestFixture, Multipath_NextHopsNeverLoop) {
+    constexpr uint8_t count = 24;
+    for (uint8_t i = 0; i < count; ++i) {
+        createRouter(i);
+    }
+    List<Router*> raw;
+    for (auto& r : routers) {
+        raw.pushBack(r.get());
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        connectRouters(raw[i], raw[(i + 1) % count]);
+        connectRouters(raw[i], raw[(i + 6) % count]);
+    }
+
+    const TopologySnapshot topology(pRouters);
+
+    // Following any mix of next hops reaches the destination within the router count, with and
+    // without slack
+    for (const size_t slack : {size_t{0}, size_t{2}}) {
+        std::vector<RoutingTable> tables;
+        DijkstraAlgorithm::computeAllRoutingTables(topology, tables, nullptr, 4, slack);
+
+        // The shared cost rows give the same tables as computing each source on its own
+        for (size_t src = 0; src < count; ++src) {
+            const RoutingTable own =
+                DijkstraAlgorithm::computeRoutingTable(topology, src, 4, slack);
+            for (size_t dst = 0; dst < count; ++dst) {
+                const IPAddress dstIP = topology.getRouterIP(dst);
+                ASSERT_EQ(tables[src].getPathCount(dstIP), own.getPathCount(dstIP));
+                for (size_t p = 0; p < own.getPathCount(dstIP); ++p) {
+                    EXPECT_EQ(tables[src].getNextHopIP(dstIP, p), own.getNextHopIP(dstIP, p));
+                }
+            }
+        }
+
+        size_t multipathRoutes = 0;
+        for (size_t dst = 0; dst < count; ++dst) {
+            const IPAddress dstIP = topology.getRouterIP(dst);
+            std::vector<size_t> frontier;
+            for (size_t src = 0; src < count; ++src) {
+                if (src != dst) {
+                    frontier.push_back(src);
+                }
+                multipathRoutes += tables[src].getPathCount(dstIP) > 1;
+            }
+            for (size_t hop = 0; hop < count && !frontier.empty(); ++hop) {
+                std::vector<size_t> next;
+                for (const size_t at : frontier) {
+                    ASSERT_TRUE(tables[at].hasRoute(dstIP));
+                    for (size_t p = 0; p < tables[at].getPathCount(dstIP); ++p) {
+                        const size_t via = topology.indexOf(tables[at].getNextHopIP(dstIP, p));
+                        if (via != dst && std::ranges::find(next, via) == next.end()) {
+                            next.push_back(via);
+                        }
+                    }
+                }
+                frontier = std::move(next);
+            }
+            EXPECT_TRUE(frontier.empty());
+        }
+        EXPECT_GT(multipathRoutes, size_t{0});
+    }
+}
+
+TEST_F(DijkstraTestFixture, Multipath_SlackKeepsNearEqualPaths) {
+    // Topology: R1 -- R2 -- R4, with 2 packets queued on R1 -> R3
+    //            \__ R3 __/
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+    Router* r4 = createRouter(4);
+
+    connectRouters(r1, r2);
+    connectRouters(r1, r3);
+    connectRouters(r2, r4);
+    connectRouters(r3, r4);
+
+    for (int i = 0; i < 2; i++) {
+        r1->receivePacket(Packet(10, i, 4, r1->getIP(), r3->getIP(), 10));
+    }
+    auto rt = RoutingTable();
+    rt.setNextHopIP(r3->getIP(), r3->getIP());
+    r1->setRoutingTable(std::move(rt));
+    r1->processInputBuffer(1);
+
+    const TopologySnapshot topology(pRouters);
+    const RoutingTable exact = DijkstraAlgorithm::computeRoutingTable(topology, 0, 4);
+    const RoutingTable tight = DijkstraAlgorithm::computeRoutingTable(topology, 0, 4, 1);
+    const RoutingTable loose = DijkstraAlgorithm::computeRoutingTable(topology, 0, 4, 2);
+
+    EXPECT_EQ(exact.getPathCount(r4->getIP()), 1);
+    EXPECT_EQ(tight.getPathCount(r4->getIP()), 1);
+    ASSERT_EQ(loose.getPathCount(r4->getIP()), 2);
+    EXPECT_EQ(loose.getNextHopIP(r4->getIP(), 0), r2->getIP());
+    EXPECT_EQ(loose.getNextHopIP(r4->getIP(), 1), r3->getIP());
+
+    // The shortest path to R3 avoids the loaded link, which the slack lets back in second
+    EXPECT_EQ(exact.getNextHopIP(r3->getIP()), r2->getIP());
+    ASSERT_EQ(loose.getPathCount(r3->getIP()), 2);
+    EXPECT_EQ(loose.getNextHopIP(r3->getIP(), 1), r3->getIP());
+}
+
+TEST_F(DijkstraTestFixture, Multipath_InvalidPathCountThrows) {
+    createRouter(0);
+    const TopologySnapshot topology(pRouters);
+
+    EXPECT_THROW((void)DijkstraAlgorithm::computeRoutingTable(topology, 0, 0),
+                 std::invalid_argument);
+    EXPECT_THROW(
+        (void)DijkstraAlgorithm::computeRoutingTable(topology, 0, RoutingTable::MAX_PATHS + 1),
+        std::invalid_argument);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "algorithms/GraphOrdering.h"
+
+namespace {
+using Links = std::vector<GraphOrdering::Link>;
+
+// Largest distance in the ordering between the two ends of a link
+size_t bandwidth(const std::vector<size_t>& order, const Links& links) {
+    std::vector<size_t> position(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = i;
+    }
+
+    size_t widest = 0;
+    for (const auto& [a, b] : links) {
+        widest = std::max(widest, position[a] > position[b] ? position[a] - position[b]
+                                                            : position[b] - position[a]);
+    }
+    return widest;
+}
+
+bool isPermutation(std::vector<size_t> order, size_t nodeCount) {
+    std::ranges::sort(order);
+    for (size_t i = 0; i < nodeCount; ++i) {
+        if (i >= order.size() || order[i] != i) {
+            return false;
+        }
+    }
+    return order.size() == nodeCount;
+}
+}  // namespace
+
+// =============== Breadth-first tests ===============
+TEST(GraphOrderingTest, BreadthFirst_VisitsLevelsInOrder) {
+    // 0 - 3 - 1, 0 - 4 - 2: levels {0}, {3, 4}, {1, 2}
+    const Links links{{0, 3}, {3, 1}, {4, 2}, {0, 4}};
+
+    EXPECT_EQ(GraphOrdering::breadthFirst(5, links), (std::vector<size_t>{0, 3, 4, 1, 2}));
+}
+
+TEST(GraphOrderingTest, BreadthFirst_IgnoresSelfAndDuplicateLinks) {
+    const Links links{{0, 0}, {0, 2}, {2, 0}, {0, 2}, {2, 1}};
+
+    EXPECT_EQ(GraphOrdering::breadthFirst(3, links), (std::vector<size_t>{0, 2, 1}));
+}
+
+TEST(GraphOrderingTest, BreadthFirst_AppendsDisconnectedComponents) {
+    const Links links{{1, 3}, {4, 5}};
+
+    EXPECT_EQ(GraphOrdering::breadthFirst(6, links), (std::vector<size_t>{0, 1, 3, 2, 4, 5}));
+}
+
+// =============== Reverse Cuthill-McKee tests ===============
+TEST(GraphOrderingTest, ReverseCuthillMcKee_NarrowsScatteredPath) {
+    // A path whose consecutive nodes have scattered indices
+    const std::vector<size_t> path{0, 7, 2, 5, 9, 1, 6, 3, 8, 4};
+    Links links;
+    for (size_t i = 1; i < path.size(); ++i) {
+        links.emplace_back(path[i - 1], path[i]);
+    }
+
+    const std::vector<size_t> order = GraphOrdering::reverseCuthillMcKee(path.size(), links);
+
+    EXPECT_TRUE(isPermutation(order, path.size()));
+    EXPECT_EQ(bandwidth(order, links), 1);
+    std::vector<size_t> identity(path.size());
+    std::iota(identity.begin(), identity.end(), size_t{0});
+    EXPECT_GT(bandwidth(identity, links), 1);
+}
+
+TEST(GraphOrderingTest, ReverseCuthillMcKee_StartsFromMinimumDegree) {
+    // Star centred on 0 plus a tail 3 - 4: node 1 has the lowest degree and index
+    const Links links{{0, 1}, {0, 2}, {0, 3}, {3, 4}};
+
+    const std::vector<size_t> order = GraphOrdering::reverseCuthillMcKee(5, links);
+
+    ASSERT_EQ(order.size(), 5);
+    EXPECT_EQ(order.back(), 1);
+    EXPECT_TRUE(isPermutation(order, 5));
+}
+
+TEST(GraphOrderingTest, RejectsLinksOutsideTheGraph) {
+    EXPECT_THROW((void)GraphOrdering::breadthFirst(2, Links{{0, 2}}), std::invalid_argument);
+    EXPECT_THROW((void)GraphOrdering::reverseCuthillMcKee(2, Links{{3, 1}}),
+                 std::invalid_argument);
+    EXPECT_TRUE(GraphOrdering::breadthFirst(0, {}).empty());
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "algorithms/GraphPartitioner.h"
+#include "core/Router.h"
+
+class GraphPartitionerTest : public ::testing::Test {
+protected:
+    std::vector<std::unique_ptr<Router>> routers;
+    std::vector<const Router*> pRouters;
+
+    void createRouters(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            routers.push_back(std::make_unique<Router>(IPAddress(static_cast<uint8_t>(i))));
+            pRouters.push_back(routers.back().get());
+        }
+    }
+
+    void connect(size_t a, size_t b) {
+        routers[a]->connectRouter(routers[b].get());
+        routers[b]->connectRouter(routers[a].get());
+    }
+
+    static std::vector<size_t> sizesOf(const std::vector<size_t>& partOf, size_t parts) {
+        std::vector<size_t> sizes(parts, 0);
+        for (size_t part : partOf) {
+            sizes[part]++;
+        }
+        return sizes;
+    }
+};
+
+// =============== Partition tests ===============
+TEST_F(GraphPartitionerTest, TwoCliques_CutAtTheBridge) {
+    // Two cliques of four, {0, 2, 4, 6} and {1, 3, 5, 7}, joined by the link 6 - 1
+    createRouters(8);
+    for (size_t a = 0; a < 8; ++a) {
+        for (size_t b = a + 2; b < 8; b += 2) {
+            connect(a, b);
+        }
+    }
+    connect(6, 1);
+
+    const TopologySnapshot topology(pRouters);
+    const std::vector<size_t> partOf = GraphPartitioner::partition(topology, 2);
+
+    EXPECT_EQ(GraphPartitioner::cutEdges(topology, partOf), 2);
+    EXPECT_EQ(sizesOf(partOf, 2), (std::vector<size_t>{4, 4}));
+    EXPECT_EQ(partOf[0], partOf[6]);
+    EXPECT_NE(partOf[0], partOf[1]);
+}
+
+TEST_F(GraphPartitionerTest, Ring_BalancedContiguousArcs) {
+    createRouters(12);
+    for (size_t i = 0; i < 12; ++i) {
+        connect(i, (i + 1) % 12);
+    }
+
+    const TopologySnapshot topology(pRouters);
+    const std::vector<size_t> partOf = GraphPartitioner::partition(topology, 3);
+
+    // Three arcs cut the ring in three places, each link counted in both directions
+    EXPECT_EQ(GraphPartitioner::cutEdges(topology, partOf), 6);
+    for (size_t size : sizesOf(partOf, 3)) {
+        EXPECT_GE(size, 1);
+        EXPECT_LE(size, 5);
+    }
+}
+
+TEST_F(GraphPartitionerTest, OnePartPerRouter) {
+    createRouters(4);
+    connect(0, 1);
+    connect(1, 2);
+    connect(2, 3);
+
+    const TopologySnapshot topology(pRouters);
+    const std::vector<size_t> partOf = GraphPartitioner::partition(topology, 4);
+
+    EXPECT_EQ(sizesOf(partOf, 4), (std::vector<size_t>{1, 1, 1, 1}));
+    EXPECT_EQ(GraphPartitioner::cutEdges(topology, partOf), 6);
+    EXPECT_EQ(GraphPartitioner::partition(topology, 1), (std::vector<size_t>{0, 0, 0, 0}));
+}
+
+TEST_F(GraphPartitionerTest, InvalidPartCountThrows) {
+    createRouters(3);
+    const TopologySnapshot topology(pRouters);
+
+    EXPECT_THROW((void)GraphPartitioner::partition(topology, 0), std::invalid_argument);
+    EXPECT_THROW((void)GraphPartitioner::partition(topology, 4), std::invalid_argument);
+}
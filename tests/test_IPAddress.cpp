@@ -1,7 +1,22 @@
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <type_traits>
 #include "core/IPAddress.h"
 
+/** Whether IPAddress uses the default 8 + 8 layout, which the expected strings are written for */
+constexpr bool COMPACT_LAYOUT = IPAddress::ROUTER_BITS == 8 && IPAddress::TERMINAL_BITS == 8;
+
+/**
+ * @brief Packs a router and a terminal ID the way the layout of this build does.
+ *
+ * @param router Router ID.
+ * @param terminal Terminal ID.
+ * @return Raw address with the router in the upper bits and the terminal in the lower bits.
+ */
+constexpr IPAddress::Raw rawOf(IPAddress::Raw router, IPAddress::Raw terminal) {
+    return static_cast<IPAddress::Raw>(router << IPAddress::TERMINAL_BITS | terminal);
+}
+
 // =============== Constructors and assignment tests ===============
 TEST(IPAddressConstructors, DefaultConstructor) {
     const IPAddress ip;
@@ -28,10 +43,14 @@ TEST(IPAddressConstructors, RouterAndTerminalConstructor) {
 }
 
 TEST(IPAddressConstructors, RawAddressConstructor) {
-    const IPAddress ip(static_cast<uint16_t>(0x0A64));
+    if constexpr (std::is_same_v<IPAddress::Raw, IPAddress::RouterID>) {
+        GTEST_SKIP() << "Layouts with a full-width router ID build raw addresses with fromRaw()";
+    } else {
+        const IPAddress ip(rawOf(10, 100));
 
-    EXPECT_EQ(ip.getRouterIP(), 10);
-    EXPECT_EQ(ip.getTerminalIP(), 100);
+        EXPECT_EQ(ip.getRouterIP(), 10);
+        EXPECT_EQ(ip.getTerminalIP(), 100);
+    }
 }
 
 TEST(IPAddressConstructors, CopyConstructor) {
@@ -68,10 +87,10 @@ TEST(IPAddressGetter, GetTerminalIPVariousValues) {
 }
 
 TEST(IPAddressGetter, GetRawAddress) {
-    EXPECT_EQ(IPAddress(0, 0).getRawAddress(), 0x0000);
-    EXPECT_EQ(IPAddress(1, 2).getRawAddress(), 0x0102);
-    EXPECT_EQ(IPAddress(255, 255).getRawAddress(), 0xFFFF);
-    EXPECT_EQ(IPAddress(10, 100).getRawAddress(), 0x0A64);
+    EXPECT_EQ(IPAddress(0, 0).getRawAddress(), 0);
+    EXPECT_EQ(IPAddress(1, 2).getRawAddress(), rawOf(1, 2));
+    EXPECT_EQ(IPAddress(255, 255).getRawAddress(), rawOf(255, 255));
+    EXPECT_EQ(IPAddress(10, 100).getRawAddress(), rawOf(10, 100));
 }
 
 // =============== Query Methods tests ===============
@@ -93,12 +112,18 @@ TEST(IPAddressQuery, IsValid) {
 
 // =============== Utilities tests ===============
 TEST(IPAddressUtilities, ToStringRouter) {
+    if constexpr (!COMPACT_LAYOUT) {
+        GTEST_SKIP() << "Wide layouts pad to more digits, see IPAddressLayout";
+    }
     EXPECT_EQ(IPAddress(0, 0).toString(), "000.000");
     EXPECT_EQ(IPAddress(10, 0).toString(), "010.000");
     EXPECT_EQ(IPAddress(255, 0).toString(), "255.000");
 }
 
 TEST(IPAddressUtilities, ToStringTerminal) {
+    if constexpr (!COMPACT_LAYOUT) {
+        GTEST_SKIP() << "Wide layouts pad to more digits, see IPAddressLayout";
+    }
     EXPECT_EQ(IPAddress(10, 1).toString(), "010.001");
     EXPECT_EQ(IPAddress(192, 168).toString(), "192.168");
     EXPECT_EQ(IPAddress(255, 255).toString(), "255.255");
@@ -106,6 +131,9 @@ TEST(IPAddressUtilities, ToStringTerminal) {
 }
 
 TEST(IPAddressUtilities, StreamOperatorRouter) {
+    if constexpr (!COMPACT_LAYOUT) {
+        GTEST_SKIP() << "Wide layouts pad to more digits, see IPAddressLayout";
+    }
     const IPAddress ip(42, 0);
     std::ostringstream oss;
 
@@ -115,6 +143,9 @@ TEST(IPAddressUtilities, StreamOperatorRouter) {
 }
 
 TEST(IPAddressUtilities, StreamOperatorTerminal) {
+    if constexpr (!COMPACT_LAYOUT) {
+        GTEST_SKIP() << "Wide layouts pad to more digits, see IPAddressLayout";
+    }
     const IPAddress ip(192, 168);
     std::ostringstream oss;
 
@@ -124,6 +155,9 @@ TEST(IPAddressUtilities, StreamOperatorTerminal) {
 }
 
 TEST(IPAddressUtilities, StreamOperatorMultiple) {
+    if constexpr (!COMPACT_LAYOUT) {
+        GTEST_SKIP() << "Wide layouts pad to more digits, see IPAddressLayout";
+    }
     const IPAddress ip1(10, 0);
     const IPAddress ip2(20, 30);
     std::ostringstream oss;
@@ -208,7 +242,7 @@ TEST(IPAddressEdge, BoundaryValues) {
     EXPECT_EQ(ipMin.getRawAddress(), 0);
 
     const IPAddress ipMax(255, 255);
-    EXPECT_EQ(ipMax.getRawAddress(), 0xFFFF);
+    EXPECT_EQ(ipMax.getRawAddress(), rawOf(255, 255));
     EXPECT_EQ(ipMax.getRouterIP(), 255);
     EXPECT_EQ(ipMax.getTerminalIP(), 255);
 }
@@ -310,7 +344,7 @@ TEST(IPAddressComplex, UseInSet) {
 TEST(IPAddressBitwise, BitwiseRepresentation) {
     const IPAddress ip(0xAB, 0xCD);
 
-    EXPECT_EQ(ip.getRawAddress(), 0xABCD);
+    EXPECT_EQ(ip.getRawAddress(), rawOf(0xAB, 0xCD));
     EXPECT_EQ(ip.getRouterIP(), 0xAB);
     EXPECT_EQ(ip.getTerminalIP(), 0xCD);
 }
@@ -318,7 +352,7 @@ TEST(IPAddressBitwise, BitwiseRepresentation) {
 TEST(IPAddressBitwise, AllBitsSet) {
     const IPAddress ip(0xFF, 0xFF);
 
-    EXPECT_EQ(ip.getRawAddress(), 0xFFFF);
+    EXPECT_EQ(ip.getRawAddress(), rawOf(0xFF, 0xFF));
     EXPECT_EQ(ip.getRouterIP(), 255);
     EXPECT_EQ(ip.getTerminalIP(), 255);
 }
@@ -328,5 +362,55 @@ TEST(IPAddressBitwise, AlternatingBits) {
 
     EXPECT_EQ(ip.getRouterIP(), 170);
     EXPECT_EQ(ip.getTerminalIP(), 85);
-    EXPECT_EQ(ip.getRawAddress(), 0xAA55);
+    EXPECT_EQ(ip.getRawAddress(), rawOf(0xAA, 0x55));
+}
+
+// =============== Address layout tests ===============
+TEST(IPAddressLayout, DefaultLayoutStaysCompact) {
+    using Compact = BasicIPAddress<8, 8>;
+
+    EXPECT_EQ(sizeof(Compact), 2);
+    EXPECT_TRUE((std::is_same_v<Compact::Raw, uint16_t>));
+    EXPECT_TRUE((std::is_same_v<Compact::RouterID, uint8_t>));
+    EXPECT_EQ(Compact::fromRaw(0x0A64), Compact(10, 100));
+}
+
+TEST(IPAddressLayout, WideRoutersAndTerminals) {
+    using Wide = BasicIPAddress<16, 16>;
+    constexpr Wide ip(1000, 40000);
+
+    static_assert(sizeof(Wide) == 4);
+    static_assert(ip.getRouterIP() == 1000 && ip.getTerminalIP() == 40000);
+    EXPECT_EQ(ip.getRawAddress(), (uint32_t{1000} << 16) | 40000);
+    EXPECT_EQ(Wide(static_cast<uint32_t>(0x00020003)), Wide(2, 3));
+    EXPECT_EQ(Wide::MAX_ROUTER_ID, 65535);
+    EXPECT_FALSE(ip.isRouter());
+    EXPECT_TRUE(Wide(1000).isRouter());
+}
+
+TEST(IPAddressLayout, ManyRoutersFewTerminals) {
+    using Wide = BasicIPAddress<24, 8>;
+    constexpr Wide ip(0x123456, 0x78);
+
+    static_assert(sizeof(Wide) == 4);
+    EXPECT_TRUE((std::is_same_v<Wide::TerminalID, uint8_t>));
+    EXPECT_EQ(ip.getRawAddress(), 0x12345678u);
+    EXPECT_EQ(ip.getRouterIP(), 0x123456u);
+    EXPECT_EQ(ip.getTerminalIP(), 0x78);
+    EXPECT_EQ(Wide::fromRaw(0x12345678u), ip);
+    EXPECT_EQ(Wide::MAX_ROUTER_ID, 0xFFFFFFu);
+}
+
+TEST(IPAddressLayout, ToStringPadsToFieldWidth) {
+    EXPECT_EQ((BasicIPAddress<16, 16>(7, 42).toString()), "00007.00042");
+    EXPECT_EQ((BasicIPAddress<24, 8>(7, 42).toString()), "00000007.042");
+}
+
+TEST(IPAddressLayout, WideHashAndOrdering) {
+    using Wide = BasicIPAddress<16, 16>;
+    const std::hash<Wide> hasher;
+
+    EXPECT_EQ(hasher(Wide(300, 1)), hasher(Wide(300, 1)));
+    EXPECT_NE(hasher(Wide(300, 1)), hasher(Wide(300, 2)));
+    EXPECT_LT(Wide(1, 65535), Wide(2, 0));
 }
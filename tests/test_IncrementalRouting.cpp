@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "algorithms/IncrementalRouting.h"
+#include "core/Router.h"
+#include "core/ThreadPool.h"
+
+class IncrementalRoutingTestFixture : public ::testing::Test {
+protected:
+    List<std::unique_ptr<Router>> routers;
+    List<const Router*> pRouters;
+    List<Router*> raw;
+    size_t pageID = 0;
+
+    Router* createRouter(uint8_t routerID) {
+        auto r = std::make_unique<Router>(IPAddress(routerID));
+        routers.pushBack(std::move(r));
+
+        Router* ptr = routers.getTail().get();
+        pRouters.pushBack(ptr);
+        raw.pushBack(ptr);
+        return ptr;
+    }
+
+    void connectRouters(Router* r1, Router* r2) {
+        r1->connectRouter(r2);
+        r2->connectRouter(r1);
+    }
+
+    // Queues packets on the output buffer from -> to, increasing the weight of that edge
+    void load(Router* from, const Router* to, size_t packets) {
+        for (size_t i = 0; i < packets; ++i) {
+            from->receivePacket(Packet(pageID++, 0, 1, from->getIP(), to->getIP(), 1000));
+        }
+        RoutingTable rt;
+        rt.setNextHopIP(to->getIP(), to->getIP());
+        from->setRoutingTable(std::move(rt));
+        while (from->getPacketsInPending() > 0) {
+            from->processInputBuffer(1);
+        }
+    }
+
+    // Checks every distance and next hop of the engine against a freshly built engine
+    void expectMatchesRebuild(const IncrementalRouting& engine) {
+        const TopologySnapshot topology(pRouters);
+        IncrementalRouting fresh;
+        fresh.update(topology);
+
+        const size_t n = topology.routerCount();
+        for (size_t src = 0; src < n; ++src) {
+            const RoutingTable table = engine.buildRoutingTable(src);
+            for (size_t dst = 0; dst < n; ++dst) {
+                ASSERT_EQ(engine.getDistance(src, dst), fresh.getDistance(src, dst))
+                    << "src " << src << " dst " << dst;
+                if (src == dst) {
+                    continue;
+                }
+
+                // The next hop must start a shortest path
+                const size_t hop = topology.indexOf(table.getNextHopIP(topology.getRouterIP(dst)));
+                ASSERT_NE(hop, TopologySnapshot::NO_INDEX);
+                const auto neighbors = topology.neighbors(src);
+                size_t weight        = 0;
+                bool found           = false;
+                for (size_t k = 0; k < neighbors.size(); ++k) {
+                    if (neighbors[k] == hop) {
+                        weight = topology.weights(src)[k];
+                        found  = true;
+                    }
+                }
+                ASSERT_TRUE(found);
+                EXPECT_EQ(weight + fresh.getDistance(hop, dst), fresh.getDistance(src, dst));
+            }
+        }
+    }
+};
+
+// =============== Construction tests ===============
+TEST_F(IncrementalRoutingTestFixture, InvalidRatioThrows) {
+    EXPECT_THROW(IncrementalRouting(IncrementalRouting::Config{0, -0.5}), std::invalid_argument);
+}
+
+TEST_F(IncrementalRoutingTestFixture, FirstUpdateIsFull) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+    connectRouters(r1, r2);
+    connectRouters(r2, r3);
+
+    IncrementalRouting engine;
+    const size_t changed = engine.update(TopologySnapshot(pRouters));
+
+    EXPECT_EQ(changed, 3);
+    EXPECT_EQ(engine.getFullRecomputes(), 1);
+    EXPECT_EQ(engine.getIncrementalUpdates(), 0);
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r3->getIP()), r2->getIP());
+    EXPECT_THROW((void)engine.buildRoutingTable(3), std::out_of_range);
+}
+
+// =============== Update tests ===============
+TEST_F(IncrementalRoutingTestFixture, UnchangedWeightsDoNothing) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    connectRouters(r1, r2);
+
+    IncrementalRouting engine;
+    engine.update(TopologySnapshot(pRouters));
+
+    EXPECT_EQ(engine.update(TopologySnapshot(pRouters)), 0);
+    EXPECT_EQ(engine.getFullRecomputes(), 1);
+    EXPECT_EQ(engine.getIncrementalUpdates(), 0);
+    EXPECT_FALSE(engine.routesChanged(0));
+}
+
+TEST_F(IncrementalRoutingTestFixture, IncreaseOnTreeEdgeReroutes) {
+    // Topology: R1 -- R2
+    //            \    /
+    //              R3
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+    connectRouters(r1, r2);
+    connectRouters(r2, r3);
+    connectRouters(r3, r1);
+
+    IncrementalRouting engine(IncrementalRouting::Config{0, 1.0});
+    engine.update(TopologySnapshot(pRouters));
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r2->getIP()), r2->getIP());
+
+    load(r1, r2, 3);
+    EXPECT_GT(engine.update(TopologySnapshot(pRouters)), 0);
+
+    EXPECT_EQ(engine.getIncrementalUpdates(), 1);
+    EXPECT_EQ(engine.getLastChangedEdges(), 1);
+    EXPECT_TRUE(engine.routesChanged(0));
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r2->getIP()), r3->getIP());
+    EXPECT_EQ(engine.getDistance(0, 1), 0);
+    expectMatchesRebuild(engine);
+}
+
+TEST_F(IncrementalRoutingTestFixture, DecreaseRestoresRoute) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+    connectRouters(r1, r2);
+    connectRouters(r2, r3);
+    connectRouters(r3, r1);
+
+    load(r1, r2, 3);
+    load(r1, r3, 1);
+    load(r3, r2, 1);
+
+    IncrementalRouting engine(IncrementalRouting::Config{0, 1.0});
+    engine.update(TopologySnapshot(pRouters));
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r2->getIP()), r3->getIP());
+
+    r1->processOutputBuffers(1);  // Drains every output buffer of R1
+    engine.update(TopologySnapshot(pRouters));
+
+    EXPECT_EQ(engine.getIncrementalUpdates(), 1);
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r2->getIP()), r2->getIP());
+    expectMatchesRebuild(engine);
+}
+
+TEST_F(IncrementalRoutingTestFixture, ChangesWithinThresholdIgnored) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+    connectRouters(r1, r2);
+    connectRouters(r2, r3);
+    connectRouters(r3, r1);
+
+    IncrementalRouting engine(IncrementalRouting::Config{2, 1.0});
+    engine.update(TopologySnapshot(pRouters));
+
+    load(r1, r2, 2);
+    EXPECT_EQ(engine.update(TopologySnapshot(pRouters)), 0);
+    EXPECT_EQ(engine.getLastChangedEdges(), 0);
+    EXPECT_EQ(engine.getDistance(0, 1), 0);
+
+    load(r1, r2, 1);
+    engine.update(TopologySnapshot(pRouters));
+    EXPECT_EQ(engine.getLastChangedEdges(), 1);
+    EXPECT_EQ(engine.getDistance(0, 1), 0);  // Now through R3
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r2->getIP()), r3->getIP());
+}
+
+TEST_F(IncrementalRoutingTestFixture, TooManyChangesFallBackToFull) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    connectRouters(r1, r2);
+
+    IncrementalRouting engine(IncrementalRouting::Config{0, 0.25});
+    engine.update(TopologySnapshot(pRouters));
+
+    load(r1, r2, 1);  // One of two edges changed: 50% > 25%
+    engine.update(TopologySnapshot(pRouters));
+
+    EXPECT_EQ(engine.getFullRecomputes(), 2);
+    EXPECT_EQ(engine.getIncrementalUpdates(), 0);
+    EXPECT_EQ(engine.getDistance(0, 1), 1);
+}
+
+TEST_F(IncrementalRoutingTestFixture, TopologyChangeFallsBackToFull) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+    connectRouters(r1, r2);
+
+    IncrementalRouting engine(IncrementalRouting::Config{0, 1.0});
+    engine.update(TopologySnapshot(pRouters));
+    EXPECT_EQ(engine.getDistance(0, 2), std::numeric_limits<size_t>::max());
+
+    connectRouters(r2, r3);
+    engine.update(TopologySnapshot(pRouters));
+
+    EXPECT_EQ(engine.getFullRecomputes(), 2);
+    EXPECT_EQ(engine.buildRoutingTable(0).getNextHopIP(r3->getIP()), r2->getIP());
+}
+
+TEST_F(IncrementalRoutingTestFixture, RandomLoadsMatchRebuild) {
+    constexpr uint8_t count = 16;
+    for (uint8_t i = 1; i <= count; ++i) {
+        createRouter(i);
+    }
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+    for (size_t i = 0; i < count; ++i) {
+        connectRouters(raw[i], raw[(i + 1) % count]);
+    }
+    for (size_t c = 0; c < count; ++c) {
+        const size_t a = pick(rng);
+        const size_t b = pick(rng);
+        if (a != b) {
+            connectRouters(raw[a], raw[b]);
+        }
+    }
+
+    IncrementalRouting engine(IncrementalRouting::Config{0, 1.0});
+    ThreadPool pool(3);
+    engine.update(TopologySnapshot(pRouters), &pool);
+
+    std::uniform_int_distribution<size_t> amount(1, 4);
+    for (size_t round = 0; round < 40; ++round) {
+        // Load a few random links, and drain one router every other round
+        for (size_t k = 0; k < 3; ++k) {
+            Router* from       = raw[pick(rng)];
+            const auto targets = from->getNeighborIPs();
+            const IPAddress to = targets[pick(rng) % targets.size()];
+            for (const Router* r : pRouters) {
+                if (r->getIP() == to) {
+                    load(from, r, amount(rng));
+                }
+            }
+        }
+        if (round % 2 == 1) {
+            raw[pick(rng)]->processOutputBuffers(1);
+        }
+
+        engine.update(TopologySnapshot(pRouters), round % 3 == 0 ? &pool : nullptr);
+        expectMatchesRebuild(engine);
+    }
+
+    EXPECT_EQ(engine.getFullRecomputes(), 1);
+    EXPECT_GT(engine.getIncrementalUpdates(), 0);
+}
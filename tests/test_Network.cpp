@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include "core/Network.h"
 #include "core/Terminal.h"
 
@@ -26,7 +30,8 @@ TEST_F(NetworkTest, Constructor_InstantiatesObjects) {
 }
 
 TEST_F(NetworkTest, Constructor_DefaultParameters) {
-    const Network::Config c{10, 3, 5, 0.5, 3};
+    const Network::Config c{.routerCount = 10, .maxTerminalCount = 3, .complexity = 5,
+                            .trafficProbability = 0.5, .maxPageLen = 3};
     const Network n{c};
     for (const auto* rtr : n.getRouters()) {
         for (const auto trm : rtr->getTerminals()) {
@@ -38,7 +43,8 @@ TEST_F(NetworkTest, Constructor_DefaultParameters) {
 }
 
 TEST_F(NetworkTest, Constructor_MinimalConnectivity) {
-    const Network::Config c{10, 3, 0, 0.5, 3};
+    const Network::Config c{.routerCount = 10, .maxTerminalCount = 3, .complexity = 0,
+                            .trafficProbability = 0.5, .maxPageLen = 3};
     const Network n{c};
     for (const auto* rtr : net.getRouters()) {
         EXPECT_GE(rtr->getRouterCount(), 1);
@@ -46,7 +52,8 @@ TEST_F(NetworkTest, Constructor_MinimalConnectivity) {
 }
 
 TEST_F(NetworkTest, Constructor_ZeroTerminals) {
-    const Network::Config c{4, 0, 0, 0.5f, 5};
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 0, .complexity = 0,
+                            .trafficProbability = 0.5f, .maxPageLen = 5};
     const Network n{c};
     for (const auto* rtr : n.getRouters()) {
         EXPECT_EQ(rtr->getTerminalCount(), 0);
@@ -54,7 +61,8 @@ TEST_F(NetworkTest, Constructor_ZeroTerminals) {
 }
 
 TEST_F(NetworkTest, Constructor_SingleRouter) {
-    const Network::Config c{1, 2, 0, 0.5f, 5};
+    const Network::Config c{.routerCount = 1, .maxTerminalCount = 2, .complexity = 0,
+                            .trafficProbability = 0.5f, .maxPageLen = 5};
     const Network n{c};
     EXPECT_EQ(n.getRouters().size(), 1);
     EXPECT_EQ(n.getRouters()[0]->getRouterCount(), 0);
@@ -94,7 +102,8 @@ TEST_F(NetworkTest, Simulate_ZeroTicks_NoOp) {
 }
 
 TEST_F(NetworkTest, Simulate_PacketsReceivedAfterSimulation) {
-    const Network::Config c{4, 3, 1, 1.0f, 3};
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 3, .complexity = 1,
+                            .trafficProbability = 1.0f, .maxPageLen = 3};
     Network n{c};
     n.simulate(10);
 
@@ -106,7 +115,8 @@ TEST_F(NetworkTest, Simulate_PacketsReceivedAfterSimulation) {
 }
 
 TEST_F(NetworkTest, Simulate_ZeroProbability_NoTrafficGenerated) {
-    const Network::Config c{4, 3, 1, 0.0f, 5};
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 3, .complexity = 1,
+                            .trafficProbability = 0.0f, .maxPageLen = 5};
     Network n{c};
     n.simulate(20);
 
@@ -128,7 +138,8 @@ TEST_F(NetworkTest, Simulate_MultipleCallsAreStable) {
 }
 
 TEST_F(NetworkTest, Simulate_PacketsDeliveredLessThanReceived) {
-    const Network::Config c{4, 3, 1, 1.0f, 3};
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 3, .complexity = 1,
+                            .trafficProbability = 1.0f, .maxPageLen = 3};
     Network n{c};
     n.simulate(20);
 
@@ -138,7 +149,8 @@ TEST_F(NetworkTest, Simulate_PacketsDeliveredLessThanReceived) {
 }
 
 TEST_F(NetworkTest, Simulate_DroppedPlusForwardedPlusDelivered_ConsistentWithReceived) {
-    const Network::Config c{4, 3, 1, 1.0f, 3};
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 3, .complexity = 1,
+                            .trafficProbability = 1.0f, .maxPageLen = 3};
     Network n{c};
     n.simulate(20);
 
@@ -151,24 +163,670 @@ TEST_F(NetworkTest, Simulate_DroppedPlusForwardedPlusDelivered_ConsistentWithRec
 
 // =============== Stress tests ===============
 TEST(NetworkStressTest, LargeNetwork_Simulate) {
-    const Network::Config c{20, 10, 5, 0.3f, 10};
+    const Network::Config c{.routerCount = 20, .maxTerminalCount = 10, .complexity = 5,
+                            .trafficProbability = 0.3f, .maxPageLen = 10};
     EXPECT_NO_THROW(Network{c}.simulate(30));
 }
 
 TEST(NetworkStressTest, MinimalNetwork_TwoRouters) {
-    const Network::Config c{2, 2, 0, 0.5f, 5};
+    const Network::Config c{.routerCount = 2, .maxTerminalCount = 2, .complexity = 0,
+                            .trafficProbability = 0.5f, .maxPageLen = 5};
     Network n{c};
     EXPECT_NO_THROW(n.simulate(10));
 }
 
 TEST(NetworkStressTest, HighLoad_ManyTerminals) {
-    const Network::Config c{6, 8, 2, 1.0f, 10};
+    const Network::Config c{.routerCount = 6, .maxTerminalCount = 8, .complexity = 2,
+                            .trafficProbability = 1.0f, .maxPageLen = 10};
     Network n{c};
     EXPECT_NO_THROW(n.simulate(100));
 }
 
 TEST(NetworkStressTest, LongSimulation_TickCounterStable) {
-    const Network::Config c{5, 4, 1, 0.5f, 5};
+    const Network::Config c{.routerCount = 5, .maxTerminalCount = 4, .complexity = 1,
+                            .trafficProbability = 0.5f, .maxPageLen = 5};
     Network n{c};
     EXPECT_NO_THROW(n.simulate(200));
 }
+
+TEST(NetworkStressTest, ParallelRoutes_Simulate) {
+    const Network::Config c{.routerCount = 20, .maxTerminalCount = 4, .complexity = 3,
+                            .trafficProbability = 0.5f, .maxPageLen = 5, .routeThreads = 4};
+    Network n{c};
+    EXPECT_NO_THROW(n.simulate(30));
+
+    const NetworkStats stats = n.getStats();
+    EXPECT_GT(stats.packetsGenerated, 0);
+}
+
+TEST(NetworkStressTest, IncrementalRoutes_EveryTick) {
+    const Network::Config c{.routerCount = 12, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 0.5f, .maxPageLen = 5, .routeThreads = 2,
+                            .routeInterval = 1, .incrementalRoutes = true};
+    Network n{c};
+    EXPECT_NO_THROW(n.simulate(40));
+    EXPECT_GT(n.getStats().packetsGenerated, 0);
+}
+
+TEST(NetworkStressTest, EagerExpiry_Simulate) {
+    const Network::Config c{.routerCount = 10, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 1.0f, .maxPageLen = 8, .seed = 7,
+                            .eagerExpiry = true};
+    Network n{c};
+    EXPECT_NO_THROW(n.simulate(300));
+
+    for (const auto* rtr : n.getRouters()) {
+        EXPECT_TRUE(rtr->hasEagerExpiry());
+    }
+    EXPECT_GT(n.getStats().packetsDelivered, 0);
+}
+
+TEST(NetworkStressTest, WideLayout_MoreRoutersThanOneByte) {
+    if constexpr (IPAddress::ROUTER_BITS <= 8) {
+        GTEST_SKIP() << "Build with ROUTERSIM_ADDRESS_LAYOUT=16+16 or 24+8 to run";
+    } else {
+        constexpr size_t ROUTERS = 300;
+        Network::Config c{.routerCount = static_cast<IPAddress::RouterID>(ROUTERS),
+                          .maxTerminalCount = 2, .complexity = 2, .trafficProbability = 0.5f,
+                          .maxPageLen = 4};
+        c.seed = 5;
+        Network n{c};
+        n.simulate(60);
+
+        ASSERT_EQ(n.getRouters().size(), ROUTERS);
+        size_t highest = 0;
+        for (const auto* rtr : n.getRouters()) {
+            highest = std::max<size_t>(highest, rtr->getIP().getRouterIP());
+        }
+        EXPECT_GT(highest, 255);
+        EXPECT_GT(n.getStats().packetsDelivered, 0);
+    }
+}
+
+TEST(NetworkStaticTest, Constructor_ZeroRouteIntervalThrows) {
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 2, .complexity = 0,
+                            .trafficProbability = 0.5f, .maxPageLen = 5, .routeInterval = 0};
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+}
+
+TEST(NetworkStaticTest, Constructor_PageLengthAbovePacketLimitThrows) {
+    Network::Config c{.routerCount = 4, .maxTerminalCount = 2, .complexity = 0,
+                      .trafficProbability = 0.5f, .maxPageLen = Packet::MAX_PAGE_LEN + 1};
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+
+    c.maxPageLen = Packet::MAX_PAGE_LEN;
+    EXPECT_NO_THROW(Network{c});
+}
+
+TEST(NetworkStaticTest, Constructor_EventDrivenWithTickThreadsThrows) {
+    const Network::Config c{.routerCount = 4, .maxTerminalCount = 2, .complexity = 0,
+                            .trafficProbability = 0.5f, .maxPageLen = 5, .tickThreads = 2,
+                            .seed = 1, .eventDriven = true};
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+}
+
+// =============== Determinism tests ===============
+namespace {
+void expectSameStats(const NetworkStats& a, const NetworkStats& b) {
+    EXPECT_EQ(a.packetsGenerated, b.packetsGenerated);
+    EXPECT_EQ(a.packetsSent, b.packetsSent);
+    EXPECT_EQ(a.packetsDelivered, b.packetsDelivered);
+    EXPECT_EQ(a.packetsDropped, b.packetsDropped);
+    EXPECT_EQ(a.packetsTimedOut, b.packetsTimedOut);
+    EXPECT_EQ(a.packetsInFlight, b.packetsInFlight);
+    EXPECT_EQ(a.pagesCreated, b.pagesCreated);
+    EXPECT_EQ(a.pagesCompleted, b.pagesCompleted);
+}
+}  // namespace
+
+TEST(NetworkDeterminismTest, SameSeed_SameRun) {
+    const Network::Config c{.routerCount = 12, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 0.5f, .maxPageLen = 5, .seed = 1234};
+    Network a{c};
+    Network b{c};
+    a.simulate(50);
+    b.simulate(50);
+
+    EXPECT_EQ(a.getSeed(), 1234);
+    EXPECT_GT(a.getStats().packetsGenerated, 0);
+    expectSameStats(a.getStats(), b.getStats());
+}
+
+TEST(NetworkDeterminismTest, RandomSeed_Reported) {
+    const Network n{};
+    EXPECT_NE(n.getSeed(), 0);
+}
+
+TEST(NetworkDeterminismTest, ParallelTick_IndependentOfThreadCount) {
+    const Network::Config two{.routerCount = 30, .maxTerminalCount = 4, .complexity = 3,
+                              .trafficProbability = 0.6f, .maxPageLen = 6, .tickThreads = 2,
+                              .seed = 99};
+    const Network::Config five{.routerCount = 30, .maxTerminalCount = 4, .complexity = 3,
+                               .trafficProbability = 0.6f, .maxPageLen = 6, .routeThreads = 4,
+                               .tickThreads = 5, .seed = 99};
+    Network a{two};
+    Network b{five};
+    a.simulate(60);
+    b.simulate(60);
+
+    EXPECT_GT(a.getStats().packetsDelivered, 0);
+    expectSameStats(a.getStats(), b.getStats());
+}
+
+// =============== Stats tests ===============
+namespace {
+/** Stats gathered by walking every router, buffer and terminal */
+NetworkStats walkStats(const Network& n) {
+    NetworkStats stats;
+    for (const auto* rtr : n.getRouters()) {
+        stats.packetsDropped += rtr->getPacketsDropped();
+        stats.packetsTimedOut += rtr->getPacketsTimedOut();
+        stats.packetsInFlight += rtr->getPacketsInPending() + rtr->getPacketsOutPending() +
+                                 rtr->getPacketsLocPending();
+        for (const auto* trm : rtr->getTerminals()) {
+            stats.pagesCreated += trm->getPagesCreated();
+            stats.pagesCompleted += trm->getPagesCompleted();
+            stats.packetsGenerated += trm->getPacketsGenerated();
+            stats.packetsSent += trm->getPacketsSent();
+            stats.packetsDropped += trm->getPacketsInDropped() + trm->getPacketsOutDropped();
+            stats.packetsTimedOut += trm->getPacketsInTimedOut() + trm->getPacketsOutTimedOut();
+            stats.packetsInFlight += trm->getPacketsInPending() + trm->getPacketsOutPending();
+            stats.packetsDelivered += trm->getPacketsSuccProcessed();
+        }
+    }
+    return stats;
+}
+}  // namespace
+
+TEST(NetworkStatsTest, RunningTotals_MatchFullWalk) {
+    const Network::Config c{.routerCount = 15, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 0.5f, .maxPageLen = 6, .seed = 555};
+    Network n{c};
+    for (int i = 0; i < 8; ++i) {
+        n.simulate(25);
+        expectSameStats(n.getStats(), walkStats(n));
+    }
+    EXPECT_GT(n.getStats().packetsTimedOut, 0);
+}
+
+TEST(NetworkStatsTest, RunningTotals_MatchFullWalkInParallelTick) {
+    const Network::Config c{.routerCount = 15, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 0.5f, .maxPageLen = 6, .tickThreads = 3,
+                            .seed = 556};
+    Network n{c};
+    n.simulate(150);
+
+    EXPECT_GT(n.getStats().packetsDelivered, 0);
+    expectSameStats(n.getStats(), walkStats(n));
+}
+
+// =============== Event-driven tests ===============
+TEST(NetworkEventDrivenTest, SameSeed_SameRun) {
+    const Network::Config c{.routerCount = 12, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 0.2f, .maxPageLen = 5, .seed = 77,
+                            .eventDriven = true};
+    Network a{c};
+    Network b{c};
+    a.simulate(200);
+    b.simulate(200);
+
+    EXPECT_GT(a.getStats().pagesCompleted, 0);
+    expectSameStats(a.getStats(), b.getStats());
+}
+
+TEST(NetworkEventDrivenTest, ZeroProbability_OnlyTicksAdvance) {
+    const Network::Config c{.routerCount = 10, .maxTerminalCount = 3, .complexity = 2,
+                            .trafficProbability = 0.0f, .maxPageLen = 5, .seed = 5,
+                            .eventDriven = true};
+    Network n{c};
+    n.simulate(100);
+
+    const NetworkStats stats = n.getStats();
+    EXPECT_EQ(stats.currentTick, 100);
+    EXPECT_EQ(stats.packetsGenerated, 0);
+    EXPECT_EQ(stats.packetsInFlight, 0);
+}
+
+TEST(NetworkEventDrivenTest, SparseTraffic_MatchesTickMode) {
+    const Network::Config ticked{.routerCount = 30, .maxTerminalCount = 4, .complexity = 2,
+                                 .trafficProbability = 0.02f, .maxPageLen = 6, .seed = 2024};
+    const Network::Config evented{.routerCount = 30, .maxTerminalCount = 4, .complexity = 2,
+                                  .trafficProbability = 0.02f, .maxPageLen = 6, .seed = 2024,
+                                  .eventDriven = true};
+    Network a{ticked};
+    Network b{evented};
+    a.simulate(3000);
+    b.simulate(3000);
+
+    // Both modes draw the same emission ticks from the same streams
+    EXPECT_EQ(a.getStats().currentTick, b.getStats().currentTick);
+    EXPECT_GT(a.getStats().pagesCompleted, 0);
+    expectSameStats(a.getStats(), b.getStats());
+}
+
+TEST(NetworkEventDrivenTest, BurstyTrafficModel_MatchesTickMode) {
+    const auto model = std::make_shared<OnOffTraffic>(0.5f, 10.0, 400.0);
+    const Network::Config ticked{.routerCount = 20, .maxTerminalCount = 4, .complexity = 2,
+                                 .trafficProbability = 0.0f, .maxPageLen = 6, .seed = 31,
+                                 .trafficModel = model};
+    const Network::Config evented{.routerCount = 20, .maxTerminalCount = 4, .complexity = 2,
+                                  .trafficProbability = 0.0f, .maxPageLen = 6, .seed = 31,
+                                  .eventDriven = true, .trafficModel = model};
+    Network a{ticked};
+    Network b{evented};
+    a.simulate(2000);
+    b.simulate(2000);
+
+    EXPECT_GT(a.getStats().pagesCreated, 0);
+    expectSameStats(a.getStats(), b.getStats());
+}
+
+// =============== Layout tests ===============
+TEST(NetworkLayoutTest, RoutersAreContiguousInLayoutOrder) {
+    const Network creation{Network::Config{.routerCount = 20, .maxTerminalCount = 3,
+                                           .complexity = 2, .trafficProbability = 0.5f,
+                                           .maxPageLen = 4, .seed = 77}};
+    Network::Config c{.routerCount = 20, .maxTerminalCount = 3, .complexity = 2,
+                      .trafficProbability = 0.5f, .maxPageLen = 4, .seed = 77};
+    c.layout = Network::Layout::BreadthFirst;
+    const Network bfs{c};
+
+    const auto& routers = bfs.getRouters();
+    ASSERT_EQ(routers.size(), 20);
+    EXPECT_EQ(routers[0]->getIP().getRouterIP(), 0);
+    std::vector<List<IPAddress>> neighborsByID(20);
+    for (size_t i = 0; i < routers.size(); ++i) {
+        EXPECT_EQ(routers[i], routers[0] + i);
+        neighborsByID[routers[i]->getIP().getRouterIP()] = routers[i]->getNeighborIPs();
+    }
+
+    // Same routers with the same links, in the same connection order
+    for (const auto* rtr : creation.getRouters()) {
+        const List<IPAddress>& neighbors = neighborsByID[rtr->getIP().getRouterIP()];
+        const List<IPAddress> expected   = rtr->getNeighborIPs();
+        ASSERT_EQ(neighbors.size(), expected.size());
+        auto it = neighbors.begin();
+        for (IPAddress ip : expected) {
+            EXPECT_EQ(*it++, ip);
+        }
+    }
+    EXPECT_FALSE(std::ranges::equal(bfs.getRouters(), creation.getRouters(), {},
+                                    [](const Router* r) { return r->getIP(); },
+                                    [](const Router* r) { return r->getIP(); }));
+}
+
+TEST(NetworkLayoutTest, ParallelTick_OutcomeIndependentOfLayout) {
+    // A tree has a single path between any two routers, so routes cannot depend on the order
+    // the routers are stored in, and the two-phase tick does not depend on the visiting order
+    NetworkStats stats[3];
+    const Network::Layout layouts[] = {Network::Layout::Creation, Network::Layout::BreadthFirst,
+                                       Network::Layout::ReverseCuthillMcKee};
+    for (size_t i = 0; i < 3; ++i) {
+        Network::Config c{.routerCount = 25, .maxTerminalCount = 4, .complexity = 0,
+                          .trafficProbability = 0.5f, .maxPageLen = 6, .tickThreads = 2,
+                          .seed = 4242};
+        c.layout = layouts[i];
+        Network n{c};
+        n.simulate(80);
+        stats[i] = n.getStats();
+    }
+
+    EXPECT_GT(stats[0].packetsDelivered, 0);
+    expectSameStats(stats[0], stats[1]);
+    expectSameStats(stats[0], stats[2]);
+}
+
+// =============== Partition tests ===============
+TEST(NetworkPartitionTest, PartitionsCoverRoutersAndStageCrossLinks) {
+    Network::Config c{.routerCount = 24, .maxTerminalCount = 3, .complexity = 2,
+                      .trafficProbability = 0.5f, .maxPageLen = 4, .seed = 808};
+    c.partitions = 4;
+    const Network n{c};
+
+    const auto& routers = n.getRouters();
+    std::vector<size_t> partOf(routers.size(), routers.size());
+    for (size_t p = 0; p < n.getPartitions().size(); ++p) {
+        EXPECT_FALSE(n.getPartitions()[p].empty());
+        for (size_t index : n.getPartitions()[p]) {
+            EXPECT_EQ(partOf[index], routers.size());
+            partOf[index] = p;
+        }
+    }
+    ASSERT_EQ(n.getPartitions().size(), 4);
+
+    std::vector<size_t> indexByID(routers.size());
+    for (size_t i = 0; i < routers.size(); ++i) {
+        ASSERT_LT(partOf[i], 4);
+        indexByID[routers[i]->getIP().getRouterIP()] = i;
+    }
+    for (size_t i = 0; i < routers.size(); ++i) {
+        for (IPAddress neighbor : routers[i]->getNeighborIPs()) {
+            const bool crossing = partOf[i] != partOf[indexByID[neighbor.getRouterIP()]];
+            EXPECT_EQ(routers[i]->isLinkStaged(neighbor), crossing);
+        }
+    }
+}
+
+TEST(NetworkPartitionTest, OutcomeIndependentOfThreadCount) {
+    Network::Config one{.routerCount = 30, .maxTerminalCount = 4, .complexity = 3,
+                        .trafficProbability = 0.6f, .maxPageLen = 6, .seed = 909};
+    one.partitions = 3;
+    Network::Config four = one;
+    four.tickThreads     = 4;
+    Network a{one};
+    Network b{four};
+    a.simulate(80);
+    b.simulate(80);
+
+    EXPECT_GT(a.getStats().packetsDelivered, 0);
+    expectSameStats(a.getStats(), b.getStats());
+    expectSameStats(b.getStats(), walkStats(b));
+}
+
+TEST(NetworkPartitionTest, InvalidPartitionCountThrows) {
+    Network::Config zero{.routerCount = 5, .maxTerminalCount = 2, .complexity = 1,
+                         .trafficProbability = 0.5f, .maxPageLen = 4};
+    zero.partitions = 0;
+    Network::Config tooMany{.routerCount = 5, .maxTerminalCount = 2, .complexity = 1,
+                            .trafficProbability = 0.5f, .maxPageLen = 4};
+    tooMany.partitions = 6;
+    Network::Config evented{.routerCount = 5, .maxTerminalCount = 2, .complexity = 1,
+                            .trafficProbability = 0.5f, .maxPageLen = 4, .eventDriven = true};
+    evented.partitions = 2;
+
+    EXPECT_THROW(Network{zero}, std::invalid_argument);
+    EXPECT_THROW(Network{tooMany}, std::invalid_argument);
+    EXPECT_THROW(Network{evented}, std::invalid_argument);
+}
+
+// =============== Queueing discipline tests ===============
+TEST(NetworkQueueTest, ClassCountersMatchForwardedPackets) {
+    for (const auto discipline :
+         {QueueDiscipline::Fifo, QueueDiscipline::StrictPriority,
+          QueueDiscipline::DeficitRoundRobin, QueueDiscipline::EarliestDeadline}) {
+        Network::Config c{.routerCount = 10, .maxTerminalCount = 4, .complexity = 2,
+                          .trafficProbability = 0.8f, .maxPageLen = 8};
+        c.seed        = 11;
+        c.eagerExpiry = discipline == QueueDiscipline::EarliestDeadline;
+        c.outQueue    = QueueConfig{.discipline = discipline, .classLimits = {2, 5}};
+        Network n{c};
+        n.simulate(150);
+
+        size_t forwarded = 0;
+        for (const auto* rtr : n.getRouters()) {
+            EXPECT_EQ(rtr->getOutputQueue().discipline, discipline);
+            forwarded += rtr->getPacketsForwarded();
+        }
+        size_t sent = 0;
+        for (const ClassCounters& counters : n.getClassCounters()) {
+            sent += counters.sent;
+        }
+        EXPECT_GT(forwarded, 0);
+        EXPECT_EQ(sent, forwarded);
+        EXPECT_EQ(n.getClassCounters().size(), discipline == QueueDiscipline::Fifo ? 1 : 3);
+    }
+}
+
+TEST(NetworkQueueTest, EarlyDropWithQueueManagement) {
+    for (const auto mode : {AqmMode::Red, AqmMode::CoDel}) {
+        Network::Config c{.routerCount = 10, .maxTerminalCount = 4, .complexity = 2,
+                          .trafficProbability = 0.8f, .maxPageLen = 8};
+        c.seed                      = 11;
+        c.outQueue.aqm.mode         = mode;
+        c.outQueue.aqm.minThreshold = 1;
+        c.outQueue.aqm.maxThreshold = 4;
+        c.outQueue.aqm.target       = 1;
+        c.outQueue.aqm.interval     = 4;
+        c.doomedFilterBits          = 1 << 12;
+        Network n{c};
+        n.simulate(200);
+
+        size_t aqmDropped = 0;
+        for (const ClassCounters& counters : n.getClassCounters()) {
+            aqmDropped += counters.aqmDropped;
+        }
+        for (const auto* rtr : n.getRouters()) {
+            EXPECT_EQ(rtr->getDoomedFilterBits(), 1 << 12);
+            EXPECT_TRUE(rtr->getDropNotices().empty());
+        }
+        const NetworkStats stats = n.getStats();
+        EXPECT_GT(aqmDropped, 0);
+        EXPECT_GT(stats.packetsDoomed, 0);
+        EXPECT_LE(stats.packetsDoomed + aqmDropped, stats.packetsDropped);
+        EXPECT_LE(stats.packetsInFlight, stats.packetsGenerated);
+    }
+}
+
+TEST(NetworkQueueTest, InvalidQueueConfigThrows) {
+    Network::Config c{.routerCount = 5, .maxTerminalCount = 2, .complexity = 1,
+                      .trafficProbability = 0.5f, .maxPageLen = 4};
+    c.outQueue = QueueConfig{.discipline = QueueDiscipline::StrictPriority, .classLimits = {5, 2}};
+
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+}
+
+// =============== Multipath tests ===============
+TEST(NetworkMultipathTest, TablesKeepEqualCostPaths) {
+    Network::Config c{.routerCount = 16, .maxTerminalCount = 3, .complexity = 12,
+                      .trafficProbability = 0.6f, .maxPageLen = 6};
+    c.seed       = 5;
+    c.routePaths = 4;
+    Network n{c};
+    n.simulate(100);
+
+    size_t multipathRoutes = 0;
+    for (const auto* rtr : n.getRouters()) {
+        const RoutingTable& table = rtr->getRoutingTable();
+        EXPECT_EQ(table.size(), n.getRouters().size() - 1);
+        for (const auto* dst : n.getRouters()) {
+            EXPECT_LE(table.getPathCount(dst->getIP()), 4);
+            multipathRoutes += table.getPathCount(dst->getIP()) > 1;
+        }
+    }
+    const NetworkStats stats = n.getStats();
+    EXPECT_GT(multipathRoutes, 0);
+    EXPECT_GT(stats.pagesCompleted, 0);
+    EXPECT_LE(stats.packetsInFlight, stats.packetsGenerated);
+}
+
+TEST(NetworkMultipathTest, InvalidPathCountThrows) {
+    Network::Config c{.routerCount = 5, .maxTerminalCount = 2, .complexity = 1,
+                      .trafficProbability = 0.5f, .maxPageLen = 4};
+    c.routePaths = 0;
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+
+    c.routePaths = RoutingTable::MAX_PATHS + 1;
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+
+    c.routePaths        = 2;
+    c.incrementalRoutes = true;
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+
+    c.routePaths        = 1;
+    c.incrementalRoutes = false;
+    c.routeSlack        = 2;
+    EXPECT_THROW(Network{c}, std::invalid_argument);
+}
+
+TEST(NetworkMultipathTest, SlackKeepsMorePathsAndDelivers) {
+    Network::Config c{.routerCount = 16, .maxTerminalCount = 3, .complexity = 6,
+                      .trafficProbability = 0.8f, .maxPageLen = 6, .seed = 23};
+    c.routePaths = 4;
+    Network exact{c};
+    c.routeSlack = 3;
+    Network slack{c};
+    exact.simulate(120);
+    slack.simulate(120);
+
+    const auto paths = [](const Network& n) {
+        size_t total = 0;
+        for (const auto* rtr : n.getRouters()) {
+            for (const auto* dst : n.getRouters()) {
+                total += rtr->getRoutingTable().getPathCount(dst->getIP());
+            }
+        }
+        return total;
+    };
+    EXPECT_GT(paths(slack), paths(exact));
+    EXPECT_GT(slack.getStats().pagesCompleted, 0);
+}
+
+// =============== Run control tests ===============
+TEST(NetworkRunControlTest, StepMatchesSimulate) {
+    const Network::Config c{.routerCount = 12, .maxTerminalCount = 4, .complexity = 2,
+                            .trafficProbability = 0.5f, .maxPageLen = 5, .seed = 77};
+    Network whole{c};
+    Network stepped{c};
+    Network split{c};
+    whole.simulate(37);
+    for (size_t i = 0; i < 37; i++) {
+        stepped.step();
+    }
+    split.simulate(11);
+    split.simulate(26);
+
+    expectSameStats(whole.getStats(), stepped.getStats());
+    expectSameStats(whole.getStats(), split.getStats());
+    EXPECT_EQ(whole.getCurrentTick(), 37);
+    EXPECT_EQ(stepped.getRouteRecomputes(), whole.getRouteRecomputes());
+    EXPECT_EQ(split.getRouteRecomputes(), whole.getRouteRecomputes());
+}
+
+TEST(NetworkRunControlTest, IntervalPolicyRecomputesOnMultiples) {
+    Network n{Network::Config{.routerCount = 8, .maxTerminalCount = 3, .complexity = 2,
+                              .trafficProbability = 0.5f, .maxPageLen = 4}};
+    EXPECT_EQ(n.getRouteRecomputes(), 1);
+
+    n.simulate(23);
+    EXPECT_EQ(n.getRouteRecomputes(), 1 + 23 / Network::DEF_ROUTE_INTERVAL);
+}
+
+TEST(NetworkRunControlTest, ManualPolicyWaitsForRecompute) {
+    Network::Config c{.routerCount = 8, .maxTerminalCount = 3, .complexity = 2,
+                      .trafficProbability = 0.5f, .maxPageLen = 4};
+    c.routePolicy = Network::RoutePolicy::Manual;
+    Network n{c};
+    n.simulate(30);
+    EXPECT_EQ(n.getRouteRecomputes(), 1);
+
+    n.recomputeRoutes();
+    EXPECT_EQ(n.getRouteRecomputes(), 2);
+}
+
+TEST(NetworkRunControlTest, LoadChangePolicyFollowsTheThreshold) {
+    Network::Config c{.routerCount = 12, .maxTerminalCount = 4, .complexity = 2,
+                      .trafficProbability = 0.8f, .maxPageLen = 6};
+    c.seed               = 3;
+    c.routePolicy        = Network::RoutePolicy::LoadChange;
+    c.routeLoadThreshold = 0;
+    Network eager{c};
+    eager.simulate(40);
+
+    c.routeLoadThreshold = SIZE_MAX;
+    Network idle{c};
+    idle.simulate(40);
+
+    EXPECT_GT(eager.getRouteRecomputes(), 1 + 40 / Network::DEF_ROUTE_INTERVAL);
+    EXPECT_EQ(idle.getRouteRecomputes(), 1);
+}
+
+TEST(NetworkRunControlTest, PeriodicCallbacksFireOnMultiples) {
+    Network n{Network::Config{.routerCount = 6, .maxTerminalCount = 2, .complexity = 1,
+                              .trafficProbability = 0.5f, .maxPageLen = 4}};
+    std::vector<size_t> ticks;
+    size_t calls = 0;
+    n.addPeriodicCallback(4, [&ticks](const Network& net) {
+        ticks.push_back(net.getCurrentTick());
+    });
+    const size_t id = n.addPeriodicCallback(1, [&calls](const Network&) { calls++; });
+
+    n.simulate(10);
+    EXPECT_TRUE(n.removePeriodicCallback(id));
+    EXPECT_FALSE(n.removePeriodicCallback(id));
+    n.simulate(10);
+
+    EXPECT_EQ(ticks, (std::vector<size_t>{4, 8, 12, 16, 20}));
+    EXPECT_EQ(calls, 10);
+}
+
+TEST(NetworkRunControlTest, InvalidCallbackThrows) {
+    Network n{Network::Config{.routerCount = 4, .maxTerminalCount = 2, .complexity = 1,
+                              .trafficProbability = 0.5f, .maxPageLen = 4}};
+    EXPECT_THROW(n.addPeriodicCallback(0, [](const Network&) {}), std::invalid_argument);
+    EXPECT_THROW(n.addPeriodicCallback(3, nullptr), std::invalid_argument);
+}
+
+TEST(NetworkRunControlTest, RunPastMaxTickThrows) {
+    Network n{Network::Config{.routerCount = 4, .maxTerminalCount = 2, .complexity = 1,
+                              .trafficProbability = 0.5f, .maxPageLen = 4}};
+    EXPECT_THROW(n.simulate(Network::MAX_TICK + 1), std::out_of_range);
+    EXPECT_EQ(n.getCurrentTick(), 0);
+
+    n.simulate(3);
+    EXPECT_THROW(n.simulate(Network::MAX_TICK - 2), std::out_of_range);
+    EXPECT_EQ(n.getCurrentTick(), 3);
+}
+
+// =============== Pipelined tick tests ===============
+TEST(NetworkPipelineTest, MatchesPartitionedTick) {
+    Network::Config barrier{.routerCount = 30, .maxTerminalCount = 4, .complexity = 3,
+                            .trafficProbability = 0.6f, .maxPageLen = 6, .tickThreads = 4,
+                            .seed = 1212};
+    barrier.partitions         = 4;
+    Network::Config pipelined  = barrier;
+    pipelined.pipelined        = true;
+    Network a{barrier};
+    Network b{pipelined};
+
+    size_t calls = 0;
+    b.addPeriodicCallback(7, [&calls](const Network&) { calls++; });
+    a.simulate(53);
+    b.simulate(30);
+    b.simulate(23);
+
+    EXPECT_GT(a.getStats().packetsDelivered, 0);
+    expectSameStats(a.getStats(), b.getStats());
+    expectSameStats(b.getStats(), walkStats(b));
+    EXPECT_EQ(b.getCurrentTick(), 53);
+    EXPECT_EQ(b.getRouteRecomputes(), a.getRouteRecomputes());
+    EXPECT_EQ(calls, 53 / 7);
+}
+
+TEST(NetworkPipelineTest, ManualRoutesRunInOneStretch) {
+    Network::Config barrier{.routerCount = 20, .maxTerminalCount = 3, .complexity = 2,
+                            .trafficProbability = 0.7f, .maxPageLen = 5, .tickThreads = 3,
+                            .seed = 77};
+    barrier.partitions  = 3;
+    barrier.routePolicy = Network::RoutePolicy::Manual;
+    barrier.eagerExpiry = true;
+    Network::Config pipelined = barrier;
+    pipelined.pipelined       = true;
+    Network a{barrier};
+    Network b{pipelined};
+    a.simulate(120);
+    b.simulate(120);
+
+    expectSameStats(a.getStats(), b.getStats());
+    EXPECT_EQ(b.getRouteRecomputes(), 1);
+}
+
+TEST(NetworkPipelineTest, InvalidConfigThrows) {
+    Network::Config single{.routerCount = 8, .maxTerminalCount = 2, .complexity = 1,
+                           .trafficProbability = 0.5f, .maxPageLen = 4, .tickThreads = 2};
+    single.pipelined = true;
+    EXPECT_THROW(Network{single}, std::invalid_argument);
+
+    Network::Config fewThreads = single;
+    fewThreads.partitions      = 4;
+    EXPECT_THROW(Network{fewThreads}, std::invalid_argument);
+
+    Network::Config loadDriven = single;
+    loadDriven.partitions      = 2;
+    loadDriven.routePolicy     = Network::RoutePolicy::LoadChange;
+    EXPECT_THROW(Network{loadDriven}, std::invalid_argument);
+
+    Network::Config earlyDrop  = single;
+    earlyDrop.partitions       = 2;
+    earlyDrop.doomedFilterBits = 1 << 10;
+    EXPECT_THROW(Network{earlyDrop}, std::invalid_argument);
+}
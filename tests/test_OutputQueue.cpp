@@ -0,0 +1,317 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/Checkpoint.h"
+#include "core/OutputQueue.h"
+
+class OutputQueueTest : public testing::Test {
+protected:
+    const IPAddress src{20, 15};
+    const IPAddress dst{10, 5};
+    const IPAddress rtr{15, 0};
+    static constexpr size_t TICK  = 100;
+    static constexpr size_t SHORT = 2;  // Page length of class 0
+    static constexpr size_t LONG  = 10;  // Page length of class 1
+
+    /** Two classes split at pages of 4 packets */
+    static QueueConfig config(QueueDiscipline discipline, std::vector<size_t> quanta = {}) {
+        return QueueConfig{
+            .discipline = discipline, .classLimits = {4}, .quanta = std::move(quanta)};
+    }
+
+    Packet packet(size_t pageID, size_t pageLen, size_t timeout = TICK) const {
+        return Packet(pageID, 0, pageLen, src, dst, timeout);
+    }
+
+    /** Page IDs of the next n packets the queue sends */
+    static std::vector<size_t> send(OutputQueue& queue, size_t n, size_t tick = 0) {
+        std::vector<Packet> out;
+        queue.dequeueLive(n, tick, out);
+        std::vector<size_t> ids;
+        for (const Packet& p : out) {
+            ids.push_back(p.getPageID());
+        }
+        return ids;
+    }
+};
+
+// =============== Configuration tests ===============
+TEST_F(OutputQueueTest, Fifo_SingleClassInArrivalOrder) {
+    OutputQueue queue(rtr, 0, config(QueueDiscipline::Fifo));
+    queue.enqueue(packet(1, LONG));
+    queue.enqueue(packet(2, SHORT));
+
+    EXPECT_EQ(queue.getClassCount(), 1);
+    EXPECT_EQ(queue.getDstIP(), rtr);
+    EXPECT_EQ(send(queue, 5), (std::vector<size_t>{1, 2}));
+    EXPECT_EQ(queue.getClassCounters()[0].sent, 2);
+}
+
+TEST_F(OutputQueueTest, ClassOf_ByPageLength) {
+    const OutputQueue queue(
+        rtr, 0, QueueConfig{.discipline = QueueDiscipline::StrictPriority, .classLimits = {1, 4}});
+
+    EXPECT_EQ(queue.getClassCount(), 3);
+    EXPECT_EQ(queue.classOf(packet(1, 1)), 0);
+    EXPECT_EQ(queue.classOf(packet(1, 2)), 1);
+    EXPECT_EQ(queue.classOf(packet(1, 4)), 1);
+    EXPECT_EQ(queue.classOf(packet(1, 5)), 2);
+}
+
+TEST_F(OutputQueueTest, InvalidConfig_Throws) {
+    using D = QueueDiscipline;
+    EXPECT_THROW(
+        OutputQueue(rtr, 0, QueueConfig{.discipline = D::StrictPriority, .classLimits = {4, 4}}),
+        std::invalid_argument);
+    EXPECT_THROW(OutputQueue(rtr, 0, config(D::DeficitRoundRobin, {1})), std::invalid_argument);
+    EXPECT_THROW(OutputQueue(rtr, 0, config(D::DeficitRoundRobin, {1, 0})),
+                 std::invalid_argument);
+
+    QueueConfig tooMany{.discipline = D::EarliestDeadline};
+    for (size_t limit = 1; limit <= OutputQueue::MAX_CLASSES; limit++) {
+        tooMany.classLimits.push_back(limit);
+    }
+    EXPECT_THROW(OutputQueue(rtr, 0, tooMany), std::invalid_argument);
+
+    QueueConfig red{.aqm = {.mode = AqmMode::Red}};
+    red.aqm.maxThreshold = red.aqm.minThreshold;
+    EXPECT_THROW(OutputQueue(rtr, 0, red), std::invalid_argument);
+    QueueConfig codel{.aqm = {.mode = AqmMode::CoDel}};
+    codel.aqm.interval = 0;
+    EXPECT_THROW(OutputQueue(rtr, 0, codel), std::invalid_argument);
+}
+
+// =============== Discipline tests ===============
+TEST_F(OutputQueueTest, StrictPriority_ShortPagesFirst) {
+    OutputQueue queue(rtr, 0, config(QueueDiscipline::StrictPriority));
+    queue.enqueue(packet(1, LONG));
+    queue.enqueue(packet(2, LONG));
+    queue.enqueue(packet(3, SHORT));
+    queue.enqueue(packet(4, SHORT));
+
+    EXPECT_EQ(send(queue, 3), (std::vector<size_t>{3, 4, 1}));
+    EXPECT_EQ(send(queue, 3), (std::vector<size_t>{2}));
+    EXPECT_EQ(queue.getClassCounters()[0].sent, 2);
+    EXPECT_EQ(queue.getClassCounters()[1].sent, 2);
+}
+
+TEST_F(OutputQueueTest, DeficitRoundRobin_SharesByQuantum) {
+    OutputQueue queue(rtr, 0, config(QueueDiscipline::DeficitRoundRobin, {2, 1}));
+    for (size_t i = 0; i < 4; i++) {
+        queue.enqueue(packet(10 + i, SHORT));
+        queue.enqueue(packet(20 + i, LONG));
+    }
+
+    EXPECT_EQ(send(queue, 6), (std::vector<size_t>{10, 11, 20, 12, 13, 21}));
+    EXPECT_EQ(send(queue, 6), (std::vector<size_t>{22, 23}));
+}
+
+TEST_F(OutputQueueTest, DeficitRoundRobin_KeepsTurnAcrossTicks) {
+    OutputQueue queue(rtr, 0, config(QueueDiscipline::DeficitRoundRobin, {3, 1}));
+    for (size_t i = 0; i < 4; i++) {
+        queue.enqueue(packet(10 + i, SHORT));
+        queue.enqueue(packet(20 + i, LONG));
+    }
+
+    // Bandwidth runs out in the middle of the turn of class 0, which resumes it next tick
+    EXPECT_EQ(send(queue, 2), (std::vector<size_t>{10, 11}));
+    EXPECT_EQ(send(queue, 2), (std::vector<size_t>{12, 20}));
+    EXPECT_EQ(send(queue, 2), (std::vector<size_t>{13, 21}));
+}
+
+TEST_F(OutputQueueTest, EarliestDeadline_EarliestTimeoutFirst) {
+    OutputQueue queue(rtr, 0, config(QueueDiscipline::EarliestDeadline));
+    queue.enqueue(packet(1, LONG, 300));
+    queue.enqueue(packet(2, SHORT, 200));
+    queue.enqueue(packet(3, LONG, 100));
+    queue.enqueue(packet(4, SHORT, 200));
+
+    EXPECT_EQ(send(queue, 10), (std::vector<size_t>{3, 2, 4, 1}));
+    EXPECT_EQ(queue.getClassCounters()[0].sent, 2);
+    EXPECT_EQ(queue.getClassCounters()[1].sent, 2);
+}
+
+TEST_F(OutputQueueTest, Capacity_SharedAcrossClasses) {
+    OutputQueue queue(rtr, 3, config(QueueDiscipline::StrictPriority));
+    EXPECT_TRUE(queue.enqueue(packet(1, LONG)));
+    EXPECT_TRUE(queue.enqueue(packet(2, LONG)));
+    EXPECT_TRUE(queue.enqueue(packet(3, SHORT)));
+    EXPECT_FALSE(queue.enqueue(packet(4, SHORT)));
+
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.getClassCounters()[0].enqueued, 1);
+    EXPECT_EQ(queue.getClassCounters()[0].dropped, 1);
+    EXPECT_EQ(queue.getClassCounters()[1].enqueued, 2);
+}
+
+// =============== Expiry tests ===============
+TEST_F(OutputQueueTest, DequeueLive_CountsExpiredByClass) {
+    for (const auto discipline : {QueueDiscipline::StrictPriority,
+                                  QueueDiscipline::DeficitRoundRobin,
+                                  QueueDiscipline::EarliestDeadline}) {
+        OutputQueue queue(rtr, 0, config(discipline));
+        queue.enqueue(packet(1, SHORT, 10));
+        queue.enqueue(packet(2, LONG, 10));
+        queue.enqueue(packet(3, LONG, 50));
+
+        std::vector<Packet> out;
+        std::vector<Packet> expired;
+        EXPECT_EQ(queue.dequeueLive(5, 20, out, &expired), 2);
+        EXPECT_EQ(out.size(), 1);
+        EXPECT_EQ(expired.size(), 2);
+        EXPECT_EQ(queue.getClassCounters()[0].timedOut, 1);
+        EXPECT_EQ(queue.getClassCounters()[1].timedOut, 1);
+        EXPECT_TRUE(queue.isDrained());
+    }
+}
+
+TEST_F(OutputQueueTest, EagerExpiry_PurgesEveryClass) {
+    for (const auto discipline : {QueueDiscipline::StrictPriority,
+                                  QueueDiscipline::EarliestDeadline}) {
+        OutputQueue queue(rtr, 0, config(discipline));
+        queue.setEagerExpiry(true, 0);
+        queue.enqueue(packet(1, SHORT, 10));
+        queue.enqueue(packet(2, LONG, 30));
+        queue.enqueue(packet(3, LONG, 50));
+
+        EXPECT_EQ(queue.purgeExpired(30), 2);
+        EXPECT_EQ(queue.size(), 1);
+        EXPECT_EQ(queue.getClassCounters()[0].timedOut, 1);
+        EXPECT_EQ(queue.getClassCounters()[1].timedOut, 1);
+
+        // Arrivals already past the last purge are reported on the next one
+        queue.enqueue(packet(4, SHORT, 20));
+        EXPECT_FALSE(queue.isDrained());
+        EXPECT_EQ(queue.purgeExpired(31), 1);
+        EXPECT_EQ(send(queue, 5, 31), (std::vector<size_t>{3}));
+    }
+}
+
+// =============== Queue management tests ===============
+TEST_F(OutputQueueTest, Red_DropsEveryArrivalAboveMaxThreshold) {
+    QueueConfig red{.aqm = {.mode = AqmMode::Red}};
+    red.aqm.weight         = 1;  // The average follows the queue length exactly
+    red.aqm.minThreshold   = 2;
+    red.aqm.maxThreshold   = 6;
+    red.aqm.maxProbability = 0.5;
+    OutputQueue queue(rtr, 0, red);
+
+    for (size_t i = 0; i < 10; i++) {
+        EXPECT_EQ(queue.enqueue(packet(i, SHORT)), i < 6);
+    }
+    EXPECT_EQ(queue.size(), 6);
+    EXPECT_EQ(queue.getClassCounters()[0].aqmDropped, 4);
+    EXPECT_EQ(queue.getClassCounters()[0].dropped, 0);
+}
+
+TEST_F(OutputQueueTest, Red_SpacesDropsEvenly) {
+    QueueConfig red{.aqm = {.mode = AqmMode::Red}};
+    red.aqm.weight         = 1;
+    red.aqm.minThreshold   = 2;
+    red.aqm.maxThreshold   = 10;
+    red.aqm.maxProbability = 0.5;
+    OutputQueue queue(rtr, 0, red);
+    for (size_t i = 0; i < 4; i++) {
+        queue.enqueue(packet(i, SHORT));
+    }
+
+    // At a steady length of 4 each arrival adds 1/8 of a drop
+    size_t drops = 0;
+    for (size_t i = 0; i < 40; i++) {
+        if (queue.enqueue(packet(100 + i, SHORT))) {
+            send(queue, 1);
+        } else {
+            drops++;
+        }
+    }
+    EXPECT_EQ(drops, 5);
+}
+
+TEST_F(OutputQueueTest, CoDel_DropsFromHeadAfterInterval) {
+    QueueConfig codel{.aqm = {.mode = AqmMode::CoDel}};
+    codel.aqm.target   = 2;
+    codel.aqm.interval = 5;
+    OutputQueue queue(rtr, 0, codel);
+    for (size_t i = 0; i < 30; i++) {
+        queue.enqueue(packet(i, SHORT));
+    }
+
+    std::vector<Packet> out;
+    std::vector<Packet> dropped;
+    for (size_t tick = 0; tick < 5; tick++) {
+        queue.dequeueLive(1, tick, out, nullptr, &dropped);
+    }
+    EXPECT_TRUE(dropped.empty());
+
+    queue.dequeueLive(1, 5, out, nullptr, &dropped);
+    ASSERT_EQ(dropped.size(), 1);
+    EXPECT_EQ(dropped[0].getPageID(), 5);
+    EXPECT_EQ(out.back().getPageID(), 6);
+
+    for (size_t tick = 6; tick < 15; tick++) {
+        queue.dequeueLive(1, tick, out, nullptr, &dropped);
+    }
+    const ClassCounters& counter = queue.getClassCounters()[0];
+    EXPECT_EQ(counter.aqmDropped, dropped.size());
+    EXPECT_GT(dropped.size(), 2);
+    EXPECT_EQ(counter.sent, out.size());
+    EXPECT_EQ(out.size() + dropped.size() + queue.size(), 30);
+}
+
+TEST_F(OutputQueueTest, CoDel_KeepsShortQueues) {
+    QueueConfig codel{.aqm = {.mode = AqmMode::CoDel}};
+    codel.aqm.target   = 2;
+    codel.aqm.interval = 5;
+    OutputQueue queue(rtr, 0, codel);
+
+    std::vector<Packet> out;
+    std::vector<Packet> dropped;
+    for (size_t tick = 0; tick < 50; tick++) {
+        queue.enqueue(packet(tick, SHORT, 1000));
+        queue.dequeueLive(1, tick, out, nullptr, &dropped);
+    }
+    EXPECT_EQ(out.size(), 50);
+    EXPECT_TRUE(dropped.empty());
+}
+
+// =============== Checkpoint tests ===============
+TEST_F(OutputQueueTest, Checkpoint_RestoresOrderAndCounters) {
+    for (const auto discipline : {QueueDiscipline::DeficitRoundRobin,
+                                  QueueDiscipline::EarliestDeadline}) {
+        OutputQueue queue(rtr, 0, config(discipline, {}));
+        for (size_t i = 0; i < 4; i++) {
+            queue.enqueue(packet(10 + i, SHORT, TICK + 4 - i));
+            queue.enqueue(packet(20 + i, LONG, TICK + i));
+        }
+        send(queue, 3);
+
+        std::ostringstream out;
+        CheckpointWriter writer(out);
+        queue.saveState(writer);
+        const std::string saved = out.str();
+        const std::vector<unsigned char> bytes(saved.begin(), saved.end());
+        CheckpointReader reader(bytes);
+
+        OutputQueue restored(rtr, 0, config(discipline, {}));
+        restored.restoreState(reader);
+        EXPECT_TRUE(reader.atEnd());
+        EXPECT_EQ(restored.getClassCounters()[0].sent, queue.getClassCounters()[0].sent);
+        EXPECT_EQ(send(restored, 10), send(queue, 10));
+    }
+}
+
+TEST_F(OutputQueueTest, Checkpoint_OtherDisciplineThrows) {
+    OutputQueue queue(rtr, 0, config(QueueDiscipline::StrictPriority));
+    std::ostringstream out;
+    CheckpointWriter writer(out);
+    queue.saveState(writer);
+    const std::string saved = out.str();
+    const std::vector<unsigned char> bytes(saved.begin(), saved.end());
+    CheckpointReader reader(bytes);
+
+    OutputQueue other(rtr, 0, config(QueueDiscipline::EarliestDeadline));
+    EXPECT_THROW(other.restoreState(reader), std::runtime_error);
+}
@@ -9,6 +9,11 @@ protected:
     const IPAddress src{20, 15};
     const IPAddress dst{10, 5};
     static constexpr size_t TICK = 10;
+
+    /** Address part of the string of a packet from src to dst, in the layout of this build */
+    [[nodiscard]] std::string route() const {
+        return "Src: " + src.toString() + " -> Dst: " + dst.toString();
+    }
 };
 
 // =============== Constructors tests ===============
@@ -41,6 +46,28 @@ TEST_F(PacketTest, Constructor_InvalidSrcIP) {
     EXPECT_THROW(Packet(100, 0, 10, invalidSrc, dst, TICK), std::invalid_argument);
 }
 
+TEST_F(PacketTest, Constructor_FieldOverflow) {
+    EXPECT_THROW(Packet(Packet::MAX_PAGE_ID + 1, 0, 10, src, dst, TICK), std::out_of_range);
+    EXPECT_THROW(Packet(100, 0, Packet::MAX_PAGE_LEN + 1, src, dst, TICK), std::out_of_range);
+    EXPECT_THROW(Packet(100, 0, 10, src, dst, Packet::MAX_TIMEOUT + 1), std::out_of_range);
+}
+
+TEST_F(PacketTest, Constructor_FieldLimits) {
+    const Packet packet(Packet::MAX_PAGE_ID, Packet::MAX_PAGE_LEN - 1, Packet::MAX_PAGE_LEN, src,
+                        dst, Packet::MAX_TIMEOUT);
+
+    EXPECT_EQ(packet.getPageID(), Packet::MAX_PAGE_ID);
+    EXPECT_EQ(packet.getPagePos(), Packet::MAX_PAGE_LEN - 1);
+    EXPECT_EQ(packet.getPageLen(), Packet::MAX_PAGE_LEN);
+    EXPECT_EQ(packet.getTimeout(), Packet::MAX_TIMEOUT);
+    EXPECT_TRUE(packet.isLastPacket());
+}
+
+TEST_F(PacketTest, Layout_Packed) {
+    EXPECT_EQ(sizeof(Packet), 12 + 2 * sizeof(IPAddress));
+    EXPECT_TRUE(std::is_trivially_copyable_v<Packet>);
+}
+
 TEST_F(PacketTest, Constructor_Copy) {
     const Packet p1(100, 5, 10, src, dst, TICK);
     const Packet p2(p1);
@@ -118,19 +145,19 @@ TEST_F(PacketTest, Query_IsLastPacket) {
 TEST_F(PacketTest, ToString_Basic) {
     const Packet packet(123, 4, 10, src, dst, TICK);
 
-    EXPECT_EQ(packet.toString(), "Src: 020.015 -> Dst: 010.005 | ID: 000123-4/10");
+    EXPECT_EQ(packet.toString(), route() + " | ID: 000123-4/10");
 }
 
 TEST_F(PacketTest, ToString_LargePageID) {
     const Packet packet(654321, 99, 100, src, dst, TICK);
 
-    EXPECT_EQ(packet.toString(), "Src: 020.015 -> Dst: 010.005 | ID: 654321-99/100");
+    EXPECT_EQ(packet.toString(), route() + " | ID: 654321-99/100");
 }
 
 TEST_F(PacketTest, ToString_SmallPageID) {
     const Packet packet(7, 0, 5, src, dst, TICK);
 
-    EXPECT_EQ(packet.toString(), "Src: 020.015 -> Dst: 010.005 | ID: 000007-0/5");
+    EXPECT_EQ(packet.toString(), route() + " | ID: 000007-0/5");
 }
 
 TEST_F(PacketTest, StreamOperator_Basic) {
@@ -140,7 +167,7 @@ TEST_F(PacketTest, StreamOperator_Basic) {
     std::ostringstream oss;
     oss << packet;
 
-    EXPECT_EQ(oss.str(), "Src: 020.015 -> Dst: 010.005 | ID: 000999-5/10");
+    EXPECT_EQ(oss.str(), route() + " | ID: 000999-5/10");
 }
 
 TEST_F(PacketTest, StreamOperator_Multiple) {
@@ -150,9 +177,7 @@ TEST_F(PacketTest, StreamOperator_Multiple) {
     std::ostringstream oss;
     oss << p1 << " | " << p2;
 
-    EXPECT_EQ(oss.str(),
-              "Src: 020.015 -> Dst: 010.005 | ID: 000010-0/5 | Src: 020.015 -> Dst: 010.005 | ID: "
-              "000020-1/5");
+    EXPECT_EQ(oss.str(), route() + " | ID: 000010-0/5 | " + route() + " | ID: 000020-1/5");
 }
 
 // =============== Comparison tests ===============
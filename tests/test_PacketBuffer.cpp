@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <limits>
+#include <sstream>
+#include "core/Checkpoint.h"
 #include "core/PacketBuffer.h"
 #include "core/Page.h"
 
@@ -140,6 +143,17 @@ TEST_F(PacketBufferTest, Setter_Capacity) {
     EXPECT_EQ(buffer.getCapacity(), 10);
 }
 
+TEST_F(PacketBufferTest, Setter_CapacityBackToUnlimited) {
+    buffer.setCapacity(1);
+    buffer.enqueue(Packet(100, 0, 2, src, dst, TICK));
+    EXPECT_TRUE(buffer.isFull());
+
+    buffer.setCapacity(0);
+    EXPECT_FALSE(buffer.isFull());
+    EXPECT_EQ(buffer.availableSpace(), std::numeric_limits<int>::max());
+    EXPECT_TRUE(buffer.enqueue(Packet(100, 1, 2, src, dst, TICK)));
+}
+
 TEST_F(PacketBufferTest, Setter_DstIP) {
     buffer.setDstIP(rtr);
     EXPECT_EQ(buffer.getDstIP(), rtr);
@@ -235,3 +249,273 @@ TEST_F(PacketBufferTest, BufferOverflow) {
     EXPECT_EQ(packetsAccepted, 6);
     EXPECT_EQ(packetsRejected, 4);
 }
+
+// =============== Ring storage tests ===============
+TEST_F(PacketBufferTest, TryDequeue) {
+    Packet out(1, 0, 1, src, dst, TICK);
+    EXPECT_FALSE(buffer.tryDequeue(out));
+    EXPECT_EQ(out.getPageID(), 1);
+
+    buffer.enqueue(Packet(100, 0, 2, src, dst, TICK));
+    buffer.enqueue(Packet(100, 1, 2, src, dst, TICK));
+
+    EXPECT_TRUE(buffer.tryDequeue(out));
+    EXPECT_EQ(out.getPageID(), 100);
+    EXPECT_EQ(out.getPagePos(), 0);
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST_F(PacketBufferTest, BoundedBuffer_FifoAcrossWrapAround) {
+    PacketBuffer bounded(4);
+
+    for (size_t round = 0; round < 5; ++round) {
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_TRUE(bounded.enqueue(Packet(round, i, 3, src, dst, TICK)));
+        }
+        for (size_t i = 0; i < 3; ++i) {
+            const Packet out = bounded.dequeue();
+            EXPECT_EQ(out.getPageID(), round);
+            EXPECT_EQ(out.getPagePos(), i);
+        }
+    }
+    EXPECT_TRUE(bounded.isEmpty());
+}
+
+TEST_F(PacketBufferTest, RemoveAt_PreservesOrder) {
+    for (size_t i = 0; i < 5; ++i) {
+        buffer.enqueue(Packet(100, i, 5, src, dst, TICK));
+    }
+
+    buffer.removeAt(3);
+    buffer.removeAt(0);
+
+    EXPECT_EQ(buffer.dequeue().getPagePos(), 1);
+    EXPECT_EQ(buffer.dequeue().getPagePos(), 2);
+    EXPECT_EQ(buffer.dequeue().getPagePos(), 4);
+    EXPECT_THROW(buffer.removeAt(0), std::out_of_range);
+}
+
+TEST_F(PacketBufferTest, CopyIsIndependent) {
+    buffer.enqueue(Packet(100, 0, 2, src, dst, TICK));
+    PacketBuffer copy(buffer);
+
+    (void)buffer.dequeue();
+
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(copy.size(), 1);
+    EXPECT_TRUE(copy.contains(100, 0));
+}
+
+// =============== Batch tests ===============
+TEST_F(PacketBufferTest, EnqueueBatch_AcceptsPrefixUpToCapacity) {
+    PacketBuffer bounded{3};
+    bounded.enqueue(Packet(1, 0, 1, src, dst, TICK));
+    const std::vector<Packet> batch = {Packet(2, 0, 1, src, dst, TICK),
+                                       Packet(3, 0, 1, src, dst, TICK),
+                                       Packet(4, 0, 1, src, dst, TICK)};
+
+    EXPECT_EQ(bounded.enqueueBatch(batch), 2);
+
+    EXPECT_TRUE(bounded.isFull());
+    EXPECT_TRUE(bounded.contains(3, 0));
+    EXPECT_FALSE(bounded.contains(4, 0));
+}
+
+TEST_F(PacketBufferTest, DequeueBatch_AppendsInFifoOrder) {
+    for (uint32_t id = 1; id <= 4; ++id) {
+        buffer.enqueue(Packet(id, 0, 1, src, dst, TICK));
+    }
+    std::vector<Packet> out = {Packet(9, 0, 1, src, dst, TICK)};
+
+    EXPECT_EQ(buffer.dequeueBatch(3, out), 3);
+    EXPECT_EQ(buffer.dequeueBatch(5, out), 1);
+
+    ASSERT_EQ(out.size(), 5);
+    for (uint32_t i = 1; i < 5; ++i) {
+        EXPECT_EQ(out[i].getPageID(), i);
+    }
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+TEST_F(PacketBufferTest, DequeueLive_SkipsExpiredWithoutCountingThem) {
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(3, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(4, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(5, 0, 1, src, dst, TICK));
+    std::vector<Packet> out;
+
+    EXPECT_EQ(buffer.dequeueLive(2, 10, out), 2);
+
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].getPageID(), 2);
+    EXPECT_EQ(out[1].getPageID(), 4);
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST_F(PacketBufferTest, DequeueLive_HandsExpiredPacketsToSink) {
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(3, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(4, 0, 1, src, dst, TICK));
+    std::vector<Packet> out;
+    std::vector<Packet> expired;
+
+    EXPECT_EQ(buffer.dequeueLive(2, 10, out, &expired), 2);
+
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].getPageID(), 2);
+    EXPECT_EQ(out[1].getPageID(), 4);
+    ASSERT_EQ(expired.size(), 2);
+    EXPECT_EQ(expired[0].getPageID(), 1);
+    EXPECT_EQ(expired[1].getPageID(), 3);
+}
+
+TEST_F(PacketBufferTest, DequeueBatch_EagerExpirySkipsRetiredPackets) {
+    buffer.setEagerExpiry(true);
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(3, 0, 1, src, dst, TICK));
+    buffer.purgeExpired(5);
+    std::vector<Packet> out;
+
+    EXPECT_EQ(buffer.dequeueBatch(2, out), 2);
+
+    ASSERT_EQ(out.size(), 2);
+    EXPECT_EQ(out[0].getPageID(), 2);
+    EXPECT_EQ(out[1].getPageID(), 3);
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(buffer.purgeExpired(TICK), 0);
+}
+
+// =============== Eager expiry tests ===============
+TEST_F(PacketBufferTest, EagerExpiry_DisabledByDefault) {
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+
+    EXPECT_FALSE(buffer.hasEagerExpiry());
+    EXPECT_EQ(buffer.purgeExpired(10), 0);
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST_F(PacketBufferTest, EagerExpiry_PurgeFreesCapacity) {
+    PacketBuffer bounded{3};
+    bounded.setEagerExpiry(true);
+    bounded.enqueue(Packet(1, 0, 1, src, dst, 5));
+    bounded.enqueue(Packet(2, 0, 1, src, dst, TICK));
+    bounded.enqueue(Packet(3, 0, 1, src, dst, 5));
+    ASSERT_TRUE(bounded.isFull());
+
+    EXPECT_EQ(bounded.purgeExpired(5), 2);
+
+    EXPECT_EQ(bounded.size(), 1);
+    EXPECT_EQ(bounded.availableSpace(), 2);
+    EXPECT_TRUE(bounded.enqueue(Packet(4, 0, 1, src, dst, TICK)));
+    EXPECT_FALSE(bounded.contains(1, 0));
+    EXPECT_EQ(bounded.dequeue().getPageID(), 2);
+    EXPECT_EQ(bounded.dequeue().getPageID(), 4);
+    EXPECT_TRUE(bounded.isEmpty());
+}
+
+TEST_F(PacketBufferTest, EagerExpiry_ExpiredOnEntryReportedOnNextPurge) {
+    buffer.setEagerExpiry(true);
+    buffer.purgeExpired(10);
+
+    EXPECT_TRUE(buffer.enqueue(Packet(1, 0, 1, src, dst, 8)));
+
+    EXPECT_TRUE(buffer.isEmpty());
+    EXPECT_EQ(buffer.purgeExpired(11), 1);
+    EXPECT_EQ(buffer.purgeExpired(12), 0);
+}
+
+TEST_F(PacketBufferTest, EagerExpiry_EnableRetiresStoredExpiredPackets) {
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, TICK));
+
+    buffer.setEagerExpiry(true, 10);
+
+    EXPECT_EQ(buffer.size(), 1);
+    EXPECT_EQ(buffer.purgeExpired(10), 1);
+    EXPECT_EQ(buffer.dequeue().getPageID(), 2);
+}
+
+TEST_F(PacketBufferTest, EagerExpiry_RemoveAtSkipsRetiredPackets) {
+    buffer.setEagerExpiry(true);
+    buffer.enqueue(Packet(1, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(3, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(4, 0, 1, src, dst, TICK));
+    buffer.purgeExpired(5);
+
+    buffer.removeAt(1);
+
+    ASSERT_EQ(buffer.size(), 2);
+    EXPECT_EQ(buffer.dequeue().getPageID(), 1);
+    EXPECT_EQ(buffer.dequeue().getPageID(), 4);
+    EXPECT_EQ(buffer.purgeExpired(TICK), 0);
+}
+
+TEST_F(PacketBufferTest, EagerExpiry_DisableDiscardsRetiredPackets) {
+    buffer.setEagerExpiry(true);
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, TICK));
+    buffer.purgeExpired(5);
+
+    buffer.setEagerExpiry(false);
+
+    EXPECT_FALSE(buffer.hasEagerExpiry());
+    ASSERT_EQ(buffer.size(), 1);
+    EXPECT_EQ(buffer.dequeue().getPageID(), 2);
+}
+
+TEST_F(PacketBufferTest, EagerExpiry_ClearForgetsTimeouts) {
+    buffer.setEagerExpiry(true);
+    buffer.enqueue(Packet(1, 0, 1, src, dst, 5));
+    buffer.clear();
+
+    EXPECT_EQ(buffer.purgeExpired(TICK), 0);
+    EXPECT_TRUE(buffer.isEmpty());
+}
+
+// =============== Checkpoint tests ===============
+TEST_F(PacketBufferTest, Checkpoint_RestoresLivePacketsInOrder) {
+    buffer.setEagerExpiry(true);
+    buffer.enqueue(Packet(1, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, 5));
+    buffer.enqueue(Packet(3, 0, 1, src, dst, TICK));
+    buffer.purgeExpired(5);
+    buffer.enqueue(Packet(4, 0, 1, src, dst, 4));
+
+    std::ostringstream out;
+    CheckpointWriter writer(out);
+    buffer.saveState(writer);
+    const std::string saved = out.str();
+    const std::vector<unsigned char> bytes(saved.begin(), saved.end());
+
+    PacketBuffer restored{4};
+    restored.setEagerExpiry(true);
+    restored.enqueue(Packet(9, 0, 1, src, dst, TICK));
+    CheckpointReader reader(bytes);
+    restored.restoreState(reader);
+
+    EXPECT_TRUE(reader.atEnd());
+    ASSERT_EQ(restored.size(), 2);
+    EXPECT_EQ(restored.getCapacity(), 4);
+    EXPECT_EQ(restored.purgeExpired(6), 1);  // The packet refused on entry
+    EXPECT_EQ(restored.dequeue().getPageID(), 1);
+    EXPECT_EQ(restored.dequeue().getPageID(), 3);
+}
+
+TEST_F(PacketBufferTest, Checkpoint_OverCapacityThrows) {
+    buffer.enqueue(Packet(1, 0, 1, src, dst, TICK));
+    buffer.enqueue(Packet(2, 0, 1, src, dst, TICK));
+
+    std::ostringstream out;
+    CheckpointWriter writer(out);
+    buffer.saveState(writer);
+    const std::string saved = out.str();
+    const std::vector<unsigned char> bytes(saved.begin(), saved.end());
+
+    PacketBuffer bounded{1};
+    CheckpointReader reader(bytes);
+    EXPECT_THROW(bounded.restoreState(reader), std::runtime_error);
+}
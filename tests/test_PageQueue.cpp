@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "core/Checkpoint.h"
+#include "core/PacketBuffer.h"
+#include "core/PageQueue.h"
+
+class PageQueueTest : public testing::Test {
+protected:
+    const IPAddress src{20, 15};
+    const IPAddress dst{10, 5};
+    static constexpr size_t TICK = 100;
+    PageQueue queue{};
+    std::vector<Packet> out;
+};
+
+// =============== Constructors tests ===============
+TEST_F(PageQueueTest, Constructor_Default) {
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_TRUE(queue.isDrained());
+    EXPECT_EQ(queue.size(), 0);
+    EXPECT_EQ(queue.getPageCount(), 0);
+    EXPECT_EQ(queue.getCapacity(), 0);  // Unlimited
+}
+
+// =============== Queue operation tests ===============
+TEST_F(PageQueueTest, Enqueue_CountsPacketsNotPages) {
+    EXPECT_TRUE(queue.enqueue(Page(1, 40, src, dst), TICK));
+    EXPECT_TRUE(queue.enqueue(Page(2, 3, src, dst), TICK));
+
+    EXPECT_EQ(queue.size(), 43);
+    EXPECT_EQ(queue.getPageCount(), 2);
+}
+
+TEST_F(PageQueueTest, Enqueue_AllOrNothing) {
+    PageQueue bounded{10};
+    EXPECT_TRUE(bounded.enqueue(Page(1, 6, src, dst), TICK));
+    EXPECT_FALSE(bounded.enqueue(Page(2, 5, src, dst), TICK));
+    EXPECT_EQ(bounded.size(), 6);
+    EXPECT_EQ(bounded.availableSpace(), 4);
+
+    EXPECT_TRUE(bounded.enqueue(Page(3, 4, src, dst), TICK));
+    EXPECT_EQ(bounded.availableSpace(), 0);
+}
+
+TEST_F(PageQueueTest, Enqueue_PageOutOfPackedRangeThrows) {
+    EXPECT_THROW(queue.enqueue(Page(1, 2, src, dst), Packet::MAX_TIMEOUT + 1), std::out_of_range);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST_F(PageQueueTest, DequeueLive_FragmentsLikeToPackets) {
+    const Page first(1, 5, src, dst);
+    const Page second(2, 3, src, dst);
+    queue.enqueue(first, TICK);
+    queue.enqueue(second, TICK);
+
+    // Bandwidth smaller than a page: fragments span several drains and cross page boundaries
+    while (!queue.isEmpty()) {
+        queue.dequeueLive(3, 0, out);
+    }
+
+    std::vector<Packet> expected;
+    for (const Page* page : {&first, &second}) {
+        for (const Packet& packet : page->toPackets(TICK)) {
+            expected.push_back(packet);
+        }
+    }
+    ASSERT_EQ(out.size(), expected.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        EXPECT_EQ(out[i].getPageID(), expected[i].getPageID());
+        EXPECT_EQ(out[i].getPagePos(), expected[i].getPagePos());
+        EXPECT_EQ(out[i].getPageLen(), expected[i].getPageLen());
+        EXPECT_EQ(out[i].getTimeout(), expected[i].getTimeout());
+    }
+    EXPECT_EQ(queue.getPageCount(), 0);
+}
+
+TEST_F(PageQueueTest, DequeueLive_DiscardsRestOfExpiredPage) {
+    queue.enqueue(Page(1, 6, src, dst), 10);
+    queue.enqueue(Page(2, 2, src, dst), TICK);
+    queue.dequeueLive(2, 5, out);
+
+    std::vector<Packet> expired;
+    EXPECT_EQ(queue.dequeueLive(5, 10, out, &expired), 4);
+    ASSERT_EQ(expired.size(), 4);
+    EXPECT_EQ(expired.front().getPagePos(), 2);
+    EXPECT_EQ(out.size(), 4);
+    EXPECT_EQ(out.back().getPageID(), 2);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+// =============== Eager expiry tests ===============
+TEST_F(PageQueueTest, PurgeExpired_DropsWholePages) {
+    queue.setEagerExpiry(true);
+    queue.enqueue(Page(1, 4, src, dst), 10);
+    queue.enqueue(Page(2, 3, src, dst), TICK);
+    queue.enqueue(Page(3, 2, src, dst), 12);
+    queue.dequeueLive(1, 0, out);
+
+    EXPECT_EQ(queue.purgeExpired(12), 5);
+    EXPECT_EQ(queue.size(), 3);
+    EXPECT_EQ(queue.getPageCount(), 1);
+    EXPECT_EQ(queue.purgeExpired(20), 0);
+}
+
+TEST_F(PageQueueTest, PurgeExpired_ReportsExpiredOnEntry) {
+    queue.setEagerExpiry(true, 50);
+    EXPECT_TRUE(queue.enqueue(Page(1, 3, src, dst), 40));
+
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.isDrained());
+    EXPECT_EQ(queue.purgeExpired(51), 3);
+    EXPECT_TRUE(queue.isDrained());
+}
+
+TEST_F(PageQueueTest, EagerExpiry_MatchesPacketBuffer) {
+    PacketBuffer buffer;
+    buffer.setEagerExpiry(true);
+    queue.setEagerExpiry(true);
+    std::vector<Packet> bufferOut;
+
+    for (size_t tick = 1; tick <= 60; tick++) {
+        const Page page(tick, tick % 7 + 1, src, dst);
+        const size_t timeout = tick + (tick * 13) % 11;
+        for (const Packet& packet : page.toPackets(timeout)) {
+            buffer.enqueue(packet);
+        }
+        queue.enqueue(page, timeout);
+
+        EXPECT_EQ(queue.purgeExpired(tick), buffer.purgeExpired(tick));
+        EXPECT_EQ(queue.dequeueLive(2, tick, out), buffer.dequeueLive(2, tick, bufferOut));
+        EXPECT_EQ(queue.size(), buffer.size());
+    }
+    EXPECT_EQ(out.size(), bufferOut.size());
+}
+
+// =============== Checkpoint tests ===============
+TEST_F(PageQueueTest, SaveRestore_KeepsPartialPages) {
+    queue.enqueue(Page(1, 5, src, dst), TICK);
+    queue.enqueue(Page(2, 2, src, dst), TICK);
+    queue.dequeueLive(3, 0, out);
+
+    std::ostringstream saved;
+    CheckpointWriter writer(saved);
+    queue.saveState(writer);
+    const std::string contents = saved.str();
+    const std::vector<unsigned char> bytes(contents.begin(), contents.end());
+
+    CheckpointReader reader(bytes);
+    PageQueue restored{10};
+    restored.restoreState(reader);
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(restored.size(), 4);
+
+    std::vector<Packet> rest;
+    restored.dequeueLive(10, 0, rest);
+    ASSERT_EQ(rest.size(), 4);
+    EXPECT_EQ(rest.front().getPageID(), 1);
+    EXPECT_EQ(rest.front().getPagePos(), 3);
+    EXPECT_EQ(rest.back().getPageID(), 2);
+}
+
+TEST_F(PageQueueTest, Restore_OverCapacityThrows) {
+    queue.enqueue(Page(1, 8, src, dst), TICK);
+    std::ostringstream saved;
+    CheckpointWriter writer(saved);
+    queue.saveState(writer);
+    const std::string contents = saved.str();
+    const std::vector<unsigned char> bytes(contents.begin(), contents.end());
+
+    CheckpointReader reader(bytes);
+    PageQueue small{4};
+    EXPECT_THROW(small.restoreState(reader), std::runtime_error);
+}
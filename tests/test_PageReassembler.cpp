@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+#include "core/Checkpoint.h"
 #include "core/Page.h"
 #include "core/PageReassembler.h"
 
@@ -323,3 +326,146 @@ TEST_F(TestPageReassembler, Integration_Page) {
     EXPECT_EQ(reconstructedPage.getSrcIP(), src);
     EXPECT_EQ(reconstructedPage.getDstIP(), dst);
 }
+
+// =============== Fragment storage tests ===============
+TEST_F(TestPageReassembler, AddPacket_DifferentDestination) {
+    EXPECT_TRUE(reassembler.addPacket(Packet(100, 0, 10, src, dst, TICK)));
+
+    EXPECT_FALSE(reassembler.addPacket(Packet(100, 1, 10, src, IPAddress(10, 6), TICK)));
+    EXPECT_EQ(reassembler.getReceivedPackets(), 1);
+}
+
+TEST_F(TestPageReassembler, Package_PreservesFragmentTimeouts) {
+    for (int i = 0; i < 10; ++i) {
+        reassembler.addPacket(Packet(100, i, 10, src, dst, TICK + i));
+    }
+
+    List<Packet> packetList = reassembler.package();
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(packetList[i].getTimeout(), TICK + i);
+    }
+}
+
+TEST_F(TestPageReassembler, LongPageSpansSeveralBitmapWords) {
+    constexpr size_t LEN = 200;
+    PageReassembler longPR(7, src, LEN, TICK);
+
+    for (size_t i = 0; i < LEN; i += 2) {
+        EXPECT_TRUE(longPR.addPacket(Packet(7, i, LEN, src, dst, TICK)));
+    }
+    EXPECT_TRUE(longPR.hasPacketAt(64));
+    EXPECT_FALSE(longPR.hasPacketAt(65));
+    EXPECT_FALSE(longPR.addPacket(Packet(7, 128, LEN, src, dst, TICK)));
+
+    for (size_t i = 1; i < LEN; i += 2) {
+        EXPECT_TRUE(longPR.addPacket(Packet(7, i, LEN, src, dst, TICK)));
+    }
+
+    EXPECT_TRUE(longPR.isComplete());
+    List<Packet> packetList = longPR.package();
+    EXPECT_EQ(packetList.size(), LEN);
+    EXPECT_EQ(packetList[LEN - 1].getPagePos(), LEN - 1);
+}
+
+TEST_F(TestPageReassembler, Finish_Complete) {
+    for (int i = 0; i < 10; ++i) {
+        reassembler.addPacket(Packet(100, i, 10, src, dst, TICK));
+    }
+
+    EXPECT_EQ(reassembler.finish(), 10);
+    EXPECT_EQ(reassembler.getReceivedPackets(), 0);
+    EXPECT_FALSE(reassembler.hasPacketAt(0));
+}
+
+TEST_F(TestPageReassembler, Finish_Incomplete) {
+    reassembler.addPacket(Packet(100, 0, 10, src, dst, TICK));
+
+    EXPECT_THROW((void)reassembler.finish(), std::runtime_error);
+}
+
+TEST_F(TestPageReassembler, Pool_ReusesReleasedBlocks) {
+    ReassemblyPool pool(16);
+    {
+        PageReassembler first(1, src, 16, TICK, &pool);
+        first.addPacket(Packet(1, 3, 16, src, dst, TICK));
+        PageReassembler second(2, src, 4, TICK, &pool);
+        EXPECT_EQ(pool.getFreeBlocks(), 0);
+    }
+    EXPECT_EQ(pool.getFreeBlocks(), 2);
+
+    const PageReassembler reused(3, src, 16, TICK, &pool);
+
+    EXPECT_EQ(pool.getFreeBlocks(), 1);
+    EXPECT_FALSE(reused.hasPacketAt(3));
+}
+
+TEST_F(TestPageReassembler, Pool_OversizedPagesAreNotPooled) {
+    ReassemblyPool pool(8);
+    {
+        const PageReassembler oversized(1, src, 9, TICK, &pool);
+    }
+
+    EXPECT_EQ(pool.getFreeBlocks(), 0);
+}
+
+TEST_F(TestPageReassembler, Pool_ResizeDropsOldBlocks) {
+    ReassemblyPool pool(8);
+    {
+        const PageReassembler pr(1, src, 8, TICK, &pool);
+    }
+    ASSERT_EQ(pool.getFreeBlocks(), 1);
+
+    pool.setBlockFragments(32);
+
+    EXPECT_EQ(pool.getBlockFragments(), 32);
+    EXPECT_EQ(pool.getFreeBlocks(), 0);
+}
+
+TEST_F(TestPageReassembler, Pool_MoveKeepsFragments) {
+    ReassemblyPool pool(10);
+    PageReassembler pooled(100, src, 10, TICK, &pool);
+    pooled.addPacket(Packet(100, 9, 10, src, dst, TICK));
+
+    std::vector<PageReassembler> active;
+    active.push_back(std::move(pooled));
+
+    EXPECT_TRUE(active[0].hasPacketAt(9));
+    active.clear();
+    EXPECT_EQ(pool.getFreeBlocks(), 1);
+}
+
+// =============== Checkpoint tests ===============
+TEST_F(TestPageReassembler, Checkpoint_RestoresFragments) {
+    ReassemblyPool pool(10);
+    reassembler.addPacket(Packet(100, 3, 10, src, dst, 40));
+    reassembler.addPacket(Packet(100, 7, 10, src, dst, 41));
+
+    std::ostringstream out;
+    CheckpointWriter writer(out);
+    reassembler.saveState(writer);
+    const std::string saved = out.str();
+    const std::vector<unsigned char> bytes(saved.begin(), saved.end());
+
+    CheckpointReader reader(bytes);
+    PageReassembler restored = PageReassembler::restoreState(reader, &pool);
+
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(restored.getPageID(), 100);
+    EXPECT_EQ(restored.getSrcIP(), src);
+    EXPECT_EQ(restored.getTimeout(), TICK);
+    EXPECT_EQ(restored.getReceivedPackets(), 2);
+    EXPECT_TRUE(restored.hasPacketAt(3));
+    EXPECT_TRUE(restored.hasPacketAt(7));
+    EXPECT_FALSE(restored.hasPacketAt(4));
+    EXPECT_FALSE(restored.addPacket(Packet(100, 5, 10, src, IPAddress{10, 6}, 42)));
+
+    for (size_t pos = 0; pos < 10; ++pos) {
+        if (pos != 3 && pos != 7) {
+            restored.addPacket(Packet(100, pos, 10, src, dst, 50));
+        }
+    }
+    const List<Packet> page = restored.package();
+    EXPECT_EQ(page.getAt(3).getTimeout(), 40);
+    EXPECT_EQ(page.getAt(7).getTimeout(), 41);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "core/Network.h"
+#include "core/Profiler.h"
+
+class ProfilerTest : public testing::Test {
+protected:
+    void SetUp() override { Profiler::reset(); }
+    void TearDown() override { Profiler::reset(); }
+};
+
+// =============== Histogram tests ===============
+TEST_F(ProfilerTest, EndTick_MovesTickTotalsIntoHistograms) {
+    Profiler::record(Profiler::Phase::Routing, 100);
+    Profiler::record(Profiler::Phase::Routing, 200);
+    Profiler::endTick();
+    Profiler::endTick();
+
+    const Profiler::Histogram& h = Profiler::histogram(Profiler::Phase::Routing);
+    EXPECT_EQ(h.ticks, 2);
+    EXPECT_EQ(h.totalNanos, 300);
+    EXPECT_EQ(h.maxNanos, 300);
+    EXPECT_EQ(h.buckets[0], 1);  // The idle tick
+    EXPECT_EQ(h.buckets[8], 1);  // 300 ns falls in [256, 512)
+    EXPECT_DOUBLE_EQ(h.meanNanos(), 150.0);
+    EXPECT_EQ(Profiler::histogram(Profiler::Phase::Reassembly).totalNanos, 0);
+}
+
+TEST_F(ProfilerTest, Percentile_ReturnsBucketUpperBound) {
+    Profiler::Histogram h;
+    EXPECT_EQ(h.percentile(0.5), 0);
+
+    for (int i = 0; i < 99; ++i) {
+        h.add(1000);  // [512, 1024)
+    }
+    h.add(100000);
+
+    EXPECT_EQ(h.percentile(0.5), 1023);
+    EXPECT_EQ(h.percentile(0.98), 1023);
+    EXPECT_EQ(h.percentile(1.0), 100000);
+}
+
+TEST_F(ProfilerTest, ScopedPhaseTimer_RecordsItsLifetime) {
+    {
+        const ScopedPhaseTimer timer(Profiler::Phase::RouterInput);
+    }
+    Profiler::endTick();
+
+    EXPECT_EQ(Profiler::histogram(Profiler::Phase::RouterInput).ticks, 1);
+    EXPECT_STREQ(Profiler::phaseName(Profiler::Phase::RouterInput), "Router input");
+}
+
+TEST_F(ProfilerTest, EndTick_MergesEveryThread) {
+    std::vector<std::thread> threads;
+    for (uint64_t t = 1; t <= 4; ++t) {
+        threads.emplace_back([t] { Profiler::record(Profiler::Phase::RouterInput, 100 * t); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    Profiler::record(Profiler::Phase::RouterInput, 24);
+    Profiler::endTick();
+
+    // The workers exited before the tick was closed, and their time is still counted
+    const Profiler::Histogram& h = Profiler::histogram(Profiler::Phase::RouterInput);
+    EXPECT_EQ(h.ticks, 1);
+    EXPECT_EQ(h.totalNanos, 1024);
+}
+
+TEST_F(ProfilerTest, EndTicks_ChargesClosedTicksToTheirOwnSample) {
+    std::thread worker([] {
+        Profiler::record(Profiler::Phase::RouterOutput, 10);
+        Profiler::closeThreadTick(0);
+        Profiler::record(Profiler::Phase::RouterOutput, 30);
+        Profiler::closeThreadTick(2);
+    });
+    worker.join();
+    Profiler::record(Profiler::Phase::RouterOutput, 5);
+    Profiler::closeThreadTick(1);
+    Profiler::record(Profiler::Phase::Routing, 700);  // After the run, as a route recompute
+    Profiler::endTicks(3);
+
+    const Profiler::Histogram& output = Profiler::histogram(Profiler::Phase::RouterOutput);
+    EXPECT_EQ(output.ticks, 3);
+    EXPECT_EQ(output.totalNanos, 45);
+    EXPECT_EQ(output.maxNanos, 30);
+    EXPECT_EQ(output.buckets[2], 1);  // 5 ns
+    EXPECT_EQ(output.buckets[3], 1);  // 10 ns
+    EXPECT_EQ(output.buckets[4], 1);  // 30 ns
+
+    const Profiler::Histogram& routing = Profiler::histogram(Profiler::Phase::Routing);
+    EXPECT_EQ(routing.ticks, 3);
+    EXPECT_EQ(routing.maxNanos, 700);
+    EXPECT_EQ(routing.buckets[0], 2);
+}
+
+// =============== Network tests ===============
+TEST_F(ProfilerTest, Network_RecordsEveryTickWhenEnabled) {
+    Network net{Network::Config{.routerCount = 6, .maxTerminalCount = 3, .complexity = 2,
+                                .trafficProbability = 0.5f, .maxPageLen = 5, .seed = 3}};
+    Profiler::reset();
+    net.simulate(20);
+
+    const Profiler::Histogram& routing = Profiler::histogram(Profiler::Phase::Routing);
+    if (!Profiler::ENABLED) {
+        EXPECT_EQ(routing.ticks, 0);
+        return;
+    }
+    EXPECT_EQ(routing.ticks, 20);
+    EXPECT_GT(routing.totalNanos, 0);
+    EXPECT_GT(Profiler::histogram(Profiler::Phase::RouterTerminals).totalNanos, 0);
+}
+
+TEST_F(ProfilerTest, Network_PipelinedRunRecordsEveryTick) {
+    Network::Config cfg{.routerCount = 12, .maxTerminalCount = 3, .complexity = 2,
+                        .trafficProbability = 0.5f, .maxPageLen = 5, .tickThreads = 2, .seed = 3};
+    cfg.partitions = 2;
+    cfg.pipelined  = true;
+    Network net{cfg};
+    Profiler::reset();
+    net.simulate(12);
+
+    const Profiler::Histogram& output = Profiler::histogram(Profiler::Phase::RouterOutput);
+    EXPECT_EQ(output.ticks, Profiler::ENABLED ? 12 : 0);
+}
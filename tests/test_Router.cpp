@@ -160,6 +160,24 @@ TEST_F(RouterTest, ProcessInputBuffer_ToNeighborBuffer) {
     EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 1);
 }
 
+TEST_F(RouterTest, ProcessInputBuffer_RoutesInstalledBeforeLinkUp) {
+    RoutingTable rt;
+    rt.setNextHopIP(rtr2.getIP(), rtr2.getIP());
+    rt.setNextHopIP(rtr3.getIP(), rtr2.getIP());
+    rtr1.setRoutingTable(std::move(rt));
+
+    // Both routes point at a neighbor that is not connected yet, so they resolve once it is
+    rtr1.receivePacket(Packet{100, 0, 5, IPAddress{5, 1}, IPAddress{15, 1}, TICK});
+    rtr1.processInputBuffer(1);
+    EXPECT_EQ(rtr1.getPacketsDropped(), 1);
+
+    rtr1.connectRouter(&rtr2);
+    rtr1.receivePacket(Packet{100, 1, 5, IPAddress{5, 1}, IPAddress{15, 1}, TICK});
+    rtr1.processInputBuffer(1);
+    EXPECT_EQ(rtr1.getPacketsDropped(), 1);
+    EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 1);
+}
+
 TEST_F(RouterTest, ProcessInputBuffer_NoRoute) {
     const IPAddress src{5, 1};
     const IPAddress dst{99, 1};
@@ -252,6 +270,240 @@ TEST_F(RouterTest, ProcessOutputBuffers_ExpiredPacket) {
     EXPECT_EQ(rtr2.getPacketsReceived(), 0);
 }
 
+TEST_F(RouterTest, ProcessOutputBuffers_StrictPriorityServesShortPagesFirst) {
+    connectAndRoute();
+    rtr1.setOutBufferBW(2);
+    rtr1.setOutputQueue(
+        QueueConfig{.discipline = QueueDiscipline::StrictPriority, .classLimits = {4}});
+
+    for (size_t i = 0; i < 3; ++i) {
+        rtr1.receivePacket(Packet{100, i, 10, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    }
+    rtr1.receivePacket(Packet{200, 0, 2, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.receivePacket(Packet{200, 1, 2, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.processInputBuffer(1);
+    rtr1.processOutputBuffers(1);
+
+    const std::vector<ClassCounters> counters = rtr1.getClassCounters();
+    ASSERT_EQ(counters.size(), 2);
+    EXPECT_EQ(counters[0].sent, 2);
+    EXPECT_EQ(counters[1].sent, 0);
+    EXPECT_EQ(counters[1].enqueued, 3);
+    EXPECT_EQ(rtr2.getPacketsReceived(), 2);
+}
+
+TEST_F(RouterTest, SetOutputQueue_WithQueuedPacketsThrows) {
+    connectAndRoute();
+    rtr1.receivePacket(Packet{100, 0, 5, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.processInputBuffer(1);
+
+    EXPECT_THROW(rtr1.setOutputQueue(QueueConfig{.discipline = QueueDiscipline::EarliestDeadline}),
+                 std::invalid_argument);
+    EXPECT_EQ(rtr1.getOutputQueue().discipline, QueueDiscipline::Fifo);
+}
+
+// =============== Multipath tests ===============
+TEST_F(RouterTest, Multipath_KeepsEachPageOnOnePath) {
+    connectAndRoute();
+    const IPAddress far{20, 0};
+    RoutingTable rt;
+    rt.addNextHopIP(far, rtr2.getIP());
+    rt.addNextHopIP(far, rtr3.getIP());
+    rtr1.setRoutingTable(std::move(rt));
+    rtr1.setInProcCap(200);
+
+    constexpr size_t PAGE_LEN = 3;
+    const IPAddress src{5, 1};
+    const IPAddress dst{20, 1};
+    for (size_t pos = 0; pos < PAGE_LEN; ++pos) {
+        for (size_t page = 0; page < 40; ++page) {
+            rtr1.receivePacket(Packet{page, pos, PAGE_LEN, src, dst, TICK});
+        }
+    }
+    rtr1.processInputBuffer(1);
+
+    // Pages spread over both links, but never split across them
+    const size_t viaR2 = rtr1.getNeighborBufferUsage(rtr2.getIP());
+    const size_t viaR3 = rtr1.getNeighborBufferUsage(rtr3.getIP());
+    EXPECT_EQ(viaR2 + viaR3, 40 * PAGE_LEN);
+    EXPECT_GT(viaR2, 0);
+    EXPECT_GT(viaR3, 0);
+    EXPECT_EQ(viaR2 % PAGE_LEN, 0);
+}
+
+TEST_F(RouterTest, Multipath_SkipsUnconnectedNextHops) {
+    rtr1.connectRouter(&rtr2);
+    const IPAddress far{20, 0};
+    RoutingTable rt;
+    rt.addNextHopIP(far, rtr3.getIP());
+    rt.addNextHopIP(far, rtr2.getIP());
+    rtr1.setRoutingTable(std::move(rt));
+
+    for (size_t page = 0; page < 10; ++page) {
+        rtr1.receivePacket(Packet{page, 0, 1, IPAddress{5, 1}, IPAddress{20, 1}, TICK});
+    }
+    rtr1.processInputBuffer(1);
+
+    EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 10);
+    EXPECT_EQ(rtr1.getPacketsDropped(), 0);
+}
+
+// =============== Early drop tests ===============
+TEST_F(RouterTest, EarlyDrop_DropsRestOfDoomedPage) {
+    const Router::Config cfg{0, Router::DEF_INPUT_PROC, 0, Router::DEF_LOC_BW, 1,
+                             Router::DEF_OUTPUT_BW};
+    Router router{IPAddress{5, 0}, 0, cfg};
+    router.connectRouter(&rtr2);
+    RoutingTable rt;
+    rt.setNextHopIP(rtr2.getIP(), rtr2.getIP());
+    router.setRoutingTable(std::move(rt));
+    router.setDoomedPageFilter(1024);
+
+    const IPAddress src{15, 1};
+    for (size_t i = 0; i < 3; ++i) {
+        router.receivePacket(Packet{100, i, 3, src, IPAddress{10, 1}, TICK});
+    }
+    router.receivePacket(Packet{200, 0, 2, src, IPAddress{10, 1}, TICK});
+    router.processInputBuffer(1);
+
+    // The first packet fills the link, the second dooms page 100 and the third is dropped early
+    EXPECT_EQ(router.getNeighborBufferUsage(rtr2.getIP()), 1);
+    EXPECT_EQ(router.getPacketsDropped(), 3);
+    EXPECT_EQ(router.getPacketsDoomed(), 1);
+    const std::vector<uint64_t> notices(router.getDropNotices().begin(),
+                                        router.getDropNotices().end());
+    EXPECT_EQ(notices, (std::vector<uint64_t>{Terminal::makePageKey(src, 100),
+                                              Terminal::makePageKey(src, 200)}));
+
+    router.clearDropNotices();
+    EXPECT_TRUE(router.getDropNotices().empty());
+}
+
+TEST_F(RouterTest, EarlyDrop_DisabledByDefault) {
+    const IPAddress src{15, 1};
+    for (size_t i = 0; i < 3; ++i) {
+        rtr1.receivePacket(Packet{100, i, 3, src, IPAddress{99, 1}, TICK});
+    }
+    rtr1.processInputBuffer(1);
+
+    EXPECT_EQ(rtr1.getDoomedFilterBits(), 0);
+    EXPECT_EQ(rtr1.getPacketsDropped(), 3);
+    EXPECT_EQ(rtr1.getPacketsDoomed(), 0);
+    EXPECT_TRUE(rtr1.getDropNotices().empty());
+}
+
+TEST_F(RouterTest, MarkPageDoomed_DropsLocalPageOnArrival) {
+    connectAndRoute();
+    rtr1.setDoomedPageFilter(1024);
+    const IPAddress src{5, 1};
+    rtr1.markPageDoomed(Terminal::makePageKey(src, 7));
+
+    rtr1.receivePacket(Packet{7, 1, 4, src, IPAddress{10, 1}, TICK});
+    rtr1.receivePacket(Packet{8, 0, 4, src, IPAddress{10, 1}, TICK});
+    rtr1.processInputBuffer(1);
+
+    EXPECT_EQ(rtr1.getPacketsDoomed(), 1);
+    EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 1);
+    EXPECT_TRUE(rtr1.getDropNotices().empty());
+}
+
+// =============== Two-phase tick tests ===============
+TEST_F(RouterTest, StageOutputBuffers_DefersDelivery) {
+    connectAndRoute();
+    rtr2.connectRouter(&rtr1);
+
+    rtr1.receivePacket(Packet{100, 0, 5, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.receivePacket(Packet{200, 0, 5, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.processInputBuffer(1);
+    const size_t staged = rtr1.stageOutputBuffers(1);
+
+    EXPECT_EQ(staged, 2);
+    EXPECT_EQ(rtr1.getPacketsForwarded(), 2);
+    EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 0);
+    EXPECT_EQ(rtr2.getPacketsReceived(), 0);
+
+    EXPECT_EQ(rtr2.collectInbound(), 2);
+    EXPECT_EQ(rtr2.getPacketsReceived(), 2);
+    EXPECT_EQ(rtr2.getPacketsInPending(), 2);
+
+    // The outbox was emptied by the receiver
+    EXPECT_EQ(rtr2.collectInbound(), 0);
+}
+
+TEST_F(RouterTest, StageOutputBuffers_BandwidthAndTimeout) {
+    const Router::Config cfg{0, Router::DEF_INPUT_PROC, 0, Router::DEF_LOC_BW, 0, 2};
+    Router router{IPAddress{5, 0}, 0, cfg};
+    router.connectRouter(&rtr2);
+    rtr2.connectRouter(&router);
+    RoutingTable rt;
+    rt.setNextHopIP(rtr2.getIP(), rtr2.getIP());
+    router.setRoutingTable(std::move(rt));
+
+    router.receivePacket(Packet{100, 0, 10, IPAddress{5, 1}, IPAddress{10, 1}, 5});
+    for (size_t i = 1; i < 5; ++i) {
+        router.receivePacket(Packet{100, i, 10, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    }
+    router.processInputBuffer(1);
+
+    EXPECT_EQ(router.stageOutputBuffers(10), 2);
+    EXPECT_EQ(router.getPacketsTimedOut(), 1);
+    EXPECT_EQ(router.getNeighborBufferUsage(rtr2.getIP()), 2);
+    EXPECT_EQ(rtr2.collectInbound(), 2);
+}
+
+TEST_F(RouterTest, ProcessOutputBuffers_StagedLinkWaitsForCollect) {
+    connectAndRoute();
+    rtr2.connectRouter(&rtr1);
+    rtr3.connectRouter(&rtr1);
+    rtr1.setLinkStaged(rtr2.getIP(), true);
+
+    rtr1.receivePacket(Packet{100, 0, 5, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.receivePacket(Packet{200, 0, 5, IPAddress{5, 1}, IPAddress{15, 1}, TICK});
+    rtr1.processInputBuffer(1);
+
+    EXPECT_EQ(rtr1.processOutputBuffers(1), 2);
+    EXPECT_TRUE(rtr1.isLinkStaged(rtr2.getIP()));
+    EXPECT_FALSE(rtr1.isLinkStaged(rtr3.getIP()));
+    EXPECT_EQ(rtr2.getPacketsReceived(), 0);
+    EXPECT_EQ(rtr3.getPacketsReceived(), 1);
+
+    EXPECT_EQ(rtr2.collectInbound(), 1);
+    EXPECT_EQ(rtr3.collectInbound(), 0);
+    EXPECT_EQ(rtr1.getPacketsForwarded(), 2);
+}
+
+TEST_F(RouterTest, SetLinkStaged_NotConnectedThrows) {
+    EXPECT_THROW(rtr1.setLinkStaged(rtr2.getIP(), true), std::invalid_argument);
+    EXPECT_FALSE(rtr1.isLinkStaged(rtr2.getIP()));
+}
+
+TEST_F(RouterTest, CollectInbound_OneWayLink) {
+    connectAndRoute();  // rtr2 is not connected back to rtr1
+
+    rtr1.receivePacket(Packet{100, 0, 5, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.processInputBuffer(1);
+    rtr1.stageOutputBuffers(1);
+
+    EXPECT_EQ(rtr2.collectInbound(), 0);
+    EXPECT_EQ(rtr2.getPacketsReceived(), 0);
+}
+
+TEST_F(RouterTest, TickCompute_FullCycle) {
+    rtr1.connectTerminal(std::make_unique<Terminal>(&rtr1, 10));
+    connectAndRoute();
+    rtr2.connectRouter(&rtr1);
+
+    rtr1.receivePacket(Packet{100, 0, 2, IPAddress{5, 1}, IPAddress{5, 10}, TICK});
+    rtr1.receivePacket(Packet{200, 0, 2, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+
+    rtr1.tickCompute(1);
+    rtr1.tickCompute(1);
+    rtr2.collectInbound();
+
+    EXPECT_EQ(rtr2.getPacketsReceived(), 1);
+    EXPECT_EQ(rtr1.getTerminal(IPAddress{5, 10})->getPacketsReceived(), 1);
+}
+
 // =============== Local buffer processing tests ===============
 TEST_F(RouterTest, ProcessLocalBuffer_Valid) {
     rtr1.connectTerminal(std::make_unique<Terminal>(&rtr1, 10));
@@ -343,6 +595,88 @@ TEST_F(RouterTest, Tick_TerminalsAreTicked) {
     EXPECT_GT(rtr1.getPacketsReceived(), 0);
 }
 
+TEST_F(RouterTest, ReceivePackets_DropsOverflowOnce) {
+    Router bounded{IPAddress{20, 0}, 0, Router::Config{2, 10, 0, 10, 0, 5}};
+    const std::vector<Packet> batch = {Packet{1, 0, 1, IPAddress{5, 1}, IPAddress{20, 1}, TICK},
+                                       Packet{2, 0, 1, IPAddress{5, 1}, IPAddress{20, 1}, TICK},
+                                       Packet{3, 0, 1, IPAddress{5, 1}, IPAddress{20, 1}, TICK}};
+
+    EXPECT_EQ(bounded.receivePackets(batch), 2);
+
+    EXPECT_EQ(bounded.getPacketsReceived(), 3);
+    EXPECT_EQ(bounded.getPacketsDropped(), 1);
+    EXPECT_EQ(bounded.getPacketsInPending(), 2);
+}
+
+TEST_F(RouterTest, ProcessOutputBuffers_ExpiredPacketsDoNotUseBandwidth) {
+    connectAndRoute();
+    rtr1.setOutBufferBW(2);
+    rtr1.receivePacket(Packet{1, 0, 1, IPAddress{5, 1}, IPAddress{10, 1}, 3});
+    rtr1.receivePacket(Packet{2, 0, 1, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.receivePacket(Packet{3, 0, 1, IPAddress{5, 1}, IPAddress{10, 1}, 3});
+    rtr1.receivePacket(Packet{4, 0, 1, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.receivePacket(Packet{5, 0, 1, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+    rtr1.processInputBuffer(1);
+
+    EXPECT_EQ(rtr1.processOutputBuffers(5), 2);
+
+    EXPECT_EQ(rtr1.getPacketsTimedOut(), 2);
+    EXPECT_EQ(rtr1.getPacketsForwarded(), 2);
+    EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 1);
+    EXPECT_EQ(rtr2.getPacketsReceived(), 2);
+}
+
+TEST_F(RouterTest, Tick_EagerExpiryPurgesBeforeProcessing) {
+    rtr1.setEagerExpiry(true);
+    rtr1.setInProcCap(1);
+    connectAndRoute();
+
+    rtr1.receivePacket(Packet{100, 0, 2, IPAddress{5, 1}, IPAddress{10, 1}, 3});
+    rtr1.receivePacket(Packet{200, 0, 2, IPAddress{5, 1}, IPAddress{10, 1}, TICK});
+
+    rtr1.tick(5);
+
+    // The expired packet is purged without using the single processing slot of the tick
+    EXPECT_EQ(rtr1.getPacketsTimedOut(), 1);
+    EXPECT_EQ(rtr1.getNeighborBufferUsage(rtr2.getIP()), 1);
+}
+
+TEST_F(RouterTest, SetEagerExpiry_ReachesTerminalsAndNewLinks) {
+    rtr1.setEagerExpiry(true);
+    auto t       = std::make_unique<Terminal>(&rtr1, 10);
+    Terminal* t1 = t.get();
+    rtr1.connectTerminal(std::move(t));
+    connectAndRoute();
+
+    t1->sendPage(2, IPAddress{10, 1}, 3);
+    rtr1.tick(5);
+
+    EXPECT_TRUE(rtr1.hasEagerExpiry());
+    EXPECT_EQ(t1->getPacketsOutTimedOut(), 2);
+    EXPECT_EQ(rtr1.getPacketsReceived(), 0);
+}
+
+TEST_F(RouterTest, NextActivityTick_FollowsBuffersAndTerminals) {
+    connectAndRoute();
+    auto t       = std::make_unique<Terminal>(&rtr1, 10);
+    Terminal* t1 = t.get();
+    rtr1.connectTerminal(std::move(t));
+
+    EXPECT_EQ(rtr1.nextActivityTick(3), Terminal::NO_ACTIVITY);
+
+    rtr1.receivePacket(Packet{1, 0, 2, IPAddress{10, 1}, IPAddress{5, 10}, TICK});
+    EXPECT_TRUE(rtr1.hasPendingInput());
+    EXPECT_EQ(rtr1.nextActivityTick(3), 4);
+
+    rtr1.tick(4);
+    rtr1.tick(5);
+
+    // The packet waits in a reassembler that expires after MAX_ASSEMBLER_TTL
+    EXPECT_EQ(t1->getPacketsInPending(), 1);
+    EXPECT_FALSE(rtr1.hasPendingInput());
+    EXPECT_EQ(rtr1.nextActivityTick(5), 5 + MAX_ASSEMBLER_TTL);
+}
+
 // =============== Configuration tests ===============
 TEST_F(RouterTest, SetInProcCap) {
     rtr1.setInProcCap(25);
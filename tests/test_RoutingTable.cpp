@@ -24,3 +24,98 @@ TEST(RoutingTableTest, UpdateExistingEntry) {
     rt.setNextHopIP(IPAddress{1, 0}, IPAddress{3, 0});
     EXPECT_EQ(rt.size(), 1);
 }
+
+TEST(RoutingTableTest, GetMissingEntry) {
+    const RoutingTable rt(8);
+    EXPECT_EQ(rt.size(), 0);
+    EXPECT_FALSE(rt.hasRoute(IPAddress{3, 0}));
+    EXPECT_FALSE(rt.getNextHopIP(IPAddress{3, 0}).isValid());
+    EXPECT_FALSE(rt.getNextHopIP(IPAddress{200, 0}).isValid());
+}
+
+TEST(RoutingTableTest, LookupUsesRouterID) {
+    RoutingTable rt;
+    rt.setNextHopIP(IPAddress{5, 0}, IPAddress{2, 0});
+
+    EXPECT_TRUE(rt.hasRoute(IPAddress{5, 7}));
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{5, 7}), IPAddress(2, 0));
+}
+
+TEST(RoutingTableTest, NextHopToRouterZero) {
+    RoutingTable rt;
+    rt.setNextHopIP(IPAddress{4, 0}, IPAddress{0, 0});
+
+    EXPECT_TRUE(rt.hasRoute(IPAddress{4, 0}));
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{4, 0}), IPAddress(0, 0));
+}
+
+TEST(RoutingTableTest, HighestRouterID) {
+    RoutingTable rt;
+    rt.setNextHopIP(IPAddress{255, 0}, IPAddress{1, 0});
+
+    EXPECT_EQ(rt.size(), 1);
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{255, 1}), IPAddress(1, 0));
+}
+
+TEST(RoutingTableTest, Clear) {
+    RoutingTable rt;
+    rt.setNextHopIP(IPAddress{1, 0}, IPAddress{2, 0});
+    rt.setNextHopIP(IPAddress{3, 0}, IPAddress{4, 0});
+
+    rt.clear();
+
+    EXPECT_EQ(rt.size(), 0);
+    EXPECT_FALSE(rt.hasRoute(IPAddress{1, 0}));
+
+    rt.setNextHopIP(IPAddress{1, 0}, IPAddress{4, 0});
+    EXPECT_EQ(rt.size(), 1);
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{1, 0}), IPAddress(4, 0));
+}
+
+TEST(RoutingTableTest, AddNextHopKeepsPathsInOrder) {
+    RoutingTable rt;
+    EXPECT_TRUE(rt.addNextHopIP(IPAddress{1, 0}, IPAddress{2, 0}));
+    EXPECT_TRUE(rt.addNextHopIP(IPAddress{1, 0}, IPAddress{3, 0}));
+    EXPECT_FALSE(rt.addNextHopIP(IPAddress{1, 0}, IPAddress{2, 0}));
+    EXPECT_FALSE(rt.addNextHopIP(IPAddress{1, 0}, IPAddress{3, 0}));
+
+    EXPECT_TRUE(rt.isMultipath());
+    EXPECT_EQ(rt.size(), 1);
+    EXPECT_EQ(rt.getPathCount(IPAddress{1, 0}), 2);
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{1, 0}), IPAddress(2, 0));
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{1, 0}, 1), IPAddress(3, 0));
+    EXPECT_FALSE(rt.getNextHopIP(IPAddress{1, 0}, 2).isValid());
+}
+
+TEST(RoutingTableTest, AddNextHopStopsAtMaxPaths) {
+    RoutingTable rt;
+    for (uint8_t hop = 1; hop <= RoutingTable::MAX_PATHS; hop++) {
+        EXPECT_TRUE(rt.addNextHopIP(IPAddress{9, 0}, IPAddress{hop, 0}));
+    }
+    EXPECT_FALSE(rt.addNextHopIP(IPAddress{9, 0}, IPAddress{100, 0}));
+    EXPECT_EQ(rt.getPathCount(IPAddress{9, 0}), RoutingTable::MAX_PATHS);
+}
+
+TEST(RoutingTableTest, ClearDropsAlternatePaths) {
+    RoutingTable rt;
+    rt.addNextHopIP(IPAddress{1, 0}, IPAddress{2, 0});
+    rt.addNextHopIP(IPAddress{1, 0}, IPAddress{3, 0});
+
+    rt.clear();
+
+    EXPECT_FALSE(rt.isMultipath());
+    rt.addNextHopIP(IPAddress{1, 0}, IPAddress{4, 0});
+    EXPECT_EQ(rt.getPathCount(IPAddress{1, 0}), 1);
+    EXPECT_FALSE(rt.getNextHopIP(IPAddress{1, 0}, 1).isValid());
+}
+
+TEST(RoutingTableTest, SetNextHopDropsOtherPaths) {
+    RoutingTable rt;
+    rt.addNextHopIP(IPAddress{1, 0}, IPAddress{2, 0});
+    rt.addNextHopIP(IPAddress{1, 0}, IPAddress{3, 0});
+
+    rt.setNextHopIP(IPAddress{1, 0}, IPAddress{4, 0});
+    EXPECT_EQ(rt.getPathCount(IPAddress{1, 0}), 1);
+    EXPECT_EQ(rt.getNextHopIP(IPAddress{1, 0}), IPAddress(4, 0));
+    EXPECT_EQ(rt.getPathCount(IPAddress{2, 0}), 0);
+}
@@ -270,6 +270,34 @@ TEST_F(TerminalTest, SetInternalProc) {
     EXPECT_EQ(trm.getInternalProc(), 20);
 }
 
+// =============== Traffic generation tests ===============
+TEST_F(TerminalTest, GenerateTraffic_UsesAddressBook) {
+    const std::vector<IPAddress> book{IPAddress{7, 1}};
+    Xoshiro256 gen(1);
+    trm.setAddressBook(&book);
+    trm.setRandomGenerator(&gen);
+    trm.setTrafficProbability(1.0f);
+    trm.setMaxPageLength(4);
+
+    trm.generateTraffic(1);
+
+    EXPECT_EQ(trm.getPagesCreated(), 1);
+    EXPECT_GE(trm.getPacketsGenerated(), 2);
+    EXPECT_LE(trm.getPacketsGenerated(), 4);
+}
+
+TEST_F(TerminalTest, GenerateTraffic_EmptyAddressBook) {
+    const std::vector<IPAddress> book;
+    Xoshiro256 gen(1);
+    trm.setAddressBook(&book);
+    trm.setRandomGenerator(&gen);
+    trm.setTrafficProbability(1.0f);
+
+    trm.generateTraffic(1);
+
+    EXPECT_EQ(trm.getPagesCreated(), 0);
+}
+
 // =============== Utilities tests ===============
 TEST_F(TerminalTest, ToString) {
     const std::string str = trm.toString();
@@ -289,6 +317,33 @@ TEST_F(TerminalTest, TickProcessesBothBuffers) {
     EXPECT_EQ(trm.getPagesCompleted(), 1);
 }
 
+TEST_F(TerminalTest, ReceivePackets_BuffersBatchUpToCapacity) {
+    Terminal bounded(&rtr, TERMINAL_ID + 1, Terminal::Config{2, 10, 0, 4});
+    const IPAddress boundedIP = bounded.getTerminalIP();
+    const std::vector<Packet> batch = {Packet(200, 0, 3, src, boundedIP, TICK),
+                                       Packet(200, 1, 3, src, boundedIP, TICK),
+                                       Packet(200, 2, 3, src, boundedIP, TICK)};
+
+    EXPECT_EQ(bounded.receivePackets(batch), 2);
+
+    EXPECT_EQ(bounded.getPacketsReceived(), 3);
+    EXPECT_EQ(bounded.getPacketsInDropped(), 1);
+    EXPECT_EQ(bounded.getPacketsInPending(), 2);
+}
+
+TEST_F(TerminalTest, ReceivePackets_RejectsQuarantinedPages) {
+    trm.receivePacket(Packet(500, 0, 10, src, dst, TICK));
+    trm.processInputBuffer(1);
+    trm.tick(TICK + MAX_ASSEMBLER_TTL + 1);
+
+    const std::vector<Packet> batch = {Packet(500, 1, 10, src, dst, TICK * 10),
+                                       Packet(600, 0, 1, src, dst, TICK * 10)};
+
+    EXPECT_EQ(trm.receivePackets(batch), 1);
+    EXPECT_EQ(trm.getPacketsInTimedOut(), 2);
+    EXPECT_EQ(trm.getPacketsInPending(), 1);
+}
+
 TEST_F(TerminalTest, ReassemblerTimeout_SetsQuarantine) {
     trm.receivePacket(Packet(500, 0, 10, src, dst, TICK));
     trm.processInputBuffer(1);
@@ -315,7 +370,120 @@ TEST_F(TerminalTest, QuarantineExpires_AcceptsPacketAgain) {
     EXPECT_TRUE(accepted);
 }
 
+TEST_F(TerminalTest, Quarantine_IsKeyedBySource) {
+    trm.receivePacket(Packet(500, 0, 10, src, dst, TICK));
+    trm.processInputBuffer(1);
+
+    trm.tick(TICK + MAX_ASSEMBLER_TTL + 1);
+
+    const IPAddress otherSrc{11, 20};
+    EXPECT_TRUE(trm.receivePacket(Packet(500, 1, 10, otherSrc, dst, TICK * 10)));
+    EXPECT_FALSE(trm.receivePacket(Packet(500, 1, 10, src, dst, TICK * 10)));
+}
+
+TEST_F(TerminalTest, ReassemblersOfManyPagesExpireIndependently) {
+    for (size_t page = 0; page < 300; ++page) {
+        trm.receivePacket(Packet(page, 0, 2, src, dst, TICK * 10));
+    }
+    trm.setInternalProc(300);
+    trm.processInputBuffer(1);
+
+    for (size_t page = 0; page < 300; page += 2) {
+        trm.receivePacket(Packet(page, 1, 2, src, dst, TICK * 10));
+    }
+    trm.processInputBuffer(2);
+    EXPECT_EQ(trm.getPagesCompleted(), 150);
+    EXPECT_EQ(trm.getPacketsInPending(), 150);
+
+    trm.tick(1 + MAX_ASSEMBLER_TTL);
+
+    EXPECT_EQ(trm.getPagesTimedOut(), 150);
+    EXPECT_EQ(trm.getPacketsInPending(), 0);
+    EXPECT_FALSE(trm.receivePacket(Packet(1, 1, 2, src, dst, TICK * 10)));
+    EXPECT_TRUE(trm.receivePacket(Packet(0, 1, 2, src, dst, TICK * 10)));
+}
+
 // =============== Complex scenario ===============
+// =============== Scheduled traffic tests ===============
+TEST_F(TerminalTest, NextActivityTick_FollowsBuffersAndTimers) {
+    EXPECT_EQ(trm.nextActivityTick(1), Terminal::NO_ACTIVITY);
+
+    trm.receivePacket(Packet(500, 0, 2, src, dst, TICK));
+    EXPECT_EQ(trm.nextActivityTick(1), 2);
+
+    trm.tick(2);
+    EXPECT_EQ(trm.nextActivityTick(2), 2 + MAX_ASSEMBLER_TTL);
+
+    trm.tick(2 + MAX_ASSEMBLER_TTL);
+    EXPECT_EQ(trm.getPagesTimedOut(), 1);
+    EXPECT_EQ(trm.nextActivityTick(2 + MAX_ASSEMBLER_TTL), 2 + MAX_ASSEMBLER_TTL + PACKET_TTL);
+}
+
+TEST_F(TerminalTest, ScheduledTraffic_GeneratesOnlyAtEventTicks) {
+    const std::vector<IPAddress> book = {src};
+    Xoshiro256 gen(3);
+    trm.setAddressBook(&book);
+    trm.setRandomGenerator(&gen);
+    trm.setMaxPageLength(4);
+    trm.setTrafficProbability(0.25f);
+
+    // Before the first tick the schedule has not been drawn yet
+    EXPECT_EQ(trm.nextActivityTick(0), 1);
+    trm.tick(1);
+    trm.processOutputBuffer(1);
+    trm.processOutputBuffer(1);
+
+    size_t tick  = 1;
+    size_t pages = trm.getPagesCreated();
+    for (int i = 0; i < 5; ++i) {
+        const size_t next = trm.nextActivityTick(tick);
+        ASSERT_GT(next, tick);
+        // Nothing happens on the ticks in between
+        if (next > tick + 1) {
+            trm.tick(next - 1);
+            EXPECT_EQ(trm.getPagesCreated(), pages);
+        }
+        trm.tick(next);
+        EXPECT_EQ(trm.getPagesCreated(), ++pages);
+
+        // Drain the page so the next activity is the next traffic event
+        trm.processOutputBuffer(next);
+        trm.processOutputBuffer(next);
+        tick = next;
+    }
+}
+
+TEST_F(TerminalTest, ScheduledTraffic_ZeroProbabilityNeverActs) {
+    const std::vector<IPAddress> book = {src};
+    Xoshiro256 gen(3);
+    trm.setAddressBook(&book);
+    trm.setRandomGenerator(&gen);
+    trm.setTrafficProbability(0.0f);
+    trm.tick(1);
+
+    EXPECT_EQ(trm.nextActivityTick(1), Terminal::NO_ACTIVITY);
+}
+
+TEST_F(TerminalTest, TrafficModel_TraceEmitsAtRecordedTicks) {
+    const std::vector<IPAddress> book = {src};
+    Xoshiro256 gen(3);
+    trm.setAddressBook(&book);
+    trm.setRandomGenerator(&gen);
+    trm.setMaxPageLength(4);
+    trm.setTrafficModel(std::make_unique<TraceTraffic>(std::vector<size_t>{3, 3, 7}));
+
+    trm.tick(1);
+    EXPECT_EQ(trm.nextActivityTick(1), 3);
+    trm.tick(3);
+    EXPECT_EQ(trm.getPagesCreated(), 2);
+    trm.tick(7);
+    EXPECT_EQ(trm.getPagesCreated(), 3);
+
+    trm.setTrafficModel(nullptr);
+    trm.tick(8);
+    EXPECT_EQ(trm.getPagesCreated(), 3);
+}
+
 TEST_F(TerminalTest, ComplexScenario_SendAndReceive) {
     trm.sendPage(5, dst, TICK);
     trm.sendPage(5, dst, TICK);
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "core/ThreadPool.h"
+
+// =============== Construction tests ===============
+TEST(ThreadPoolTest, ThreadCount) {
+    const ThreadPool serial(1);
+    const ThreadPool four(4);
+    const ThreadPool hardware(0);
+
+    EXPECT_EQ(serial.threadCount(), 1);
+    EXPECT_EQ(four.threadCount(), 4);
+    EXPECT_GE(hardware.threadCount(), 1);
+}
+
+// =============== parallelFor tests ===============
+TEST(ThreadPoolTest, ParallelFor_VisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+
+    pool.parallelFor(hits.size(), [&](size_t i) { hits[i]++; });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelFor_ZeroIterations) {
+    ThreadPool pool(4);
+    bool called = false;
+
+    pool.parallelFor(0, [&](size_t) { called = true; });
+
+    EXPECT_FALSE(called);
+}
+
+TEST(ThreadPoolTest, ParallelFor_Reusable) {
+    ThreadPool pool(3);
+    std::vector<size_t> out(64);
+
+    for (size_t round = 1; round <= 20; ++round) {
+        pool.parallelFor(out.size(), [&](size_t i) { out[i] = i * round; });
+
+        EXPECT_EQ(std::accumulate(out.begin(), out.end(), size_t{0}), 2016 * round);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelFor_SerialPool) {
+    ThreadPool pool(1);
+    std::vector<size_t> order;
+
+    pool.parallelFor(5, [&](size_t i) { order.push_back(i); });
+
+    EXPECT_EQ(order, (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(ThreadPoolTest, ParallelFor_RethrowsException) {
+    ThreadPool pool(4);
+
+    EXPECT_THROW(pool.parallelFor(100,
+                                  [](size_t i) {
+                                      if (i == 42) {
+                                          throw std::runtime_error("boom");
+                                      }
+                                  }),
+                 std::runtime_error);
+
+    // The pool stays usable after a failed loop
+    std::atomic<size_t> sum{0};
+    pool.parallelFor(10, [&](size_t i) { sum += i; });
+    EXPECT_EQ(sum.load(), 45);
+}
+
+TEST(ThreadPoolTest, ParallelFor_UnevenWorkIsStolen) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(257);
+    std::atomic<size_t> slowDone{0};
+
+    // The first quarter of the range is far slower than the rest
+    pool.parallelFor(hits.size(), [&](size_t i) {
+        if (i < hits.size() / 4) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            slowDone++;
+        }
+        hits[i]++;
+    });
+
+    EXPECT_EQ(slowDone.load(), hits.size() / 4);
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelFor_FewerIterationsThanThreads) {
+    ThreadPool pool(8);
+    std::vector<std::atomic<int>> hits(3);
+
+    pool.parallelFor(hits.size(), [&](size_t i) { hits[i]++; });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "core/Network.h"
+#include "core/TopologyFile.h"
+
+// =============== Fixture ===============
+class TopologyFileTest : public testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override {
+        const auto* info   = testing::UnitTest::GetInstance()->current_test_info();
+        const auto tempDir = std::filesystem::temp_directory_path();
+        path = (tempDir / (std::string("routersim_") + info->name() + ".topo")).string();
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    /** Three routers on a line, 0 - 1 - 2, stored in reverse order */
+    static TopologyData line() {
+        constexpr uint32_t NONE = TopologyFileHeader::NO_ROUTE;
+
+        TopologyData topology;
+        topology.seed           = 77;
+        topology.terminalCounts = {2, 1, 3};
+        topology.order          = {2, 1, 0};
+        topology.neighborStarts = {0, 1, 3, 4};
+        topology.neighbors      = {1, 0, 2, 1};
+        topology.nextHops       = {NONE, 1, 1, 0, NONE, 2, 1, 1, NONE};
+        return topology;
+    }
+
+    static void expectSameStats(const NetworkStats& a, const NetworkStats& b) {
+        EXPECT_EQ(a.totalRouters, b.totalRouters);
+        EXPECT_EQ(a.totalTerminals, b.totalTerminals);
+        EXPECT_EQ(a.packetsGenerated, b.packetsGenerated);
+        EXPECT_EQ(a.packetsDelivered, b.packetsDelivered);
+        EXPECT_EQ(a.packetsDropped, b.packetsDropped);
+        EXPECT_EQ(a.packetsTimedOut, b.packetsTimedOut);
+        EXPECT_EQ(a.pagesCompleted, b.pagesCompleted);
+    }
+};
+
+// =============== File tests ===============
+TEST_F(TopologyFileTest, RoundTripsEveryArray) {
+    const TopologyData topology = line();
+    TopologyFile::write(path, topology);
+
+    const TopologyFile file(path);
+    EXPECT_EQ(file.getSeed(), 77);
+    ASSERT_EQ(file.getRouterCount(), 3);
+    EXPECT_EQ(std::vector<uint32_t>(file.terminalCounts().begin(), file.terminalCounts().end()),
+              topology.terminalCounts);
+    EXPECT_EQ(std::vector<uint32_t>(file.order().begin(), file.order().end()), topology.order);
+    EXPECT_EQ(file.neighbors(0).size(), 1);
+    EXPECT_EQ(file.neighbors(1).size(), 2);
+    EXPECT_EQ(file.neighbors(1)[1], 2);
+    EXPECT_EQ(file.nextHops(0)[2], 1);
+    EXPECT_EQ(file.nextHops(2)[2], TopologyFileHeader::NO_ROUTE);
+}
+
+TEST_F(TopologyFileTest, WriteRejectsMismatchedArrays) {
+    TopologyData topology = line();
+    topology.nextHops.pop_back();
+
+    EXPECT_THROW(TopologyFile::write(path, topology), std::invalid_argument);
+}
+
+TEST_F(TopologyFileTest, RejectsFilesThatAreNotTopologies) {
+    std::ofstream(path) << "not a topology file, but long enough for a header";
+
+    EXPECT_THROW(TopologyFile{path}, std::runtime_error);
+    EXPECT_THROW(TopologyFile{path + ".missing"}, std::runtime_error);
+}
+
+TEST_F(TopologyFileTest, RejectsTruncatedFiles) {
+    TopologyFile::write(path, line());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+    EXPECT_THROW(TopologyFile{path}, std::runtime_error);
+}
+
+TEST_F(TopologyFileTest, RejectsMoreRoutersThanTheLayoutHolds) {
+    TopologyFile::write(path, line());
+    const uint32_t routerCount = uint32_t{IPAddress::MAX_ROUTER_ID} + 2;
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offsetof(TopologyFileHeader, routerCount));
+    file.write(reinterpret_cast<const char*>(&routerCount), sizeof(routerCount));
+    file.close();
+
+    EXPECT_THROW(TopologyFile{path}, std::runtime_error);
+}
+
+// =============== Network tests ===============
+TEST_F(TopologyFileTest, Network_LoadsRoutersLinksAndRoutes) {
+    TopologyFile::write(path, line());
+    Network::Config c{};
+    c.topologyPath = path;
+    const Network n{c};
+
+    const auto& routers = n.getRouters();
+    ASSERT_EQ(routers.size(), 3);
+    EXPECT_EQ(n.getSeed(), 77);
+    EXPECT_EQ(routers[0]->getIP(), IPAddress{uint8_t{2}});
+    EXPECT_EQ(routers[0]->getTerminalCount(), 3);
+    EXPECT_EQ(routers[2]->getTerminalCount(), 2);
+    EXPECT_EQ(routers[1]->getRouterCount(), 2);
+    EXPECT_EQ(routers[2]->getRoutingTable().getNextHopIP(IPAddress{uint8_t{2}}),
+              IPAddress{uint8_t{1}});
+    EXPECT_EQ(n.getStats().totalTerminals, 6);
+}
+
+TEST_F(TopologyFileTest, Network_LoadedNetworkRunsLikeTheSavedOne) {
+    Network::Config c{.routerCount = 30, .maxTerminalCount = 4, .complexity = 3,
+                      .trafficProbability = 0.5f, .maxPageLen = 6, .seed = 4321};
+    c.layout = Network::Layout::ReverseCuthillMcKee;
+    Network generated{c};
+    generated.saveTopology(path);
+
+    Network::Config traffic{};
+    traffic.trafficProbability = 0.5f;
+    traffic.maxPageLen         = 6;
+    traffic.topologyPath       = path;
+    Network loaded{traffic};
+
+    ASSERT_EQ(loaded.getRouters().size(), generated.getRouters().size());
+    for (size_t i = 0; i < generated.getRouters().size(); ++i) {
+        const Router* a = generated.getRouters()[i];
+        const Router* b = loaded.getRouters()[i];
+        EXPECT_EQ(a->getIP(), b->getIP());
+        const List<IPAddress> neighborsA = a->getNeighborIPs();
+        const List<IPAddress> neighborsB = b->getNeighborIPs();
+        EXPECT_TRUE(std::equal(neighborsA.begin(), neighborsA.end(), neighborsB.begin(),
+                               neighborsB.end()));
+        EXPECT_EQ(a->getRoutingTable().size(), b->getRoutingTable().size());
+    }
+
+    generated.simulate(60);
+    loaded.simulate(60);
+    EXPECT_GT(loaded.getStats().packetsDelivered, 0);
+    expectSameStats(generated.getStats(), loaded.getStats());
+}
+
+TEST_F(TopologyFileTest, Network_RejectsOutOfRangeRouterIDs) {
+    TopologyData topology = line();
+    topology.neighbors[0] = 9;
+    TopologyFile::write(path, topology);
+
+    Network::Config c{};
+    c.topologyPath = path;
+    EXPECT_THROW(Network{c}, std::runtime_error);
+}
+
+TEST_F(TopologyFileTest, Network_RejectsCorruptNeighborOffsets) {
+    Network::Config c{};
+    c.topologyPath = path;
+
+    // Offsets that go back, that start past the first neighbor, and that overrun the array
+    for (const std::vector<uint32_t>& starts :
+         {std::vector<uint32_t>{0, 3, 1, 4}, std::vector<uint32_t>{1, 1, 3, 4}}) {
+        TopologyData topology   = line();
+        topology.neighborStarts = starts;
+        TopologyFile::write(path, topology);
+
+        EXPECT_THROW(TopologyFile{path}, std::runtime_error);
+        EXPECT_THROW(Network{c}, std::runtime_error);
+    }
+
+    TopologyFile::write(path, line());
+    const uint32_t overrun = 9;
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(TopologyFileHeader) + (3 + 3 + 3) * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(&overrun), sizeof(overrun));
+    file.close();
+    EXPECT_THROW(Network{c}, std::runtime_error);
+}
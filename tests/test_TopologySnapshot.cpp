@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "algorithms/TopologySnapshot.h"
+#include "core/Router.h"
+
+class TopologySnapshotTestFixture : public ::testing::Test {
+protected:
+    List<std::unique_ptr<Router>> routers;
+    List<const Router*> pRouters;
+
+    Router* createRouter(uint8_t routerID) {
+        auto r = std::make_unique<Router>(IPAddress(routerID));
+        routers.pushBack(std::move(r));
+
+        Router* ptr = routers.getTail().get();
+        pRouters.pushBack(ptr);
+        return ptr;
+    }
+
+    void connectRouters(Router* r1, Router* r2) {
+        r1->connectRouter(r2);
+        r2->connectRouter(r1);
+    }
+};
+
+// =============== Construction tests ===============
+TEST_F(TopologySnapshotTestFixture, Empty) {
+    const TopologySnapshot topology(pRouters);
+
+    EXPECT_EQ(topology.routerCount(), 0);
+    EXPECT_EQ(topology.edgeCount(), 0);
+    EXPECT_EQ(topology.indexOf(IPAddress(1, 0)), TopologySnapshot::NO_INDEX);
+}
+
+TEST_F(TopologySnapshotTestFixture, IndicesFollowListOrder) {
+    createRouter(7);
+    createRouter(3);
+    createRouter(0);
+
+    const TopologySnapshot topology(pRouters);
+
+    ASSERT_EQ(topology.routerCount(), 3);
+    EXPECT_EQ(topology.indexOf(IPAddress(7, 0)), 0);
+    EXPECT_EQ(topology.indexOf(IPAddress(3, 0)), 1);
+    EXPECT_EQ(topology.indexOf(IPAddress(0, 0)), 2);
+    EXPECT_EQ(topology.indexOf(IPAddress(5, 0)), TopologySnapshot::NO_INDEX);
+    EXPECT_EQ(topology.indexOf(IPAddress(200, 0)), TopologySnapshot::NO_INDEX);
+    EXPECT_EQ(topology.getRouterIP(1), IPAddress(3, 0));
+}
+
+TEST_F(TopologySnapshotTestFixture, AdjacencyRows) {
+    // Topology: R1 -- R2 -- R3
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    Router* r3 = createRouter(3);
+
+    connectRouters(r1, r2);
+    connectRouters(r2, r3);
+
+    const TopologySnapshot topology(pRouters);
+
+    EXPECT_EQ(topology.edgeCount(), 4);
+    ASSERT_EQ(topology.neighbors(0).size(), 1);
+    EXPECT_EQ(topology.neighbors(0)[0], 1);
+    ASSERT_EQ(topology.neighbors(1).size(), 2);
+    EXPECT_NE(std::ranges::find(topology.neighbors(1), 0), topology.neighbors(1).end());
+    EXPECT_NE(std::ranges::find(topology.neighbors(1), 2), topology.neighbors(1).end());
+    EXPECT_EQ(topology.weights(1).size(), 2);
+}
+
+TEST_F(TopologySnapshotTestFixture, WeightsAreBufferUsage) {
+    Router* r1 = createRouter(1);
+    Router* r2 = createRouter(2);
+    connectRouters(r1, r2);
+
+    for (int i = 0; i < 3; i++) {
+        r1->receivePacket(Packet(10, i, 4, r1->getIP(), r2->getIP(), 10));
+    }
+    RoutingTable rt;
+    rt.setNextHopIP(r2->getIP(), r2->getIP());
+    r1->setRoutingTable(std::move(rt));
+    r1->processInputBuffer(1);
+
+    const TopologySnapshot topology(pRouters);
+
+    ASSERT_EQ(topology.weights(0).size(), 1);
+    EXPECT_EQ(topology.weights(0)[0], 3);
+    EXPECT_EQ(topology.weights(1)[0], 0);
+}
+
+TEST_F(TopologySnapshotTestFixture, NeighborOutsideListThrows) {
+    Router* r1 = createRouter(1);
+    Router outside(IPAddress(9, 0));
+    r1->connectRouter(&outside);
+
+    EXPECT_THROW(TopologySnapshot{pRouters}, std::runtime_error);
+}
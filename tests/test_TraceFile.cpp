@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "core/Network.h"
+#include "core/TraceFile.h"
+
+// =============== Fixture ===============
+class TraceFileTest : public testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override {
+        const auto* info   = testing::UnitTest::GetInstance()->current_test_info();
+        const auto tempDir = std::filesystem::temp_directory_path();
+        path = (tempDir / (std::string("routersim_") + info->name() + ".bin")).string();
+    }
+
+    void TearDown() override { std::filesystem::remove(path); }
+
+    static std::vector<TraceEvent> readAll(const std::string& file) {
+        TraceReader reader(file);
+        std::vector<TraceEvent> events;
+        TraceEvent event{};
+        while (reader.next(event)) {
+            events.push_back(event);
+        }
+        EXPECT_EQ(events.size(), reader.getEventCount());
+        return events;
+    }
+
+    static size_t countOf(const std::vector<TraceEvent>& events, TraceEventType type) {
+        return static_cast<size_t>(std::ranges::count(events, type, &TraceEvent::type));
+    }
+};
+
+// =============== TraceBuffer tests ===============
+TEST_F(TraceFileTest, TraceBuffer_StampsEventsWithTheTick) {
+    TraceBuffer buffer;
+    const Packet packet(7, 2, 4, IPAddress{1, 3}, IPAddress{2, 5}, 50);
+
+    buffer.setTick(12);
+    buffer.record(TraceEventType::Forward, packet, IPAddress{uint8_t{1}});
+
+    ASSERT_EQ(buffer.getEvents().size(), 1);
+    const TraceEvent& event = buffer.getEvents()[0];
+    EXPECT_EQ(event.tick, 12);
+    EXPECT_EQ(event.pageID, 7);
+    EXPECT_EQ(event.pagePos, 2);
+    EXPECT_EQ(event.srcIP, IPAddress(1, 3).getRawAddress());
+    EXPECT_EQ(event.dstIP, IPAddress(2, 5).getRawAddress());
+    EXPECT_EQ(event.node, IPAddress(uint8_t{1}).getRawAddress());
+    EXPECT_EQ(event.type, TraceEventType::Forward);
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.getEvents().empty());
+}
+
+// =============== Writer and reader tests ===============
+TEST_F(TraceFileTest, Writer_RoundTripsEventsAcrossWindows) {
+    // Enough events to need a second window, submitted in blocks that straddle the boundary
+    const size_t total = TraceWriter::WINDOW_EVENTS + 1000;
+    std::vector<TraceEvent> events(total);
+    for (size_t i = 0; i < total; ++i) {
+        events[i].tick   = static_cast<uint32_t>(i / 100);
+        events[i].pageID = static_cast<uint32_t>(i);
+        events[i].type   = static_cast<TraceEventType>(i % 6);
+    }
+
+    {
+        TraceWriter writer(path);
+        for (size_t i = 0; i < total; i += 777) {
+            writer.submit(std::span(events).subspan(i, std::min<size_t>(777, total - i)));
+        }
+        EXPECT_EQ(writer.getSubmittedCount(), total);
+        EXPECT_TRUE(writer.close());
+    }
+
+    const std::vector<TraceEvent> read = readAll(path);
+    ASSERT_EQ(read.size(), total);
+    for (size_t i = 0; i < total; ++i) {
+        ASSERT_EQ(read[i].pageID, events[i].pageID);
+        ASSERT_EQ(read[i].tick, events[i].tick);
+        ASSERT_EQ(read[i].type, events[i].type);
+    }
+    EXPECT_EQ(std::filesystem::file_size(path),
+              sizeof(TraceFileHeader) + total * sizeof(TraceEvent));
+}
+
+TEST_F(TraceFileTest, Writer_SmallPendingLimitKeepsEveryEvent) {
+    // Blocks larger than the limit and blocks that only fit once the writer catches up
+    std::vector<TraceEvent> events(5000);
+    for (size_t i = 0; i < events.size(); ++i) {
+        events[i].pageID = static_cast<uint32_t>(i);
+    }
+
+    {
+        TraceWriter writer(path, 32);
+        const std::array<size_t, 3> blocks = {50, 10, 7};
+        for (size_t i = 0, b = 0; i < events.size(); i += blocks[b++ % blocks.size()]) {
+            const size_t block = std::min(blocks[b % blocks.size()], events.size() - i);
+            writer.submit(std::span(events).subspan(i, block));
+        }
+        EXPECT_TRUE(writer.close());
+    }
+
+    const std::vector<TraceEvent> read = readAll(path);
+    ASSERT_EQ(read.size(), events.size());
+    for (size_t i = 0; i < read.size(); ++i) {
+        ASSERT_EQ(read[i].pageID, i);
+    }
+}
+
+TEST_F(TraceFileTest, Writer_ZeroPendingLimitThrows) {
+    EXPECT_THROW(TraceWriter(path, 0), std::invalid_argument);
+}
+
+TEST_F(TraceFileTest, Writer_EmptyTraceHasOnlyTheHeader) {
+    {
+        TraceWriter writer(path);
+    }
+
+    EXPECT_TRUE(readAll(path).empty());
+    EXPECT_EQ(std::filesystem::file_size(path), sizeof(TraceFileHeader));
+}
+
+TEST_F(TraceFileTest, Writer_ThrowsIfFileCannotBeOpened) {
+    EXPECT_THROW(TraceWriter("/nonexistent_dir/trace.bin"), std::runtime_error);
+}
+
+TEST_F(TraceFileTest, Reader_RejectsFilesThatAreNotTraces) {
+    std::ofstream(path) << "not a trace file at all";
+
+    EXPECT_THROW(TraceReader{path}, std::runtime_error);
+    EXPECT_STREQ(traceEventName(TraceEventType::PageComplete), "page_complete");
+}
+
+// =============== Network tests ===============
+TEST_F(TraceFileTest, Network_TracesForwardsAndCompletedPages) {
+    Network net{Network::Config{.routerCount = 8, .maxTerminalCount = 3, .complexity = 2,
+                                .trafficProbability = 0.3f, .maxPageLen = 4, .seed = 11,
+                                .tracePath = path}};
+    net.simulate(40);
+    const NetworkStats stats = net.getStats();
+    EXPECT_TRUE(net.closeTrace());
+
+    const std::vector<TraceEvent> events = readAll(path);
+    size_t forwarded                     = 0;
+    for (const Router* rtr : net.getRouters()) {
+        forwarded += rtr->getPacketsForwarded();
+    }
+
+    EXPECT_EQ(countOf(events, TraceEventType::Enqueue), stats.packetsGenerated);
+    EXPECT_EQ(countOf(events, TraceEventType::Forward), forwarded);
+    EXPECT_EQ(countOf(events, TraceEventType::PageComplete), stats.pagesCompleted);
+    EXPECT_GT(countOf(events, TraceEventType::Deliver), 0);
+    ASSERT_FALSE(events.empty());
+    EXPECT_TRUE(std::ranges::is_sorted(events, {}, &TraceEvent::tick));
+    EXPECT_EQ(events.back().tick, 40);
+}
+
+TEST_F(TraceFileTest, Network_TraceDoesNotDependOnTickThreads) {
+    const std::string other = path + ".threads";
+    {
+        Network two{Network::Config{.routerCount = 8, .maxTerminalCount = 3, .complexity = 2,
+                                    .trafficProbability = 0.3f, .maxPageLen = 4, .tickThreads = 2,
+                                    .seed = 11, .tracePath = path}};
+        Network four{Network::Config{.routerCount = 8, .maxTerminalCount = 3, .complexity = 2,
+                                     .trafficProbability = 0.3f, .maxPageLen = 4, .tickThreads = 4,
+                                     .seed = 11, .tracePath = other}};
+        two.simulate(30);
+        four.simulate(30);
+    }
+
+    const std::vector<TraceEvent> a = readAll(path);
+    const std::vector<TraceEvent> b = readAll(other);
+    std::filesystem::remove(other);
+
+    ASSERT_EQ(a.size(), b.size());
+    EXPECT_FALSE(a.empty());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(std::memcmp(&a[i], &b[i], sizeof(TraceEvent)), 0) << "event " << i;
+    }
+}
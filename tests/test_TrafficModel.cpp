@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "core/TrafficModel.h"
+
+namespace {
+/** Emission ticks of a model until the first one at or past endTick */
+std::vector<size_t> emissions(TrafficModel& model, size_t fromTick, size_t endTick,
+                              Xoshiro256& rng) {
+    std::vector<size_t> ticks;
+    for (size_t tick = model.firstEmission(fromTick, rng); tick < endTick;
+         tick = model.nextEmission(tick, rng)) {
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+}  // namespace
+
+// =============== BernoulliTraffic tests ===============
+TEST(BernoulliTrafficTest, EmissionRate_MatchesProbability) {
+    BernoulliTraffic model(0.1f);
+    Xoshiro256 rng(11);
+    const std::vector<size_t> ticks = emissions(model, 5, 100005, rng);
+
+    EXPECT_NEAR(static_cast<double>(ticks.size()), 10000.0, 400.0);
+    EXPECT_GE(ticks.front(), 5);
+    for (size_t i = 1; i < ticks.size(); ++i) {
+        EXPECT_GT(ticks[i], ticks[i - 1]);  // At most one page per tick
+    }
+}
+
+TEST(BernoulliTrafficTest, EdgeProbabilities) {
+    Xoshiro256 rng(11);
+    BernoulliTraffic never(0.0f);
+    BernoulliTraffic always(1.0f);
+
+    EXPECT_EQ(never.firstEmission(3, rng), TrafficModel::NEVER);
+    EXPECT_EQ(emissions(always, 3, 8, rng), (std::vector<size_t>{3, 4, 5, 6, 7}));
+}
+
+// =============== PoissonTraffic tests ===============
+TEST(PoissonTrafficTest, EmissionRate_MatchesRate) {
+    PoissonTraffic model(2.5);
+    Xoshiro256 rng(12);
+    const std::vector<size_t> ticks = emissions(model, 0, 10000, rng);
+
+    EXPECT_NEAR(static_cast<double>(ticks.size()), 25000.0, 800.0);
+    for (size_t i = 1; i < ticks.size(); ++i) {
+        EXPECT_GE(ticks[i], ticks[i - 1]);  // Several pages can share a tick
+    }
+}
+
+TEST(PoissonTrafficTest, RateValidation) {
+    Xoshiro256 rng(12);
+    PoissonTraffic silent(0.0);
+
+    EXPECT_THROW(PoissonTraffic(-1.0), std::invalid_argument);
+    EXPECT_EQ(silent.firstEmission(0, rng), TrafficModel::NEVER);
+}
+
+// =============== OnOffTraffic tests ===============
+TEST(OnOffTrafficTest, EmitsInBurstsAtTheMeanDutyCycle) {
+    OnOffTraffic model(1.0f, 20.0, 80.0);
+    Xoshiro256 rng(13);
+    const std::vector<size_t> ticks = emissions(model, 0, 200000, rng);
+
+    // Always emitting while on, so the share of ticks with a page is the on share of the time
+    EXPECT_NEAR(static_cast<double>(ticks.size()) / 200000.0, 0.2, 0.02);
+
+    size_t bursts = 1;
+    for (size_t i = 1; i < ticks.size(); ++i) {
+        ASSERT_GT(ticks[i], ticks[i - 1]);
+        bursts += ticks[i] - ticks[i - 1] > 1 ? 1 : 0;
+    }
+    EXPECT_NEAR(static_cast<double>(ticks.size()) / static_cast<double>(bursts), 20.0, 2.0);
+    EXPECT_GT(ticks.front(), 0);  // The source starts in an off period
+}
+
+TEST(OnOffTrafficTest, PeriodValidation) {
+    EXPECT_THROW(OnOffTraffic(0.5f, 0.5, 10.0), std::invalid_argument);
+    EXPECT_THROW(OnOffTraffic(0.5f, 10.0, 0.0), std::invalid_argument);
+}
+
+// =============== TraceTraffic tests ===============
+TEST(TraceTrafficTest, ReplaysSortedTicksWithRepeats) {
+    TraceTraffic model({9, 2, 5, 5, 14});
+    Xoshiro256 rng(14);
+
+    EXPECT_EQ(emissions(model, 0, 100, rng), (std::vector<size_t>{2, 5, 5, 9, 14}));
+    EXPECT_EQ(emissions(model, 6, 100, rng), (std::vector<size_t>{9, 14}));
+    EXPECT_EQ(model.firstEmission(15, rng), TrafficModel::NEVER);
+}
+
+// =============== Clone tests ===============
+TEST(TrafficModelTest, Clone_ContinuesFromTheSameState) {
+    PoissonTraffic model(0.7);
+    Xoshiro256 rng(15);
+    const size_t first = model.firstEmission(10, rng);
+
+    const std::unique_ptr<TrafficModel> copy = model.clone();
+    Xoshiro256 copyRng = rng;
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(copy->nextEmission(first, copyRng), model.nextEmission(first, rng));
+    }
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include "structures/arena.h"
+
+// Structs for Testing ===============
+struct Pinned {
+    int value;
+    std::vector<int>* destroyed;
+
+    Pinned(int value, std::vector<int>* destroyed) : value(value), destroyed(destroyed) {}
+    ~Pinned() { destroyed->push_back(value); }
+
+    Pinned(const Pinned&)            = delete;
+    Pinned& operator=(const Pinned&) = delete;
+    Pinned(Pinned&&)                 = delete;
+    Pinned& operator=(Pinned&&)      = delete;
+};
+
+// =============== Construction tests ===============
+TEST(ArenaConstruction, EmplacesNonMovableElementsSideBySide) {
+    std::vector<int> destroyed;
+    Arena<Pinned> arena(3);
+
+    Pinned& first = arena.emplace(1, &destroyed);
+    arena.emplace(2, &destroyed);
+
+    EXPECT_EQ(arena.size(), 2);
+    EXPECT_EQ(arena.capacity(), 3);
+    EXPECT_EQ(&arena[0], &first);
+    EXPECT_EQ(&arena[1], &first + 1);
+    EXPECT_EQ(arena[1].value, 2);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&first) % 64, 0);
+}
+
+TEST(ArenaConstruction, ThrowsWhenFull) {
+    Arena<int> arena(1);
+    arena.emplace(7);
+
+    EXPECT_THROW(arena.emplace(8), std::length_error);
+    EXPECT_EQ(arena.size(), 1);
+
+    Arena<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_THROW(empty.emplace(1), std::length_error);
+}
+
+// =============== Lifetime tests ===============
+TEST(ArenaLifetime, DestroysInReverseOrder) {
+    std::vector<int> destroyed;
+    {
+        Arena<Pinned> arena(3);
+        for (int i = 1; i <= 3; ++i) {
+            arena.emplace(i, &destroyed);
+        }
+    }
+
+    EXPECT_EQ(destroyed, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(ArenaLifetime, MoveKeepsElementsInPlace) {
+    std::vector<int> destroyed;
+    Arena<Pinned> arena(2);
+    const Pinned* element = &arena.emplace(5, &destroyed);
+
+    Arena<Pinned> other = std::move(arena);
+    EXPECT_EQ(&other[0], element);
+    EXPECT_EQ(other.size(), 1);
+    EXPECT_TRUE(arena.empty());  // NOLINT(bugprone-use-after-move)
+
+    other = Arena<Pinned>(4);
+    EXPECT_EQ(destroyed, std::vector<int>{5});
+    EXPECT_EQ(other.capacity(), 4);
+}
+
+TEST(ArenaLifetime, IteratesInConstructionOrder) {
+    Arena<int> arena(4);
+    for (int i = 0; i < 4; ++i) {
+        arena.emplace(i * 10);
+    }
+
+    int expected = 0;
+    for (int value : arena) {
+        EXPECT_EQ(value, expected);
+        expected += 10;
+    }
+    EXPECT_EQ(expected, 40);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "structures/bloom_filter.h"
+
+// =============== Constructors tests ===============
+TEST(AgingBloomFilterConstructors, EmptyFilterHoldsNothing) {
+    const AgingBloomFilter filter;
+
+    EXPECT_FALSE(filter.isEnabled());
+    EXPECT_EQ(filter.getBitCount(), 0);
+    EXPECT_FALSE(filter.contains(42));
+}
+
+TEST(AgingBloomFilterConstructors, RoundsBitsUpToPowerOfTwo) {
+    EXPECT_EQ(AgingBloomFilter(1).getBitCount(), 64);
+    EXPECT_EQ(AgingBloomFilter(1000).getBitCount(), 1024);
+    EXPECT_EQ(AgingBloomFilter(1024).getGenerationKeys(), 1024 / AgingBloomFilter::BITS_PER_KEY);
+}
+
+// =============== Membership tests ===============
+TEST(AgingBloomFilterMembership, NoFalseNegatives) {
+    AgingBloomFilter filter(1 << 12);
+    for (uint64_t key = 0; key < filter.getGenerationKeys(); key++) {
+        filter.insert(key * 7919);
+    }
+
+    for (uint64_t key = 0; key < filter.getGenerationKeys(); key++) {
+        EXPECT_TRUE(filter.contains(key * 7919));
+    }
+}
+
+TEST(AgingBloomFilterMembership, FalsePositiveRateStaysLow) {
+    AgingBloomFilter filter(1 << 14);
+    for (uint64_t key = 0; key < 10 * filter.getGenerationKeys(); key++) {
+        filter.insert(key);
+    }
+
+    size_t falsePositives = 0;
+    constexpr uint64_t PROBES = 100000;
+    for (uint64_t key = 0; key < PROBES; key++) {
+        falsePositives += filter.contains((uint64_t{1} << 40) + key);
+    }
+    // Two full generations at 16 bits per key each stay around 1%
+    EXPECT_LT(falsePositives, PROBES / 50);
+}
+
+// =============== Aging tests ===============
+TEST(AgingBloomFilterAging, ForgetsKeysAfterTwoGenerations) {
+    AgingBloomFilter filter(1 << 10);
+    const size_t generation = filter.getGenerationKeys();
+    filter.insert(1);
+
+    for (uint64_t key = 0; key < generation; key++) {
+        filter.insert(1000 + key);
+    }
+    EXPECT_TRUE(filter.contains(1));  // Moved to the previous generation
+
+    for (uint64_t key = 0; key < generation; key++) {
+        filter.insert(5000 + key);
+    }
+    EXPECT_FALSE(filter.contains(1));
+}
+
+TEST(AgingBloomFilterAging, ClearForgetsEverything) {
+    AgingBloomFilter filter(256);
+    filter.insert(3);
+    filter.clear();
+
+    EXPECT_FALSE(filter.contains(3));
+    EXPECT_EQ(filter.getInserted(), 0);
+}
+
+// =============== Restore tests ===============
+TEST(AgingBloomFilterRestore, RestoresSavedGenerations) {
+    AgingBloomFilter filter(512);
+    for (uint64_t key = 0; key < 40; key++) {
+        filter.insert(key);
+    }
+    const std::vector<uint64_t> current(filter.currentWords().begin(),
+                                        filter.currentWords().end());
+    const std::vector<uint64_t> previous(filter.previousWords().begin(),
+                                         filter.previousWords().end());
+
+    AgingBloomFilter restored(512);
+    restored.restore(current, previous, filter.getInserted());
+    for (uint64_t key = 0; key < 40; key++) {
+        EXPECT_TRUE(restored.contains(key));
+    }
+    EXPECT_EQ(restored.getInserted(), filter.getInserted());
+}
+
+TEST(AgingBloomFilterRestore, OtherSizeThrows) {
+    const AgingBloomFilter filter(512);
+    AgingBloomFilter other(1024);
+
+    EXPECT_THROW(other.restore(filter.currentWords(), filter.previousWords(), 0),
+                 std::invalid_argument);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "structures/expiry_wheel.h"
+
+// =============== Counting tests ===============
+TEST(ExpiryWheelCounting, StartsEmpty) {
+    const ExpiryWheel wheel(10);
+
+    EXPECT_EQ(wheel.size(), 0);
+    EXPECT_EQ(wheel.getCurrentTick(), 10);
+}
+
+TEST(ExpiryWheelCounting, ExpiresAtDeadline) {
+    ExpiryWheel wheel;
+    wheel.add(3);
+    wheel.add(3);
+    wheel.add(5);
+
+    EXPECT_EQ(wheel.advance(2), 0);
+    EXPECT_EQ(wheel.advance(3), 2);
+    EXPECT_EQ(wheel.size(), 1);
+    EXPECT_EQ(wheel.advance(9), 1);
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST(ExpiryWheelCounting, RemovedItemsDoNotExpire) {
+    ExpiryWheel wheel;
+    wheel.add(4);
+    wheel.add(4);
+    wheel.remove(4);
+
+    EXPECT_EQ(wheel.advance(10), 1);
+}
+
+TEST(ExpiryWheelCounting, AdvanceBackwardsIsIgnored) {
+    ExpiryWheel wheel(20);
+    wheel.add(25);
+
+    EXPECT_EQ(wheel.advance(15), 0);
+    EXPECT_EQ(wheel.getCurrentTick(), 20);
+    EXPECT_EQ(wheel.size(), 1);
+}
+
+// =============== Levels tests ===============
+TEST(ExpiryWheelLevels, FarDeadlinesCascadeIntoNearLevel) {
+    constexpr size_t FAR = 3 * ExpiryWheel::NEAR_SLOTS + 7;
+    ExpiryWheel wheel;
+    wheel.add(FAR);
+    wheel.add(FAR + 1);
+    wheel.add(10);
+
+    EXPECT_EQ(wheel.advance(10), 1);
+    EXPECT_EQ(wheel.advance(FAR - 1), 0);
+    EXPECT_EQ(wheel.advance(FAR), 1);
+    EXPECT_EQ(wheel.advance(FAR + 1), 1);
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST(ExpiryWheelLevels, RemoveFromFarLevel) {
+    constexpr size_t FAR = 2 * ExpiryWheel::NEAR_SLOTS;
+    ExpiryWheel wheel;
+    wheel.add(FAR);
+    wheel.add(FAR + 5);
+
+    wheel.remove(FAR);
+
+    EXPECT_EQ(wheel.advance(FAR + 5), 1);
+}
+
+TEST(ExpiryWheelLevels, NearSlotsWrapAcrossRevolutions) {
+    ExpiryWheel wheel;
+    size_t expired = 0;
+
+    for (size_t tick = 1; tick <= 4 * ExpiryWheel::NEAR_SLOTS; ++tick) {
+        wheel.add(tick + 100);
+        expired += wheel.advance(tick);
+    }
+
+    EXPECT_EQ(expired, 4 * ExpiryWheel::NEAR_SLOTS - 100);
+    EXPECT_EQ(wheel.size(), 100);
+}
+
+TEST(ExpiryWheelLevels, LargeJumpExpiresBothLevels) {
+    ExpiryWheel wheel;
+    wheel.add(5);
+    wheel.add(ExpiryWheel::NEAR_SLOTS * 10);
+
+    EXPECT_EQ(wheel.advance(ExpiryWheel::NEAR_SLOTS * 20), 2);
+}
+
+TEST(ExpiryWheelLevels, ClearKeepsTick) {
+    ExpiryWheel wheel;
+    wheel.add(5);
+    wheel.add(ExpiryWheel::NEAR_SLOTS * 10);
+    wheel.advance(3);
+
+    wheel.clear();
+
+    EXPECT_EQ(wheel.size(), 0);
+    EXPECT_EQ(wheel.getCurrentTick(), 3);
+    EXPECT_EQ(wheel.advance(ExpiryWheel::NEAR_SLOTS * 20), 0);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "structures/flat_hash_map.h"
+
+// =============== Constructors tests ===============
+TEST(FlatHashMapConstructors, DefaultConstructor) {
+    const FlatHashMap<int, int> map;
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.slotCapacity(), 0);
+    EXPECT_EQ(map.find(1), nullptr);
+}
+
+TEST(FlatHashMapConstructors, ReserveAvoidsGrowth) {
+    FlatHashMap<int, int> map(100);
+    const size_t slots = map.slotCapacity();
+
+    for (int i = 0; i < 100; ++i) {
+        map.insert(i, i);
+    }
+
+    EXPECT_EQ(map.slotCapacity(), slots);
+}
+
+// =============== Modifiers tests ===============
+TEST(FlatHashMapModifiers, InsertAndFind) {
+    FlatHashMap<int, std::string> map;
+
+    const auto [value, inserted] = map.insert(7, "seven");
+
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, "seven");
+    ASSERT_NE(map.find(7), nullptr);
+    EXPECT_EQ(*map.find(7), "seven");
+    EXPECT_TRUE(map.contains(7));
+    EXPECT_FALSE(map.contains(8));
+}
+
+TEST(FlatHashMapModifiers, InsertExistingKeepsValue) {
+    FlatHashMap<int, int> map;
+    map.insert(1, 10);
+
+    const auto [value, inserted] = map.insert(1, 20);
+
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*value, 10);
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(FlatHashMapModifiers, InsertOrAssignReplacesValue) {
+    FlatHashMap<int, int> map;
+    map.insert(1, 10);
+
+    map.insertOrAssign(1, 20);
+    map.insertOrAssign(2, 30);
+
+    EXPECT_EQ(*map.find(1), 20);
+    EXPECT_EQ(*map.find(2), 30);
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(FlatHashMapModifiers, EraseKeepsProbeRunsReachable) {
+    FlatHashMap<uint64_t, int> map;
+    for (int i = 0; i < 12; ++i) {
+        map.insert(static_cast<uint64_t>(i) << 32, i);
+    }
+
+    EXPECT_TRUE(map.erase(uint64_t{3} << 32));
+    EXPECT_FALSE(map.erase(uint64_t{3} << 32));
+
+    EXPECT_EQ(map.size(), 11);
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_EQ(map.contains(static_cast<uint64_t>(i) << 32), i != 3);
+    }
+}
+
+TEST(FlatHashMapModifiers, ClearKeepsTable) {
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 20; ++i) {
+        map.insert(i, i);
+    }
+    const size_t slots = map.slotCapacity();
+
+    map.clear();
+
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.slotCapacity(), slots);
+    EXPECT_FALSE(map.contains(5));
+}
+
+TEST(FlatHashMapModifiers, ForEachVisitsEveryEntry) {
+    FlatHashMap<int, int> map;
+    for (int i = 1; i <= 10; ++i) {
+        map.insert(i, i * i);
+    }
+
+    int keys   = 0;
+    int values = 0;
+    map.forEach([&](const int& key, int& value) {
+        keys += key;
+        values += value;
+    });
+
+    EXPECT_EQ(keys, 55);
+    EXPECT_EQ(values, 385);
+}
+
+// =============== Complex tests ===============
+TEST(FlatHashMapComplex, MatchesUnorderedMapUnderChurn) {
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<uint64_t> keyDist(0, 500);
+
+    for (int step = 0; step < 20000; ++step) {
+        const uint64_t key = keyDist(gen) << 20;
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+        } else {
+            const bool inserted = map.insert(key, step).second;
+            EXPECT_EQ(inserted, reference.emplace(key, step).second);
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& [key, value] : reference) {
+        ASSERT_NE(map.find(key), nullptr);
+        EXPECT_EQ(*map.find(key), value);
+    }
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <memory>
 #include <string>
 #include <utility>
 #include "structures/list.h"
@@ -71,6 +72,31 @@ struct Resource {
     }
 };
 
+inline int liveNodes = 0;
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    explicit(false) CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        liveNodes += static_cast<int>(n);
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* ptr, size_t n) noexcept {
+        liveNodes -= static_cast<int>(n);
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const noexcept {
+        return true;
+    }
+};
+
 // =============== Constructors and assignment tests ===============
 TEST(ListConstructors, DefaultConstructor) {
     const List<int> list;
@@ -1167,3 +1193,66 @@ TEST(ListNested, ThreeLevelNesting) {
     EXPECT_EQ(cube[0][0].size(), 1);
     EXPECT_EQ(cube[0][0][0], 42);
 }
+
+// =============== Allocator tests ===============
+TEST(ListAllocator, NodesComeFromCustomAllocator) {
+    liveNodes = 0;
+    {
+        List<int, CountingAllocator<int>> list;
+        for (int i = 0; i < 10; ++i) {
+            list.pushBack(i);
+        }
+        list.insertAt(99, 5);
+        EXPECT_EQ(liveNodes, 11);
+
+        list.popFront();
+        list.popBack();
+        list.removeAt(3);
+        EXPECT_EQ(liveNodes, 8);
+
+        const List<int, CountingAllocator<int>> copy(list);
+        EXPECT_EQ(liveNodes, 16);
+        EXPECT_EQ(copy.toString(), list.toString());
+    }
+    EXPECT_EQ(liveNodes, 0);
+}
+
+TEST(ListAllocator, MoveTransfersNodesWithoutAllocating) {
+    liveNodes = 0;
+    List<int, CountingAllocator<int>> list;
+    list.pushBack(1);
+    list.pushBack(2);
+
+    List<int, CountingAllocator<int>> moved(std::move(list));
+    EXPECT_EQ(liveNodes, 2);
+
+    List<int, CountingAllocator<int>> assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(liveNodes, 2);
+    EXPECT_EQ(assigned.toString(), "1 -> 2");
+}
+
+TEST(ListAllocator, DefaultPoolReusesFreedNodes) {
+    List<int> first;
+    first.pushBack(1);
+    const int* firstNode = &first.getHead();
+    first.clear();
+
+    List<int> second;
+    second.pushBack(2);
+
+    EXPECT_EQ(&second.getHead(), firstNode);
+}
+
+TEST(ListAllocator, InsertAtRValueMovesElement) {
+    List<Resource> list;
+    list.pushBack(Resource(1));
+    list.pushBack(Resource(3));
+
+    Resource middle(2);
+    const int* payload = middle.data;
+    list.insertAt(std::move(middle), 1);
+
+    EXPECT_EQ(list[1].data, payload);
+    EXPECT_EQ(middle.data, nullptr);  // NOLINT(bugprone-use-after-move)
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "structures/pool_allocator.h"
+
+// Structs for Testing ===============
+struct alignas(32) WideBlock {
+    char bytes[40];
+};
+
+// =============== Allocation tests ===============
+TEST(PoolAllocatorAllocation, ReturnsAlignedDistinctBlocks) {
+    PoolAllocator<WideBlock> alloc;
+    std::vector<WideBlock*> blocks;
+    std::unordered_set<WideBlock*> unique;
+
+    for (int i = 0; i < 1000; ++i) {
+        WideBlock* block = alloc.allocate(1);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % alignof(WideBlock), 0);
+        blocks.push_back(block);
+        unique.insert(block);
+    }
+    EXPECT_EQ(unique.size(), blocks.size());
+
+    for (WideBlock* block : blocks) {
+        alloc.deallocate(block, 1);
+    }
+}
+
+TEST(PoolAllocatorAllocation, FreedBlockIsReusedFirst) {
+    PoolAllocator<double> alloc;
+    double* block = alloc.allocate(1);
+    alloc.deallocate(block, 1);
+
+    double* again = alloc.allocate(1);
+
+    EXPECT_EQ(again, block);
+    alloc.deallocate(again, 1);
+}
+
+TEST(PoolAllocatorAllocation, ArraysBypassThePool) {
+    PoolAllocator<int> alloc;
+    int* array = alloc.allocate(16);
+    for (int i = 0; i < 16; ++i) {
+        array[i] = i;
+    }
+
+    EXPECT_EQ(array[15], 15);
+    alloc.deallocate(array, 16);
+}
+
+TEST(PoolAllocatorAllocation, ReboundAllocatorsCompareEqual) {
+    const PoolAllocator<int> ints;
+    const PoolAllocator<double> doubles(ints);
+
+    EXPECT_TRUE(ints == doubles);
+}
+
+// =============== Threading tests ===============
+TEST(PoolAllocatorThreads, BlocksCanBeFreedOnAnotherThread) {
+    PoolAllocator<long> alloc;
+    std::vector<long*> blocks(5000);
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            blocks[i]  = alloc.allocate(1);
+            *blocks[i] = static_cast<long>(i);
+        }
+    });
+    producer.join();
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        EXPECT_EQ(*blocks[i], static_cast<long>(i));
+        alloc.deallocate(blocks[i], 1);
+    }
+}
+
+TEST(PoolAllocatorThreads, ExitingThreadReturnsBlocksToDepot) {
+    PoolAllocator<short> alloc;
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&alloc] {
+            std::vector<short*> blocks;
+            for (int i = 0; i < 10000; ++i) {
+                blocks.push_back(alloc.allocate(1));
+            }
+            for (short* block : blocks) {
+                alloc.deallocate(block, 1);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    short* block = alloc.allocate(1);
+    EXPECT_NE(block, nullptr);
+    alloc.deallocate(block, 1);
+}
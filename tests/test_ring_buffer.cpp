@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "structures/ring_buffer.h"
+
+// Structs for Testing ===============
+struct RingSpy {
+    inline static int alive = 0;
+
+    int value;
+
+    explicit RingSpy(int v = 0) : value(v) { alive++; }
+    RingSpy(const RingSpy& other) : value(other.value) { alive++; }
+    RingSpy(RingSpy&& other) noexcept : value(other.value) { alive++; }
+    RingSpy& operator=(const RingSpy&) = default;
+    RingSpy& operator=(RingSpy&&) noexcept = default;
+    ~RingSpy() { alive--; }
+};
+
+struct ThrowingCopy {
+    inline static int alive      = 0;
+    inline static int copiesLeft = -1;  // Copies allowed before one throws (-1 for unlimited)
+
+    int value;
+
+    explicit ThrowingCopy(int v) : value(v) { alive++; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copiesLeft == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        copiesLeft--;
+        alive++;
+    }
+    ~ThrowingCopy() { alive--; }
+};
+
+struct NoDefault {
+    int value;
+    explicit NoDefault(int v) : value(v) {}
+};
+
+// =============== Constructors and assignment tests ===============
+TEST(RingBufferConstructors, DefaultConstructor) {
+    const RingBuffer<int> ring;
+
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(ring.size(), 0);
+    EXPECT_EQ(ring.slotCapacity(), 0);
+}
+
+TEST(RingBufferConstructors, PreallocatedRoundsUpToPowerOfTwo) {
+    const RingBuffer<int> ring(100);
+
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(ring.slotCapacity(), 128);
+}
+
+TEST(RingBufferConstructors, CopyConstructor) {
+    RingBuffer<std::string> ring(4);
+    ring.pushBack("a");
+    ring.pushBack("b");
+
+    const RingBuffer<std::string> copy(ring);
+
+    ASSERT_EQ(copy.size(), 2);
+    EXPECT_EQ(copy[0], "a");
+    EXPECT_EQ(copy[1], "b");
+    EXPECT_EQ(copy.slotCapacity(), ring.slotCapacity());
+    EXPECT_EQ(ring.size(), 2);
+}
+
+TEST(RingBufferConstructors, MoveConstructor) {
+    RingBuffer<int> ring;
+    ring.pushBack(1);
+    ring.pushBack(2);
+
+    const RingBuffer<int> moved(std::move(ring));
+
+    ASSERT_EQ(moved.size(), 2);
+    EXPECT_EQ(moved[1], 2);
+    EXPECT_TRUE(ring.isEmpty());  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(RingBufferConstructors, CopyAssignment) {
+    RingBuffer<int> a;
+    a.pushBack(1);
+    RingBuffer<int> b;
+    b.pushBack(7);
+    b.pushBack(8);
+
+    a = b;
+
+    ASSERT_EQ(a.size(), 2);
+    EXPECT_EQ(a[0], 7);
+    EXPECT_EQ(a[1], 8);
+}
+
+TEST(RingBufferConstructors, DestructorDestroysElements) {
+    RingSpy::alive = 0;
+    {
+        RingBuffer<RingSpy> ring;
+        for (int i = 0; i < 20; ++i) {
+            ring.emplaceBack(i);
+        }
+        ring.popFront();
+        EXPECT_EQ(RingSpy::alive, 19);
+    }
+    EXPECT_EQ(RingSpy::alive, 0);
+}
+
+// =============== FIFO tests ===============
+TEST(RingBufferFifo, PushAndTakeInOrder) {
+    RingBuffer<int> ring;
+    for (int i = 0; i < 5; ++i) {
+        ring.pushBack(i);
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(ring.takeFront(), i);
+    }
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(RingBufferFifo, EmptyAccessThrows) {
+    RingBuffer<int> ring;
+
+    EXPECT_THROW(ring.popFront(), std::runtime_error);
+    EXPECT_THROW((void)ring.takeFront(), std::runtime_error);
+    EXPECT_THROW((void)ring.front(), std::runtime_error);
+    EXPECT_THROW((void)ring.getAt(0), std::out_of_range);
+}
+
+TEST(RingBufferFifo, WrapAroundReusesSlots) {
+    RingBuffer<int> ring(8);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 6; ++i) {
+            ring.pushBack(round * 10 + i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            EXPECT_EQ(ring.takeFront(), round * 10 + i);
+        }
+    }
+
+    EXPECT_EQ(ring.slotCapacity(), 8);
+}
+
+TEST(RingBufferFifo, GrowsGeometricallyAcrossWrap) {
+    RingBuffer<int> ring(8);
+    for (int i = 0; i < 6; ++i) {
+        ring.pushBack(i);
+    }
+    for (int i = 0; i < 4; ++i) {
+        ring.popFront();
+    }
+    // Head is now in the middle of the block; growing must keep the FIFO order
+    for (int i = 6; i < 20; ++i) {
+        ring.pushBack(i);
+    }
+
+    EXPECT_EQ(ring.slotCapacity(), 16);
+    ASSERT_EQ(ring.size(), 16);
+    for (int i = 4; i < 20; ++i) {
+        EXPECT_EQ(ring.takeFront(), i);
+    }
+}
+
+TEST(RingBufferFifo, NonDefaultConstructibleType) {
+    RingBuffer<NoDefault> ring;
+    ring.emplaceBack(3);
+    ring.pushBack(NoDefault{4});
+
+    EXPECT_EQ(ring.front().value, 3);
+    EXPECT_EQ(ring.takeFront().value, 3);
+    EXPECT_EQ(ring.takeFront().value, 4);
+}
+
+TEST(RingBufferFifo, ThrowingCopyDuringGrowthKeepsContents) {
+    ThrowingCopy::alive = 0;
+    {
+        RingBuffer<ThrowingCopy> ring;
+        for (int i = 0; i < 8; ++i) {
+            ring.emplaceBack(i);
+        }
+
+        // The type has no noexcept move, so growing copies; the fourth copy throws
+        ThrowingCopy::copiesLeft = 3;
+        EXPECT_THROW(ring.emplaceBack(8), std::runtime_error);
+        ThrowingCopy::copiesLeft = -1;
+
+        EXPECT_EQ(ThrowingCopy::alive, 8);
+        EXPECT_EQ(ring.slotCapacity(), 8);
+        ASSERT_EQ(ring.size(), 8);
+        for (int i = 0; i < 8; ++i) {
+            EXPECT_EQ(ring.getAt(i).value, i);
+        }
+
+        ring.emplaceBack(8);
+        EXPECT_EQ(ring.slotCapacity(), 16);
+        EXPECT_EQ(ThrowingCopy::alive, 9);
+    }
+    EXPECT_EQ(ThrowingCopy::alive, 0);
+}
+
+TEST(RingBufferFifo, BulkTakeFrontAcrossWrap) {
+    RingBuffer<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+        ring.pushBack(i);
+    }
+    ring.popFront();
+    ring.popFront();
+    ring.pushBack(4);
+    ring.pushBack(5);
+
+    std::vector<int> out;
+    ring.takeFront(3, std::back_inserter(out));
+
+    EXPECT_EQ(out, (std::vector<int>{2, 3, 4}));
+    ASSERT_EQ(ring.size(), 1);
+    EXPECT_EQ(ring.front(), 5);
+    EXPECT_THROW(ring.takeFront(2, std::back_inserter(out)), std::out_of_range);
+}
+
+// =============== Modifiers tests ===============
+TEST(RingBufferModifiers, RemoveAtFrontHalf) {
+    RingBuffer<int> ring;
+    for (int i = 0; i < 6; ++i) {
+        ring.pushBack(i);
+    }
+
+    ring.removeAt(1);
+
+    ASSERT_EQ(ring.size(), 5);
+    const int expected[] = {0, 2, 3, 4, 5};
+    for (size_t i = 0; i < ring.size(); ++i) {
+        EXPECT_EQ(ring[i], expected[i]);
+    }
+}
+
+TEST(RingBufferModifiers, RemoveAtBackHalf) {
+    RingBuffer<int> ring;
+    for (int i = 0; i < 6; ++i) {
+        ring.pushBack(i);
+    }
+
+    ring.removeAt(4);
+
+    ASSERT_EQ(ring.size(), 5);
+    const int expected[] = {0, 1, 2, 3, 5};
+    for (size_t i = 0; i < ring.size(); ++i) {
+        EXPECT_EQ(ring[i], expected[i]);
+    }
+}
+
+TEST(RingBufferModifiers, RemoveAtInvalid) {
+    RingBuffer<int> ring;
+    ring.pushBack(1);
+
+    EXPECT_THROW(ring.removeAt(1), std::out_of_range);
+}
+
+TEST(RingBufferModifiers, ClearKeepsStorage) {
+    RingSpy::alive = 0;
+    RingBuffer<RingSpy> ring(16);
+    for (int i = 0; i < 10; ++i) {
+        ring.emplaceBack(i);
+    }
+
+    ring.clear();
+
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(ring.slotCapacity(), 16);
+    EXPECT_EQ(RingSpy::alive, 0);
+}
+
+// =============== Iteration tests ===============
+TEST(RingBufferIteration, RangeForFollowsFifoOrder) {
+    RingBuffer<int> ring(8);
+    for (int i = 0; i < 7; ++i) {
+        ring.pushBack(i);
+    }
+    ring.popFront();
+    ring.popFront();
+    ring.pushBack(7);
+    ring.pushBack(8);
+
+    int expected = 2;
+    for (const int value : ring) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, 9);
+}
+
+TEST(RingBufferIteration, MutableIteration) {
+    RingBuffer<int> ring;
+    ring.pushBack(1);
+    ring.pushBack(2);
+
+    for (int& value : ring) {
+        value *= 10;
+    }
+
+    EXPECT_EQ(ring[0], 10);
+    EXPECT_EQ(ring[1], 20);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "structures/spsc_ring.h"
+
+// =============== Constructors tests ===============
+TEST(SpscRingConstructors, RoundsCapacityUpToPowerOfTwo) {
+    EXPECT_EQ(SpscRing<int>(0).capacity(), 1);
+    EXPECT_EQ(SpscRing<int>(5).capacity(), 8);
+    EXPECT_EQ(SpscRing<int>(64).capacity(), 64);
+    EXPECT_TRUE(SpscRing<int>(4).isEmpty());
+}
+
+TEST(SpscRingConstructors, MoveKeepsContents) {
+    SpscRing<int> ring(4);
+    ring.tryPush(7);
+    ring.tryPush(8);
+
+    SpscRing<int> moved(std::move(ring));
+    std::vector<int> out;
+    EXPECT_EQ(moved.popAll(out), 2);
+    EXPECT_EQ(out, (std::vector<int>{7, 8}));
+}
+
+// =============== Queue operation tests ===============
+TEST(SpscRingOperations, PushBatchStopsWhenFull) {
+    SpscRing<int> ring(4);
+    const std::vector<int> values{1, 2, 3, 4, 5, 6};
+
+    EXPECT_EQ(ring.pushBatch(values), 4);
+    EXPECT_FALSE(ring.tryPush(9));
+    EXPECT_EQ(ring.size(), 4);
+
+    std::vector<int> out;
+    ring.popAll(out);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_TRUE(ring.tryPush(5));
+}
+
+TEST(SpscRingOperations, FifoAcrossWrapAround) {
+    SpscRing<int> ring(4);
+    std::vector<int> out;
+    for (int round = 0; round < 10; round++) {
+        const std::vector<int> values{round * 3, round * 3 + 1, round * 3 + 2};
+        ASSERT_EQ(ring.pushBatch(values), 3);
+        out.clear();
+        ASSERT_EQ(ring.popAll(out), 3);
+        EXPECT_EQ(out, values);
+    }
+}
+
+TEST(SpscRingOperations, PopUntilTakesOnlyTheSealedPrefix) {
+    SpscRing<int> ring(8);
+    ring.pushBatch(std::vector<int>{1, 2, 3});
+    const size_t sealed = ring.pushedCount();
+    ring.pushBatch(std::vector<int>{4, 5});
+
+    std::vector<int> out;
+    EXPECT_EQ(ring.popUntil(sealed, out), 3);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(ring.size(), 2);
+}
+
+TEST(SpscRingOperations, ClearRestartsTheCounts) {
+    SpscRing<int> ring(4);
+    ring.pushBatch(std::vector<int>{1, 2});
+    ring.clear();
+
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_EQ(ring.pushedCount(), 0);
+}
+
+// =============== Concurrency tests ===============
+TEST(SpscRingConcurrency, ProducerAndConsumerThreadsKeepOrder) {
+    constexpr uint64_t COUNT = 200000;
+    SpscRing<uint64_t> ring(64);
+
+    std::thread producer([&ring] {
+        uint64_t next = 0;
+        while (next < COUNT) {
+            if (ring.tryPush(next)) {
+                next++;
+            } else {
+                std::this_thread::yield();  // Lets the consumer run when both share a core
+            }
+        }
+    });
+
+    std::vector<uint64_t> out;
+    out.reserve(COUNT);
+    while (out.size() < COUNT) {
+        if (ring.popAll(out) == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    for (uint64_t i = 0; i < COUNT; i++) {
+        ASSERT_EQ(out[i], i);
+    }
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "structures/timer_wheel.h"
+
+// =============== Scheduling tests ===============
+TEST(TimerWheelScheduling, ConstructorRoundsSlots) {
+    const TimerWheel<int> wheel(100);
+
+    EXPECT_EQ(wheel.size(), 0);
+    EXPECT_EQ(wheel.getCurrentTick(), 0);
+}
+
+TEST(TimerWheelScheduling, ReleasesEntriesAtDeadline) {
+    TimerWheel<int> wheel(8);
+    wheel.schedule(3, 30);
+    wheel.schedule(5, 50);
+    wheel.schedule(3, 31);
+
+    std::vector<int> fired;
+    auto collect = [&fired](int value) { fired.push_back(value); };
+
+    EXPECT_EQ(wheel.advance(2, collect), 0);
+    EXPECT_EQ(wheel.advance(3, collect), 2);
+    EXPECT_EQ(fired, (std::vector<int>{30, 31}));
+    EXPECT_EQ(wheel.size(), 1);
+
+    EXPECT_EQ(wheel.advance(10, collect), 1);
+    EXPECT_EQ(fired.back(), 50);
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST(TimerWheelScheduling, PastDeadlineFiresOnNextAdvance) {
+    TimerWheel<int> wheel(8);
+    wheel.advance(20, [](int) {});
+
+    wheel.schedule(5, 1);
+
+    int fired = 0;
+    EXPECT_EQ(wheel.advance(21, [&fired](int) { fired++; }), 1);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(TimerWheelScheduling, DeadlinesBeyondOneRevolution) {
+    TimerWheel<int> wheel(8);
+    wheel.schedule(4, 4);
+    wheel.schedule(12, 12);
+    wheel.schedule(20, 20);
+
+    std::vector<int> fired;
+    auto collect = [&fired](int value) { fired.push_back(value); };
+
+    wheel.advance(4, collect);
+    EXPECT_EQ(fired, (std::vector<int>{4}));
+    wheel.advance(12, collect);
+    EXPECT_EQ(fired, (std::vector<int>{4, 12}));
+    wheel.advance(19, collect);
+    EXPECT_EQ(fired.size(), 2);
+    wheel.advance(20, collect);
+    EXPECT_EQ(fired, (std::vector<int>{4, 12, 20}));
+}
+
+TEST(TimerWheelScheduling, LargeJumpReleasesEverythingDue) {
+    TimerWheel<int> wheel(8);
+    for (int i = 1; i <= 30; ++i) {
+        wheel.schedule(i, i);
+    }
+
+    int sum = 0;
+    EXPECT_EQ(wheel.advance(1000, [&sum](int value) { sum += value; }), 30);
+    EXPECT_EQ(sum, 465);
+    EXPECT_EQ(wheel.getCurrentTick(), 1000);
+}
+
+TEST(TimerWheelScheduling, AdvanceBackwardsIsIgnored) {
+    TimerWheel<int> wheel(8);
+    wheel.advance(10, [](int) {});
+    wheel.schedule(12, 1);
+
+    EXPECT_EQ(wheel.advance(5, [](int) {}), 0);
+    EXPECT_EQ(wheel.getCurrentTick(), 10);
+    EXPECT_EQ(wheel.size(), 1);
+}
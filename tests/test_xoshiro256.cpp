@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <random>
+#include <set>
+#include "structures/xoshiro256.h"
+
+TEST(Xoshiro256Test, Seed_MatchesReferenceSequence) {
+    // Outputs of the reference xoshiro256** seeded with SplitMix64(0)
+    Xoshiro256 rng(0);
+    EXPECT_EQ(rng(), 0x99EC5F36CB75F2B4ULL);
+    EXPECT_EQ(rng(), 0xBF6E1F784956452AULL);
+    EXPECT_EQ(rng(), 0x1A5F849D4933E6E0ULL);
+
+    rng.seed(0);
+    EXPECT_EQ(rng, Xoshiro256(0));
+}
+
+TEST(Xoshiro256Test, Jump_MatchesReferenceAndSeparatesStreams) {
+    Xoshiro256 jumped(0);
+    jumped.jump();
+    EXPECT_EQ(jumped(), 0x376215EDC846D62CULL);
+
+    // Streams handed out by jumping a master copy never start alike
+    Xoshiro256 master(42);
+    std::set<uint64_t> firsts;
+    for (int i = 0; i < 64; ++i) {
+        Xoshiro256 stream = master;
+        master.jump();
+        firsts.insert(stream());
+    }
+    EXPECT_EQ(firsts.size(), 64);
+
+    Xoshiro256 shortJumps(42);
+    Xoshiro256 longJump(42);
+    shortJumps.jump();
+    longJump.longJump();
+    EXPECT_NE(shortJumps, longJump);
+}
+
+TEST(Xoshiro256Test, WorksWithStandardDistributions) {
+    Xoshiro256 rng(7);
+    std::uniform_int_distribution<int> die(1, 6);
+    std::array<int, 7> counts{};
+    for (int i = 0; i < 60000; ++i) {
+        const int face = die(rng);
+        ASSERT_GE(face, 1);
+        ASSERT_LE(face, 6);
+        counts[face]++;
+    }
+    for (int face = 1; face <= 6; ++face) {
+        EXPECT_NEAR(counts[face], 10000, 400);
+    }
+}
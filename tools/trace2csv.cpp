@@ -0,0 +1,47 @@
+#include <exception>
+#include <fstream>
+#include <iostream>
+
+#include "core/IPAddress.h"
+#include "core/TraceFile.h"
+
+// Converts a binary trace written by Network (Config::tracePath) into CSV
+
+namespace {
+void writeCsv(TraceReader& reader, std::ostream& out) {
+    out << "tick,event,page_id,page_pos,src,dst,node\n";
+
+    TraceEvent event{};
+    while (reader.next(event)) {
+        out << event.tick << ',' << traceEventName(event.type) << ',' << event.pageID << ','
+            << event.pagePos << ',' << IPAddress::fromRaw(event.srcIP) << ','
+            << IPAddress::fromRaw(event.dstIP) << ',' << IPAddress::fromRaw(event.node) << '\n';
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <trace.bin> [output.csv]\n";
+        return 2;
+    }
+
+    try {
+        TraceReader reader(argv[1]);
+        if (argc == 2) {
+            writeCsv(reader, std::cout);
+            return 0;
+        }
+
+        std::ofstream out(argv[2]);
+        if (!out) {
+            std::cerr << "Cannot open " << argv[2] << '\n';
+            return 1;
+        }
+        writeCsv(reader, out);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}